@@ -5,7 +5,7 @@
  * - AABB (Axis-Aligned Bounding Box)
  * - OBB (Oriented Bounding Box)
  * - Plane
- * - Ray
+ * - Ray / PreparedRay
  * - Sphere
  * - Capsule
  *
@@ -18,5 +18,6 @@
 #include<hgl/math/geometry/OBB.h>
 #include<hgl/math/geometry/Plane.h>
 #include<hgl/math/geometry/Ray.h>
+#include<hgl/math/geometry/PreparedRay.h>
 #include<hgl/math/geometry/primitives/Sphere.h>
 #include<hgl/math/geometry/primitives/Capsule.h>
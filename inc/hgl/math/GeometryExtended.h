@@ -5,6 +5,9 @@
  * - Cylinder
  * - Cone
  * - Torus
+ * - TriangleMesh (static mesh collider with BVH)
+ * - HeightField (terrain collider with min/max mip ray marching)
+ * - SignedDistanceField (sparse brick SDF baked from meshes or primitives)
  *
  * These shapes are useful for more specialized applications like
  * modeling complex objects, special collision cases, and visual effects.
@@ -14,3 +17,6 @@
 #include<hgl/math/geometry/primitives/Cylinder.h>
 #include<hgl/math/geometry/primitives/Cone.h>
 #include<hgl/math/geometry/primitives/Torus.h>
+#include<hgl/math/geometry/primitives/TriangleMesh.h>
+#include<hgl/math/geometry/primitives/HeightField.h>
+#include<hgl/math/geometry/primitives/SignedDistanceField.h>
@@ -16,6 +16,11 @@
  * - RaycastQuery: Ray-geometry intersection tests
  * - DistanceQuery: Distance calculations between geometries
  * - ContainmentQuery: Containment and inclusion tests
+ * - GJK: Support-function based convex collision (GJK/EPA)
+ * - ContactManifoldQuery: Multi-point contact manifolds and persistent caching
+ * - SweepQuery: Continuous collision (time of impact) for moving geometry
+ * - CollisionDispatcher: Type-bucketed batch collision dispatch
+ * - CollisionPipeline: Grid broadphase to narrowphase contact pipeline
  */
 #pragma once
 
@@ -23,3 +28,8 @@
 #include<hgl/math/geometry/queries/RaycastQuery.h>
 #include<hgl/math/geometry/queries/DistanceQuery.h>
 #include<hgl/math/geometry/queries/ContainmentQuery.h>
+#include<hgl/math/geometry/queries/GJK.h>
+#include<hgl/math/geometry/queries/ContactManifold.h>
+#include<hgl/math/geometry/queries/SweepQuery.h>
+#include<hgl/math/geometry/queries/CollisionDispatch.h>
+#include<hgl/math/geometry/queries/CollisionPipeline.h>
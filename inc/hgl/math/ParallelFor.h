@@ -0,0 +1,135 @@
+﻿/**
+ * ParallelFor.h - 可插拔线程池的分块并行循环
+ *
+ * 批量操作将 [begin,end) 切分为缓存大小的块，交给 IParallelExecutor 执行。
+ * 引擎可实现 IParallelExecutor 接入自己的任务系统；传入 nullptr 时在当前线程串行执行。
+ */
+
+#pragma once
+
+#include<cstddef>
+#include<cstdint>
+#include<functional>
+
+/**
+ * HGL_OMP_SIMD - 标记无循环依赖、可按通道并行的内层循环
+ *
+ * 以 -fopenmp-simd（构建脚本同时定义 HGL_OPENMP_SIMD）或完整 OpenMP 编译时展开为 #pragma omp simd，
+ * 否则为空，由编译器自行决定是否自动向量化。
+ */
+#if defined(_OPENMP)||defined(HGL_OPENMP_SIMD)
+    #define HGL_OMP_SIMD _Pragma("omp simd")
+#else
+    #define HGL_OMP_SIMD
+#endif
+
+namespace hgl::math
+{
+    /**
+     * 并行执行器接口
+     */
+    class IParallelExecutor
+    {
+    public:
+
+        virtual ~IParallelExecutor()=default;
+
+        /**
+         * 获取可并行的工作线程数量（用于决定分块数量）
+         */
+        virtual uint32_t GetWorkerCount()const=0;
+
+        /**
+         * 执行 task_count 个任务，task(i) 可能在任意线程上被调用
+         * @note 必须在所有任务完成后才返回
+         */
+        virtual void Execute(size_t task_count,const std::function<void(size_t task_index)> &task)=0;
+    };//class IParallelExecutor
+
+    /**
+     * 基于 std::thread 的简单执行器(每次 Execute 创建工作线程)
+     * @note 适合工具与测试，引擎内建议接入常驻线程池
+     */
+    class ThreadParallelExecutor:public IParallelExecutor
+    {
+        uint32_t worker_count;
+
+    public:
+
+        /**
+         * @param workers 工作线程数量，0 表示使用 std::thread::hardware_concurrency()
+         */
+        explicit ThreadParallelExecutor(uint32_t workers=0);
+
+        uint32_t GetWorkerCount()const override{return worker_count;}
+
+        void Execute(size_t task_count,const std::function<void(size_t task_index)> &task) override;
+    };//class ThreadParallelExecutor
+
+    constexpr size_t PARALLEL_CHUNK_BYTES       =32*1024;       ///<默认块大小（按 L1 数据缓存估算）
+    constexpr size_t PARALLEL_CHUNK_ALIGNMENT   =64;            ///<块元素数量对齐（与 64 位位集对齐）
+
+    /**
+     * 根据每元素字节数计算缓存友好的块元素数量
+     * @param bytes_per_element 单个元素在一次遍历中访问的字节数
+     * @return 块元素数量（PARALLEL_CHUNK_ALIGNMENT 的倍数）
+     */
+    constexpr size_t ComputeChunkSize(size_t bytes_per_element)
+    {
+        if(bytes_per_element==0)
+            bytes_per_element=1;
+
+        const size_t n=PARALLEL_CHUNK_BYTES/bytes_per_element;
+
+        if(n<=PARALLEL_CHUNK_ALIGNMENT)
+            return PARALLEL_CHUNK_ALIGNMENT;
+
+        return n-n%PARALLEL_CHUNK_ALIGNMENT;
+    }
+
+    /**
+     * 计算 [begin,end) 按 chunk_size 切分后的块数量
+     */
+    constexpr size_t GetChunkCount(size_t begin,size_t end,size_t chunk_size)
+    {
+        if(end<=begin||chunk_size==0)
+            return 0;
+
+        return (end-begin+chunk_size-1)/chunk_size;
+    }
+
+    /**
+     * 分块并行循环
+     * @param executor 执行器，为 nullptr 或只有一个块时在当前线程串行执行
+     * @param begin 起始索引
+     * @param end 结束索引(不含)
+     * @param chunk_size 块元素数量
+     * @param func 块处理函数 func(chunk_index,chunk_begin,chunk_end)
+     */
+    template<typename F>
+    void ParallelForChunks(IParallelExecutor *executor,size_t begin,size_t end,size_t chunk_size,F &&func)
+    {
+        const size_t chunk_count=GetChunkCount(begin,end,chunk_size);
+
+        if(chunk_count==0)
+            return;
+
+        auto run_chunk=[&](size_t chunk)
+            {
+                const size_t chunk_begin=begin+chunk*chunk_size;
+                const size_t chunk_end=(end-chunk_begin>chunk_size)?chunk_begin+chunk_size:end;
+
+                func(chunk,chunk_begin,chunk_end);
+            };
+
+        if(!executor||chunk_count==1||executor->GetWorkerCount()<=1)
+        {
+            for(size_t i=0;i<chunk_count;i++)
+                run_chunk(i);
+
+            return;
+        }
+
+        executor->Execute(chunk_count,run_chunk);
+    }
+}//namespace hgl::math
@@ -0,0 +1,57 @@
+﻿/**
+ * Polynomial.h - 一元三次/四次方程实数根求解
+ *
+ * 解析求根（三次方程用三角/Cardano 公式，四次方程用 Ferrari 预解三次式），
+ * 全部在 double 下计算，并对每个根做两步保护性牛顿迭代修正。
+ * 三次/四次方程的重根会按重数重复给出。
+ * 主要用于射线与环面等解析曲面的求交。
+ *
+ * 批量版本按 SoA 输入系数。以 AVX 编译（CMMATH_ENABLE_AVX）时每次用 4 个 double 通道
+ * 同时求解 4 个方程：所有公式分支都计算后按掩码选择，acos/cos/cbrt 使用多项式近似，
+ * 再由同样的牛顿迭代修正到双精度；未启用 AVX 时逐个方程标量求解。
+ * 首项系数接近 0 的方程回退到标量路径降次求解。
+ */
+#pragma once
+
+#include<cstddef>
+#include<cstdint>
+
+namespace hgl::math
+{
+    /**
+     * 求解 a*x^2+b*x+c=0 的实数根（a 为 0 时按一次方程处理）
+     * @param roots 输出实数根，升序
+     * @return 实数根数量（重根只计一次）
+     */
+    int SolveQuadratic(double a,double b,double c,double roots[2]);
+
+    /**
+     * 求解 a*x^3+b*x^2+c*x+d=0 的实数根（a 为 0 时降次）
+     * @param roots 输出实数根，升序
+     * @return 实数根数量
+     */
+    int SolveCubic(double a,double b,double c,double d,double roots[3]);
+
+    /**
+     * 求解 a*x^4+b*x^3+c*x^2+d*x+e=0 的实数根（a 为 0 时降次）
+     * @param roots 输出实数根，升序
+     * @return 实数根数量
+     */
+    int SolveQuartic(double a,double b,double c,double d,double e,double roots[4]);
+
+    /**
+     * 批量求解三次方程，第 i 个方程为 a[i]*x^3+b[i]*x^2+c[i]*x+d[i]=0
+     * @param roots 输出，第 i 个方程的根为 roots[i*3,i*3+root_count[i])，升序
+     * @param root_count 输出每个方程的实数根数量
+     */
+    void SolveCubicBatch(const float *a,const float *b,const float *c,const float *d,size_t count,
+                         float *roots,uint8_t *root_count);
+
+    /**
+     * 批量求解四次方程，第 i 个方程为 a[i]*x^4+b[i]*x^3+c[i]*x^2+d[i]*x+e[i]=0
+     * @param roots 输出，第 i 个方程的根为 roots[i*4,i*4+root_count[i])，升序
+     * @param root_count 输出每个方程的实数根数量
+     */
+    void SolveQuarticBatch(const float *a,const float *b,const float *c,const float *d,const float *e,size_t count,
+                           float *roots,uint8_t *root_count);
+}//namespace hgl::math
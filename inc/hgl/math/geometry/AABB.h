@@ -19,6 +19,7 @@ namespace hgl::math
     };
 
     class Ray;
+    struct PreparedRay;
     class OBB;
 
     /**
@@ -259,6 +260,13 @@ namespace hgl::math
         bool IntersectsRay(const Ray &ray) const;
         bool IntersectsRay(const Ray &ray, float &t_min, float &t_max) const;
 
+        /**
+         * 使用预处理射线检查相交（同一射线测试多个盒子时避免重复求倒数）
+         */
+        bool IntersectsRay(const PreparedRay &ray, float &distance) const;
+        bool IntersectsRay(const PreparedRay &ray) const;
+        bool IntersectsRay(const PreparedRay &ray, float &t_min, float &t_max) const;
+
         /**
          * 检查与平面的关系
          * @return <0: 完全在平面后面, 0: 相交, >0: 完全在平面前面
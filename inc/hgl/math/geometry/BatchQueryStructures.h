@@ -17,7 +17,8 @@
 #include <vector>
 #include <hgl/math/Vector.h>
 #include <cstdint>
-#include <memory>
+#include <cstddef>
+#include <new>
 
 namespace hgl::math
 {
@@ -27,8 +28,36 @@ namespace hgl::math
      */
     constexpr size_t SIMD_ALIGNMENT = 32;
 
+    /**
+     * 按指定字节对齐分配内存的分配器（C++17 对齐 operator new）
+     */
+    template<typename T, size_t Alignment>
+    struct AlignedAllocator
+    {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        AlignedAllocator() noexcept = default;
+
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* p, size_t) noexcept {
+            ::operator delete(p, std::align_val_t(Alignment));
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    };
+
     template<typename T>
-    using AlignedVector = std::vector<T, std::aligned_allocator<T, SIMD_ALIGNMENT>>;
+    using AlignedVector = std::vector<T, AlignedAllocator<T, SIMD_ALIGNMENT>>;
 
     //=========================================================================
     // 批量球体数据（SOA布局）
@@ -182,6 +211,204 @@ namespace hgl::math
         }
     };
 
+    //=========================================================================
+    // 批量OBB数据（SOA布局）
+    //=========================================================================
+
+    /**
+     * 批量OBB操作的SOA结构
+     *
+     * axis[i][c] 为第 i 根轴（单位向量）的第 c 个分量
+     */
+    struct BatchOBBSOA
+    {
+        AlignedVector<float> centerX, centerY, centerZ;
+        AlignedVector<float> axis[3][3];
+        AlignedVector<float> halfX, halfY, halfZ;
+
+        size_t count;
+
+        BatchOBBSOA() : count(0) {}
+
+        void Reserve(size_t n) {
+            centerX.reserve(n); centerY.reserve(n); centerZ.reserve(n);
+            for (auto& a : axis)
+                for (auto& column : a)
+                    column.reserve(n);
+            halfX.reserve(n); halfY.reserve(n); halfZ.reserve(n);
+        }
+
+        void Add(const Vector3f& center, const Vector3f& a0, const Vector3f& a1, const Vector3f& a2, const Vector3f& half) {
+            const Vector3f* a[3] = {&a0, &a1, &a2};
+
+            centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+            for (int i = 0; i < 3; ++i)
+                for (int c = 0; c < 3; ++c)
+                    axis[i][c].push_back((*a[i])[c]);
+            halfX.push_back(half.x); halfY.push_back(half.y); halfZ.push_back(half.z);
+            count++;
+        }
+
+        void Clear() {
+            centerX.clear(); centerY.clear(); centerZ.clear();
+            for (auto& a : axis)
+                for (auto& column : a)
+                    column.clear();
+            halfX.clear(); halfY.clear(); halfZ.clear();
+            count = 0;
+        }
+    };
+
+    //=========================================================================
+    // 批量圆柱/圆锥/圆环数据（SOA布局）
+    //=========================================================================
+
+    /**
+     * 批量圆柱体操作的SOA结构（中心 + 单位轴向 + 高度 + 半径，与 Cylinder 相同）
+     */
+    struct BatchCylinderSOA
+    {
+        AlignedVector<float> centerX, centerY, centerZ;
+        AlignedVector<float> axisX, axisY, axisZ;
+        AlignedVector<float> height;
+        AlignedVector<float> radius;
+
+        size_t count;
+
+        BatchCylinderSOA() : count(0) {}
+
+        void Reserve(size_t n) {
+            centerX.reserve(n); centerY.reserve(n); centerZ.reserve(n);
+            axisX.reserve(n); axisY.reserve(n); axisZ.reserve(n);
+            height.reserve(n); radius.reserve(n);
+        }
+
+        void Add(const Vector3f& center, const Vector3f& axis, float h, float r) {
+            centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+            axisX.push_back(axis.x); axisY.push_back(axis.y); axisZ.push_back(axis.z);
+            height.push_back(h); radius.push_back(r);
+            count++;
+        }
+
+        void Clear() {
+            centerX.clear(); centerY.clear(); centerZ.clear();
+            axisX.clear(); axisY.clear(); axisZ.clear();
+            height.clear(); radius.clear();
+            count = 0;
+        }
+    };
+
+    /**
+     * 批量圆锥体操作的SOA结构（顶点 + 指向底面的单位轴向 + 高度 + 底面半径，与 Cone 相同）
+     */
+    struct BatchConeSOA
+    {
+        AlignedVector<float> apexX, apexY, apexZ;
+        AlignedVector<float> axisX, axisY, axisZ;
+        AlignedVector<float> height;
+        AlignedVector<float> radius;
+
+        size_t count;
+
+        BatchConeSOA() : count(0) {}
+
+        void Reserve(size_t n) {
+            apexX.reserve(n); apexY.reserve(n); apexZ.reserve(n);
+            axisX.reserve(n); axisY.reserve(n); axisZ.reserve(n);
+            height.reserve(n); radius.reserve(n);
+        }
+
+        void Add(const Vector3f& apex, const Vector3f& axis, float h, float r) {
+            apexX.push_back(apex.x); apexY.push_back(apex.y); apexZ.push_back(apex.z);
+            axisX.push_back(axis.x); axisY.push_back(axis.y); axisZ.push_back(axis.z);
+            height.push_back(h); radius.push_back(r);
+            count++;
+        }
+
+        void Clear() {
+            apexX.clear(); apexY.clear(); apexZ.clear();
+            axisX.clear(); axisY.clear(); axisZ.clear();
+            height.clear(); radius.clear();
+            count = 0;
+        }
+    };
+
+    /**
+     * 批量圆环操作的SOA结构（中心 + 单位轴向 + 主半径 + 管半径，与 Torus 相同）
+     */
+    struct BatchTorusSOA
+    {
+        AlignedVector<float> centerX, centerY, centerZ;
+        AlignedVector<float> axisX, axisY, axisZ;
+        AlignedVector<float> majorRadius;
+        AlignedVector<float> minorRadius;
+
+        size_t count;
+
+        BatchTorusSOA() : count(0) {}
+
+        void Reserve(size_t n) {
+            centerX.reserve(n); centerY.reserve(n); centerZ.reserve(n);
+            axisX.reserve(n); axisY.reserve(n); axisZ.reserve(n);
+            majorRadius.reserve(n); minorRadius.reserve(n);
+        }
+
+        void Add(const Vector3f& center, const Vector3f& axis, float major_r, float minor_r) {
+            centerX.push_back(center.x); centerY.push_back(center.y); centerZ.push_back(center.z);
+            axisX.push_back(axis.x); axisY.push_back(axis.y); axisZ.push_back(axis.z);
+            majorRadius.push_back(major_r); minorRadius.push_back(minor_r);
+            count++;
+        }
+
+        void Clear() {
+            centerX.clear(); centerY.clear(); centerZ.clear();
+            axisX.clear(); axisY.clear(); axisZ.clear();
+            majorRadius.clear(); minorRadius.clear();
+            count = 0;
+        }
+    };
+
+    //=========================================================================
+    // 批量点数据（SOA布局）
+    //=========================================================================
+
+    /**
+     * 批量查询点的SOA结构
+     */
+    struct BatchPointSOA
+    {
+        AlignedVector<float> x, y, z;
+
+        size_t count;
+
+        BatchPointSOA() : count(0) {}
+
+        void Reserve(size_t n) {
+            x.reserve(n); y.reserve(n); z.reserve(n);
+        }
+
+        void Resize(size_t n) {
+            x.resize(n); y.resize(n); z.resize(n);
+            count = n;
+        }
+
+        void Set(size_t index, const Vector3f& p) {
+            x[index] = p.x; y[index] = p.y; z[index] = p.z;
+        }
+
+        void Add(const Vector3f& p) {
+            x.push_back(p.x); y.push_back(p.y); z.push_back(p.z);
+            count++;
+        }
+
+        void Clear() {
+            x.clear(); y.clear(); z.clear();
+            count = 0;
+        }
+
+        Vector3f Get(size_t index) const { return Vector3f(x[index], y[index], z[index]); }
+    };
+
     //=========================================================================
     // 批量射线数据（SOA布局）
     //=========================================================================
@@ -203,6 +430,20 @@ namespace hgl::math
             directionX.reserve(n); directionY.reserve(n); directionZ.reserve(n);
         }
 
+        /**
+         * 调整为N条射线（供批量生成直接按下标写入）
+         */
+        void Resize(size_t n) {
+            originX.resize(n); originY.resize(n); originZ.resize(n);
+            directionX.resize(n); directionY.resize(n); directionZ.resize(n);
+            count = n;
+        }
+
+        void Set(size_t index, const Vector3f& origin, const Vector3f& direction) {
+            originX[index] = origin.x; originY[index] = origin.y; originZ[index] = origin.z;
+            directionX[index] = direction.x; directionY[index] = direction.y; directionZ[index] = direction.z;
+        }
+
         void Add(const Vector3f& origin, const Vector3f& direction) {
             originX.push_back(origin.x); originY.push_back(origin.y); originZ.push_back(origin.z);
             directionX.push_back(direction.x); directionY.push_back(direction.y); directionZ.push_back(direction.z);
@@ -216,6 +457,93 @@ namespace hgl::math
         }
     };
 
+    //=========================================================================
+    // 批量三角形数据（SOA布局）
+    //=========================================================================
+
+    /**
+     * 批量三角形操作的SOA结构
+     *
+     * vertex[i][axis] 为第 i 个顶点（0..2）在 axis 轴（0=X,1=Y,2=Z）上的坐标列，
+     * 按数组下标访问，便于射线测试按轴置换直接选取列
+     */
+    struct BatchTriangleSOA
+    {
+        AlignedVector<float> vertex[3][3];
+
+        size_t count;
+
+        BatchTriangleSOA() : count(0) {}
+
+        void Reserve(size_t n) {
+            for (auto& v : vertex)
+                for (auto& column : v)
+                    column.reserve(n);
+        }
+
+        void Add(const Vector3f& v0, const Vector3f& v1, const Vector3f& v2) {
+            const Vector3f* v[3] = {&v0, &v1, &v2};
+
+            for (int i = 0; i < 3; ++i)
+                for (int axis = 0; axis < 3; ++axis)
+                    vertex[i][axis].push_back((*v[i])[axis]);
+
+            count++;
+        }
+
+        void Clear() {
+            for (auto& v : vertex)
+                for (auto& column : v)
+                    column.clear();
+
+            count = 0;
+        }
+
+        const float* GetData(int i, int axis) const { return vertex[i][axis].data(); }
+    };
+
+    /**
+     * 8 个三角形一组的定长 SOA 包（用于 BVH 叶节点，一次 AVX 运算测试一条射线对 8 个三角形）
+     *
+     * 未使用的槽位保持为退化三角形（三个顶点相同），不会被命中
+     */
+    struct TrianglePacket8
+    {
+        static constexpr uint32_t WIDTH = 8;
+
+        alignas(32) float vertex[3][3][WIDTH];     // [顶点][轴][槽位]
+        uint32_t count;
+
+        TrianglePacket8() { Clear(); }
+
+        void Clear() {
+            for (auto& v : vertex)
+                for (auto& column : v)
+                    for (float& value : column)
+                        value = 0.0f;
+
+            count = 0;
+        }
+
+        /**
+         * 追加一个三角形
+         * @return 包已满时返回 false
+         */
+        bool Add(const Vector3f& v0, const Vector3f& v1, const Vector3f& v2) {
+            if (count >= WIDTH)
+                return false;
+
+            const Vector3f* v[3] = {&v0, &v1, &v2};
+
+            for (int i = 0; i < 3; ++i)
+                for (int axis = 0; axis < 3; ++axis)
+                    vertex[i][axis][count] = (*v[i])[axis];
+
+            count++;
+            return true;
+        }
+    };
+
     //=========================================================================
     // 批量查询结果（SOA布局）
     //=========================================================================
@@ -246,6 +574,56 @@ namespace hgl::math
         }
     };
 
+    /**
+     * 包含关系分类（2 位）
+     */
+    enum class ContainmentState : uint8_t
+    {
+        Outside      = 0,       // 与容器不相交
+        Intersecting = 1,       // 部分在容器内
+        Inside       = 2        // 完全在容器内
+    };
+
+    /**
+     * 批量包含分类结果
+     * 每个对象 2 位，每字节 4 个，未使用的位为 Outside
+     */
+    struct BatchContainmentResults
+    {
+        AlignedVector<uint8_t> states;     // 2位状态（第 i 个位于 states[i/4] 的第 (i%4)*2 位）
+
+        size_t count;
+
+        BatchContainmentResults() : count(0) {}
+
+        /**
+         * 设置数量并将全部状态清为 Outside
+         */
+        void Resize(size_t n) {
+            states.assign((n + 3) / 4, 0);
+            count = n;
+        }
+
+        ContainmentState Get(size_t index) const {
+            return ContainmentState((states[index / 4] >> ((index % 4) * 2)) & 3);
+        }
+
+        void Set(size_t index, ContainmentState state) {
+            const int shift = int(index % 4) * 2;
+            states[index / 4] = uint8_t((states[index / 4] & ~(3 << shift)) | (int(state) << shift));
+        }
+
+        /**
+         * 统计处于指定状态的对象数量
+         */
+        size_t Count(ContainmentState state) const {
+            size_t n = 0;
+            for (size_t i = 0; i < count; ++i)
+                n += (Get(i) == state);
+            return n;
+        }
+    };
+
     /**
      * 批量射线检测结果（含详细信息）
      */
@@ -36,6 +36,29 @@ namespace hgl::math
      */
     OBB ToOBB(const BoundingSphere &sphere);
 
+    /**
+     * 包围体通道(可按位组合)
+     * 用于只计算/存储需要的包围体，避免不必要的 OBB 计算等开销
+     */
+    enum class BoundingVolumeChannel:uint8_t
+    {
+        None        =0,
+        AABB        =0x01,          ///<轴对齐包围盒
+        OBB         =0x02,          ///<有向包围盒
+        Sphere      =0x04,          ///<包围球
+
+        AABBSphere  =AABB|Sphere,   ///<最常用组合(AABB+包围球)
+        All         =AABB|OBB|Sphere
+    };
+
+    constexpr BoundingVolumeChannel operator|(BoundingVolumeChannel a,BoundingVolumeChannel b){return BoundingVolumeChannel(uint8_t(a)|uint8_t(b));}
+    constexpr BoundingVolumeChannel operator&(BoundingVolumeChannel a,BoundingVolumeChannel b){return BoundingVolumeChannel(uint8_t(a)&uint8_t(b));}
+
+    /**
+     * 检查通道组合中是否包含指定通道
+     */
+    constexpr bool HasChannel(BoundingVolumeChannel channels,BoundingVolumeChannel ch){return (uint8_t(channels)&uint8_t(ch))!=0;}
+
     struct BoundingVolumesData;
 
     /**
@@ -131,6 +154,35 @@ namespace hgl::math
             return true;
         }
 
+        /**
+         * 从点集初始化指定通道的包围体
+         * @param channels 需要精确计算的通道，未选中的包围体由 AABB 推导
+         * @note OBB 点集拟合开销最大，不需要精确 OBB 时请不要选择 OBB 通道
+         */
+        bool SetFromPoints(const float *pts,const uint32_t count,const uint32_t component_count,const BoundingVolumeChannel channels)
+        {
+            if(!pts||count<=0||channels==BoundingVolumeChannel::None)
+            {
+                Clear();
+                return false;
+            }
+
+            // AABB 计算开销最低，且未选中的包围体需要由它推导，所以始终计算
+            aabb.SetFromPoints(pts,count,component_count);
+
+            if(HasChannel(channels,BoundingVolumeChannel::OBB))
+                obb.SetFromPoints(pts,count,component_count);
+            else
+                obb=ToOBB(aabb);
+
+            if(HasChannel(channels,BoundingVolumeChannel::Sphere))
+                bsphere.SetFromPoints(pts,count,component_count);
+            else
+                bsphere=ToBoundingSphere(aabb);
+
+            return true;
+        }
+
     public: // 碰撞检测 - 点相关
 
         /**
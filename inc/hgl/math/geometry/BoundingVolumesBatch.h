@@ -0,0 +1,66 @@
+﻿#pragma once
+
+#include<hgl/math/geometry/BoundingVolumesDataStorage.h>
+#include<hgl/math/geometry/Frustum.h>
+#include<hgl/math/ParallelFor.h>
+#include<vector>
+
+namespace hgl::math
+{
+    /**
+     * BoundingVolumesDataStorage 并行批量操作
+     *
+     * 所有操作作用于 [begin,end) 范围，按缓存大小切块后交给 IParallelExecutor 执行。
+     * executor 为 nullptr 时在当前线程串行执行，结果与并行执行完全一致。
+     */
+    class BoundingVolumesBatch
+    {
+    public:
+
+        /**
+         * 计算该存储一次遍历的块元素数量（按启用通道的世界+本地数据大小估算）
+         */
+        static size_t GetChunkSize(const BoundingVolumesDataStorage &storage);
+
+        /**
+         * 按逐元素世界矩阵，从本地包围体重建 [begin,end) 范围的世界空间包围体
+         * @param storage 存储
+         * @param begin 起始索引
+         * @param end 结束索引（不含）
+         * @param world_matrices 世界矩阵数组，按元素索引对应
+         * @param executor 并行执行器（可为 nullptr）
+         * @note 完成后清除该范围的脏标记
+         */
+        static void TransformRange(BoundingVolumesDataStorage &storage,size_t begin,size_t end,
+                                   const Matrix4f *world_matrices,IParallelExecutor *executor=nullptr);
+
+        /**
+         * 将 [begin,end) 范围内的所有包围体合并为一个包围体
+         * @param out 输出的包围体（AABB 为精确合并，包围球取合并球与 AABB 外接球中较小者）
+         * @return 范围为空时返回 false
+         */
+        static bool MergeRange(const BoundingVolumesDataStorage &storage,size_t begin,size_t end,
+                               BoundingVolumes &out,IParallelExecutor *executor=nullptr);
+
+        /**
+         * 两级视锥裁剪：先测试包围球，球体与视锥相交的再测试 AABB
+         * @param out_visible 输出可见元素索引（按索引升序，覆盖原内容）
+         * @return 可见元素数量
+         * @note 未启用球体通道时直接测试 AABB；未启用 AABB 通道时球体相交即视为可见
+         */
+        static size_t FrustumCull(const BoundingVolumesDataStorage &storage,size_t begin,size_t end,
+                                  const Frustum &frustum,std::vector<uint32_t> &out_visible,
+                                  IParallelExecutor *executor=nullptr);
+
+        /**
+         * 将指定元素紧凑拷贝到另一个存储（如视锥裁剪的幸存者）
+         * @param src 源存储
+         * @param indices 源元素索引数组
+         * @param count 索引数量
+         * @param dst 目标存储，会被重置为与源相同的通道且元素数量为 count
+         * @note 脏标记一并拷贝
+         */
+        static void Gather(const BoundingVolumesDataStorage &src,const uint32_t *indices,size_t count,
+                           BoundingVolumesDataStorage &dst,IParallelExecutor *executor=nullptr);
+    };//class BoundingVolumesBatch
+}//namespace hgl::math
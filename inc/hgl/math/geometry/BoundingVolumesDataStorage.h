@@ -2,6 +2,9 @@
 
 #include<hgl/math/geometry/BoundingVolumes.h>
 #include<vector>
+#include<bit>
+#include<cstdio>
+#include<cstdint>
 
 namespace hgl::math
 {
@@ -18,6 +21,14 @@ namespace hgl::math
      * - AABB: minPoint[n], maxPoint[n]
      * - OBB: center[n], axis[n*3], halfLength[n]
      * - Sphere: center[n], radius[n]
+     *
+     * 通道选择：
+     * - 构造时可指定只存储部分包围体(如仅 AABB+Sphere)，未启用通道的数组保持为空
+     * - Get 时未启用的包围体由已启用的包围体推导
+     *
+     * 脏标记：
+     * - 每个元素同时保存一份本地空间包围体(布局与世界空间数组相同)
+     * - SetLocal/MarkDirty 只设置脏标记，RecomputeDirty 统一从本地包围体重建变化过的元素
      */
     class BoundingVolumesDataStorage
     {
@@ -38,22 +49,219 @@ namespace hgl::math
         std::vector<float>    sphereRadii;      ///< 球体半径数组
 
     private:
+        // 本地空间包围体(用于 RecomputeDirty 重建世界空间数据)
+        std::vector<Vector3f> localAABBMinPoints;
+        std::vector<Vector3f> localAABBMaxPoints;
+
+        std::vector<Vector3f> localOBBCenters;
+        std::vector<Vector3f> localOBBAxis0;
+        std::vector<Vector3f> localOBBAxis1;
+        std::vector<Vector3f> localOBBAxis2;
+        std::vector<Vector3f> localOBBHalfLengths;
+
+        std::vector<Vector3f> localSphereCenters;
+        std::vector<float>    localSphereRadii;
+
+        std::vector<uint64_t> dirtyBits;        ///< 脏标记位集（每位对应一个元素）
+        size_t dirtyCount;                      ///< 脏元素数量
+
+        BoundingVolumeChannel channels;         ///< 启用的包围体通道
+
         size_t capacity;                        ///< 当前容量
         size_t count;                           ///< 当前元素数量
 
+    private:
+
+        static constexpr size_t DirtyWordCount(size_t n) { return (n + 63) / 64; }
+
+        /**
+         * 对指定通道的所有数组(世界+本地)执行操作
+         * @note 传入多个存储时，func 依次收到各存储中的同名数组(用于逐数组拷贝)
+         */
+        template<typename F, typename... Storages>
+        static void ForEachArray(BoundingVolumeChannel mask, F &&func, Storages &...s)
+        {
+            if (HasChannel(mask, BoundingVolumeChannel::AABB))
+            {
+                func(s.aabbMinPoints...);       func(s.aabbMaxPoints...);
+                func(s.localAABBMinPoints...);  func(s.localAABBMaxPoints...);
+            }
+
+            if (HasChannel(mask, BoundingVolumeChannel::OBB))
+            {
+                func(s.obbCenters...);      func(s.obbAxis0...);        func(s.obbAxis1...);        func(s.obbAxis2...);        func(s.obbHalfLengths...);
+                func(s.localOBBCenters...); func(s.localOBBAxis0...);   func(s.localOBBAxis1...);   func(s.localOBBAxis2...);   func(s.localOBBHalfLengths...);
+            }
+
+            if (HasChannel(mask, BoundingVolumeChannel::Sphere))
+            {
+                func(s.sphereCenters...);       func(s.sphereRadii...);
+                func(s.localSphereCenters...);  func(s.localSphereRadii...);
+            }
+        }
+
+        void SetDirtyBit(size_t index, bool dirty)
+        {
+            uint64_t &word = dirtyBits[index >> 6];
+            const uint64_t bit = uint64_t(1) << (index & 63);
+
+            if (((word & bit) != 0) == dirty)
+                return;
+
+            if (dirty)
+            {
+                word |= bit;
+                ++dirtyCount;
+            }
+            else
+            {
+                word &= ~bit;
+                --dirtyCount;
+            }
+        }
+
+        void WriteWorld(size_t index, const BoundingVolumes &bv)
+        {
+            if (HasAABB())
+            {
+                aabbMinPoints[index] = bv.aabb.GetMin();
+                aabbMaxPoints[index] = bv.aabb.GetMax();
+            }
+
+            if (HasOBB())
+            {
+                obbCenters[index] = bv.obb.GetCenter();
+                obbAxis0[index] = bv.obb.GetAxis(0);
+                obbAxis1[index] = bv.obb.GetAxis(1);
+                obbAxis2[index] = bv.obb.GetAxis(2);
+                obbHalfLengths[index] = bv.obb.GetHalfExtend();
+            }
+
+            if (HasSphere())
+            {
+                sphereCenters[index] = bv.bsphere.GetCenter();
+                sphereRadii[index] = bv.bsphere.GetRadius();
+            }
+        }
+
+        void WriteLocal(size_t index, const BoundingVolumes &bv)
+        {
+            if (HasAABB())
+            {
+                localAABBMinPoints[index] = bv.aabb.GetMin();
+                localAABBMaxPoints[index] = bv.aabb.GetMax();
+            }
+
+            if (HasOBB())
+            {
+                localOBBCenters[index] = bv.obb.GetCenter();
+                localOBBAxis0[index] = bv.obb.GetAxis(0);
+                localOBBAxis1[index] = bv.obb.GetAxis(1);
+                localOBBAxis2[index] = bv.obb.GetAxis(2);
+                localOBBHalfLengths[index] = bv.obb.GetHalfExtend();
+            }
+
+            if (HasSphere())
+            {
+                localSphereCenters[index] = bv.bsphere.GetCenter();
+                localSphereRadii[index] = bv.bsphere.GetRadius();
+            }
+        }
+
+        /**
+         * 变换 AABB（按矩阵列绝对值投影 extent，结果为紧致包围盒）
+         */
+        static void TransformAABB(const Vector3f &min_point, const Vector3f &max_point, const Matrix4f &m,
+                                  Vector3f &out_min, Vector3f &out_max)
+        {
+            const Vector3f center = (min_point + max_point) * 0.5f;
+            const Vector3f extent = (max_point - min_point) * 0.5f;
+
+            const Vector3f new_center = Vector3f(m * Vector4f(center, 1.0f));
+            const Vector3f new_extent = glm::abs(Vector3f(m[0])) * extent.x
+                                      + glm::abs(Vector3f(m[1])) * extent.y
+                                      + glm::abs(Vector3f(m[2])) * extent.z;
+
+            out_min = new_center - new_extent;
+            out_max = new_center + new_extent;
+        }
+
+        /**
+         * 变换 OBB（轴经线性部分变换后重新归一化，长度并入半长度）
+         */
+        static void TransformOBB(const Vector3f &center, const Vector3f &axis0, const Vector3f &axis1, const Vector3f &axis2,
+                                 const Vector3f &half_length, const Matrix4f &m,
+                                 Vector3f &out_center, Vector3f &out_axis0, Vector3f &out_axis1, Vector3f &out_axis2,
+                                 Vector3f &out_half_length)
+        {
+            const Matrix3f linear(m);
+
+            const Vector3f a0 = linear * axis0;
+            const Vector3f a1 = linear * axis1;
+            const Vector3f a2 = linear * axis2;
+
+            const float s0 = glm::length(a0);
+            const float s1 = glm::length(a1);
+            const float s2 = glm::length(a2);
+
+            out_center = Vector3f(m * Vector4f(center, 1.0f));
+            out_half_length = half_length * Vector3f(s0, s1, s2);
+            out_axis0 = (s0 > 0.0f) ? (a0 / s0) : axis0;
+            out_axis1 = (s1 > 0.0f) ? (a1 / s1) : axis1;
+            out_axis2 = (s2 > 0.0f) ? (a2 / s2) : axis2;
+        }
+
+        static float GetMaxScale(const Matrix4f &m)
+        {
+            const float s0 = glm::length(Vector3f(m[0]));
+            const float s1 = glm::length(Vector3f(m[1]));
+            const float s2 = glm::length(Vector3f(m[2]));
+
+            return glm::max(glm::max(s0, s1), s2);
+        }
+
+        /**
+         * 从本地包围体重建指定元素的世界空间包围体
+         */
+        void RebuildEntry(size_t i, const Matrix4f &m)
+        {
+            if (HasAABB())
+                TransformAABB(localAABBMinPoints[i], localAABBMaxPoints[i], m, aabbMinPoints[i], aabbMaxPoints[i]);
+
+            if (HasOBB())
+                TransformOBB(localOBBCenters[i], localOBBAxis0[i], localOBBAxis1[i], localOBBAxis2[i], localOBBHalfLengths[i], m,
+                             obbCenters[i], obbAxis0[i], obbAxis1[i], obbAxis2[i], obbHalfLengths[i]);
+
+            if (HasSphere())
+            {
+                sphereCenters[i] = Vector3f(m * Vector4f(localSphereCenters[i], 1.0f));
+                sphereRadii[i] = localSphereRadii[i] * GetMaxScale(m);
+            }
+        }
+
     public:
 
         BoundingVolumesDataStorage()
-            : capacity(0), count(0)
+            : dirtyCount(0), channels(BoundingVolumeChannel::All), capacity(0), count(0)
+        {
+        }
+
+        /**
+         * 构造函数 - 指定启用的包围体通道
+         * @param ch 启用的通道（None 视为 All）
+         */
+        explicit BoundingVolumesDataStorage(BoundingVolumeChannel ch)
+            : dirtyCount(0), channels(ch == BoundingVolumeChannel::None ? BoundingVolumeChannel::All : ch), capacity(0), count(0)
         {
         }
 
         /**
          * 构造函数 - 预分配指定容量
          * @param initial_capacity 初始容量
+         * @param ch 启用的通道（None 视为 All）
          */
-        explicit BoundingVolumesDataStorage(size_t initial_capacity)
-            : capacity(0), count(0)
+        explicit BoundingVolumesDataStorage(size_t initial_capacity, BoundingVolumeChannel ch = BoundingVolumeChannel::All)
+            : BoundingVolumesDataStorage(ch)
         {
             Reserve(initial_capacity);
         }
@@ -73,6 +281,15 @@ namespace hgl::math
          */
         bool IsEmpty() const { return count == 0; }
 
+        /**
+         * 获取启用的包围体通道
+         */
+        BoundingVolumeChannel GetChannels() const { return channels; }
+
+        bool HasAABB() const { return HasChannel(channels, BoundingVolumeChannel::AABB); }
+        bool HasOBB() const { return HasChannel(channels, BoundingVolumeChannel::OBB); }
+        bool HasSphere() const { return HasChannel(channels, BoundingVolumeChannel::Sphere); }
+
         /**
          * 预分配容量
          * @param new_capacity 新容量
@@ -82,20 +299,8 @@ namespace hgl::math
             if (new_capacity <= capacity)
                 return;
 
-            // AABB
-            aabbMinPoints.reserve(new_capacity);
-            aabbMaxPoints.reserve(new_capacity);
-
-            // OBB
-            obbCenters.reserve(new_capacity);
-            obbAxis0.reserve(new_capacity);
-            obbAxis1.reserve(new_capacity);
-            obbAxis2.reserve(new_capacity);
-            obbHalfLengths.reserve(new_capacity);
-
-            // Sphere
-            sphereCenters.reserve(new_capacity);
-            sphereRadii.reserve(new_capacity);
+            ForEachArray(channels, [new_capacity](auto &arr) { arr.reserve(new_capacity); }, *this);
+            dirtyBits.reserve(DirtyWordCount(new_capacity));
 
             capacity = new_capacity;
         }
@@ -105,21 +310,10 @@ namespace hgl::math
          */
         void Clear()
         {
-            // AABB
-            aabbMinPoints.clear();
-            aabbMaxPoints.clear();
-
-            // OBB
-            obbCenters.clear();
-            obbAxis0.clear();
-            obbAxis1.clear();
-            obbAxis2.clear();
-            obbHalfLengths.clear();
-
-            // Sphere
-            sphereCenters.clear();
-            sphereRadii.clear();
+            ForEachArray(channels, [](auto &arr) { arr.clear(); }, *this);
+            dirtyBits.clear();
 
+            dirtyCount = 0;
             count = 0;
         }
 
@@ -128,47 +322,28 @@ namespace hgl::math
          */
         void ShrinkToFit()
         {
-            // AABB
-            aabbMinPoints.shrink_to_fit();
-            aabbMaxPoints.shrink_to_fit();
-
-            // OBB
-            obbCenters.shrink_to_fit();
-            obbAxis0.shrink_to_fit();
-            obbAxis1.shrink_to_fit();
-            obbAxis2.shrink_to_fit();
-            obbHalfLengths.shrink_to_fit();
-
-            // Sphere
-            sphereCenters.shrink_to_fit();
-            sphereRadii.shrink_to_fit();
+            ForEachArray(channels, [](auto &arr) { arr.shrink_to_fit(); }, *this);
+            dirtyBits.shrink_to_fit();
 
             capacity = count;
         }
 
         /**
          * 添加一个 BoundingVolumes
-         * @param bv 包围体
+         * @param bv 包围体（同时作为该元素的本地包围体）
          * @return 添加的索引
          */
         size_t Add(const BoundingVolumes &bv)
         {
             size_t index = count;
 
-            // AABB
-            aabbMinPoints.push_back(bv.aabb.GetMin());
-            aabbMaxPoints.push_back(bv.aabb.GetMax());
+            ForEachArray(channels, [](auto &arr) { arr.emplace_back(); }, *this);
 
-            // OBB
-            obbCenters.push_back(bv.obb.GetCenter());
-            obbAxis0.push_back(bv.obb.GetAxis(0));
-            obbAxis1.push_back(bv.obb.GetAxis(1));
-            obbAxis2.push_back(bv.obb.GetAxis(2));
-            obbHalfLengths.push_back(bv.obb.GetHalfExtend());
+            if (dirtyBits.size() < DirtyWordCount(index + 1))
+                dirtyBits.push_back(0);
 
-            // Sphere
-            sphereCenters.push_back(bv.bsphere.GetCenter());
-            sphereRadii.push_back(bv.bsphere.GetRadius());
+            WriteWorld(index, bv);
+            WriteLocal(index, bv);
 
             count++;
             return index;
@@ -195,27 +370,30 @@ namespace hgl::math
         /**
          * 设置指定索引的 BoundingVolumes
          * @param index 索引
-         * @param bv 包围体
+         * @param bv 包围体（同时作为该元素的本地包围体，并清除脏标记）
          */
         void Set(size_t index, const BoundingVolumes &bv)
         {
             if (index >= count)
                 return;
 
-            // AABB
-            aabbMinPoints[index] = bv.aabb.GetMin();
-            aabbMaxPoints[index] = bv.aabb.GetMax();
+            WriteWorld(index, bv);
+            WriteLocal(index, bv);
+            SetDirtyBit(index, false);
+        }
 
-            // OBB
-            obbCenters[index] = bv.obb.GetCenter();
-            obbAxis0[index] = bv.obb.GetAxis(0);
-            obbAxis1[index] = bv.obb.GetAxis(1);
-            obbAxis2[index] = bv.obb.GetAxis(2);
-            obbHalfLengths[index] = bv.obb.GetHalfExtend();
+        /**
+         * 设置指定索引的本地包围体，世界空间数据在下次 RecomputeDirty 时重建
+         * @param index 索引
+         * @param local_bv 本地空间包围体
+         */
+        void SetLocal(size_t index, const BoundingVolumes &local_bv)
+        {
+            if (index >= count)
+                return;
 
-            // Sphere
-            sphereCenters[index] = bv.bsphere.GetCenter();
-            sphereRadii[index] = bv.bsphere.GetRadius();
+            WriteLocal(index, local_bv);
+            SetDirtyBit(index, true);
         }
 
         /**
@@ -223,6 +401,7 @@ namespace hgl::math
          * @param index 索引
          * @param out_bv 输出的包围体
          * @return 是否成功
+         * @note 未启用的通道由已启用的包围体推导
          */
         bool Get(size_t index, BoundingVolumes &out_bv) const
         {
@@ -230,17 +409,29 @@ namespace hgl::math
                 return false;
 
             // AABB
-            out_bv.aabb.SetMinMax(aabbMinPoints[index], aabbMaxPoints[index]);
+            if (HasAABB())
+                out_bv.aabb.SetMinMax(aabbMinPoints[index], aabbMaxPoints[index]);
 
             // OBB
-            out_bv.obb.Set(obbCenters[index],
-                          obbAxis0[index],
-                          obbAxis1[index],
-                          obbAxis2[index],
-                          obbHalfLengths[index]);
+            if (HasOBB())
+                out_bv.obb.Set(obbCenters[index],
+                               obbAxis0[index],
+                               obbAxis1[index],
+                               obbAxis2[index],
+                               obbHalfLengths[index]);
 
             // Sphere
-            out_bv.bsphere.Set(sphereCenters[index], sphereRadii[index]);
+            if (HasSphere())
+                out_bv.bsphere.Set(sphereCenters[index], sphereRadii[index]);
+
+            if (!HasAABB())
+                out_bv.aabb = HasOBB() ? ToAABB(out_bv.obb) : ToAABB(out_bv.bsphere);
+
+            if (!HasOBB())
+                out_bv.obb = ToOBB(out_bv.aabb);
+
+            if (!HasSphere())
+                out_bv.bsphere = ToBoundingSphere(out_bv.aabb);
 
             return true;
         }
@@ -253,22 +444,14 @@ namespace hgl::math
             if (count == 0)
                 return;
 
-            // AABB
-            aabbMinPoints.pop_back();
-            aabbMaxPoints.pop_back();
-
-            // OBB
-            obbCenters.pop_back();
-            obbAxis0.pop_back();
-            obbAxis1.pop_back();
-            obbAxis2.pop_back();
-            obbHalfLengths.pop_back();
+            SetDirtyBit(count - 1, false);
 
-            // Sphere
-            sphereCenters.pop_back();
-            sphereRadii.pop_back();
+            ForEachArray(channels, [](auto &arr) { arr.pop_back(); }, *this);
 
             count--;
+
+            if (dirtyBits.size() > DirtyWordCount(count))
+                dirtyBits.pop_back();
         }
 
         /**
@@ -281,20 +464,13 @@ namespace hgl::math
             if (index1 >= count || index2 >= count || index1 == index2)
                 return;
 
-            // AABB
-            std::swap(aabbMinPoints[index1], aabbMinPoints[index2]);
-            std::swap(aabbMaxPoints[index1], aabbMaxPoints[index2]);
+            ForEachArray(channels, [index1, index2](auto &arr) { std::swap(arr[index1], arr[index2]); }, *this);
 
-            // OBB
-            std::swap(obbCenters[index1], obbCenters[index2]);
-            std::swap(obbAxis0[index1], obbAxis0[index2]);
-            std::swap(obbAxis1[index1], obbAxis1[index2]);
-            std::swap(obbAxis2[index1], obbAxis2[index2]);
-            std::swap(obbHalfLengths[index1], obbHalfLengths[index2]);
+            const bool dirty1 = IsDirty(index1);
+            const bool dirty2 = IsDirty(index2);
 
-            // Sphere
-            std::swap(sphereCenters[index1], sphereCenters[index2]);
-            std::swap(sphereRadii[index1], sphereRadii[index2]);
+            SetDirtyBit(index1, dirty2);
+            SetDirtyBit(index2, dirty1);
         }
 
         /**
@@ -315,6 +491,180 @@ namespace hgl::math
             PopBack();
         }
 
+        /**
+         * 调整元素数量（新增元素为默认值且不脏）
+         * @param new_count 新的元素数量
+         */
+        void Resize(size_t new_count)
+        {
+            if (new_count == count)
+                return;
+
+            while (count > new_count)
+                PopBack();
+
+            Reserve(new_count);
+            ForEachArray(channels, [new_count](auto &arr) { arr.resize(new_count); }, *this);
+            dirtyBits.resize(DirtyWordCount(new_count), 0);
+
+            count = new_count;
+        }
+
+        /**
+         * 从另一个存储拷贝一个元素（世界与本地数据，不含脏标记）
+         * @param index 目标索引
+         * @param src 源存储（通道必须与本存储一致）
+         * @param src_index 源索引
+         * @note 只写入目标索引位置，不同索引可在多个线程中同时调用
+         */
+        void CopyEntry(size_t index, const BoundingVolumesDataStorage &src, size_t src_index)
+        {
+            if (index >= count || src_index >= src.count || src.channels != channels)
+                return;
+
+            ForEachArray(channels, [index, src_index](auto &dst_arr, const auto &src_arr) { dst_arr[index] = src_arr[src_index]; }, *this, src);
+        }
+
+        /**
+         * 获取指定元素的世界空间 AABB（AABB 通道未启用时由 OBB 或球体推导）
+         */
+        void GetWorldAABB(size_t i, Vector3f &out_min, Vector3f &out_max) const
+        {
+            if (HasAABB())
+            {
+                out_min = aabbMinPoints[i];
+                out_max = aabbMaxPoints[i];
+            }
+            else if (HasOBB())
+            {
+                const Vector3f e = glm::abs(obbAxis0[i]) * obbHalfLengths[i].x
+                                 + glm::abs(obbAxis1[i]) * obbHalfLengths[i].y
+                                 + glm::abs(obbAxis2[i]) * obbHalfLengths[i].z;
+
+                out_min = obbCenters[i] - e;
+                out_max = obbCenters[i] + e;
+            }
+            else
+            {
+                out_min = sphereCenters[i] - Vector3f(sphereRadii[i]);
+                out_max = sphereCenters[i] + Vector3f(sphereRadii[i]);
+            }
+        }
+
+    public: // 脏标记
+
+        /**
+         * 标记指定元素需要重建（通常在其世界变换改变时调用）
+         */
+        void MarkDirty(size_t index)
+        {
+            if (index >= count)
+                return;
+
+            SetDirtyBit(index, true);
+        }
+
+        /**
+         * 标记所有元素需要重建
+         */
+        void MarkAllDirty()
+        {
+            if (count == 0)
+                return;
+
+            std::fill(dirtyBits.begin(), dirtyBits.end(), ~uint64_t(0));
+
+            if (count & 63)
+                dirtyBits.back() = (uint64_t(1) << (count & 63)) - 1;
+
+            dirtyCount = count;
+        }
+
+        bool IsDirty(size_t index) const
+        {
+            if (index >= count)
+                return false;
+
+            return (dirtyBits[index >> 6] >> (index & 63)) & 1;
+        }
+
+        size_t GetDirtyCount() const { return dirtyCount; }
+
+        /**
+         * 从本地包围体重建所有脏元素的世界空间包围体
+         * @param world_matrices 世界矩阵数组，按元素索引一一对应（长度至少为 GetCount()）
+         * @return 重建的元素数量
+         * @note 以 64 位为单位跳过干净元素，只处理启用的通道
+         */
+        size_t RecomputeDirty(const Matrix4f *world_matrices)
+        {
+            if (!world_matrices || dirtyCount == 0)
+                return 0;
+
+            size_t rebuilt = 0;
+
+            for (size_t w = 0; w < dirtyBits.size(); w++)
+            {
+                uint64_t bits = dirtyBits[w];
+
+                while (bits)
+                {
+                    const size_t index = (w << 6) + std::countr_zero(bits);
+
+                    RebuildEntry(index, world_matrices[index]);
+
+                    bits &= bits - 1;
+                    ++rebuilt;
+                }
+
+                dirtyBits[w] = 0;
+            }
+
+            dirtyCount = 0;
+            return rebuilt;
+        }
+
+        /**
+         * 从本地包围体重建 [begin,end) 范围内所有元素的世界空间包围体
+         * @param begin 起始索引
+         * @param end 结束索引（不含）
+         * @param world_matrices 世界矩阵数组，按元素索引对应
+         * @note 不修改脏标记，不同范围可在多个线程中同时调用；完成后可调用 ClearDirtyRange
+         */
+        void RecomputeRange(size_t begin, size_t end, const Matrix4f *world_matrices)
+        {
+            if (!world_matrices)
+                return;
+
+            if (end > count)
+                end = count;
+
+            for (size_t i = begin; i < end; i++)
+                RebuildEntry(i, world_matrices[i]);
+        }
+
+        /**
+         * 清除 [begin,end) 范围内的脏标记
+         */
+        void ClearDirtyRange(size_t begin, size_t end)
+        {
+            if (end > count)
+                end = count;
+
+            for (size_t i = begin; i < end; i++)
+            {
+                if ((i & 63) == 0 && i + 64 <= end)
+                {
+                    dirtyCount -= std::popcount(dirtyBits[i >> 6]);
+                    dirtyBits[i >> 6] = 0;
+                    i += 63;
+                    continue;
+                }
+
+                SetDirtyBit(i, false);
+            }
+        }
+
     public: // 批量查询接口（便于 SIMD 优化）
 
         /**
@@ -347,7 +697,7 @@ namespace hgl::math
         const float* GetSphereRadii() const { return sphereRadii.data(); }
         float* GetSphereRadii() { return sphereRadii.data(); }
 
-    public: // 批量操作
+    public: // 批量操作（仅修改世界空间数据，不影响本地包围体）
 
         /**
          * 批量变换所有包围体
@@ -355,50 +705,22 @@ namespace hgl::math
          */
         void TransformAll(const Matrix4f &transform)
         {
-            // 提取变换的缩放因子
-            const float s0 = glm::length(Vector3f(transform[0]));
-            const float s1 = glm::length(Vector3f(transform[1]));
-            const float s2 = glm::length(Vector3f(transform[2]));
-            const float max_scale = glm::max(glm::max(s0, s1), s2);
-
-            // 提取归一化的轴
-            Vector3f a0 = (s0 > 0.0f) ? (Vector3f(transform[0]) / s0) : Vector3f(1, 0, 0);
-            Vector3f a1 = (s1 > 0.0f) ? (Vector3f(transform[1]) / s1) : Vector3f(0, 1, 0);
-            Vector3f a2 = (s2 > 0.0f) ? (Vector3f(transform[2]) / s2) : Vector3f(0, 0, 1);
+            const float max_scale = GetMaxScale(transform);
 
             for (size_t i = 0; i < count; i++)
             {
-                // Transform AABB (重建)
-                Vector3f aabb_center = (aabbMinPoints[i] + aabbMaxPoints[i]) * 0.5f;
-                Vector3f aabb_extent = (aabbMaxPoints[i] - aabbMinPoints[i]) * 0.5f;
-
-                Vector3f new_center = Vector3f(transform * Vector4f(aabb_center, 1.0f));
-
-                // 计算变换后的 extent
-                const Vector3f ax = glm::abs(a0);
-                const Vector3f ay = glm::abs(a1);
-                const Vector3f az = glm::abs(a2);
-                Vector3f scaled_extent = aabb_extent * Vector3f(s0, s1, s2);
-                Vector3f new_extent = ax * scaled_extent.x + ay * scaled_extent.y + az * scaled_extent.z;
-
-                aabbMinPoints[i] = new_center - new_extent;
-                aabbMaxPoints[i] = new_center + new_extent;
+                if (HasAABB())
+                    TransformAABB(aabbMinPoints[i], aabbMaxPoints[i], transform, aabbMinPoints[i], aabbMaxPoints[i]);
 
-                // Transform OBB
-                obbCenters[i] = Vector3f(transform * Vector4f(obbCenters[i], 1.0f));
+                if (HasOBB())
+                    TransformOBB(obbCenters[i], obbAxis0[i], obbAxis1[i], obbAxis2[i], obbHalfLengths[i], transform,
+                                 obbCenters[i], obbAxis0[i], obbAxis1[i], obbAxis2[i], obbHalfLengths[i]);
 
-                // 旋转 OBB 的轴（注意：这里假设 OBB 的轴已经是正交的）
-                Matrix3f rotation(a0, a1, a2);
-                obbAxis0[i] = rotation * obbAxis0[i];
-                obbAxis1[i] = rotation * obbAxis1[i];
-                obbAxis2[i] = rotation * obbAxis2[i];
-
-                // 缩放半长度
-                obbHalfLengths[i] = obbHalfLengths[i] * Vector3f(s0, s1, s2);
-
-                // Transform Sphere
-                sphereCenters[i] = Vector3f(transform * Vector4f(sphereCenters[i], 1.0f));
-                sphereRadii[i] = sphereRadii[i] * max_scale;
+                if (HasSphere())
+                {
+                    sphereCenters[i] = Vector3f(transform * Vector4f(sphereCenters[i], 1.0f));
+                    sphereRadii[i] = sphereRadii[i] * max_scale;
+                }
             }
         }
 
@@ -411,14 +733,19 @@ namespace hgl::math
             for (size_t i = 0; i < count; i++)
             {
                 // AABB
-                aabbMinPoints[i] += offset;
-                aabbMaxPoints[i] += offset;
+                if (HasAABB())
+                {
+                    aabbMinPoints[i] += offset;
+                    aabbMaxPoints[i] += offset;
+                }
 
                 // OBB
-                obbCenters[i] += offset;
+                if (HasOBB())
+                    obbCenters[i] += offset;
 
                 // Sphere
-                sphereCenters[i] += offset;
+                if (HasSphere())
+                    sphereCenters[i] += offset;
             }
         }
 
@@ -431,23 +758,28 @@ namespace hgl::math
             for (size_t i = 0; i < count; i++)
             {
                 // AABB（从中心缩放）
-                Vector3f aabb_center = (aabbMinPoints[i] + aabbMaxPoints[i]) * 0.5f;
-                Vector3f aabb_extent = (aabbMaxPoints[i] - aabbMinPoints[i]) * 0.5f * scale;
-                aabbMinPoints[i] = aabb_center - aabb_extent;
-                aabbMaxPoints[i] = aabb_center + aabb_extent;
+                if (HasAABB())
+                {
+                    Vector3f aabb_center = (aabbMinPoints[i] + aabbMaxPoints[i]) * 0.5f;
+                    Vector3f aabb_extent = (aabbMaxPoints[i] - aabbMinPoints[i]) * 0.5f * scale;
+                    aabbMinPoints[i] = aabb_center - aabb_extent;
+                    aabbMaxPoints[i] = aabb_center + aabb_extent;
+                }
 
                 // OBB（半长度缩放）
-                obbHalfLengths[i] *= scale;
+                if (HasOBB())
+                    obbHalfLengths[i] *= scale;
 
                 // Sphere
-                sphereRadii[i] *= scale;
+                if (HasSphere())
+                    sphereRadii[i] *= scale;
             }
         }
 
     public: // 碰撞检测批量操作
 
         /**
-         * 批量检查哪些包围体与指定点相交（使用球体快速测试）
+         * 批量检查哪些包围体与指定点相交（使用球体快速测试，无球体通道时使用 AABB）
          * @param point 测试点
          * @param out_indices 输出相交的索引列表
          */
@@ -455,6 +787,25 @@ namespace hgl::math
         {
             out_indices.clear();
 
+            if (!HasSphere())
+            {
+                Vector3f box_min, box_max;
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    GetWorldAABB(i, box_min, box_max);
+
+                    if (point.x >= box_min.x && point.x <= box_max.x &&
+                        point.y >= box_min.y && point.y <= box_max.y &&
+                        point.z >= box_min.z && point.z <= box_max.z)
+                    {
+                        out_indices.push_back(i);
+                    }
+                }
+
+                return;
+            }
+
             for (size_t i = 0; i < count; i++)
             {
                 // 使用球体快速测试
@@ -470,7 +821,7 @@ namespace hgl::math
         }
 
         /**
-         * 批量检查哪些包围体与指定球体相交
+         * 批量检查哪些包围体与指定球体相交（无球体通道时使用 AABB）
          * @param sphere_center 球体中心
          * @param sphere_radius 球体半径
          * @param out_indices 输出相交的索引列表
@@ -480,6 +831,26 @@ namespace hgl::math
         {
             out_indices.clear();
 
+            if (!HasSphere())
+            {
+                Vector3f box_min, box_max;
+                const float radius_sq = sphere_radius * sphere_radius;
+
+                for (size_t i = 0; i < count; i++)
+                {
+                    GetWorldAABB(i, box_min, box_max);
+
+                    const Vector3f diff = sphere_center - glm::clamp(sphere_center, box_min, box_max);
+
+                    if (glm::dot(diff, diff) <= radius_sq)
+                    {
+                        out_indices.push_back(i);
+                    }
+                }
+
+                return;
+            }
+
             for (size_t i = 0; i < count; i++)
             {
                 Vector3f diff = sphere_center - sphereCenters[i];
@@ -505,13 +876,16 @@ namespace hgl::math
 
             Vector3f test_min = aabb.GetMin();
             Vector3f test_max = aabb.GetMax();
+            Vector3f box_min, box_max;
 
             for (size_t i = 0; i < count; i++)
             {
+                GetWorldAABB(i, box_min, box_max);
+
                 // AABB vs AABB 测试
-                if (!(aabbMaxPoints[i].x <= test_min.x || aabbMinPoints[i].x >= test_max.x ||
-                      aabbMaxPoints[i].y <= test_min.y || aabbMinPoints[i].y >= test_max.y ||
-                      aabbMaxPoints[i].z <= test_min.z || aabbMinPoints[i].z >= test_max.z))
+                if (!(box_max.x <= test_min.x || box_min.x >= test_max.x ||
+                      box_max.y <= test_min.y || box_min.y >= test_max.y ||
+                      box_max.z <= test_min.z || box_min.z >= test_max.z))
                 {
                     out_indices.push_back(i);
                 }
@@ -526,16 +900,16 @@ namespace hgl::math
          */
         bool ValidateConsistency() const
         {
-            // 检查所有数组大小是否一致
-            return aabbMinPoints.size() == count &&
-                   aabbMaxPoints.size() == count &&
-                   obbCenters.size() == count &&
-                   obbAxis0.size() == count &&
-                   obbAxis1.size() == count &&
-                   obbAxis2.size() == count &&
-                   obbHalfLengths.size() == count &&
-                   sphereCenters.size() == count &&
-                   sphereRadii.size() == count;
+            bool ok = dirtyBits.size() == DirtyWordCount(count) && dirtyCount <= count;
+
+            // 启用通道的数组大小必须与元素数量一致
+            ForEachArray(channels, [&](const auto &arr) { if (arr.size() != count) ok = false; }, *this);
+
+            // 未启用通道的数组必须为空
+            const BoundingVolumeChannel disabled = BoundingVolumeChannel(uint8_t(BoundingVolumeChannel::All) & ~uint8_t(channels));
+            ForEachArray(disabled, [&](const auto &arr) { if (!arr.empty()) ok = false; }, *this);
+
+            return ok;
         }
 
         /**
@@ -545,20 +919,13 @@ namespace hgl::math
         {
             size_t total = 0;
 
-            // AABB: 2 * Vector3f * count
-            total += aabbMinPoints.capacity() * sizeof(Vector3f);
-            total += aabbMaxPoints.capacity() * sizeof(Vector3f);
-
-            // OBB: 5 * Vector3f * count
-            total += obbCenters.capacity() * sizeof(Vector3f);
-            total += obbAxis0.capacity() * sizeof(Vector3f);
-            total += obbAxis1.capacity() * sizeof(Vector3f);
-            total += obbAxis2.capacity() * sizeof(Vector3f);
-            total += obbHalfLengths.capacity() * sizeof(Vector3f);
+            // 世界空间与本地空间数组（未启用通道为空）
+            ForEachArray(BoundingVolumeChannel::All, [&total](const auto &arr)
+            {
+                total += arr.capacity() * sizeof(typename std::remove_reference_t<decltype(arr)>::value_type);
+            }, *this);
 
-            // Sphere: Vector3f + float * count
-            total += sphereCenters.capacity() * sizeof(Vector3f);
-            total += sphereRadii.capacity() * sizeof(float);
+            total += dirtyBits.capacity() * sizeof(uint64_t);
 
             return total;
         }
@@ -571,6 +938,8 @@ namespace hgl::math
             printf("BoundingVolumesDataStorage Statistics:\n");
             printf("  Count: %zu\n", count);
             printf("  Capacity: %zu\n", capacity);
+            printf("  Channels: %s%s%s\n", HasAABB() ? "AABB " : "", HasOBB() ? "OBB " : "", HasSphere() ? "Sphere" : "");
+            printf("  Dirty: %zu\n", dirtyCount);
             printf("  Memory Usage: %.2f KB\n", GetMemoryUsage() / 1024.0f);
             printf("  Consistency: %s\n", ValidateConsistency() ? "OK" : "FAILED");
         }
@@ -0,0 +1,58 @@
+﻿/**
+ * DistanceTransform2D.h - 2D 精确欧氏距离变换
+ *
+ * 对二值栅格计算每个像素到最近特征像素（像素中心之间）的精确欧氏距离，
+ * 时间复杂度 O(width × height)，与特征分布无关。
+ *
+ * 算法（Felzenszwalb–Huttenlocher / Meijster 两阶段分解）：
+ * 1. 列阶段：每列正反各扫描一次，得到到本列最近特征像素的整数距离 g(x,y)
+ *    （按列块处理，行内连续访问，可向量化）
+ * 2. 行阶段：每行求抛物线族 (x - i)² + g(i,y)² 的下包络，
+ *    包络交点用精确整数运算比较，得到的距离平方为精确整数
+ * 两个阶段分别按列块和行块并行。
+ *
+ * 使用场景：
+ * - 由高度图阈值掩码生成到海岸线的符号距离栅格（替代逐顶点的线段搜索）
+ * - 区域膨胀/腐蚀、影响范围计算
+ */
+
+#pragma once
+
+#include <hgl/math/ParallelFor.h>
+#include <cstdint>
+
+namespace hgl::math
+{
+    /**
+     * @brief 欧氏距离变换
+     *
+     * @param feature_mask 特征掩码（行优先，非 0 为特征像素）
+     * @param width 宽度
+     * @param height 高度
+     * @param out_distance 输出每个像素到最近特征像素的距离（像素单位），
+     *                     不存在特征像素时为 float 最大值
+     * @param executor 并行执行器，nullptr 时串行
+     * @return 参数无效时返回 false
+     */
+    bool EuclideanDistanceTransform2D(const uint8_t* feature_mask, int width, int height,
+                                      float* out_distance,
+                                      IParallelExecutor* executor = nullptr);
+
+    /**
+     * @brief 符号欧氏距离变换
+     *
+     * 外部像素为到最近内部像素的距离 - 0.5，内部像素为 -(到最近外部像素的距离 - 0.5)，
+     * 零值位于内外相邻像素中心的中点，即 Marching Squares 等高线所在的格子边上。
+     * 全部为内部（或全部为外部）时输出 float 最小值（或最大值）。
+     *
+     * @param inside_mask 内部掩码（行优先，非 0 为内部）
+     * @param width 宽度
+     * @param height 高度
+     * @param out_distance 输出符号距离（外部为正，内部为负）
+     * @param executor 并行执行器，nullptr 时串行
+     * @return 参数无效时返回 false
+     */
+    bool SignedDistanceTransform2D(const uint8_t* inside_mask, int width, int height,
+                                   float* out_distance,
+                                   IParallelExecutor* executor = nullptr);
+}//namespace hgl::math
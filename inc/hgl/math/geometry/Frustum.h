@@ -151,5 +151,21 @@ namespace hgl::math
         * @return OUTSIDE/INTERSECT/INSIDE 表示包围盒的可见性状态
         */
         Scope BoxIn(const AABB &box)const;
+
+        /**
+        * 判断以最小/最大点表示的AABB是否在视锥体内
+        *
+        * 与 BoxIn(const AABB &) 算法相同，但无需构造 AABB 对象，适合 SOA 批量数据。
+        *
+        * @param box_min 包围盒最小点
+        * @param box_max 包围盒最大点
+        * @return OUTSIDE/INTERSECT/INSIDE 表示包围盒的可见性状态
+        */
+        Scope BoxIn(const Vector3f &box_min,const Vector3f &box_max)const;
+
+        /**
+        * 获取指定的裁剪平面
+        */
+        const Plane &GetPlane(Side side)const{return pl[size_t(side)];}
     };//class Frustum
 }//namespace hgl::math
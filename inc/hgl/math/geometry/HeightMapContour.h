@@ -8,6 +8,10 @@
  * - 提取指定高度阈值的等高线
  * - 支持多种数据类型（uint8, uint16, uint32, float）
  * - 线性插值实现亚像素精度
+ * - 交点按格子边共享，线性时间串接为闭合/开放折线
+ * - 一次遍历提取任意多个阈值，按行带并行并在接缝处连接
+ * - 流式提取：按行送入数据，只保留两行与未完成的折线，完成的折线即时输出
+ * - 由同一阈值掩码生成到海岸的符号距离栅格（精确欧氏距离变换）
  * - 支持多边形简化（Douglas-Peucker 算法）
  * - 支持轮廓平滑（Chaikin 算法）
  *
@@ -20,10 +24,16 @@
 #pragma once
 
 #include <hgl/math/VectorTypes.h>
+#include <hgl/math/ParallelFor.h>
+#include <hgl/math/geometry/DistanceTransform2D.h>
 #include <vector>
 #include <cmath>
 #include <algorithm>
 #include <functional>
+#include <cstdint>
+#include <unordered_map>
+#include <deque>
+#include <type_traits>
 
 namespace hgl::math
 {
@@ -91,6 +101,92 @@ namespace hgl::math
      */
     void ProcessContours(std::vector<ContourPolygon>& contours, bool smooth, float simplify_epsilon);
 
+    namespace detail
+    {
+        /**
+         * 每个配置的有向线段（起点边, 终点边），高于阈值的一侧在左边
+         * 边索引：0=下边, 1=右边, 2=上边, 3=左边；-1 表示结束
+         */
+        inline constexpr int8_t MARCHING_SQUARES_SEGMENTS[16][4] = {
+            {-1, -1, -1, -1},   // 0: 无边
+            { 0,  3, -1, -1},   // 1: 左下
+            { 1,  0, -1, -1},   // 2: 右下
+            { 1,  3, -1, -1},   // 3: 左下+右下
+            { 2,  1, -1, -1},   // 4: 右上
+            { 0,  3,  2,  1},   // 5: 左下+右上（鞍点，中心低）
+            { 2,  0, -1, -1},   // 6: 右下+右上
+            { 2,  3, -1, -1},   // 7: 左下+右下+右上
+            { 3,  2, -1, -1},   // 8: 左上
+            { 0,  2, -1, -1},   // 9: 左下+左上
+            { 1,  0,  3,  2},   // 10: 右下+左上（鞍点，中心低）
+            { 1,  2, -1, -1},   // 11: 左下+右下+左上
+            { 3,  1, -1, -1},   // 12: 右上+左上
+            { 0,  1, -1, -1},   // 13: 左下+右上+左上
+            { 3,  0, -1, -1},   // 14: 右下+右上+左上
+            {-1, -1, -1, -1}    // 15: 全部高于阈值
+        };
+
+        /**
+         * 鞍点中心高于阈值时，两个高角连通，改为包围两个低角
+         */
+        inline constexpr int8_t MARCHING_SQUARES_SADDLE_HIGH[2][4] = {
+            { 0,  1,  2,  3},   // 5
+            { 3,  0,  1,  2}    // 10
+        };
+
+        /**
+         * 取格子的有向线段表，鞍点格子用四角平均值判断中心是否连通
+         * @param v0,v1,v2,v3 左下、右下、右上、左上角的高度
+         */
+        template<typename T>
+        inline const int8_t* MarchingSquaresSegments(int config, T v0, T v1, T v2, T v3, T threshold)
+        {
+            if (config == 5 || config == 10)
+            {
+                const double center = (double(v0) + double(v1) + double(v2) + double(v3)) * 0.25;
+
+                if (center >= double(threshold))
+                    return MARCHING_SQUARES_SADDLE_HIGH[config == 10];
+            }
+
+            return MARCHING_SQUARES_SEGMENTS[config];
+        }
+
+        /**
+         * 阈值在边 v0 -> v1 上的插值参数（先转换为 double，避免无符号类型相减回绕）
+         */
+        template<typename T>
+        inline float ContourEdgeParameter(T v0, T v1, T threshold)
+        {
+            if (v1 == v0)
+                return 0.5f;
+
+            const double t = (double(threshold) - double(v0)) / (double(v1) - double(v0));
+            return static_cast<float>(std::clamp(t, 0.0, 1.0));
+        }
+
+        /**
+         * 计算一行角点是否高于阈值
+         */
+        template<typename T>
+        inline void ComputeContourRowMask(const T* row, int count, T threshold, uint8_t* mask)
+        {
+            HGL_OMP_SIMD
+            for (int x = 0; x < count; ++x)
+                mask[x] = row[x] >= threshold ? 1 : 0;
+        }
+
+        /**
+         * 由上下两行角点掩码计算一行格子的配置索引（位：1=左下, 2=右下, 4=右上, 8=左上）
+         */
+        inline void ComputeContourRowCases(const uint8_t* lower, const uint8_t* upper, int cell_count, uint8_t* cases)
+        {
+            HGL_OMP_SIMD
+            for (int x = 0; x < cell_count; ++x)
+                cases[x] = uint8_t(lower[x] | (lower[x + 1] << 1) | (upper[x + 1] << 2) | (upper[x] << 3));
+        }
+    }//namespace detail
+
     /**
      * @brief 高度图等高线提取器
      *
@@ -109,29 +205,37 @@ namespace hgl::math
         T low_threshold_;        ///< 低阈值（深水区/浅水区边界）
         T high_threshold_;       ///< 高阈值（浅水区/陆地边界）
 
+        static constexpr uint32_t NONE = UINT32_MAX;
+        static constexpr uint64_t NO_SEAM = UINT64_MAX;
+
         /**
-         * @brief 计算 Marching Squares 的格子配置索引
+         * @brief 行带内串接出的等高线片段
          *
-         * @param x 格子左下角 x 坐标
-         * @param y 格子左下角 y 坐标
-         * @param threshold 高度阈值
-         * @return 格子配置索引（0-15）
+         * 跨越行带接缝的片段在接缝处断开，start_key/end_key 为端点所在接缝水平边的全局编号
          */
-        int GetCellConfig(int x, int y, T threshold) const
+        struct ContourChain
         {
-            if (x < 0 || x >= width_ - 1 || y < 0 || y >= height_ - 1)
-                return 0;
+            std::vector<Vector2f> vertices;
+            bool is_closed = false;
+            uint64_t start_key = NO_SEAM;
+            uint64_t end_key = NO_SEAM;
+        };
 
-            int config = 0;
+        /**
+         * @brief 单个阈值在行带内的工作数据，边 -> 交点索引只保留当前行
+         */
+        struct LevelState
+        {
+            std::vector<uint8_t> lower_mask, upper_mask;    ///< 当前行格子下/上两行角点是否高于阈值
+            std::vector<uint8_t> cases;                     ///< 当前行格子的配置索引（0-15）
 
-            // 按逆时针顺序检查四个角点：左下、右下、右上、左上
-            if (data_[y * width_ + x] >= threshold)                    config |= 1;  // 左下
-            if (data_[y * width_ + (x + 1)] >= threshold)              config |= 2;  // 右下
-            if (data_[(y + 1) * width_ + (x + 1)] >= threshold)        config |= 4;  // 右上
-            if (data_[(y + 1) * width_ + x] >= threshold)              config |= 8;  // 左上
+            std::vector<uint32_t> bottom_edges, top_edges, side_edges;
 
-            return config;
-        }
+            std::vector<Vector2f> points;                   ///< 交点，每条格子边至多一个
+            std::vector<uint32_t> next;                     ///< 沿等高线的下一个交点
+            std::vector<uint8_t> has_prev;
+            std::vector<uint64_t> seam_keys;                ///< 位于行带接缝上的交点的边编号
+        };
 
         /**
          * @brief 使用线性插值计算等高线与格子边的交点
@@ -144,47 +248,221 @@ namespace hgl::math
          */
         Vector2f InterpolateEdge(int x, int y, int edge, T threshold) const
         {
-            float fx = static_cast<float>(x);
-            float fy = static_cast<float>(y);
-            float t = 0.5f;  // 默认中点
+            const float fx = static_cast<float>(x);
+            const float fy = static_cast<float>(y);
 
             switch (edge)
             {
             case 0: // 下边（y, 从 x 到 x+1）
-            {
-                T v0 = data_[y * width_ + x];
-                T v1 = data_[y * width_ + (x + 1)];
-                if (v1 != v0)
-                    t = static_cast<float>(threshold - v0) / static_cast<float>(v1 - v0);
-                return Vector2f(fx + glm::clamp(t, 0.0f, 1.0f), fy);
-            }
+                return Vector2f(fx + detail::ContourEdgeParameter(data_[y * width_ + x], data_[y * width_ + (x + 1)], threshold), fy);
             case 1: // 右边（x+1, 从 y 到 y+1）
+                return Vector2f(fx + 1.0f, fy + detail::ContourEdgeParameter(data_[y * width_ + (x + 1)], data_[(y + 1) * width_ + (x + 1)], threshold));
+            case 2: // 上边（y+1, 从 x 到 x+1）
+                return Vector2f(fx + detail::ContourEdgeParameter(data_[(y + 1) * width_ + x], data_[(y + 1) * width_ + (x + 1)], threshold), fy + 1.0f);
+            case 3: // 左边（x, 从 y 到 y+1）
+                return Vector2f(fx, fy + detail::ContourEdgeParameter(data_[y * width_ + x], data_[(y + 1) * width_ + x], threshold));
+            default:
+                return Vector2f(fx + 0.5f, fy + 0.5f);
+            }
+        }
+
+        /**
+         * @brief 提取 [row_begin,row_end) 行格子内各阈值的等高线片段
+         *
+         * 每行数据只读取一次，依次处理所有阈值。每条格子边上的交点只插值一次，
+         * 线段按“高于阈值的一侧在左边”定向，每个交点恰有一个前驱和一个后继，
+         * 最后线性时间串成片段。
+         *
+         * @param chains 输出，chains[i] 为 levels[i] 的片段
+         */
+        void ExtractBand(const T* levels, size_t level_count, int row_begin, int row_end,
+                         std::vector<std::vector<ContourChain>>& chains) const
+        {
+            const int cell_count = width_ - 1;
+            const bool seam_below = row_begin > 0;
+            const bool seam_above = row_end < height_ - 1;
+
+            std::vector<LevelState> states(level_count);
+
+            for (size_t l = 0; l < level_count; ++l)
             {
-                T v0 = data_[y * width_ + (x + 1)];
-                T v1 = data_[(y + 1) * width_ + (x + 1)];
-                if (v1 != v0)
-                    t = static_cast<float>(threshold - v0) / static_cast<float>(v1 - v0);
-                return Vector2f(fx + 1.0f, fy + glm::clamp(t, 0.0f, 1.0f));
+                LevelState& state = states[l];
+
+                state.lower_mask.resize(width_);
+                state.upper_mask.resize(width_);
+                state.cases.resize(cell_count);
+                state.bottom_edges.assign(cell_count, NONE);
+                state.top_edges.assign(cell_count, NONE);
+                state.side_edges.assign(width_, NONE);
+
+                detail::ComputeContourRowMask(data_ + size_t(row_begin) * width_, width_, levels[l], state.upper_mask.data());
             }
-            case 2: // 上边（y+1, 从 x+1 到 x）
+
+            for (int y = row_begin; y < row_end; ++y)
             {
-                T v0 = data_[(y + 1) * width_ + (x + 1)];
-                T v1 = data_[(y + 1) * width_ + x];
-                if (v1 != v0)
-                    t = static_cast<float>(threshold - v0) / static_cast<float>(v1 - v0);
-                return Vector2f(fx + 1.0f - glm::clamp(t, 0.0f, 1.0f), fy + 1.0f);
+                const T* upper_row = data_ + size_t(y + 1) * width_;
+
+                for (size_t l = 0; l < level_count; ++l)
+                {
+                    LevelState& state = states[l];
+                    const T threshold = levels[l];
+
+                    std::swap(state.lower_mask, state.upper_mask);
+                    detail::ComputeContourRowMask(upper_row, width_, threshold, state.upper_mask.data());
+                    detail::ComputeContourRowCases(state.lower_mask.data(), state.upper_mask.data(), cell_count, state.cases.data());
+
+                    std::swap(state.bottom_edges, state.top_edges);
+                    std::fill(state.top_edges.begin(), state.top_edges.end(), NONE);
+                    std::fill(state.side_edges.begin(), state.side_edges.end(), NONE);
+
+                    for (int x = 0; x < cell_count; ++x)
+                    {
+                        const int config = state.cases[x];
+
+                        if (config == 0 || config == 15)
+                            continue;
+
+                        uint32_t* slots[4] = { &state.bottom_edges[x], &state.side_edges[x + 1], &state.top_edges[x], &state.side_edges[x] };
+
+                        auto point_on = [&](int edge) -> uint32_t
+                        {
+                            uint32_t& slot = *slots[edge];
+
+                            if (slot == NONE)
+                            {
+                                uint64_t key = NO_SEAM;
+
+                                if (edge == 0 && y == row_begin && seam_below)
+                                    key = uint64_t(y) * cell_count + x;
+                                else if (edge == 2 && y + 1 == row_end && seam_above)
+                                    key = uint64_t(y + 1) * cell_count + x;
+
+                                slot = uint32_t(state.points.size());
+                                state.points.push_back(InterpolateEdge(x, y, edge, threshold));
+                                state.next.push_back(NONE);
+                                state.has_prev.push_back(0);
+                                state.seam_keys.push_back(key);
+                            }
+
+                            return slot;
+                        };
+
+                        const int8_t* segments = detail::MarchingSquaresSegments(config,
+                            data_[y * width_ + x], data_[y * width_ + (x + 1)],
+                            upper_row[x + 1], upper_row[x], threshold);
+
+                        for (int i = 0; i < 4 && segments[i] != -1; i += 2)
+                        {
+                            const uint32_t from = point_on(segments[i]);
+                            const uint32_t to = point_on(segments[i + 1]);
+
+                            state.next[from] = to;
+                            state.has_prev[to] = 1;
+                        }
+                    }
+                }
             }
-            case 3: // 左边（x, 从 y+1 到 y）
+
+            // 串成片段：先从没有前驱的交点出发得到开放片段，剩下的都在闭合环上
+            chains.assign(level_count, {});
+
+            for (size_t l = 0; l < level_count; ++l)
             {
-                T v0 = data_[(y + 1) * width_ + x];
-                T v1 = data_[y * width_ + x];
-                if (v1 != v0)
-                    t = static_cast<float>(threshold - v0) / static_cast<float>(v1 - v0);
-                return Vector2f(fx, fy + 1.0f - glm::clamp(t, 0.0f, 1.0f));
+                const LevelState& state = states[l];
+                std::vector<uint8_t> visited(state.points.size(), 0);
+
+                auto walk = [&](uint32_t start, bool closed)
+                {
+                    ContourChain& chain = chains[l].emplace_back();
+                    chain.is_closed = closed;
+
+                    uint32_t last = start;
+
+                    for (uint32_t p = start; p != NONE && !visited[p]; p = state.next[p])
+                    {
+                        visited[p] = 1;
+                        chain.vertices.push_back(state.points[p]);
+                        last = p;
+                    }
+
+                    if (!closed)
+                    {
+                        chain.start_key = state.seam_keys[start];
+                        chain.end_key = state.seam_keys[last];
+                    }
+                };
+
+                for (uint32_t p = 0; p < state.points.size(); ++p)
+                    if (!state.has_prev[p])
+                        walk(p, false);
+
+                for (uint32_t p = 0; p < state.points.size(); ++p)
+                    if (!visited[p])
+                        walk(p, true);
             }
-            default:
-                return Vector2f(fx + 0.5f, fy + 0.5f);
+        }
+
+        /**
+         * @brief 在接缝处连接各行带的片段
+         *
+         * 接缝上的交点被上下两个行带各计算一次，连接时丢弃重复的一个。
+         */
+        static void StitchChains(std::vector<ContourChain>& chains, std::vector<ContourPolygon>& contours)
+        {
+            contours.clear();
+
+            std::unordered_map<uint64_t, size_t> starts;
+
+            for (size_t i = 0; i < chains.size(); ++i)
+                if (chains[i].start_key != NO_SEAM)
+                    starts.emplace(chains[i].start_key, i);
+
+            constexpr size_t NO_CHAIN = size_t(-1);
+
+            std::vector<size_t> succ(chains.size(), NO_CHAIN);
+            std::vector<uint8_t> has_pred(chains.size(), 0);
+            std::vector<uint8_t> visited(chains.size(), 0);
+
+            for (size_t i = 0; i < chains.size(); ++i)
+            {
+                if (chains[i].end_key == NO_SEAM)
+                    continue;
+
+                auto it = starts.find(chains[i].end_key);
+
+                if (it != starts.end())
+                {
+                    succ[i] = it->second;
+                    has_pred[it->second] = 1;
+                }
             }
+
+            auto emit = [&](size_t first, bool cycle)
+            {
+                ContourPolygon& contour = contours.emplace_back();
+                contour.is_closed = cycle || chains[first].is_closed;
+
+                for (size_t i = first; i != NO_CHAIN && !visited[i]; i = succ[i])
+                {
+                    visited[i] = 1;
+
+                    std::vector<Vector2f>& v = chains[i].vertices;
+                    const size_t skip = (i != first && !contour.vertices.empty()) ? 1 : 0;
+
+                    contour.vertices.insert(contour.vertices.end(), v.begin() + skip, v.end());
+                }
+
+                if (cycle && contour.vertices.size() > 1)
+                    contour.vertices.pop_back();
+            };
+
+            for (size_t i = 0; i < chains.size(); ++i)
+                if (!has_pred[i])
+                    emit(i, false);
+
+            for (size_t i = 0; i < chains.size(); ++i)
+                if (!visited[i])
+                    emit(i, true);
         }
 
     public:
@@ -210,67 +488,74 @@ namespace hgl::math
         /**
          * @brief 提取单个阈值的等高线
          *
+         * 每条格子边上的交点只插值一次，按行保存“边 -> 交点”的索引（只需 O(width) 内存），
+         * 线段按“高于阈值的一侧在左边”定向，每个交点恰有一个前驱和一个后继，
+         * 最后线性时间串成折线：从网格边界进入的为开放折线，其余为闭合环（绕高区逆时针）。
+         * 鞍点格子（对角两角高于阈值）用四角平均值判断中心是否连通。
+         *
          * @param threshold 高度阈值
          * @param contours 输出等高线列表
          */
-        void ExtractSingleContour(T threshold, std::vector<ContourPolygon>& contours)
+        void ExtractSingleContour(T threshold, std::vector<ContourPolygon>& contours) const
         {
             contours.clear();
 
-            // Marching Squares 边查找表
-            // 每个配置对应的边列表（-1 表示结束）
-            static const int edgeTable[16][5] = {
-                {-1, -1, -1, -1, -1}, // 0: 无边
-                {0, 3, -1, -1, -1},   // 1: 左下
-                {0, 1, -1, -1, -1},   // 2: 右下
-                {1, 3, -1, -1, -1},   // 3: 左下+右下
-                {1, 2, -1, -1, -1},   // 4: 右上
-                {0, 1, 2, 3, -1},     // 5: 左下+右上（模糊情况）
-                {0, 2, -1, -1, -1},   // 6: 右下+右上
-                {2, 3, -1, -1, -1},   // 7: 左下+右下+右上
-                {2, 3, -1, -1, -1},   // 8: 左上
-                {0, 2, -1, -1, -1},   // 9: 左下+左上
-                {0, 1, 2, 3, -1},     // 10: 右下+左上（模糊情况）
-                {1, 2, -1, -1, -1},   // 11: 左下+右下+左上
-                {1, 3, -1, -1, -1},   // 12: 右上+左上
-                {0, 1, -1, -1, -1},   // 13: 左下+右上+左上
-                {0, 3, -1, -1, -1},   // 14: 右下+右上+左上
-                {-1, -1, -1, -1, -1}  // 15: 全部高于阈值
-            };
+            if (!data_ || width_ < 2 || height_ < 2)
+                return;
 
-            // 遍历所有格子，提取线段
-            std::vector<std::pair<Vector2f, Vector2f>> segments;
+            std::vector<std::vector<ContourChain>> chains;
+
+            ExtractBand(&threshold, 1, 0, height_ - 1, chains);
+            StitchChains(chains[0], contours);
+        }
 
-            for (int y = 0; y < height_ - 1; ++y)
+        /**
+         * @brief 一次遍历提取任意多个阈值的等高线，可按行带并行
+         *
+         * 格子行被切分为若干行带，各行带独立提取片段（每行数据只读取一次，依次处理所有阈值，
+         * 配置索引整行向量化计算），之后按阈值并行在行带接缝处连接片段。
+         * 结果与逐个调用 ExtractSingleContour 相同，等高线的输出顺序可能不同。
+         *
+         * @param levels 阈值列表
+         * @param out 输出，out[i] 为 levels[i] 的等高线列表
+         * @param executor 并行执行器，nullptr 时串行
+         */
+        void ExtractLevels(const std::vector<T>& levels,
+                           std::vector<std::vector<ContourPolygon>>& out,
+                           IParallelExecutor* executor = nullptr) const
+        {
+            out.assign(levels.size(), {});
+
+            if (!data_ || width_ < 2 || height_ < 2 || levels.empty())
+                return;
+
+            const size_t rows = size_t(height_ - 1);
+            const size_t workers = executor ? std::max<uint32_t>(executor->GetWorkerCount(), 1) : 1;
+
+            // 每个工作线程约 4 个行带，行带过薄时接缝连接的开销会超过收益
+            const size_t band_rows = workers > 1 ? std::max<size_t>(32, (rows + workers * 4 - 1) / (workers * 4)) : rows;
+            const size_t band_count = GetChunkCount(0, rows, band_rows);
+
+            std::vector<std::vector<std::vector<ContourChain>>> bands(band_count);
+
+            ParallelForChunks(executor, 0, rows, band_rows, [&](size_t band, size_t begin, size_t end)
             {
-                for (int x = 0; x < width_ - 1; ++x)
+                ExtractBand(levels.data(), levels.size(), int(begin), int(end), bands[band]);
+            });
+
+            ParallelForChunks(executor, 0, levels.size(), 1, [&](size_t, size_t begin, size_t end)
+            {
+                for (size_t l = begin; l < end; ++l)
                 {
-                    int config = GetCellConfig(x, y, threshold);
+                    std::vector<ContourChain> chains;
 
-                    const int* edges = edgeTable[config];
-                    for (int i = 0; edges[i] != -1; i += 2)
-                    {
-                        if (edges[i + 1] == -1)
-                            break;
+                    for (auto& band : bands)
+                        for (ContourChain& chain : band[l])
+                            chains.push_back(std::move(chain));
 
-                        Vector2f p0 = InterpolateEdge(x, y, edges[i], threshold);
-                        Vector2f p1 = InterpolateEdge(x, y, edges[i + 1], threshold);
-                        segments.push_back({p0, p1});
-                    }
+                    StitchChains(chains, out[l]);
                 }
-            }
-
-            // 将线段连接成轮廓
-            // 简化实现：直接将每个线段作为一个轮廓
-            // 在实际应用中，可以实现更复杂的线段连接算法
-            for (const auto& seg : segments)
-            {
-                ContourPolygon poly;
-                poly.vertices.push_back(seg.first);
-                poly.vertices.push_back(seg.second);
-                poly.is_closed = false;
-                contours.push_back(poly);
-            }
+            });
         }
 
         /**
@@ -278,17 +563,20 @@ namespace hgl::math
          *
          * @param smooth 是否平滑轮廓
          * @param simplify_epsilon 简化容差（0 表示不简化）
+         * @param executor 并行执行器，nullptr 时串行
          * @return 等高线提取结果
          */
-        HeightMapContourResult Extract(bool smooth = false, float simplify_epsilon = 0.0f)
+        HeightMapContourResult Extract(bool smooth = false, float simplify_epsilon = 0.0f,
+                                       IParallelExecutor* executor = nullptr)
         {
             HeightMapContourResult result;
 
-            // 提取低阈值等高线（深水区/浅水区边界）
-            ExtractSingleContour(low_threshold_, result.low_to_mid_contours);
+            // 一次遍历同时提取低阈值（深水区/浅水区边界）与高阈值（浅水区/陆地边界）等高线
+            std::vector<std::vector<ContourPolygon>> levels;
+            ExtractLevels({ low_threshold_, high_threshold_ }, levels, executor);
 
-            // 提取高阈值等高线（浅水区/陆地边界）
-            ExtractSingleContour(high_threshold_, result.mid_to_high_contours);
+            result.low_to_mid_contours = std::move(levels[0]);
+            result.mid_to_high_contours = std::move(levels[1]);
 
             // 应用简化和平滑
             if (simplify_epsilon > 0.0f || smooth)
@@ -299,6 +587,430 @@ namespace hgl::math
 
             return result;
         }
+
+        /**
+         * @brief 计算到指定阈值海岸的符号距离栅格
+         *
+         * 使用与等高线提取相同的阈值掩码（高度 >= threshold 为陆地）做精确欧氏距离变换，
+         * 输出每个像素的符号距离（像素单位，向海为正、向陆为负），
+         * 与 ShallowWaterVertex::distance_to_shore 的约定一致，零值位于相邻水/陆像素之间。
+         * 只需要距离栅格时可代替逐顶点的海岸线段搜索。
+         *
+         * @param threshold 海岸高度阈值（通常为 high_threshold）
+         * @param out_distance 输出距离栅格（width × height，行优先）
+         * @param executor 并行执行器，nullptr 时串行
+         * @return 高度图无效时返回 false
+         */
+        bool ComputeShoreDistanceField(T threshold, std::vector<float>& out_distance,
+                                       IParallelExecutor* executor = nullptr) const
+        {
+            out_distance.clear();
+
+            if (!data_ || width_ < 1 || height_ < 1)
+                return false;
+
+            const size_t w = size_t(width_);
+            const size_t count = w * size_t(height_);
+
+            std::vector<uint8_t> land(count);
+
+            const size_t rows_per_chunk = std::max<size_t>(1, PARALLEL_CHUNK_BYTES / (w * (sizeof(T) + 1)));
+
+            ParallelForChunks(executor, 0, size_t(height_), rows_per_chunk, [&](size_t, size_t begin, size_t end)
+            {
+                for (size_t y = begin; y < end; ++y)
+                    detail::ComputeContourRowMask(data_ + y * w, width_, threshold, land.data() + y * w);
+            });
+
+            out_distance.resize(count);
+
+            // 陆地为内部：水中为正，陆上为负
+            return SignedDistanceTransform2D(land.data(), width_, height_, out_distance.data(), executor);
+        }
     };
 
+    /**
+     * @brief 流式等高线提取，用于无法整体载入内存的高度图
+     *
+     * 高度数据按行（y 递增）分段送入，可来自文件读取回调或内存映射文件。常驻内存只有：
+     * - 上一行高度数据
+     * - 每个阈值一行“前沿”：与最新一行格子上边相交、尚未结束的折线端点
+     * - 这些尚未结束的折线
+     * 折线闭合或两端都到达网格边界时立即通过回调输出，到达上边界的折线在 Finish() 时输出。
+     * 线段方向与鞍点规则与 HeightMapContourExtractor 相同，结果一致，输出顺序不同。
+     *
+     * @tparam T 高度数据类型（uint8, uint16, uint32, float）
+     */
+    template<typename T>
+    class HeightMapContourStream
+    {
+    public:
+        /**
+         * @brief 等高线输出回调
+         * @param level_index 阈值在 levels 中的索引
+         * @param contour 完成的等高线
+         */
+        using ContourCallback = std::function<void(size_t level_index, ContourPolygon&& contour)>;
+
+    private:
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        /**
+         * @brief 未完成的折线，沿方向从 head 到 tail，两端都可增长
+         */
+        struct Fragment
+        {
+            std::deque<Vector2f> vertices;
+            uint32_t merged_into = NONE;        ///< 已与另一片段合并时指向合并后的片段
+            bool head_on_border = false;
+            bool tail_on_border = false;
+        };
+
+        struct LevelState
+        {
+            T threshold;
+            std::vector<uint8_t> lower_mask, upper_mask, cases;
+            std::vector<uint32_t> frontier;         ///< 当前行格子下边上的片段端点（上一行留下的前沿）
+            std::vector<uint32_t> next_frontier;    ///< 当前行格子上边上的片段端点
+            std::vector<uint32_t> side;             ///< 当前行格子竖直边上的片段端点
+        };
+
+        int width_;
+        int row_count_ = 0;
+        size_t open_count_ = 0;
+
+        std::vector<T> previous_row_;
+        std::vector<LevelState> levels_;
+
+        std::vector<Fragment> fragments_;
+        std::vector<uint32_t> free_fragments_;
+        std::vector<uint32_t> merged_fragments_;    ///< 本行被合并掉的片段，行结束后回收
+
+        ContourCallback on_contour_;
+
+        uint32_t Resolve(uint32_t f) const
+        {
+            while (fragments_[f].merged_into != NONE)
+                f = fragments_[f].merged_into;
+
+            return f;
+        }
+
+        uint32_t NewFragment()
+        {
+            open_count_++;
+
+            if (!free_fragments_.empty())
+            {
+                const uint32_t f = free_fragments_.back();
+                free_fragments_.pop_back();
+                return f;
+            }
+
+            fragments_.emplace_back();
+            return uint32_t(fragments_.size() - 1);
+        }
+
+        void ReleaseFragment(uint32_t f)
+        {
+            Fragment& fragment = fragments_[f];
+
+            fragment.vertices.clear();
+            fragment.merged_into = NONE;
+            fragment.head_on_border = false;
+            fragment.tail_on_border = false;
+
+            free_fragments_.push_back(f);
+        }
+
+        void Emit(size_t level, uint32_t f, bool closed)
+        {
+            ContourPolygon contour;
+            contour.vertices.assign(fragments_[f].vertices.begin(), fragments_[f].vertices.end());
+            contour.is_closed = closed;
+
+            ReleaseFragment(f);
+            open_count_--;
+
+            if (on_contour_)
+                on_contour_(level, std::move(contour));
+        }
+
+        /**
+         * @brief 加入一条有向线段 a -> b
+         *
+         * 已存在的交点必然是某个片段的端点：a 为片段尾，b 为片段头。
+         */
+        void AddSegment(size_t level, uint32_t& slot_a, const Vector2f& pa, bool a_on_border,
+                                      uint32_t& slot_b, const Vector2f& pb, bool b_on_border)
+        {
+            const uint32_t fa = slot_a != NONE ? Resolve(slot_a) : NONE;
+            const uint32_t fb = slot_b != NONE ? Resolve(slot_b) : NONE;
+
+            uint32_t f;
+
+            if (fa == NONE && fb == NONE)
+            {
+                f = NewFragment();
+                fragments_[f].vertices = { pa, pb };
+                fragments_[f].head_on_border = a_on_border;
+                fragments_[f].tail_on_border = b_on_border;
+            }
+            else if (fb == NONE)
+            {
+                f = fa;
+                fragments_[f].vertices.push_back(pb);
+                fragments_[f].tail_on_border = b_on_border;
+            }
+            else if (fa == NONE)
+            {
+                f = fb;
+                fragments_[f].vertices.push_front(pa);
+                fragments_[f].head_on_border = a_on_border;
+            }
+            else if (fa == fb)
+            {
+                Emit(level, fa, true);
+                return;
+            }
+            else
+            {
+                // 短的并入长的
+                Fragment& a = fragments_[fa];
+                Fragment& b = fragments_[fb];
+
+                if (a.vertices.size() >= b.vertices.size())
+                {
+                    a.vertices.insert(a.vertices.end(), b.vertices.begin(), b.vertices.end());
+                    a.tail_on_border = b.tail_on_border;
+                    b.merged_into = fa;
+                    merged_fragments_.push_back(fb);
+                    f = fa;
+                }
+                else
+                {
+                    b.vertices.insert(b.vertices.begin(), a.vertices.begin(), a.vertices.end());
+                    b.head_on_border = a.head_on_border;
+                    a.merged_into = fb;
+                    merged_fragments_.push_back(fa);
+                    f = fb;
+                }
+
+                open_count_--;
+            }
+
+            if (slot_a == NONE) slot_a = f;
+            if (slot_b == NONE) slot_b = f;
+
+            if (fragments_[f].head_on_border && fragments_[f].tail_on_border)
+                Emit(level, f, false);
+        }
+
+        void ProcessRow(const T* row)
+        {
+            const T* prev = previous_row_.data();
+            const int cell_count = width_ - 1;
+            const int y = row_count_ - 1;
+            const float fy = static_cast<float>(y);
+
+            for (size_t l = 0; l < levels_.size(); ++l)
+            {
+                LevelState& state = levels_[l];
+                const T threshold = state.threshold;
+
+                std::swap(state.lower_mask, state.upper_mask);
+                detail::ComputeContourRowMask(row, width_, threshold, state.upper_mask.data());
+                detail::ComputeContourRowCases(state.lower_mask.data(), state.upper_mask.data(), cell_count, state.cases.data());
+
+                std::fill(state.next_frontier.begin(), state.next_frontier.end(), NONE);
+                std::fill(state.side.begin(), state.side.end(), NONE);
+
+                for (int x = 0; x < cell_count; ++x)
+                {
+                    const int config = state.cases[x];
+
+                    if (config == 0 || config == 15)
+                        continue;
+
+                    const float fx = static_cast<float>(x);
+
+                    uint32_t* slots[4] = { &state.frontier[x], &state.side[x + 1], &state.next_frontier[x], &state.side[x] };
+
+                    auto point_on = [&](int edge) -> Vector2f
+                    {
+                        // 已有端点的位置不会再被使用
+                        if (*slots[edge] != NONE)
+                            return Vector2f(0.0f);
+
+                        switch (edge)
+                        {
+                        case 0:  return Vector2f(fx + detail::ContourEdgeParameter(prev[x], prev[x + 1], threshold), fy);
+                        case 1:  return Vector2f(fx + 1.0f, fy + detail::ContourEdgeParameter(prev[x + 1], row[x + 1], threshold));
+                        case 2:  return Vector2f(fx + detail::ContourEdgeParameter(row[x], row[x + 1], threshold), fy + 1.0f);
+                        default: return Vector2f(fx, fy + detail::ContourEdgeParameter(prev[x], row[x], threshold));
+                        }
+                    };
+
+                    auto on_border = [&](int edge) -> bool
+                    {
+                        return (edge == 0 && y == 0) || (edge == 3 && x == 0) || (edge == 1 && x == cell_count - 1);
+                    };
+
+                    const int8_t* segments = detail::MarchingSquaresSegments(config, prev[x], prev[x + 1], row[x + 1], row[x], threshold);
+
+                    for (int i = 0; i < 4 && segments[i] != -1; i += 2)
+                    {
+                        const int a = segments[i];
+                        const int b = segments[i + 1];
+
+                        AddSegment(l, *slots[a], point_on(a), on_border(a),
+                                      *slots[b], point_on(b), on_border(b));
+                    }
+                }
+
+                std::swap(state.frontier, state.next_frontier);
+            }
+
+            // 前沿只保留合并后的片段，被合并掉的片段不再被引用，可以回收
+            for (LevelState& state : levels_)
+                for (uint32_t& f : state.frontier)
+                    if (f != NONE)
+                        f = Resolve(f);
+
+            for (uint32_t f : merged_fragments_)
+                ReleaseFragment(f);
+
+            merged_fragments_.clear();
+        }
+
+    public:
+        /**
+         * @param width 高度图宽度
+         * @param levels 阈值列表
+         * @param on_contour 等高线完成时的回调
+         */
+        HeightMapContourStream(int width, const std::vector<T>& levels, ContourCallback on_contour)
+            : width_(width)
+            , on_contour_(std::move(on_contour))
+        {
+            if (width_ < 2)
+                return;
+
+            previous_row_.resize(width_);
+            levels_.resize(levels.size());
+
+            for (size_t l = 0; l < levels.size(); ++l)
+            {
+                LevelState& state = levels_[l];
+
+                state.threshold = levels[l];
+                state.lower_mask.resize(width_);
+                state.upper_mask.resize(width_);
+                state.cases.resize(width_ - 1);
+                state.frontier.assign(width_ - 1, NONE);
+                state.next_frontier.assign(width_ - 1, NONE);
+                state.side.assign(width_, NONE);
+            }
+        }
+
+        /**
+         * @brief 送入一行高度数据（width 个值）
+         */
+        void PushRow(const T* row)
+        {
+            if (width_ < 2 || !row)
+                return;
+
+            if (row_count_ > 0)
+            {
+                ProcessRow(row);
+            }
+            else
+            {
+                for (LevelState& state : levels_)
+                    detail::ComputeContourRowMask(row, width_, state.threshold, state.upper_mask.data());
+            }
+
+            std::copy(row, row + width_, previous_row_.begin());
+            row_count_++;
+        }
+
+        /**
+         * @brief 送入连续多行高度数据（行优先，例如内存映射文件中的一段）
+         */
+        void PushRows(const T* rows, int row_count)
+        {
+            for (int i = 0; i < row_count; ++i)
+                PushRow(rows + size_t(i) * width_);
+        }
+
+        /**
+         * @brief 所有行送入后调用，输出到达上边界的折线
+         */
+        void Finish()
+        {
+            std::vector<uint32_t> remaining;
+
+            for (size_t l = 0; l < levels_.size(); ++l)
+            {
+                remaining.clear();
+
+                for (uint32_t& f : levels_[l].frontier)
+                {
+                    if (f != NONE)
+                        remaining.push_back(f);
+
+                    f = NONE;
+                }
+
+                // 一条折线可能两端都在上边界
+                std::sort(remaining.begin(), remaining.end());
+                remaining.erase(std::unique(remaining.begin(), remaining.end()), remaining.end());
+
+                for (uint32_t f : remaining)
+                    Emit(l, f, false);
+            }
+        }
+
+        int GetRowCount() const { return row_count_; }                 ///< 已送入的行数
+        size_t GetOpenContourCount() const { return open_count_; }      ///< 尚未完成的折线数量
+    };
+
+    /**
+     * @brief 从按行带读取数据的回调流式提取等高线
+     *
+     * @param width 高度图宽度
+     * @param height 高度图高度
+     * @param band_rows 每次读取的行数
+     * @param levels 阈值列表
+     * @param read_rows 读取 [first_row, first_row + row_count) 行到 buffer，失败返回 false
+     * @param on_contour 等高线完成时的回调
+     * @return 全部行读取成功返回 true
+     */
+    template<typename T>
+    inline bool ExtractContoursStreaming(int width, int height, int band_rows,
+                                         const std::vector<T>& levels,
+                                         const std::type_identity_t<std::function<bool(int first_row, int row_count, T* buffer)>>& read_rows,
+                                         typename HeightMapContourStream<T>::ContourCallback on_contour)
+    {
+        if (width < 2 || height < 2 || band_rows < 1 || !read_rows)
+            return false;
+
+        HeightMapContourStream<T> stream(width, levels, std::move(on_contour));
+        std::vector<T> buffer(size_t(band_rows) * width);
+
+        for (int row = 0; row < height; row += band_rows)
+        {
+            const int count = std::min(band_rows, height - row);
+
+            if (!read_rows(row, count, buffer.data()))
+                return false;
+
+            stream.PushRows(buffer.data(), count);
+        }
+
+        stream.Finish();
+        return true;
+    }
+
  }//namespace hgl::math
@@ -8,6 +8,7 @@
 namespace hgl::math
 {
     class Ray;
+    struct PreparedRay;
     class AABB;
 
     /**
@@ -154,8 +155,8 @@ namespace hgl::math
         bool Contains(const OBB &other) const;
 
         /**
-         * 计算到另一个OBB的距离
-         * @note 当前实现是近似算法，采样角点计算最近距离
+         * 计算到另一个OBB的距离（相交为0）
+         * @note 等同于 DistanceQuery::Distance(const OBB&,const OBB&)
          */
         float Distance(const OBB &other) const;
 
@@ -178,6 +179,13 @@ namespace hgl::math
         bool IntersectsRay(const Ray &ray) const;
         bool IntersectsRay(const Ray &ray, float &t_min, float &t_max) const;
 
+        /**
+         * 使用预处理射线检查相交（与 AABB/三角形测试共用同一个 PreparedRay）
+         */
+        bool IntersectsRay(const PreparedRay &ray, float &distance) const;
+        bool IntersectsRay(const PreparedRay &ray) const;
+        bool IntersectsRay(const PreparedRay &ray, float &t_min, float &t_max) const;
+
         /**
          * 检查与平面的关系
          * @return <0: 完全在平面后面, 0: 相交, >0: 完全在平面前面
@@ -190,10 +198,7 @@ namespace hgl::math
         bool IntersectsPlane(const Plane &plane) const;
 
         /**
-         * 检查与三角形是否相交
-         * @warning 当前实现不完整，可能产生假阴性（漏掉某些相交情况）
-         * @note 只检查三角形顶点是否在 OBB 内，不检查边和面相交
-         * TODO: 实现完整的 SAT (Separating Axis Theorem) 测试
+         * 检查与三角形是否相交（分离轴定理，13 个轴）
          */
         bool IntersectsTriangle(const Triangle3f &triangle) const;
 
@@ -14,6 +14,7 @@
  * - 适用于简单多边形（无自相交）
  * - 时间复杂度：O(n²)，n为顶点数
  * - 稳定可靠，实现简单
+ * - 顶点数较多或带洞的多边形请使用 Polygon2DTriangulation.h 中的 O(n log n) 版本
  *
  * 参考资料：
  * - "Computational Geometry: Algorithms and Applications" (de Berg et al.)
@@ -277,11 +278,11 @@ namespace hgl::math
             indices[i] = i;
 
         // 确保顶点按逆时针顺序排列
-        std::vector<glm::vec<2, T>> ordered_vertices = vertices;
+        // indices 保存原始编号，顺时针时倒序遍历即可，顶点数组本身不需要反转
+        const std::vector<glm::vec<2, T>>& ordered_vertices = vertices;
         if (!IsPolygon2DCCW(ordered_vertices))
         {
             // 如果是顺时针，反转顶点顺序
-            std::reverse(ordered_vertices.begin(), ordered_vertices.end());
             for (size_t i = 0; i < n; ++i)
                 indices[i] = n - 1 - i;
         }
@@ -371,7 +372,7 @@ namespace hgl::math
     inline bool TriangulatePolygon2D(const std::vector<glm::vec<2, T>>& vertices,
                                     std::vector<size_t>& out_triangles,
                                     T min_edge_length,
-                                    T max_edge_length)
+                                    T max_edge_length = std::numeric_limits<T>::max())
     {
         out_triangles.clear();
 
@@ -407,11 +408,11 @@ namespace hgl::math
             indices[i] = i;
 
         // 确保顶点按逆时针顺序排列
-        std::vector<glm::vec<2, T>> ordered_vertices = vertices;
+        // indices 保存原始编号，顺时针时倒序遍历即可，顶点数组本身不需要反转
+        const std::vector<glm::vec<2, T>>& ordered_vertices = vertices;
         if (!IsPolygon2DCCW(ordered_vertices))
         {
             // 如果是顺时针，反转顶点顺序
-            std::reverse(ordered_vertices.begin(), ordered_vertices.end());
             for (size_t i = 0; i < n; ++i)
                 indices[i] = n - 1 - i;
         }
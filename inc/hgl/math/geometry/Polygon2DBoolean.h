@@ -0,0 +1,109 @@
+﻿/**
+ * Polygon2DBoolean.h - 2D多边形布尔运算与偏移
+ *
+ * 功能：
+ * - 并集、交集、差集、异或
+ * - 多边形偏移（外扩/内缩），支持尖角（Miter）与圆角（Round）连接
+ *
+ * 算法说明：
+ * 1. 坐标按 2 的整数次幂步长量化为定点整数（|坐标| < 2^29 步长），
+ *    之后所有方向判定都是精确的 int64 运算
+ * 2. 按 x 扫描找出所有相交、T 形接触与共线重叠，在交点处切分边，
+ *    交点取整后若产生新相交则重复扫描，直到没有新的切分
+ * 3. 合并完全重合的边，累加两组输入各自的环绕数贡献
+ * 4. 扫描线自左向右推进（x 相同时按 y），插入边时由正下方的边得到
+ *    边下方区域的环绕数，边上方 = 下方 + 本边贡献
+ * 5. 按填充规则与运算类型判断边两侧是否在结果内，两侧不同的边即为结果边界，
+ *    按内部在左侧的方向连接成环
+ *
+ * 输出：外环逆时针，洞顺时针，不含共线顶点。
+ * 偏移先对输入做一次并集规范化方向，生成带连接的原始偏移环，
+ * 再用 Positive 规则做并集去除自相交与翻转部分。
+ *
+ * 使用场景：
+ * - 将大量占地轮廓合并为导航网格障碍
+ * - 区域形状的裁剪、扣除与外扩
+ */
+
+#pragma once
+
+#include <hgl/math/VectorTypes.h>
+#include <vector>
+
+namespace hgl::math
+{
+    /**
+     * @brief 多边形集合，每个元素是一个闭合环
+     */
+    using Polygon2DPaths = std::vector<std::vector<Vector2d>>;
+
+    /**
+     * @brief 布尔运算类型
+     */
+    enum class Polygon2DBooleanOp
+    {
+        Union,              ///< 并集 A ∪ B
+        Intersection,       ///< 交集 A ∩ B
+        Difference,         ///< 差集 A - B
+        Xor                 ///< 异或 (A - B) ∪ (B - A)
+    };
+
+    /**
+     * @brief 填充规则，根据环绕数判断区域是否在多边形内
+     */
+    enum class Polygon2DFillRule
+    {
+        EvenOdd,            ///< 环绕数为奇数
+        NonZero,            ///< 环绕数不为 0（与环的方向无关）
+        Positive            ///< 环绕数大于 0
+    };
+
+    /**
+     * @brief 偏移时拐角的连接方式
+     */
+    enum class Polygon2DJoinType
+    {
+        Miter,              ///< 尖角，超过 miter_limit 时改为斜切
+        Round               ///< 圆弧
+    };
+
+    /**
+     * @brief 多边形布尔运算
+     *
+     * subject 与 clip 内部各自按 fill_rule 求区域，可包含任意数量的环，
+     * 环之间可以相交、重叠或自相交。clip 为空时 Union 即为 subject 的规范化合并。
+     *
+     * @param subject 主多边形集合
+     * @param clip 裁剪多边形集合
+     * @param op 运算类型
+     * @param out 输出环（外环逆时针，洞顺时针）
+     * @param fill_rule 填充规则
+     * @return 输入含非有限坐标时返回 false
+     */
+    bool Polygon2DBoolean(const Polygon2DPaths& subject,
+                          const Polygon2DPaths& clip,
+                          Polygon2DBooleanOp op,
+                          Polygon2DPaths& out,
+                          Polygon2DFillRule fill_rule = Polygon2DFillRule::NonZero);
+
+    /**
+     * @brief 多边形偏移
+     *
+     * 输入按 NonZero 规则解释。delta > 0 外扩（洞随之缩小），delta < 0 内缩，
+     * 内缩到消失的部分不会输出。
+     *
+     * @param paths 输入多边形集合
+     * @param delta 偏移距离
+     * @param out 输出环（外环逆时针，洞顺时针）
+     * @param join 拐角连接方式
+     * @param miter_limit 尖角长度上限（相对 |delta| 的倍数）
+     * @param arc_tolerance 圆角弦高误差，<=0 时取 |delta| 的 0.5%
+     * @return 输入含非有限坐标时返回 false
+     */
+    bool Polygon2DOffset(const Polygon2DPaths& paths,
+                         double delta,
+                         Polygon2DPaths& out,
+                         Polygon2DJoinType join = Polygon2DJoinType::Miter,
+                         double miter_limit = 2.0,
+                         double arc_tolerance = 0.0);
+}//namespace hgl::math
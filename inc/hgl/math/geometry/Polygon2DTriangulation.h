@@ -0,0 +1,908 @@
+﻿/**
+ * Polygon2DTriangulation.h - 大规模2D多边形三角剖分
+ *
+ * Polygon2D.h 中的耳切法每次找耳朵都要扫描全部剩余顶点，最坏 O(n³)，
+ * 对海岸线、行政区划这类上万顶点的多边形过慢。本文件提供两种替代算法。
+ *
+ * 单调多边形分解（Monotone Partition）：
+ * 1. 顶点按 y 从大到小（y 相同时 x 从大到小）排序，扫描线自上而下推进
+ * 2. 顶点分为起始/结束/分裂/合并/普通五类，扫描状态为平衡树中按 x 排序的左侧边界边
+ * 3. 在分裂顶点和合并顶点处加入对角线，把多边形切成若干 y 单调多边形
+ * 4. 每个单调多边形合并左右两条链后，用栈在线性时间内三角化
+ *
+ * 带洞多边形：扫描过程天然处理多个环（洞的最高/最低点分别成为分裂/合并顶点），
+ * 不需要像耳切法那样先用桥接边把洞连到外环上。
+ *
+ * 要求：外环与洞均为简单多边形，彼此不相交，洞位于外环内部且互不包含。
+ *
+ * 索引耳切法（TriangulatePolygon2DIndexedEar）：
+ * 与 TriangulatePolygon2D 的耳朵判定相同，但
+ * - 顶点用双向链表连接，切耳为 O(1)，不再 erase 索引数组
+ * - 只有非凸顶点才可能落在耳朵内部，因此只把非凸顶点放入均匀网格，
+ *   判定时只检查耳朵包围盒覆盖的网格单元；非凸顶点变凸后立即移出网格
+ * - 从上次切耳的位置继续寻找，不再每次从头扫描
+ * 常见多边形接近线性时间，最坏情况仍为 O(n²)。
+ *
+ * 参考资料：
+ * - "Computational Geometry: Algorithms and Applications" (de Berg et al.), 第3章
+ */
+
+#pragma once
+
+#include <hgl/math/geometry/Polygon2D.h>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+namespace hgl::math
+{
+    namespace detail
+    {
+        /**
+         * 扫描顺序：a 是否在 b 之后被扫描到（y 更小，或 y 相同时 x 更小）
+         */
+        template<typename T>
+        inline bool SweepBelow(const glm::vec<2, T>& a, const glm::vec<2, T>& b)
+        {
+            return a.y < b.y || (a.y == b.y && a.x < b.x);
+        }
+
+        /**
+         * c 是否严格位于有向线段 a->b 的左侧
+         */
+        template<typename T>
+        inline bool IsLeftTurn2D(const glm::vec<2, T>& a, const glm::vec<2, T>& b, const glm::vec<2, T>& c)
+        {
+            return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x) > T(0);
+        }
+
+        enum class MonotoneVertexType : uint8_t
+        {
+            Start,
+            End,
+            Split,
+            Merge,
+            Regular
+        };
+
+        /**
+         * 分解过程中的顶点（环形双向链表节点）
+         * 加入对角线时两个端点各复制一份，原顶点和副本分属对角线两侧的子多边形
+         */
+        template<typename T>
+        struct MonotoneVertex
+        {
+            glm::vec<2, T> p;
+            size_t index;           // 输出用的原始顶点编号
+            size_t prev, next;
+        };
+
+        /**
+         * 扫描状态中的边：vertex 的出边 (p1 -> p2)，p1 按扫描顺序先于 p2
+         * p1==p2 时表示查询点，用于查找其左侧最近的边
+         */
+        template<typename T>
+        struct SweepEdge
+        {
+            glm::vec<2, T> p1, p2;
+            mutable size_t vertex;  // 加入对角线后顶点会被复制，边的归属随之改变
+
+            /**
+             * c 相对本边的水平位置：>0 在右侧，<0 在左侧，0 在边所在直线上
+             * 水平边与查询点按 x 区间比较
+             */
+            int SideOf(const glm::vec<2, T>& c) const
+            {
+                if (p1.y == p2.y)
+                    return c.x > p1.x ? 1 : (c.x < p2.x ? -1 : 0);
+
+                const T cross = (p2.x - p1.x) * (c.y - p1.y) - (p2.y - p1.y) * (c.x - p1.x);
+                return cross > T(0) ? 1 : (cross < T(0) ? -1 : 0);
+            }
+
+            /**
+             * 当前扫描线上本边是否在 other 左侧
+             * 只用后插入一方的端点对先插入一方的直线做方向判定（两条边都跨过扫描线，
+             * 后插入一方的上端点必在先插入一方的 y 范围内），上端点在直线上（共享顶点）时改用下端点
+             */
+            bool operator<(const SweepEdge& other) const
+            {
+                if (SweepBelow(p1, other.p1))
+                {
+                    const int side = other.SideOf(p1);
+                    return (side != 0 ? side : other.SideOf(p2)) < 0;
+                }
+
+                if (SweepBelow(other.p1, p1))
+                {
+                    const int side = SideOf(other.p1);
+                    return (side != 0 ? side : SideOf(other.p2)) > 0;
+                }
+
+                return SideOf(other.p2) > 0;
+            }
+        };
+
+        /**
+         * 将一个环追加到顶点链表（跳过连续重复点）
+         * @param ccw 需要的环绕方向，与输入相反时倒序连接（编号不变）
+         * @return 环的有效顶点数
+         */
+        template<typename T>
+        inline size_t AppendMonotoneLoop(std::vector<MonotoneVertex<T>>& vertices,
+                                         const std::vector<glm::vec<2, T>>& loop,
+                                         size_t base_index,
+                                         bool ccw)
+        {
+            const size_t n = loop.size();
+            const bool reverse = (Polygon2DSignedArea(loop) > T(0)) != ccw;
+            const size_t first = vertices.size();
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                const size_t i = reverse ? n - 1 - k : k;
+
+                if (vertices.size() > first && vertices.back().p == loop[i])
+                    continue;
+
+                vertices.push_back({loop[i], base_index + i, 0, 0});
+            }
+
+            while (vertices.size() > first + 1 && vertices.back().p == vertices[first].p)
+                vertices.pop_back();
+
+            const size_t count = vertices.size() - first;
+
+            if (count < 3)
+            {
+                vertices.resize(first);
+                return 0;
+            }
+
+            for (size_t k = 0; k < count; ++k)
+            {
+                vertices[first + k].prev = first + (k + count - 1) % count;
+                vertices[first + k].next = first + (k + 1) % count;
+            }
+
+            return count;
+        }
+
+        /**
+         * y 单调多边形的线性时间三角剖分
+         * @param piece 子多边形的顶点（按环绕顺序，逆时针）
+         * @return 输入不是 y 单调多边形时返回 false
+         */
+        template<typename T>
+        inline bool TriangulateMonotonePiece(const std::vector<MonotoneVertex<T>>& vertices,
+                                             const std::vector<size_t>& piece,
+                                             std::vector<size_t>& out_triangles)
+        {
+            const size_t n = piece.size();
+
+            if (n < 3)
+                return false;
+
+            auto point = [&](size_t i) -> const glm::vec<2, T>& { return vertices[piece[i]].p; };
+            auto emit = [&](size_t a, size_t b, size_t c)
+            {
+                out_triangles.push_back(vertices[piece[a]].index);
+                out_triangles.push_back(vertices[piece[b]].index);
+                out_triangles.push_back(vertices[piece[c]].index);
+            };
+
+            if (n == 3)
+            {
+                emit(0, 1, 2);
+                return true;
+            }
+
+            size_t top = 0, bottom = 0;
+
+            for (size_t i = 1; i < n; ++i)
+            {
+                if (SweepBelow(point(i), point(bottom))) bottom = i;
+                if (SweepBelow(point(top), point(i))) top = i;
+            }
+
+            // 逆时针时从最高点沿 next 方向为左链（向下），沿 prev 方向为右链
+            for (size_t i = top; i != bottom; i = (i + 1) % n)
+                if (!SweepBelow(point((i + 1) % n), point(i)))
+                    return false;
+
+            for (size_t i = bottom; i != top; i = (i + 1) % n)
+                if (!SweepBelow(point(i), point((i + 1) % n)))
+                    return false;
+
+            // 合并左右两条链，side: 1 左链，-1 右链，0 最高/最低点
+            std::vector<size_t> order(n);
+            std::vector<int8_t> side(n, 0);
+
+            size_t left = (top + 1) % n;
+            size_t right = (top + n - 1) % n;
+
+            order[0] = top;
+
+            for (size_t k = 1; k < n - 1; ++k)
+            {
+                const bool take_right = (left == bottom) || (right != bottom && SweepBelow(point(left), point(right)));
+
+                if (take_right)
+                {
+                    order[k] = right;
+                    side[right] = -1;
+                    right = (right + n - 1) % n;
+                }
+                else
+                {
+                    order[k] = left;
+                    side[left] = 1;
+                    left = (left + 1) % n;
+                }
+            }
+
+            order[n - 1] = bottom;
+
+            std::vector<size_t> stack;
+            stack.reserve(n);
+            stack.push_back(order[0]);
+            stack.push_back(order[1]);
+
+            for (size_t k = 2; k < n - 1; ++k)
+            {
+                const size_t v = order[k];
+
+                if (side[v] != side[stack.back()])
+                {
+                    // 对侧链：与栈中所有顶点连线
+                    for (size_t j = 0; j + 1 < stack.size(); ++j)
+                    {
+                        if (side[v] == 1)
+                            emit(stack[j + 1], stack[j], v);
+                        else
+                            emit(stack[j], stack[j + 1], v);
+                    }
+
+                    stack.clear();
+                    stack.push_back(order[k - 1]);
+                    stack.push_back(v);
+                }
+                else
+                {
+                    // 同侧链：弹出能与 v 构成内部三角形的顶点
+                    size_t last = stack.back();
+                    stack.pop_back();
+
+                    while (!stack.empty())
+                    {
+                        const size_t top_vertex = stack.back();
+
+                        if (side[v] == 1)
+                        {
+                            if (!IsLeftTurn2D(point(v), point(top_vertex), point(last)))
+                                break;
+
+                            emit(v, top_vertex, last);
+                        }
+                        else
+                        {
+                            if (!IsLeftTurn2D(point(v), point(last), point(top_vertex)))
+                                break;
+
+                            emit(v, last, top_vertex);
+                        }
+
+                        last = top_vertex;
+                        stack.pop_back();
+                    }
+
+                    stack.push_back(last);
+                    stack.push_back(v);
+                }
+            }
+
+            const size_t v = order[n - 1];
+
+            for (size_t j = 0; j + 1 < stack.size(); ++j)
+            {
+                if (side[stack[j + 1]] == 1)
+                    emit(stack[j], stack[j + 1], v);
+                else
+                    emit(stack[j + 1], stack[j], v);
+            }
+
+            return true;
+        }
+
+        /**
+         * 单调分解 + 三角剖分
+         * @param vertices 已连接好的环（外环逆时针，洞顺时针），会被追加对角线副本
+         */
+        template<typename T>
+        inline bool TriangulateMonotoneLoops(std::vector<MonotoneVertex<T>>& vertices,
+                                             std::vector<size_t>& out_triangles)
+        {
+            using EdgeTree = std::set<SweepEdge<T>>;
+
+            const size_t n = vertices.size();
+
+            // 每条对角线复制两个顶点，对角线数量不超过分裂与合并顶点数之和
+            const size_t capacity = n * 3;
+            size_t count = n;
+
+            vertices.resize(capacity);
+
+            std::vector<MonotoneVertexType> types(capacity);
+            std::vector<size_t> helpers(capacity, 0);
+
+            EdgeTree edges;
+            std::vector<typename EdgeTree::iterator> edge_of(capacity, edges.end());
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const glm::vec<2, T>& p = vertices[i].p;
+                const glm::vec<2, T>& prev = vertices[vertices[i].prev].p;
+                const glm::vec<2, T>& next = vertices[vertices[i].next].p;
+
+                if (SweepBelow(prev, p) && SweepBelow(next, p))
+                    types[i] = IsLeftTurn2D(next, prev, p) ? MonotoneVertexType::Start : MonotoneVertexType::Split;
+                else if (SweepBelow(p, prev) && SweepBelow(p, next))
+                    types[i] = IsLeftTurn2D(next, prev, p) ? MonotoneVertexType::End : MonotoneVertexType::Merge;
+                else
+                    types[i] = MonotoneVertexType::Regular;
+            }
+
+            std::vector<size_t> priority(n);
+            for (size_t i = 0; i < n; ++i)
+                priority[i] = i;
+
+            std::sort(priority.begin(), priority.end(),
+                [&](size_t a, size_t b) { return SweepBelow(vertices[b].p, vertices[a].p); });
+
+            // 连接 a、b：a->b' 与 b->a' 两条新边，a'/b' 继承原顶点的出边
+            auto add_diagonal = [&](size_t a, size_t b)
+            {
+                const size_t a2 = count++;
+                const size_t b2 = count++;
+
+                vertices[a2].p = vertices[a].p;
+                vertices[a2].index = vertices[a].index;
+                vertices[b2].p = vertices[b].p;
+                vertices[b2].index = vertices[b].index;
+
+                vertices[a2].next = vertices[a].next;
+                vertices[b2].next = vertices[b].next;
+                vertices[vertices[a].next].prev = a2;
+                vertices[vertices[b].next].prev = b2;
+
+                vertices[a].next = b2;
+                vertices[b2].prev = a;
+                vertices[b].next = a2;
+                vertices[a2].prev = b;
+
+                for (const auto& [original, copy] : {std::pair{a, a2}, std::pair{b, b2}})
+                {
+                    types[copy] = types[original];
+                    helpers[copy] = helpers[original];
+                    edge_of[copy] = edge_of[original];
+
+                    if (edge_of[copy] != edges.end())
+                        edge_of[copy]->vertex = copy;
+
+                    // 原顶点的出边已变为对角线，不在扫描状态中
+                    edge_of[original] = edges.end();
+                }
+            };
+
+            // 与已有边等价说明输入自相交或有重复顶点
+            auto insert_edge = [&](size_t v, size_t helper) -> bool
+            {
+                const auto [it, inserted] = edges.insert({vertices[v].p, vertices[vertices[v].next].p, v});
+
+                if (!inserted)
+                    return false;
+
+                edge_of[v] = it;
+                helpers[v] = helper;
+                return true;
+            };
+
+            // 查找 v 左侧最近的边（加入对角线后边的归属可能改变，需通过 it->vertex 重新读取）
+            auto left_edge = [&](size_t v, typename EdgeTree::iterator& it) -> bool
+            {
+                it = edges.lower_bound({vertices[v].p, vertices[v].p, 0});
+
+                if (it == edges.begin())
+                    return false;
+
+                --it;
+                return true;
+            };
+
+            // 若 helper 恰为前一顶点，加入对角线后前一条边归属其副本，因此按当前的 prev 删除
+            auto remove_edge = [&](size_t v)
+            {
+                edges.erase(edge_of[v]);
+                edge_of[v] = edges.end();
+            };
+
+            auto is_merge = [&](size_t v) { return types[v] == MonotoneVertexType::Merge; };
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                const size_t v = priority[k];
+                size_t v2 = v;
+                typename EdgeTree::iterator edge;
+
+                switch (types[v])
+                {
+                    case MonotoneVertexType::Start:
+                        if (!insert_edge(v, v))
+                            return false;
+                        break;
+
+                    case MonotoneVertexType::End:
+                    {
+                        const size_t prev = vertices[v].prev;
+
+                        if (edge_of[prev] == edges.end())
+                            return false;
+
+                        if (is_merge(helpers[prev]))
+                            add_diagonal(v, helpers[prev]);
+
+                        remove_edge(vertices[v].prev);
+                        break;
+                    }
+
+                    case MonotoneVertexType::Split:
+                        if (!left_edge(v, edge))
+                            return false;
+
+                        add_diagonal(v, helpers[edge->vertex]);
+                        v2 = count - 2;
+
+                        helpers[edge->vertex] = v;
+
+                        if (!insert_edge(v2, v2))
+                            return false;
+                        break;
+
+                    case MonotoneVertexType::Merge:
+                    {
+                        const size_t prev = vertices[v].prev;
+
+                        if (edge_of[prev] == edges.end())
+                            return false;
+
+                        if (is_merge(helpers[prev]))
+                        {
+                            add_diagonal(v, helpers[prev]);
+                            v2 = count - 2;
+                        }
+
+                        remove_edge(vertices[v].prev);
+
+                        if (!left_edge(v, edge))
+                            return false;
+
+                        if (is_merge(helpers[edge->vertex]))
+                            add_diagonal(v2, helpers[edge->vertex]);
+
+                        helpers[edge->vertex] = v2;
+                        break;
+                    }
+
+                    case MonotoneVertexType::Regular:
+                    {
+                        const size_t prev = vertices[v].prev;
+
+                        if (SweepBelow(vertices[v].p, vertices[prev].p))
+                        {
+                            // 内部在右侧：替换左边界边
+                            if (edge_of[prev] == edges.end())
+                                return false;
+
+                            if (is_merge(helpers[prev]))
+                            {
+                                add_diagonal(v, helpers[prev]);
+                                v2 = count - 2;
+                            }
+
+                            remove_edge(vertices[v].prev);
+
+                            // 加入对角线后 v 下方的楔形属于持有出边的副本 v2，之后的对角线必须连到 v2
+                            if (!insert_edge(v2, v2))
+                                return false;
+                        }
+                        else
+                        {
+                            if (!left_edge(v, edge))
+                                return false;
+
+                            if (is_merge(helpers[edge->vertex]))
+                                add_diagonal(v, helpers[edge->vertex]);
+
+                            helpers[edge->vertex] = v;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            // 沿 next 遍历取出每个单调子多边形
+            std::vector<bool> used(count, false);
+            std::vector<size_t> piece;
+
+            out_triangles.reserve(out_triangles.size() + (n - 2) * 3);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (used[i])
+                    continue;
+
+                piece.clear();
+
+                for (size_t v = i; !used[v]; v = vertices[v].next)
+                {
+                    used[v] = true;
+                    piece.push_back(v);
+                }
+
+                if (!TriangulateMonotonePiece(vertices, piece, out_triangles))
+                    return false;
+            }
+
+            return true;
+        }
+    }//namespace detail
+
+    /**
+     * @brief 带洞2D多边形三角剖分（单调分解，O(n log n)）
+     *
+     * 输出三角形均为逆时针方向。
+     *
+     * @param outer 外环顶点（任意环绕方向）
+     * @param holes 洞的顶点（任意环绕方向）
+     * @param out_triangles 输出三角形索引，每3个一组；外环顶点编号为 [0,outer.size())，
+     *                      洞的顶点依次接在后面编号
+     * @return 外环少于3个有效顶点、面积为零或输入不是简单多边形时返回false
+     */
+    template<typename T>
+    inline bool TriangulatePolygon2DMonotone(const std::vector<glm::vec<2, T>>& outer,
+                                             const std::vector<std::vector<glm::vec<2, T>>>& holes,
+                                             std::vector<size_t>& out_triangles)
+    {
+        out_triangles.clear();
+
+        if (outer.size() < 3 || Polygon2DSignedArea(outer) == T(0))
+            return false;
+
+        size_t total = outer.size();
+        for (const auto& hole : holes)
+            total += hole.size();
+
+        std::vector<detail::MonotoneVertex<T>> vertices;
+        vertices.reserve(total * 3);
+
+        if (detail::AppendMonotoneLoop(vertices, outer, 0, true) == 0)
+            return false;
+
+        size_t base = outer.size();
+
+        for (const auto& hole : holes)
+        {
+            if (hole.size() >= 3 && Polygon2DSignedArea(hole) != T(0))
+                detail::AppendMonotoneLoop(vertices, hole, base, false);
+
+            base += hole.size();
+        }
+
+        if (!detail::TriangulateMonotoneLoops(vertices, out_triangles))
+        {
+            out_triangles.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief 2D多边形三角剖分（单调分解，O(n log n)）
+     *
+     * 与 TriangulatePolygon2D 输入输出相同，适用于大顶点数的多边形。
+     *
+     * @param vertices 多边形顶点数组（任意环绕方向）
+     * @param out_triangles 输出三角形索引数组，每3个索引构成一个逆时针三角形
+     * @return true表示三角剖分成功
+     */
+    template<typename T>
+    inline bool TriangulatePolygon2DMonotone(const std::vector<glm::vec<2, T>>& vertices,
+                                             std::vector<size_t>& out_triangles)
+    {
+        return TriangulatePolygon2DMonotone(vertices, {}, out_triangles);
+    }
+
+    namespace detail
+    {
+        /**
+         * 非凸顶点的均匀网格索引，每个单元为顶点的侵入式双向链表，插入/删除 O(1)
+         */
+        template<typename T>
+        struct ReflexVertexGrid
+        {
+            static constexpr size_t NONE = size_t(-1);
+
+            glm::vec<2, T> origin;
+            T inv_cell_size = T(1);
+            size_t cols = 1, rows = 1;
+
+            std::vector<size_t> heads;              // 每个单元的首个顶点
+            std::vector<size_t> cell_of;            // 顶点所在单元，NONE 表示不在网格中
+            std::vector<size_t> cell_prev, cell_next;
+
+            /**
+             * @param count 预计放入的顶点数，单元数与之相当
+             */
+            void Init(const glm::vec<2, T>& min_point, const glm::vec<2, T>& max_point, size_t count, size_t vertex_count)
+            {
+                const glm::vec<2, T> extent = max_point - min_point;
+                const T cell_size = std::max(std::sqrt(extent.x * extent.y / T(std::max<size_t>(count, 1))),
+                                             std::max(extent.x, extent.y) / T(1 << 12));
+
+                origin = min_point;
+                inv_cell_size = cell_size > T(0) ? T(1) / cell_size : T(1);
+                cols = size_t(extent.x * inv_cell_size) + 1;
+                rows = size_t(extent.y * inv_cell_size) + 1;
+
+                heads.assign(cols * rows, NONE);
+                cell_of.assign(vertex_count, NONE);
+                cell_prev.assign(vertex_count, NONE);
+                cell_next.assign(vertex_count, NONE);
+            }
+
+            size_t Column(T x) const { return std::min(size_t(std::max(x - origin.x, T(0)) * inv_cell_size), cols - 1); }
+            size_t Row(T y) const { return std::min(size_t(std::max(y - origin.y, T(0)) * inv_cell_size), rows - 1); }
+
+            void Insert(size_t v, const glm::vec<2, T>& p)
+            {
+                const size_t cell = Row(p.y) * cols + Column(p.x);
+
+                cell_of[v] = cell;
+                cell_prev[v] = NONE;
+                cell_next[v] = heads[cell];
+
+                if (heads[cell] != NONE)
+                    cell_prev[heads[cell]] = v;
+
+                heads[cell] = v;
+            }
+
+            void Remove(size_t v)
+            {
+                const size_t cell = cell_of[v];
+
+                if (cell == NONE)
+                    return;
+
+                if (cell_prev[v] != NONE)
+                    cell_next[cell_prev[v]] = cell_next[v];
+                else
+                    heads[cell] = cell_next[v];
+
+                if (cell_next[v] != NONE)
+                    cell_prev[cell_next[v]] = cell_prev[v];
+
+                cell_of[v] = NONE;
+            }
+
+            bool Contains(size_t v) const { return cell_of[v] != NONE; }
+
+            /**
+             * 对包围盒覆盖单元中的每个顶点调用 func，func 返回 true 时提前结束
+             * @return 是否提前结束
+             */
+            template<typename F>
+            bool Any(const glm::vec<2, T>& min_point, const glm::vec<2, T>& max_point, F&& func) const
+            {
+                const size_t x0 = Column(min_point.x), x1 = Column(max_point.x);
+                const size_t y0 = Row(min_point.y), y1 = Row(max_point.y);
+
+                for (size_t y = y0; y <= y1; ++y)
+                    for (size_t x = x0; x <= x1; ++x)
+                        for (size_t v = heads[y * cols + x]; v != NONE; v = cell_next[v])
+                            if (func(v))
+                                return true;
+
+                return false;
+            }
+        };
+
+        template<typename T>
+        inline T Cross2D(const glm::vec<2, T>& a, const glm::vec<2, T>& b, const glm::vec<2, T>& c)
+        {
+            return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        }
+    }//namespace detail
+
+    /**
+     * @brief 2D多边形三角剖分（网格索引非凸顶点的耳切法）
+     *
+     * 与 TriangulatePolygon2D 输入输出相同，耳朵判定规则一致（严格凸且三角形内不含其他顶点，
+     * 边上的顶点视为在内部）。一整圈都找不到耳朵时，先删除共线/零面积顶点再继续，
+     * 仍然找不到则返回 false。
+     *
+     * @param vertices 多边形顶点数组（任意环绕方向）
+     * @param out_triangles 输出三角形索引数组，每3个索引构成一个逆时针三角形
+     * @return true表示三角剖分成功
+     */
+    template<typename T>
+    inline bool TriangulatePolygon2DIndexedEar(const std::vector<glm::vec<2, T>>& vertices,
+                                               std::vector<size_t>& out_triangles)
+    {
+        out_triangles.clear();
+
+        const size_t n = vertices.size();
+
+        if (n < 3 || Polygon2DSignedArea(vertices) == T(0))
+            return false;
+
+        // 按逆时针顺序建立链表，跳过连续重复点
+        const bool reverse = !IsPolygon2DCCW(vertices);
+
+        std::vector<size_t> index;
+        index.reserve(n);
+
+        for (size_t k = 0; k < n; ++k)
+        {
+            const size_t i = reverse ? n - 1 - k : k;
+
+            if (index.empty() || vertices[index.back()] != vertices[i])
+                index.push_back(i);
+        }
+
+        while (index.size() > 1 && vertices[index.back()] == vertices[index.front()])
+            index.pop_back();
+
+        const size_t m = index.size();
+
+        if (m < 3)
+            return false;
+
+        auto point = [&](size_t v) -> const glm::vec<2, T>& { return vertices[index[v]]; };
+
+        std::vector<size_t> prev(m), next(m);
+        std::vector<bool> reflex(m);
+
+        glm::vec<2, T> min_point = point(0);
+        glm::vec<2, T> max_point = point(0);
+        size_t reflex_count = 0;
+
+        for (size_t v = 0; v < m; ++v)
+        {
+            prev[v] = (v + m - 1) % m;
+            next[v] = (v + 1) % m;
+
+            min_point = glm::min(min_point, point(v));
+            max_point = glm::max(max_point, point(v));
+        }
+
+        for (size_t v = 0; v < m; ++v)
+        {
+            reflex[v] = detail::Cross2D(point(prev[v]), point(v), point(next[v])) <= T(0);
+            reflex_count += reflex[v];
+        }
+
+        detail::ReflexVertexGrid<T> grid;
+        grid.Init(min_point, max_point, reflex_count, m);
+
+        for (size_t v = 0; v < m; ++v)
+            if (reflex[v])
+                grid.Insert(v, point(v));
+
+        auto is_ear = [&](size_t b) -> bool
+        {
+            if (reflex[b])
+                return false;
+
+            const size_t a = prev[b];
+            const size_t c = next[b];
+            const glm::vec<2, T>& pa = point(a);
+            const glm::vec<2, T>& pb = point(b);
+            const glm::vec<2, T>& pc = point(c);
+
+            return !grid.Any(glm::min(pa, glm::min(pb, pc)), glm::max(pa, glm::max(pb, pc)),
+                [&](size_t v) { return v != a && v != c && IsPointInTriangle2D(pa, pb, pc, point(v)); });
+        };
+
+        // 切耳后两侧顶点的内角变小，非凸顶点可能变凸
+        auto update = [&](size_t v)
+        {
+            if (reflex[v] && detail::Cross2D(point(prev[v]), point(v), point(next[v])) > T(0))
+            {
+                reflex[v] = false;
+                grid.Remove(v);
+            }
+        };
+
+        auto unlink = [&](size_t v)
+        {
+            next[prev[v]] = next[v];
+            prev[next[v]] = prev[v];
+            grid.Remove(v);
+        };
+
+        out_triangles.reserve((m - 2) * 3);
+
+        size_t remaining = m;
+        size_t ear = 0;
+        size_t stop = ear;
+
+        while (remaining > 3)
+        {
+            const size_t a = prev[ear];
+            const size_t c = next[ear];
+
+            if (is_ear(ear))
+            {
+                out_triangles.push_back(index[a]);
+                out_triangles.push_back(index[ear]);
+                out_triangles.push_back(index[c]);
+
+                unlink(ear);
+                remaining--;
+
+                update(a);
+                update(c);
+
+                ear = stop = c;
+                continue;
+            }
+
+            ear = c;
+
+            if (ear != stop)
+                continue;
+
+            // 一整圈没有耳朵：删除共线或零面积的顶点后重试
+            size_t removed = 0;
+            size_t v = ear;
+
+            for (size_t count = remaining; count > 0 && remaining > 3; --count)
+            {
+                const size_t following = next[v];
+
+                if (detail::Cross2D(point(prev[v]), point(v), point(following)) == T(0))
+                {
+                    unlink(v);
+                    remaining--;
+                    removed++;
+
+                    update(prev[v]);
+                    update(following);
+
+                    if (v == ear)
+                        ear = following;
+                }
+
+                v = following;
+            }
+
+            if (removed == 0)
+            {
+                out_triangles.clear();
+                return false;
+            }
+
+            stop = ear;
+        }
+
+        out_triangles.push_back(index[prev[ear]]);
+        out_triangles.push_back(index[ear]);
+        out_triangles.push_back(index[next[ear]]);
+
+        return true;
+    }
+}//namespace hgl::math
@@ -0,0 +1,107 @@
+﻿/**
+ * PreparedRay.h - 预处理射线
+ *
+ * Ray 只保存起点与方向，每次射线-盒子测试都要重新求倒数并按方向符号分支。
+ * 在 BVH 遍历中同一条射线要做几十次盒子测试，PreparedRay 把这些计算提到遍历之外：
+ * - inv_direction：方向分量的倒数（分量为 0 时为 ±inf）
+ * - sign：方向分量为负时为 1，直接选取盒子的近/远平面，无需比较交换
+ * - kx/ky/kz 与 shear：Woop 等人的水密射线-三角形测试所用的轴置换与剪切常量
+ */
+#pragma once
+
+#include<hgl/math/geometry/Ray.h>
+#include<limits>
+#include<cmath>
+#include<utility>
+
+namespace hgl::math
+{
+    struct PreparedRay
+    {
+        Vector3f origin;
+        Vector3f direction;
+        Vector3f inv_direction;
+        int sign[3];                ///<方向分量为负时为 1
+
+        int kx,ky,kz;               ///<kz 为方向绝对值最大的轴，kx/ky 为另两轴（保持三角形绕序）
+        Vector3f shear;             ///<(d[kx]/d[kz], d[ky]/d[kz], 1/d[kz])
+
+    public:
+
+        PreparedRay()
+        {
+            Set(Ray());
+        }
+
+        explicit PreparedRay(const Ray &ray)
+        {
+            Set(ray);
+        }
+
+        void Set(const Ray &ray)
+        {
+            origin=ray.origin;
+            direction=ray.direction;
+
+            for(int i=0;i<3;i++)
+            {
+                inv_direction[i]=1.0f/direction[i];
+                sign[i]=std::signbit(direction[i])?1:0;
+            }
+
+            kz=0;
+            if(std::fabs(direction.y)>std::fabs(direction[kz]))kz=1;
+            if(std::fabs(direction.z)>std::fabs(direction[kz]))kz=2;
+
+            kx=(kz+1)%3;
+            ky=(kx+1)%3;
+
+            if(direction[kz]<0.0f)
+                std::swap(kx,ky);
+
+            shear.z=1.0f/direction[kz];
+            shear.x=direction[kx]*shear.z;
+            shear.y=direction[ky]*shear.z;
+        }
+
+        Ray GetRay()const{return Ray(origin,direction);}
+
+        /**
+         * 射线与盒子的 slab 测试，限定在 [t_min,t_max] 参数范围内
+         * @param t_enter 输出进入参数（不小于 t_min）
+         * @param t_exit 输出离开参数（不大于 t_max）
+         * @note 方向分量为 0 且起点恰在平板上时产生的 NaN 会被忽略
+         */
+        bool IntersectsBox(const Vector3f &box_min,const Vector3f &box_max,float t_min,float t_max,float &t_enter,float &t_exit)const
+        {
+            const Vector3f *bounds[2]={&box_min,&box_max};
+
+            for(int i=0;i<3;i++)
+            {
+                const float t_near=((*bounds[sign[i]])[i]-origin[i])*inv_direction[i];
+                const float t_far =((*bounds[1-sign[i]])[i]-origin[i])*inv_direction[i]*FAR_SCALE;
+
+                // Written so a NaN slab leaves the interval unchanged
+                t_min=t_near>t_min?t_near:t_min;
+                t_max=t_far <t_max?t_far :t_max;
+            }
+
+            t_enter=t_min;
+            t_exit=t_max;
+            return t_min<=t_max;
+        }
+
+        bool IntersectsBox(const Vector3f &box_min,const Vector3f &box_max,float t_max=std::numeric_limits<float>::infinity())const
+        {
+            float t_enter,t_exit;
+            return IntersectsBox(box_min,box_max,0.0f,t_max,t_enter,t_exit);
+        }
+
+    private:
+
+        /**
+         * 远平面距离放大 1+2*gamma(3)，抵消浮点舍入，保证贴着盒子表面的射线不会漏检（Ize 2013）
+         */
+        static constexpr float FAR_SCALE=1.0f+2.0f*(3.0f*std::numeric_limits<float>::epsilon()*0.5f)/(1.0f-3.0f*std::numeric_limits<float>::epsilon()*0.5f);
+    };//struct PreparedRay
+}//namespace hgl::math
@@ -15,6 +15,8 @@ namespace hgl::math
     class EllipseSphere;
     class AABB;
     class OBB;
+    struct BatchRaySOA;
+    class IParallelExecutor;
 
     /**
     * 射线类
@@ -108,4 +110,25 @@ namespace hgl::math
 
         bool CrossCircle(const Vector3f &center,const Vector3f &normal,const float radius)const; ///<求射线是否与指定圆相交
     };//struct Ray
+
+    /**
+    * 批量生成视口矩形内每个像素的拾取射线（结果与逐点 Ray::SetFromViewportPoint 相同）
+    *
+    * 屏幕坐标经 inverse_vp 变换后的齐次坐标是屏幕 x/y 的线性函数，
+    * 因此只需预先求出近/远平面的基点与每像素的 x/y 增量，每条射线只剩加法、透视除法和归一化。
+    *
+    * @param rays 输出射线，按行优先顺序覆盖写入 size.x*size.y 条
+    * @param start 矩形左上角像素坐标
+    * @param size 矩形宽高
+    * @param executor 并行执行器（按行分块，可为 nullptr）
+    */
+    void GenerateViewportRays(BatchRaySOA &rays,const graph::CameraInfo *ci,const Vector2u &viewport_size,
+                              const Vector2i &start,const Vector2u &size,IParallelExecutor *executor=nullptr);
+
+    /**
+    * 批量生成指定屏幕坐标列表的拾取射线
+    * @param rays 输出射线，按 points 顺序覆盖写入 count 条
+    */
+    void GenerateViewportRays(BatchRaySOA &rays,const graph::CameraInfo *ci,const Vector2u &viewport_size,
+                              const Vector2i *points,size_t count);
 }//namespace hgl::math
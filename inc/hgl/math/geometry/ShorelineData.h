@@ -20,6 +20,7 @@
 
 #include <hgl/math/VectorTypes.h>
 #include <hgl/math/geometry/HeightMapContour.h>
+#include <hgl/math/ParallelFor.h>
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -51,6 +52,8 @@ namespace hgl::math
      * @brief 海岸线轮廓
      *
      * 由多个线段组成的完整海岸线，支持距离查询
+     *
+     * QueryDistance 逐线段遍历，适合少量查询；大量点查询请使用 ShorelineSegmentIndex
      */
     struct ShorelineContour
     {
@@ -81,7 +84,7 @@ namespace hgl::math
             if (segments.empty())
                 return std::numeric_limits<float>::max();
 
-            float min_dist = std::numeric_limits<float>::max();
+            float min_dist_sq = std::numeric_limits<float>::max();
             Vector2f best_closest = point;
             float best_accumulated = 0;
             Vector2f best_normal(0, 1);
@@ -92,28 +95,18 @@ namespace hgl::math
                 Vector2f ap = point - seg.start;
 
                 float ab_len_sq = glm::dot(ab, ab);
-                if (ab_len_sq < 1e-8f)
-                {
-                    float dist = glm::length(ap);
-                    if (dist < min_dist)
-                    {
-                        min_dist = dist;
-                        best_closest = seg.start;
-                        best_accumulated = seg.accumulated_length;
-                        best_normal = seg.normal;
-                    }
-                    continue;
-                }
+                float t = 0.0f;
 
-                float t = glm::dot(ap, ab) / ab_len_sq;
-                t = glm::clamp(t, 0.0f, 1.0f);
+                if (ab_len_sq >= 1e-8f)
+                    t = glm::clamp(glm::dot(ap, ab) / ab_len_sq, 0.0f, 1.0f);
 
                 Vector2f closest = seg.start + t * ab;
-                float dist = glm::length(point - closest);
+                Vector2f d = point - closest;
+                float dist_sq = glm::dot(d, d);
 
-                if (dist < min_dist)
+                if (dist_sq < min_dist_sq)
                 {
-                    min_dist = dist;
+                    min_dist_sq = dist_sq;
                     best_closest = closest;
                     best_accumulated = seg.accumulated_length + t * seg.length;
                     best_normal = seg.normal;
@@ -127,10 +120,115 @@ namespace hgl::math
             if (normal)
                 *normal = best_normal;
 
-            return min_dist;
+            return std::sqrt(min_dist_sq);
+        }
+    };
+
+    /**
+     * @brief 海岸线最近点查询结果
+     */
+    struct ShorelineQueryResult
+    {
+        float distance;                 ///< 到最近线段的距离，未找到时为 float 最大值
+        Vector2f closest_point;         ///< 最近点
+        float distance_along_contour;   ///< 最近点沿所属轮廓的弧长位置
+        Vector2f normal;                ///< 最近点处的法线（指向陆地），最近点为顶点时取顶点伪法线
+        int contour_id;                 ///< 所属轮廓序号，未找到时为 -1
+
+        ShorelineQueryResult()
+            : distance(std::numeric_limits<float>::max())
+            , closest_point(0, 0)
+            , distance_along_contour(0)
+            , normal(0, 1)
+            , contour_id(-1)
+        {
         }
     };
 
+    /**
+     * @brief 海岸线线段空间索引
+     *
+     * 对一组海岸线轮廓的全部线段建立均匀网格，每个网格记录与其包围盒相交的线段。
+     * 查询从查询点所在格开始逐圈向外扩展，当已找到的最近距离不大于
+     * 未访问格子的最小可能距离时停止，结果与逐线段遍历一致（距离相等时取序号较小的线段）。
+     *
+     * 最近点落在两条相连线段的公共顶点上时，结果法线取两条线段法线之和（二维中角度加权伪法线即等权），
+     * 因此 dot(point - closest_point, normal) 的符号在尖角附近也能正确区分陆地与海面。
+     *
+     * 建立一次后可并发查询（只读）。
+     */
+    class ShorelineSegmentIndex
+    {
+    private:
+        struct IndexedSegment
+        {
+            Vector2f start;
+            Vector2f delta;             ///< end - start
+            float inv_length_sq;        ///< 1 / |delta|^2，退化线段为 0
+            float length;
+            float accumulated_length;
+            Vector2f normal;
+            Vector2f start_normal;      ///< 起点伪法线（与前一条相连线段的法线之和，单位化）
+            Vector2f end_normal;        ///< 终点伪法线（与后一条相连线段的法线之和，单位化）
+            int contour_id;
+        };
+
+        std::vector<IndexedSegment> segments_;
+        std::vector<uint32_t> cell_start_;      ///< 每格在 cell_segments_ 中的起始位置（CSR，长度 = 格数 + 1）
+        std::vector<uint32_t> cell_segments_;   ///< 按格排列的线段序号
+
+        Vector2f origin_;
+        float cell_size_;
+        float inv_cell_size_;
+        int cells_x_;
+        int cells_y_;
+
+        void CellOf(const Vector2f& p, int& cx, int& cy) const;
+
+    public:
+        ShorelineSegmentIndex()
+            : origin_(0, 0), cell_size_(1), inv_cell_size_(1), cells_x_(0), cells_y_(0)
+        {
+        }
+
+        /**
+         * @brief 建立索引
+         *
+         * @param contours 海岸线轮廓，结果中的 contour_id 为其下标
+         * @param cell_size 网格边长，<=0 时按线段平均长度与包围盒面积自动选择
+         */
+        void Build(const std::vector<ShorelineContour>& contours, float cell_size = 0.0f);
+
+        void Clear();
+
+        bool IsEmpty() const { return segments_.empty(); }
+        size_t GetSegmentCount() const { return segments_.size(); }
+        float GetCellSize() const { return cell_size_; }
+
+        /**
+         * @brief 查询单个点的最近线段
+         *
+         * @param point 查询点
+         * @param max_distance 搜索半径，超出此距离的线段不保证被找到
+         * @return 找到线段时返回 true
+         */
+        bool Query(const Vector2f& point, ShorelineQueryResult& result,
+                   float max_distance = std::numeric_limits<float>::max()) const;
+
+        /**
+         * @brief 批量查询
+         *
+         * @param points 查询点数组
+         * @param count 点数量
+         * @param results 输出结果数组（至少 count 个）
+         * @param executor 并行执行器，nullptr 时串行
+         * @param max_distance 搜索半径
+         */
+        void QueryBatch(const Vector2f* points, size_t count, ShorelineQueryResult* results,
+                        IParallelExecutor* executor = nullptr,
+                        float max_distance = std::numeric_limits<float>::max()) const;
+    };
+
     /**
      * @brief 浅海区顶点数据
      *
@@ -253,9 +351,14 @@ namespace hgl::math
         /**
          * @brief 生成浅海区网格数据
          *
+         * 在海岸线包围盒（向外扩展 max_wave_depth）内按 grid_spacing 生成规则网格，
+         * 通过 ShorelineSegmentIndex 批量求每个顶点到海岸线的符号距离，
+         * 只保留与 [-grid_spacing, max_wave_depth] 距离带相交的网格单元及其顶点。
+         *
+         * @param executor 并行执行器，nullptr 时串行
          * @return 完整的网格数据，包括顶点、索引和海岸线信息
          */
-        ShallowWaterMeshData Extract();
+        ShallowWaterMeshData Extract(IParallelExecutor* executor = nullptr);
     };
 
 }//namespace hgl::math
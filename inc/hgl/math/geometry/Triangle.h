@@ -163,6 +163,53 @@ namespace hgl::math
     using Triangle2f=Triangle2<float>;      // 单精度浮点顶点（最常用，性能和精度平衡）
     using Triangle2d=Triangle2<double>;     // 双精度浮点顶点（高精度计算）
 
+    /**
+    * 求3D三角形上距离指定点最近的点
+    *
+    * 按 Voronoi 区域（三个顶点、三条边、面内）分类，不需要开方。
+    * 退化三角形返回第一个顶点附近的结果。
+    */
+    template<typename T>
+    glm::vec<3,T> ClosestPointOnTriangle(const glm::vec<3,T> &p,const glm::vec<3,T> &a,const glm::vec<3,T> &b,const glm::vec<3,T> &c)
+    {
+        const glm::vec<3,T> ab=b-a;
+        const glm::vec<3,T> ac=c-a;
+        const glm::vec<3,T> ap=p-a;
+
+        const T d1=glm::dot(ab,ap);
+        const T d2=glm::dot(ac,ap);
+        if(d1<=0&&d2<=0)return a;                               //顶点 a
+
+        const glm::vec<3,T> bp=p-b;
+        const T d3=glm::dot(ab,bp);
+        const T d4=glm::dot(ac,bp);
+        if(d3>=0&&d4<=d3)return b;                              //顶点 b
+
+        const T vc=d1*d4-d3*d2;
+        if(vc<=0&&d1>=0&&d3<=0)
+            return a+ab*(d1/(d1-d3));                           //边 ab
+
+        const glm::vec<3,T> cp=p-c;
+        const T d5=glm::dot(ab,cp);
+        const T d6=glm::dot(ac,cp);
+        if(d6>=0&&d5<=d6)return c;                              //顶点 c
+
+        const T vb=d5*d2-d1*d6;
+        if(vb<=0&&d2>=0&&d6<=0)
+            return a+ac*(d2/(d2-d6));                           //边 ac
+
+        const T va=d3*d6-d5*d4;
+        if(va<=0&&(d4-d3)>=0&&(d5-d6)>=0)
+            return b+(c-b)*((d4-d3)/((d4-d3)+(d5-d6)));         //边 bc
+
+        const T sum=va+vb+vc;
+
+        if(sum==0)
+            return a;
+
+        return a+ab*(vb/sum)+ac*(vc/sum);                       //面内
+    }
+
     /**
     * 3D三角形类
     *
@@ -266,6 +313,14 @@ namespace hgl::math
         {
             return TriangleArea(vertex[0],vertex[1],vertex[2]);
         }
+
+        /**
+        * 求三角形上距离指定点最近的点
+        */
+        glm::vec<3,T> ClosestPoint(const glm::vec<3,T> &p)const
+        {
+            return ClosestPointOnTriangle<T>(p,vertex[0],vertex[1],vertex[2]);
+        }
     };//template<typename T> class Triangle3
 
     // 3D三角形的常用类型别名
@@ -0,0 +1,129 @@
+﻿/**
+ * ConvexHull.h - 由顶点集定义的凸包
+ *
+ * 凸包不显式存储面，只保存顶点；支撑点查询对顶点求最大投影即可，
+ * 适合作为 GJK/EPA 的通用凸体（任意凸多面体、碰撞代理网格等）。
+ */
+#pragma once
+
+#include<hgl/math/Vector.h>
+#include<hgl/math/geometry/AABB.h>
+#include<vector>
+
+namespace hgl::math
+{
+    /**
+     * ConvexHull - 顶点集的凸包
+     *
+     * 几何定义：
+     * - 包含所有顶点的最小凸集
+     * - 顶点可以包含内部点（不影响结果，只影响支撑点查询速度）
+     *
+     * 常见用途：
+     * - 凸多面体碰撞代理
+     * - 与其它几何体进行 GJK/EPA 碰撞检测
+     */
+    class ConvexHull
+    {
+        std::vector<Vector3f> vertices;     // Hull vertices (interior points allowed)
+        Vector3f center;                    // Vertex average
+
+    public:
+
+        ConvexHull():center(0,0,0){}
+
+        /**
+         * 从顶点数组构造
+         * @param pts 顶点数组
+         * @param count 顶点数量
+         */
+        ConvexHull(const Vector3f *pts,const size_t count)
+        {
+            Set(pts,count);
+        }
+
+        /**
+         * 设置顶点
+         * @param pts 顶点数组
+         * @param count 顶点数量
+         */
+        void Set(const Vector3f *pts,const size_t count)
+        {
+            vertices.assign(pts,pts+count);
+
+            center=Vector3f(0,0,0);
+
+            if(count==0)
+                return;
+
+            for(const Vector3f &v:vertices)
+                center+=v;
+
+            center/=float(count);
+        }
+
+        /** 获取顶点数组 */
+        const std::vector<Vector3f> &GetVertices() const { return vertices; }
+
+        /** 获取顶点数量 */
+        size_t GetVertexCount() const { return vertices.size(); }
+
+        /**
+         * 获取几何中心（顶点平均值，保证在凸包内部）
+         */
+        const Vector3f &GetCenter() const { return center; }
+
+        /**
+         * 获取指定方向上的支撑点（该方向投影最大的顶点）
+         * @param direction 方向（无需归一化）
+         */
+        Vector3f GetSupportPoint(const Vector3f &direction) const
+        {
+            if(vertices.empty())
+                return center;
+
+            size_t best=0;
+            float best_dot=Dot(vertices[0],direction);
+
+            for(size_t i=1;i<vertices.size();i++)
+            {
+                const float d=Dot(vertices[i],direction);
+
+                if(d>best_dot)
+                {
+                    best_dot=d;
+                    best=i;
+                }
+            }
+
+            return vertices[best];
+        }
+
+        /**
+         * 获取轴对齐包围盒
+         */
+        AABB GetBoundingBox() const
+        {
+            AABB box;
+
+            if(vertices.empty())
+            {
+                box.SetMinMax(center,center);
+                return box;
+            }
+
+            Vector3f min_pt=vertices[0];
+            Vector3f max_pt=vertices[0];
+
+            for(const Vector3f &v:vertices)
+            {
+                min_pt=glm::min(min_pt,v);
+                max_pt=glm::max(max_pt,v);
+            }
+
+            box.SetMinMax(min_pt,max_pt);
+            return box;
+        }
+    };//class ConvexHull
+
+}//namespace hgl::math
@@ -0,0 +1,175 @@
+﻿/**
+ * HeightField.h - 高度场碰撞体
+ *
+ * 直接引用 T* 高度数据（与 HeightMapContourExtractor 相同的行优先布局，
+ * data[y*width+x]），不复制数据。按引擎 Z-up 约定映射到世界空间：
+ *     world = origin + (x, y, data[y*width+x]) * scale
+ *
+ * 每个格子沿 (x,y)-(x+1,y+1) 对角线分成两个三角形。
+ * 构建时生成格子高度的 min/max 金字塔（maximum mipmap）：
+ * - 射线检测：逐格 DDA 步进，每步取射线段能整体越过的最大块直接跳过
+ * - 球体/胶囊体重叠：只测试覆盖范围内高度区间可能相交的格子三角形
+ * - 高度查询：按所在三角形插值，同时给出法线
+ */
+#pragma once
+
+#include<hgl/math/Vector.h>
+#include<hgl/math/geometry/AABB.h>
+#include<vector>
+#include<cstdint>
+
+namespace hgl::math
+{
+    struct Ray;
+    class Sphere;
+    class Capsule;
+
+    /**
+     * 高度场射线检测结果
+     */
+    struct HeightFieldHit
+    {
+        float distance=0.0f;            ///<沿射线方向的参数距离
+        Vector3f point{0,0,0};          ///<命中点
+        Vector3f normal{0,0,1};         ///<命中三角形法线（朝向射线起点一侧）
+        int cell_x=0,cell_y=0;          ///<命中格子
+    };
+
+    /**
+     * 高度场碰撞体
+     */
+    class HeightField
+    {
+    public:
+
+        struct MinMax
+        {
+            float min_value;
+            float max_value;
+        };
+
+    private:
+
+        const void *source=nullptr;
+        float (*fetch)(const void *,size_t)=nullptr;
+
+        int width=0;
+        int height=0;
+        Vector3f origin{0,0,0};
+        Vector3f scale{1,1,1};
+
+        std::vector<MinMax> mips;                   ///<全部层级，按层连续存放，第 0 层每格一个
+        std::vector<size_t> level_offset;
+        std::vector<int> level_width;
+        std::vector<int> level_height;
+
+        template<typename T>
+        static float Fetch(const void *data,size_t index)
+        {
+            return float(static_cast<const T *>(data)[index]);
+        }
+
+        float Sample(int x,int y)const{return fetch(source,size_t(y)*width+x);}         ///<原始高度值
+
+        void BuildMips();
+        void UpdateLevel(int level,int x0,int y0,int x1,int y1);
+
+        void GetCellWorld(int cx,int cy,Vector3f corner[4])const;
+        Vector3f GetCellNormal(int cx,int cy,bool lower)const;
+
+        template<typename Test>
+        bool OverlapCells(const Vector3f &box_min,const Vector3f &box_max,const Test &test)const;
+
+    public:
+
+        HeightField()=default;
+
+        template<typename T>
+        HeightField(const T *data,int w,int h,const Vector3f &o=Vector3f(0,0,0),const Vector3f &s=Vector3f(1,1,1))
+        {
+            Set(data,w,h,o,s);
+        }
+
+        /**
+         * 设置高度数据并构建 min/max 金字塔
+         * @param data 高度数据（需在本对象使用期间保持有效）
+         * @param w,h 采样点数量（至少 2x2）
+         * @param o 采样点 (0,0)、高度 0 对应的世界坐标
+         * @param s 格子尺寸（x,y）与高度缩放（z），均需为正
+         */
+        template<typename T>
+        bool Set(const T *data,int w,int h,const Vector3f &o=Vector3f(0,0,0),const Vector3f &s=Vector3f(1,1,1))
+        {
+            if(!data||w<2||h<2||s.x<=0||s.y<=0||s.z<=0)
+            {
+                Clear();
+                return false;
+            }
+
+            source=data;
+            fetch=&Fetch<T>;
+            width=w;
+            height=h;
+            origin=o;
+            scale=s;
+
+            BuildMips();
+            return true;
+        }
+
+        /**
+         * 高度数据在 [x0,x1]x[y0,y1] 采样点范围内被修改后，更新受影响的金字塔块
+         */
+        void Refresh(int x0,int y0,int x1,int y1);
+
+        void Clear();
+
+        bool IsValid()const{return source!=nullptr;}
+
+        int GetWidth()const{return width;}
+        int GetHeight()const{return height;}
+        const Vector3f &GetOrigin()const{return origin;}
+        const Vector3f &GetScale()const{return scale;}
+
+        int GetLevelCount()const{return int(level_offset.size());}
+        int GetLevelWidth(int level)const{return level_width[level];}
+        int GetLevelHeight(int level)const{return level_height[level];}
+
+        /**
+         * 获取指定层级块的原始高度范围（第 0 层为单个格子，每升一层边长翻倍）
+         */
+        const MinMax &GetMinMax(int level,int x,int y)const
+        {
+            return mips[level_offset[level]+size_t(y)*level_width[level]+x];
+        }
+
+        /**
+         * 获取采样点的世界坐标
+         */
+        Vector3f GetSamplePoint(int x,int y)const
+        {
+            return origin+Vector3f(float(x),float(y),Sample(x,y))*scale;
+        }
+
+        AABB GetBoundingBox()const;
+
+    public: // 查询
+
+        /**
+         * 查询世界坐标 (x,y) 处的地表高度
+         * @param z 输出地表世界高度
+         * @param normal 输出地表法线（可为 nullptr）
+         * @return 超出高度场范围时返回 false
+         */
+        bool GetHeight(float x,float y,float &z,Vector3f *normal=nullptr)const;
+
+        /**
+         * 射线检测（双面）
+         * @param max_distance 最大参数距离
+         */
+        bool Raycast(const Ray &ray,float max_distance,HeightFieldHit &hit)const;
+
+        bool Overlaps(const Sphere &sphere)const;
+        bool Overlaps(const Capsule &capsule)const;
+    };//class HeightField
+}//namespace hgl::math
@@ -0,0 +1,135 @@
+﻿/**
+ * SignedDistanceField.h - 静态几何体的有符号距离场
+ *
+ * 将三角网格或一组基本形状烘焙为规则网格上的有符号距离采样（外部为正，内部为负），
+ * 之后的距离/梯度/最近点查询只需一次三线性插值，不再遍历 BVH。
+ *
+ * 存储：采样点按 8x8x8 分块（brick）。距离截断到 [-max_distance,max_distance]，
+ * 整块都在截断带之外的块只保存一个常量值，只有靠近表面的块保存完整采样。
+ *
+ * 烘焙：
+ * - 先按块中心距离判断整块是否在截断带外（距离场 1-Lipschitz，块中心距离超过
+ *   截断距离加半对角线即可整块跳过），再并行计算其余块
+ * - 三角网格使用 TriangleMesh 的 BVH 最近点查询，以截断距离为搜索半径；
+ *   符号由三条略偏离坐标轴的射线穿越次数的奇偶性多数表决决定，要求网格封闭
+ * - 基本形状取各形状有符号距离的最小值（并集）；凸包和三角形只有外部距离
+ */
+#pragma once
+
+#include<hgl/math/Vector.h>
+#include<hgl/math/geometry/AABB.h>
+#include<vector>
+#include<cstdint>
+
+namespace hgl::math
+{
+    class TriangleMesh;
+    class IParallelExecutor;
+    struct CollisionShapeSet;
+    struct BatchPointSOA;
+
+    /**
+     * 稀疏分块有符号距离场
+     */
+    class SignedDistanceField
+    {
+    public:
+
+        static constexpr int BRICK_SIZE=8;                                      ///<每块每轴采样数
+        static constexpr int BRICK_VOLUME=BRICK_SIZE*BRICK_SIZE*BRICK_SIZE;
+        static constexpr uint32_t UNIFORM_BRICK=0xFFFFFFFF;                     ///<常量块标记
+        static constexpr int MAX_SAMPLES_PER_AXIS=4096;
+
+        /**
+         * 块描述：offset 为块在采样数组中的起始位置，常量块为 UNIFORM_BRICK，此时所有采样均为 value
+         */
+        struct Brick
+        {
+            uint32_t offset;
+            float value;
+        };
+
+    private:
+
+        Vector3f origin{0,0,0};                 ///<采样点 (0,0,0) 的世界坐标
+        float voxel_size=1.0f;
+        float inv_voxel_size=1.0f;
+        float max_distance=0.0f;
+
+        int sample_count[3]={0,0,0};
+        int brick_count[3]={0,0,0};
+
+        std::vector<Brick> bricks;
+        std::vector<float> samples;             ///<非常量块的采样，每块 BRICK_VOLUME 个，块内按 x 最快排列
+
+        bool Setup(const AABB &bounds,float voxel,float band);
+
+        template<typename Evaluator>
+        void BakeBricks(const Evaluator &evaluator,IParallelExecutor *executor);
+
+        float Interpolate(const Vector3f &point,Vector3f *gradient)const;
+
+    public:
+
+        SignedDistanceField()=default;
+
+        /**
+         * 从封闭三角网格烘焙
+         * @param bounds 采样范围（建议比网格包围盒每侧大出 max_distance）
+         * @param voxel 采样间距
+         * @param band 截断距离，需为正
+         * @param executor 并行执行器（按块并行），为 nullptr 时在当前线程执行
+         * @return 参数无效、网格为空或采样数超过 MAX_SAMPLES_PER_AXIS 时返回 false
+         */
+        bool Bake(const TriangleMesh &mesh,const AABB &bounds,float voxel,float band,IParallelExecutor *executor=nullptr);
+
+        /**
+         * 从基本形状集合烘焙（取并集）
+         */
+        bool Bake(const CollisionShapeSet &shapes,const AABB &bounds,float voxel,float band,IParallelExecutor *executor=nullptr);
+
+        void Clear();
+
+        bool IsValid()const{return !bricks.empty();}
+
+        const Vector3f &GetOrigin()const{return origin;}
+        float GetVoxelSize()const{return voxel_size;}
+        float GetMaxDistance()const{return max_distance;}
+        int GetSampleCount(int axis)const{return sample_count[axis];}
+        int GetBrickCount(int axis)const{return brick_count[axis];}
+        size_t GetDenseBrickCount()const{return samples.size()/BRICK_VOLUME;}
+        const std::vector<Brick> &GetBricks()const{return bricks;}
+
+        /**
+         * 采样覆盖的世界空间范围
+         */
+        AABB GetBoundingBox()const;
+
+        /**
+         * 获取网格采样值（坐标需在 [0,sample_count) 范围内）
+         */
+        float GetSample(int x,int y,int z)const;
+
+    public: // 查询
+
+        /**
+         * 三线性插值求有符号距离
+         *
+         * 网格范围外的点按范围内最近点采样，再加上到范围的距离（真实距离的上界）。
+         * @param gradient 输出插值函数的梯度（可为 nullptr），范围外为指向外侧的单位向量
+         */
+        float Sample(const Vector3f &point,Vector3f *gradient=nullptr)const;
+
+        /**
+         * 沿梯度方向投影到零等值面，求表面上的近似最近点
+         */
+        Vector3f ClosestPoint(const Vector3f &point)const;
+
+        /**
+         * 批量采样
+         * @param distance 输出距离，需至少容纳 points.count 个
+         * @param gradient 输出梯度（可为 nullptr）
+         */
+        void Sample(const BatchPointSOA &points,float *distance,Vector3f *gradient=nullptr,IParallelExecutor *executor=nullptr)const;
+    };//class SignedDistanceField
+}//namespace hgl::math
@@ -0,0 +1,192 @@
+﻿/**
+ * TriangleMesh.h - 静态三角网格碰撞体
+ *
+ * 索引顶点 + 三角形 BVH（分箱 SAH 构建，节点按深度优先平铺存储）。
+ * 射线遍历使用 PreparedRay（盒子测试不再逐节点求倒数，三角形测试为水密版本）。
+ * 支持的查询：
+ * - 射线检测（最近命中 / 任意命中）
+ * - 球体、胶囊体、OBB、AABB 重叠（任意命中 / 收集全部三角形）
+ * - 最近点查询
+ *
+ * 角色在静态关卡网格上移动时，相邻帧的最近三角形通常不变。
+ * TriangleMeshCache 记录上次的最近/命中三角形，查询时先测试它：
+ * 最近点查询以其距离作为初始剪枝半径，重叠测试可直接提前返回。
+ */
+#pragma once
+
+#include<hgl/math/Vector.h>
+#include<hgl/math/geometry/AABB.h>
+#include<hgl/math/geometry/Triangle.h>
+#include<vector>
+#include<cstdint>
+
+namespace hgl::math
+{
+    struct Ray;
+    struct PreparedRay;
+    class Sphere;
+    class Capsule;
+    class OBB;
+
+    constexpr uint32_t MESH_INVALID_TRIANGLE=0xFFFFFFFF;
+
+    /**
+     * 网格射线检测结果
+     */
+    struct MeshRayHit
+    {
+        float distance=0.0f;                            ///<沿射线方向的参数距离
+        uint32_t triangle=MESH_INVALID_TRIANGLE;        ///<命中的三角形编号
+        Vector3f point{0,0,0};                          ///<命中点
+        Vector3f normal{0,0,0};                         ///<三角形法线（朝向射线起点一侧）
+        float u=0.0f,v=0.0f;                            ///<重心坐标
+    };
+
+    /**
+     * 网格最近点查询结果
+     */
+    struct MeshClosestPoint
+    {
+        Vector3f point{0,0,0};                          ///<网格上的最近点
+        uint32_t triangle=MESH_INVALID_TRIANGLE;        ///<最近点所在三角形
+        float distance=0.0f;                            ///<到查询点的距离
+    };
+
+    /**
+     * 最近特征缓存（每个查询者一份，跨帧保留）
+     */
+    struct TriangleMeshCache
+    {
+        uint32_t triangle=MESH_INVALID_TRIANGLE;        ///<上次找到的三角形
+
+        void Reset(){triangle=MESH_INVALID_TRIANGLE;}
+    };
+
+    /**
+     * 静态三角网格
+     */
+    class TriangleMesh
+    {
+    public:
+
+        static constexpr uint32_t MAX_LEAF_TRIANGLES=4;         ///<叶节点最多三角形数量
+        static constexpr uint32_t MAX_DEPTH=64;                 ///<遍历栈深度
+
+        /**
+         * BVH 节点（32 字节）
+         * count>0 为叶节点，三角形为 triangle_order[first,first+count)；
+         * 否则为内部节点，左子节点紧随其后，右子节点为 first
+         */
+        struct Node
+        {
+            Vector3f min_point;
+            uint32_t first;
+            Vector3f max_point;
+            uint32_t count;
+        };
+
+    private:
+
+        std::vector<Vector3f> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> triangle_order;       ///<叶节点引用的三角形编号
+        std::vector<Node> nodes;
+        uint32_t depth=0;
+
+        template<typename Test> bool OverlapAny(const Test &test,TriangleMeshCache *cache)const;
+        template<typename Test> uint32_t OverlapAll(const Test &test,std::vector<uint32_t> &out)const;
+
+        uint32_t Build(uint32_t first,uint32_t count,uint32_t level,std::vector<Vector3f> &centroids,std::vector<Vector3f> &tri_min,std::vector<Vector3f> &tri_max);
+
+        void GetVertices(uint32_t tri,Vector3f &a,Vector3f &b,Vector3f &c)const
+        {
+            const uint32_t *idx=indices.data()+tri*3;
+
+            a=vertices[idx[0]];
+            b=vertices[idx[1]];
+            c=vertices[idx[2]];
+        }
+
+    public:
+
+        TriangleMesh()=default;
+        TriangleMesh(const Vector3f *v,uint32_t vertex_count,const uint32_t *idx,uint32_t index_count)
+        {
+            Set(v,vertex_count,idx,index_count);
+        }
+
+        /**
+         * 设置网格数据并构建 BVH
+         * @param idx 三角形索引，每 3 个一组
+         * @return 索引数量不是 3 的倍数或越界时返回 false，网格保持为空
+         */
+        bool Set(const Vector3f *v,uint32_t vertex_count,const uint32_t *idx,uint32_t index_count);
+
+        void Clear();
+
+        bool IsEmpty()const{return indices.empty();}
+
+        uint32_t GetVertexCount()const{return uint32_t(vertices.size());}
+        uint32_t GetTriangleCount()const{return uint32_t(indices.size()/3);}
+        uint32_t GetNodeCount()const{return uint32_t(nodes.size());}
+        uint32_t GetDepth()const{return depth;}
+        const std::vector<Node> &GetNodes()const{return nodes;}
+
+        Triangle3f GetTriangle(uint32_t tri)const
+        {
+            Vector3f a,b,c;
+            GetVertices(tri,a,b,c);
+            return Triangle3f(a,b,c);
+        }
+
+        /**
+         * 获取三角形单位法线（按顶点逆时针顺序，退化三角形返回零向量）
+         */
+        Vector3f GetTriangleNormal(uint32_t tri)const;
+
+        AABB GetBoundingBox()const;
+
+    public: // 射线检测
+
+        /**
+         * 求射线最近命中（双面）
+         * @param max_distance 最大参数距离
+         */
+        bool Raycast(const Ray &ray,float max_distance,MeshRayHit &hit)const;
+        bool Raycast(const PreparedRay &ray,float max_distance,MeshRayHit &hit)const;
+
+        /**
+         * 仅判断射线在 max_distance 内是否命中任意三角形（用于遮挡测试）
+         */
+        bool RaycastAny(const Ray &ray,float max_distance)const;
+        bool RaycastAny(const PreparedRay &ray,float max_distance)const;
+
+    public: // 重叠测试
+
+        bool Overlaps(const Sphere &sphere,TriangleMeshCache *cache=nullptr)const;
+        bool Overlaps(const Capsule &capsule,TriangleMeshCache *cache=nullptr)const;
+        bool Overlaps(const OBB &obb,TriangleMeshCache *cache=nullptr)const;
+
+        /**
+         * 收集全部重叠三角形（追加到 out）
+         * @return 本次追加的数量
+         */
+        uint32_t QueryOverlaps(const Sphere &sphere,std::vector<uint32_t> &out)const;
+        uint32_t QueryOverlaps(const Capsule &capsule,std::vector<uint32_t> &out)const;
+        uint32_t QueryOverlaps(const OBB &obb,std::vector<uint32_t> &out)const;
+
+        /**
+         * 收集包围盒与 AABB 相交的三角形（仅粗检测）
+         */
+        uint32_t QueryBoundingBox(const AABB &box,std::vector<uint32_t> &out)const;
+
+    public: // 最近点
+
+        /**
+         * 求网格上距离 point 最近的点
+         * @param max_distance 搜索半径，超出此距离视为未找到
+         * @param cache 最近特征缓存，命中时以上次三角形的距离作为初始剪枝半径
+         */
+        bool ClosestPoint(const Vector3f &point,float max_distance,MeshClosestPoint &result,TriangleMeshCache *cache=nullptr)const;
+    };//class TriangleMesh
+}//namespace hgl::math
@@ -21,6 +21,7 @@
 #include<hgl/math/geometry/primitives/Cylinder.h>
 #include<hgl/math/geometry/primitives/Cone.h>
 #include<hgl/math/geometry/primitives/Torus.h>
+#include<hgl/math/geometry/primitives/ConvexHull.h>
 
 namespace hgl::math
 {
@@ -210,6 +211,70 @@ namespace hgl::math
             return Intersects(torus, sphere);
         }
 
+        //=============================================================================
+        // 通用凸体碰撞方法（GJK/EPA，见 GJK.h）
+        //=============================================================================
+
+        /**
+         * 测试圆锥体-胶囊体是否相交
+         */
+        static bool Intersects(const Cone& cone, const Capsule& capsule);
+        static bool Intersects(const Capsule& capsule, const Cone& cone)
+        {
+            return Intersects(cone, capsule);
+        }
+
+        /**
+         * 测试圆锥体-圆锥体是否相交
+         */
+        static bool Intersects(const Cone& a, const Cone& b);
+
+        /**
+         * 测试圆锥体-圆柱体是否相交
+         */
+        static bool Intersects(const Cone& cone, const Cylinder& cylinder);
+        static bool Intersects(const Cylinder& cylinder, const Cone& cone)
+        {
+            return Intersects(cone, cylinder);
+        }
+
+        /**
+         * 测试圆锥体-OBB是否相交
+         */
+        static bool Intersects(const Cone& cone, const OBB& box);
+        static bool Intersects(const OBB& box, const Cone& cone)
+        {
+            return Intersects(cone, box);
+        }
+
+        /**
+         * 测试圆柱体-OBB是否相交
+         */
+        static bool Intersects(const Cylinder& cylinder, const OBB& box);
+        static bool Intersects(const OBB& box, const Cylinder& cylinder)
+        {
+            return Intersects(cylinder, box);
+        }
+
+        /**
+         * 测试凸包与任意凸体是否相交
+         */
+        template<typename T>
+        static bool Intersects(const ConvexHull& hull, const T& shape);
+        template<typename T>
+        static bool Intersects(const T& shape, const ConvexHull& hull)
+        {
+            return Intersects(hull, shape);
+        }
+        static bool Intersects(const ConvexHull& a, const ConvexHull& b);
+
+        /**
+         * 获取任意两个凸体的详细碰撞信息（GJK求距离，EPA求穿透深度与法线）
+         * @note 法线从 a 指向 b，接触点位于 a 表面
+         */
+        template<typename T1, typename T2>
+        static CollisionInfo TestConvexCollision(const T1& a, const T2& b);
+
         //=============================================================================
         // AABB/OBB统一接口（委托给已有方法）
         //=============================================================================
@@ -265,3 +330,6 @@ namespace hgl::math
     };
 
 }//namespace hgl::math
+
+// ConvexHull/TestConvexCollision template definitions live in GJK.h
+#include<hgl/math/geometry/queries/GJK.h>
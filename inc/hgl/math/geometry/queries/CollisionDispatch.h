@@ -0,0 +1,147 @@
+﻿/**
+ * CollisionDispatch.h - 按形状类型分桶的批量碰撞检测
+ *
+ * CollisionDetector 以重载静态函数提供各类形状对的检测，处理混合形状的
+ * 碰撞对列表时每对都需要一次类型分支。CollisionDispatcher 将碰撞对按
+ * (类型A,类型B) 分桶，每个桶交给对应类型组合的批处理内核顺序执行，
+ * 结果按原始顺序写回。
+ *
+ * 内核选择：
+ * - 有专用解析实现的组合使用 CollisionDetector
+ * - 其余组合使用 GJK/EPA（环面按其凸包处理）
+ */
+#pragma once
+
+#include<hgl/math/geometry/queries/CollisionDetector.h>
+#include<hgl/math/geometry/Triangle.h>
+#include<vector>
+#include<cstdint>
+
+namespace hgl::math
+{
+    class IParallelExecutor;
+
+    /**
+     * 可参与批量分发的形状类型
+     */
+    enum class ShapeType:uint8_t
+    {
+        Sphere=0,
+        Capsule,
+        Cylinder,
+        Cone,
+        Torus,
+        AABB,
+        OBB,
+        ConvexHull,
+        Triangle,
+
+        ENUM_COUNT
+    };
+
+    constexpr uint32_t SHAPE_TYPE_COUNT=uint32_t(ShapeType::ENUM_COUNT);
+
+    /**
+     * 形状引用（类型 + 在对应形状数组中的下标）
+     */
+    struct ShapeRef
+    {
+        ShapeType type=ShapeType::Sphere;
+        uint32_t index=0;
+    };
+
+    /**
+     * 一个待检测的形状对
+     */
+    struct CollisionPair
+    {
+        ShapeRef a;
+        ShapeRef b;
+    };
+
+    /**
+     * 各类形状数组（不拥有数据，未使用的类型保持为空）
+     */
+    struct CollisionShapeSet
+    {
+        const Sphere       *spheres     =nullptr;   size_t sphere_count     =0;
+        const Capsule      *capsules    =nullptr;   size_t capsule_count    =0;
+        const Cylinder     *cylinders   =nullptr;   size_t cylinder_count   =0;
+        const Cone         *cones       =nullptr;   size_t cone_count       =0;
+        const Torus        *tori        =nullptr;   size_t torus_count      =0;
+        const AABB         *aabbs       =nullptr;   size_t aabb_count       =0;
+        const OBB          *obbs        =nullptr;   size_t obb_count        =0;
+        const ConvexHull   *hulls       =nullptr;   size_t hull_count       =0;
+        const Triangle3f   *triangles   =nullptr;   size_t triangle_count   =0;
+
+        /**
+         * 获取指定类型的形状数量
+         */
+        size_t GetCount(ShapeType type)const;
+
+        /**
+         * 检查形状引用是否有效
+         */
+        bool IsValid(const ShapeRef &ref)const
+        {
+            return uint32_t(ref.type)<SHAPE_TYPE_COUNT&&ref.index<GetCount(ref.type);
+        }
+    };//struct CollisionShapeSet
+
+    /**
+     * CollisionDispatcher - 按类型组合分桶的批量碰撞分发
+     *
+     * 分桶使用计数排序，内部缓冲在多次调用间复用，稳定运行后不再分配内存。
+     * 无效的形状引用不会被检测，其结果为默认值（不相交）。
+     *
+     * 用法示例：
+     *     CollisionDispatcher dispatcher;
+     *     dispatcher.Dispatch(shapes, pairs.data(), pairs.size(), results.data());
+     */
+    class CollisionDispatcher
+    {
+        std::vector<uint8_t>  pair_keys;                                ///<每个碰撞对的桶编号
+        std::vector<uint32_t> order;                                    ///<按桶排序后的碰撞对下标
+        uint32_t bucket_begin[SHAPE_TYPE_COUNT*SHAPE_TYPE_COUNT+1];     ///<各桶在 order 中的起始位置
+        uint32_t invalid_count=0;
+
+        void Bucket(const CollisionShapeSet &shapes,const CollisionPair *pairs,size_t count);
+
+    public:
+
+        CollisionDispatcher();
+
+        /**
+         * 计算完整碰撞信息
+         * @param results 输出数组，长度为 count，按 pairs 原始顺序写入
+         * @param executor 并行执行器，为 nullptr 时单线程执行
+         */
+        void Dispatch(const CollisionShapeSet &shapes,const CollisionPair *pairs,size_t count,CollisionInfo *results,IParallelExecutor *executor=nullptr);
+
+        /**
+         * 仅判断相交（优先使用各组合的解析相交测试）
+         * @param results 输出数组，长度为 count，1 表示相交
+         */
+        void DispatchIntersects(const CollisionShapeSet &shapes,const CollisionPair *pairs,size_t count,uint8_t *results,IParallelExecutor *executor=nullptr);
+
+        /**
+         * 上次分发中指定类型组合的碰撞对数量
+         */
+        uint32_t GetBucketSize(ShapeType a,ShapeType b)const
+        {
+            const uint32_t key=uint32_t(a)*SHAPE_TYPE_COUNT+uint32_t(b);
+
+            return bucket_begin[key+1]-bucket_begin[key];
+        }
+
+        /**
+         * 上次分发中非空桶的数量
+         */
+        uint32_t GetActiveBucketCount()const;
+
+        /**
+         * 上次分发中引用无效而被跳过的碰撞对数量
+         */
+        uint32_t GetInvalidPairCount()const{return invalid_count;}
+    };//class CollisionDispatcher
+}//namespace hgl::math
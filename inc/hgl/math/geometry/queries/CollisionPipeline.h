@@ -0,0 +1,148 @@
+﻿/**
+ * CollisionPipeline.h - 粗检测到窄检测的完整碰撞流水线
+ *
+ * CollisionDetector::IntersectsWithBroadPhase 每次调用只对一对物体做 AABB 预检。
+ * CollisionPipeline 对整个场景执行：
+ * 1. 计算每个代理的 AABB
+ * 2. 均匀网格粗检测：代理按覆盖的网格单元展开，按单元排序
+ * 3. 并行生成碰撞对：每个块写入自己的缓冲，按块顺序合并，无需加锁；
+ *    一对物体只在其 AABB 交集最小角所在的单元中输出，不需要额外去重
+ * 4. 窄检测：CollisionDispatcher 按类型分桶并行检测
+ * 5. 并行压缩为接触缓冲
+ *
+ * 覆盖单元过多的大物体不放入网格，单独与所有代理做 AABB 测试。
+ * 输出顺序只取决于输入，与线程数量无关。
+ */
+#pragma once
+
+#include<hgl/math/geometry/queries/CollisionDispatch.h>
+#include<vector>
+#include<cstdint>
+
+namespace hgl::math
+{
+    class IParallelExecutor;
+
+    /**
+     * 粗检测输出的代理对（a<b，均为代理下标）
+     */
+    struct ProxyPair
+    {
+        uint32_t a;
+        uint32_t b;
+    };
+
+    /**
+     * 窄检测确认的接触
+     */
+    struct CollisionContact
+    {
+        uint32_t proxy_a;               ///<代理 A 下标
+        uint32_t proxy_b;               ///<代理 B 下标
+        CollisionInfo info;             ///<碰撞信息（法线从 A 指向 B）
+    };
+
+    /**
+     * 流水线各阶段统计
+     */
+    struct CollisionPipelineStats
+    {
+        uint32_t proxy_count            =0;     ///<有效代理数量
+        uint32_t oversized_proxy_count  =0;     ///<未放入网格的大物体数量
+        uint32_t cell_entry_count       =0;     ///<代理展开后的网格条目数量
+        uint32_t occupied_cell_count    =0;     ///<非空网格单元数量
+        uint64_t broadphase_test_count  =0;     ///<粗检测执行的 AABB 测试次数
+        uint32_t broadphase_pair_count  =0;     ///<通过粗检测的碰撞对数量（已去重）
+        uint32_t contact_count          =0;     ///<窄检测确认的接触数量
+
+        void Clear(){*this=CollisionPipelineStats();}
+    };//struct CollisionPipelineStats
+
+    /**
+     * CollisionPipeline - 网格粗检测 + 分桶窄检测
+     *
+     * 内部缓冲在多帧间复用，稳定运行后不再分配内存。
+     *
+     * 用法示例：
+     *     CollisionPipeline pipeline;
+     *     const auto &contacts = pipeline.Run(shapes, proxies.data(), proxies.size(), &executor);
+     *     const auto &stats = pipeline.GetStats();
+     */
+    class CollisionPipeline
+    {
+        struct ProxyBounds
+        {
+            Vector3f min_point;
+            Vector3f max_point;
+        };
+
+        struct CellEntry
+        {
+            uint64_t cell;
+            uint32_t proxy;
+        };
+
+        float cell_size;                                ///<设定的单元尺寸，0 表示自动
+        float used_cell_size=0.0f;                      ///<上次运行实际使用的单元尺寸
+        uint32_t max_cells_per_proxy;                   ///<单个代理最多覆盖的单元数量，超过则视为大物体
+        Vector3f grid_origin{0,0,0};
+
+        std::vector<ProxyBounds> bounds;
+        std::vector<uint8_t> proxy_state;
+        std::vector<uint32_t> oversized;
+        std::vector<uint32_t> entry_offset;
+        std::vector<CellEntry> entries;
+        std::vector<uint32_t> cell_begin;
+
+        std::vector<std::vector<ProxyPair>> chunk_pairs;
+        std::vector<uint64_t> chunk_tests;
+        std::vector<ProxyPair> proxy_pairs;
+
+        CollisionDispatcher dispatcher;
+        std::vector<CollisionPair> narrow_pairs;
+        std::vector<CollisionInfo> narrow_results;
+        std::vector<uint32_t> chunk_offset;
+        std::vector<CollisionContact> contacts;
+
+        CollisionPipelineStats stats;
+
+    private:
+
+        void ComputeBounds(const CollisionShapeSet &shapes,const ShapeRef *proxies,size_t count,IParallelExecutor *executor);
+        void BuildGrid(size_t count,IParallelExecutor *executor);
+        void GeneratePairs(size_t count,IParallelExecutor *executor);
+        void MergePairs(size_t chunk_count,IParallelExecutor *executor);
+
+        uint64_t GetCellKey(const Vector3f &point)const;
+
+    public:
+
+        /**
+         * @param cell 网格单元尺寸，0 表示按代理平均尺寸自动选择
+         * @param max_cells 单个代理最多覆盖的单元数量
+         */
+        explicit CollisionPipeline(float cell=0.0f,uint32_t max_cells=64)
+            :cell_size(cell),max_cells_per_proxy(max_cells){}
+
+        void SetCellSize(float cell){cell_size=cell;}
+        float GetCellSize()const{return cell_size;}
+        float GetUsedCellSize()const{return used_cell_size;}                ///<上次运行实际使用的单元尺寸
+
+        /**
+         * 仅执行粗检测
+         * @param proxies 代理数组，每个代理引用 shapes 中的一个形状；无效引用被忽略
+         * @return 通过 AABB 测试的代理对
+         */
+        const std::vector<ProxyPair> &FindPairs(const CollisionShapeSet &shapes,const ShapeRef *proxies,size_t count,IParallelExecutor *executor=nullptr);
+
+        /**
+         * 执行完整流水线
+         * @return 确认相交的接触
+         */
+        const std::vector<CollisionContact> &Run(const CollisionShapeSet &shapes,const ShapeRef *proxies,size_t count,IParallelExecutor *executor=nullptr);
+
+        const std::vector<ProxyPair> &GetPairs()const{return proxy_pairs;}
+        const std::vector<CollisionContact> &GetContacts()const{return contacts;}
+        const CollisionPipelineStats &GetStats()const{return stats;}
+    };//class CollisionPipeline
+}//namespace hgl::math
@@ -0,0 +1,213 @@
+﻿/**
+ * ContactManifold.h - 多点接触流形
+ *
+ * CollisionInfo 只给出一个接触点；刚体堆叠在单点接触下会抖动，
+ * 需要更多求解器迭代才能稳定。接触流形为每对物体提供最多 4 个接触点：
+ * - OBB-OBB：SAT 求最小穿透轴，参考面/入射面 Sutherland-Hodgman 裁剪
+ * - 胶囊体-OBB：胶囊轴线段对盒面裁剪，平躺时得到两个接触点
+ * - 任意凸体：GJK/EPA 求法线，再沿法线采样支撑特征（面/边）相互裁剪
+ *
+ * ContactManifoldCache 按物体对 ID 持久保存流形，跨帧匹配接触点，
+ * 继承累积冲量（供求解器热启动）和 GJK 单纯形缓存。
+ */
+#pragma once
+
+#include<hgl/math/Vector.h>
+#include<hgl/math/geometry/OBB.h>
+#include<hgl/math/geometry/primitives/Capsule.h>
+#include<hgl/math/geometry/queries/GJK.h>
+#include<unordered_map>
+#include<cstdint>
+
+namespace hgl::math
+{
+    /**
+     * 单个接触点
+     */
+    struct ContactPoint
+    {
+        Vector3f point_a{0,0,0};        ///<A 表面上的接触点
+        Vector3f point_b{0,0,0};        ///<B 表面上的接触点
+        float penetration=0.0f;         ///<沿法线的穿透深度（>=0）
+        uint32_t feature_id=0;          ///<生成该点的几何特征编号（用于跨帧匹配）
+
+        float normal_impulse=0.0f;      ///<累积法向冲量（由求解器写入，缓存跨帧继承）
+        float tangent_impulse[2]={0,0}; ///<累积切向冲量
+        uint32_t lifetime=0;            ///<该点连续存在的帧数
+
+        Vector3f GetPosition()const{return (point_a+point_b)*0.5f;}     ///<取两表面接触点中点
+    };
+
+    /**
+     * 接触流形（一对物体的全部接触点，共用一个法线）
+     */
+    struct ContactManifold
+    {
+        static constexpr uint32_t MAX_POINTS=4;
+
+        ContactPoint points[MAX_POINTS];
+        uint32_t count=0;
+        Vector3f normal{0,1,0};         ///<接触法线，从 A 指向 B
+
+        void Clear(){count=0;}
+        bool IsEmpty()const{return count==0;}
+
+        /**
+         * 交换 A/B（法线取反，接触点对调）
+         */
+        void Flip()
+        {
+            normal=-normal;
+
+            for(uint32_t i=0;i<count;i++)
+                std::swap(points[i].point_a,points[i].point_b);
+        }
+
+        /**
+         * 获取最大穿透深度
+         */
+        float GetMaxPenetration()const
+        {
+            float result=0.0f;
+
+            for(uint32_t i=0;i<count;i++)
+                if(points[i].penetration>result)
+                    result=points[i].penetration;
+
+            return result;
+        }
+    };
+
+    /**
+     * ContactManifoldQuery - 接触流形生成
+     *
+     * 所有方法仅在两物体相交时生成接触点并返回 true。
+     *
+     * 用法示例：
+     *     ContactManifold manifold;
+     *     if(ContactManifoldQuery::Generate(box_a, box_b, manifold))
+     *         solver.AddContacts(manifold);
+     */
+    class ContactManifoldQuery
+    {
+    public:
+
+        static constexpr float LINEAR_SLOP=1e-3f;       ///<判定同一接触面的距离容差
+
+        /**
+         * OBB-OBB 接触流形（参考面/入射面裁剪，边-边接触为单点）
+         */
+        static bool Generate(const OBB &a,const OBB &b,ContactManifold &manifold);
+
+        /**
+         * 胶囊体-OBB 接触流形（最多 2 点）
+         */
+        static bool Generate(const Capsule &capsule,const OBB &box,ContactManifold &manifold);
+        static bool Generate(const OBB &box,const Capsule &capsule,ContactManifold &manifold)
+        {
+            if(!Generate(capsule,box,manifold))
+                return false;
+
+            manifold.Flip();
+            return true;
+        }
+
+        /**
+         * 任意凸体接触流形（GJK/EPA 求法线后对支撑特征裁剪）
+         * @param cache GJK 热启动缓存，可为 nullptr
+         */
+        static bool GenerateConvex(const ConvexSupport &a,const ConvexSupport &b,ContactManifold &manifold,GJKCache *cache=nullptr);
+
+        template<typename A,typename B>
+        static bool Generate(const A &a,const B &b,ContactManifold &manifold,GJKCache *cache=nullptr)
+        {
+            return GenerateConvex(MakeConvexSupport(a),MakeConvexSupport(b),manifold,cache);
+        }
+
+        /**
+         * 将任意数量的候选点缩减为最多 4 个（保留最深点并使覆盖面积最大）
+         * @return 保留的点数
+         */
+        static uint32_t ReduceContacts(const ContactPoint *candidates,uint32_t count,const Vector3f &normal,ContactPoint *out);
+    };//class ContactManifoldQuery
+
+    /**
+     * 持久接触流形缓存
+     *
+     * 每帧流程：
+     *     cache.NewFrame();
+     *     for(每个潜在碰撞对)
+     *     {
+     *         uint64_t id=ContactManifoldCache::MakePairID(a.id,b.id);
+     *         ContactManifold fresh;
+     *         if(ContactManifoldQuery::Generate(a.shape,b.shape,fresh,cache.GetGJKCache(id)))
+     *             solver.Add(cache.Update(id,fresh));      // 返回继承了冲量的流形
+     *     }
+     *     cache.RemoveStale();
+     *
+     * @note 物体对 ID 与 A/B 顺序无关，调用者应保证同一对的 A/B 顺序跨帧一致
+     */
+    class ContactManifoldCache
+    {
+        struct Entry
+        {
+            ContactManifold manifold;
+            GJKCache gjk;
+            uint64_t last_frame=0;          ///<最近一次访问（含仅查询 GJK 缓存）的帧
+            uint64_t manifold_frame=0;      ///<最近一次生成接触的帧
+        };
+
+        std::unordered_map<uint64_t,Entry> entries;
+        uint64_t frame=0;
+
+        float match_distance;           ///<新旧接触点匹配的最大距离
+        float normal_tolerance;         ///<法线夹角余弦低于此值时不继承冲量
+
+    public:
+
+        explicit ContactManifoldCache(float match_dist=0.02f,float normal_cos=0.95f)
+            :match_distance(match_dist),normal_tolerance(normal_cos){}
+
+        /**
+         * 由两个物体 ID 生成与顺序无关的物体对 ID
+         */
+        static uint64_t MakePairID(uint32_t a,uint32_t b)
+        {
+            if(a>b)std::swap(a,b);
+
+            return (uint64_t(b)<<32)|uint64_t(a);
+        }
+
+        void NewFrame(){++frame;}
+        uint64_t GetFrame()const{return frame;}
+
+        /**
+         * 用本帧生成的流形更新缓存，匹配的接触点继承累积冲量与存活帧数
+         * @return 缓存中的流形（求解器应写回其中的冲量）
+         */
+        ContactManifold &Update(uint64_t pair_id,const ContactManifold &fresh);
+
+        /**
+         * 获取物体对的 GJK 热启动缓存（不存在则创建）
+         */
+        GJKCache *GetGJKCache(uint64_t pair_id);
+
+        /**
+         * 查找物体对本帧的流形
+         * @return 不存在或本帧未接触时返回 nullptr
+         */
+        ContactManifold *Find(uint64_t pair_id);
+        const ContactManifold *Find(uint64_t pair_id)const;
+
+        bool Remove(uint64_t pair_id){return entries.erase(pair_id)>0;}
+
+        /**
+         * 移除连续 max_age 帧未访问（Update/GetGJKCache）的物体对，应在每帧更新结束后调用
+         * @return 移除数量
+         */
+        uint32_t RemoveStale(uint32_t max_age=1);
+
+        size_t GetCount()const{return entries.size();}
+        void Clear(){entries.clear();}
+    };//class ContactManifoldCache
+}//namespace hgl::math
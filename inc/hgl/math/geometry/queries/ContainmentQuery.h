@@ -7,6 +7,11 @@
  * - 视锥体裁剪
  * - 区域测试
  * - 包围体优化
+ *
+ * 批量分类（Classify）：
+ * 将 N 个点/球体/AABB 相对一个容器分为内部/相交/外部三种状态，写入 2 位打包数组，
+ * 用于触发体积、区域流式加载等每帧大量对象对大量区域的判定。
+ * 逐对象的判定不含分支，按块在 SoA 数据上矢量化，可选交给并行执行器。
  */
 #pragma once
 
@@ -18,6 +23,12 @@
 
 namespace hgl::math
 {
+    class IParallelExecutor;
+    struct BatchPointSOA;
+    struct BatchSphereSOA;
+    struct BatchAABBSOA;
+    struct BatchContainmentResults;
+
     /**
      * ContainmentQuery - 静态包含性测试方法
      *
@@ -134,6 +145,41 @@ namespace hgl::math
          * @return 若完全包含返回true
          */
         static bool Contains(const OBB& container, const OBB& box);
+
+        //=============================================================================
+        // 批量分类（N个对象 vs 一个容器）
+        //=============================================================================
+
+        // 边界上的对象视为 Inside（与 Contains 一致），仅接触容器表面的对象视为 Intersecting。
+        // 点只有 Inside/Outside 两种状态。
+        // out 会被重设为对象数量，executor 为 nullptr 时在当前线程执行。
+
+        static void Classify(const AABB& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+        static void Classify(const AABB& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+        static void Classify(const AABB& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+
+        static void Classify(const OBB& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+        static void Classify(const OBB& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+
+        /**
+         * OBB 容器对 AABB：完整 15 轴分离轴测试，结果精确
+         */
+        static void Classify(const OBB& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+
+        static void Classify(const Sphere& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+        static void Classify(const Sphere& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+        static void Classify(const Sphere& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+
+        static void Classify(const Capsule& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+        static void Classify(const Capsule& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
+
+        /**
+         * 胶囊体容器对 AABB
+         *
+         * 线段到盒子的距离用固定次数的黄金分割搜索求下界，
+         * 距胶囊体表面不足约 1e-5 倍轴长的外部盒子会被判为 Intersecting（保守）。
+         */
+        static void Classify(const Capsule& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor = nullptr);
     };
 
 }//namespace hgl::math
@@ -17,6 +17,21 @@
 
 namespace hgl::math
 {
+    class OBB;
+    class Cone;
+    class Torus;
+    class IParallelExecutor;
+
+    struct BatchPointSOA;
+    struct BatchSphereSOA;
+    struct BatchCapsuleSOA;
+    struct BatchAABBSOA;
+    struct BatchOBBSOA;
+    struct BatchCylinderSOA;
+    struct BatchConeSOA;
+    struct BatchTorusSOA;
+    struct BatchTriangleSOA;
+
     /**
      * 最近点结果结构体
      *
@@ -75,10 +90,54 @@ namespace hgl::math
         static float Distance(const Vector3f& point, const AABB& box);
 
         /**
-         * 点到圆柱体表面的距离
+         * 点到圆柱体的距离（点在内部时为0）
          */
         static float Distance(const Vector3f& point, const Cylinder& cylinder);
 
+        /**
+         * 点到OBB、圆锥体、环面的距离（点在内部时为0）
+         */
+        static float Distance(const Vector3f& point, const OBB& box);
+        static float Distance(const Vector3f& point, const Cone& cone);
+        static float Distance(const Vector3f& point, const Torus& torus);
+
+        /**
+         * 点到三角形的距离
+         */
+        static float Distance(const Vector3f& point, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2);
+
+        //=============================================================================
+        // 点在几何体上的最近点
+        //
+        // 实心几何体上距离查询点最近的点，点在内部时返回点本身。
+        // （几何体类自身的 ClosestPoint 返回表面上的点，内部点也会被推到表面）
+        //=============================================================================
+
+        static Vector3f ClosestPoint(const Vector3f& point, const Sphere& sphere);
+        static Vector3f ClosestPoint(const Vector3f& point, const Capsule& capsule);
+        static Vector3f ClosestPoint(const Vector3f& point, const AABB& box);
+        static Vector3f ClosestPoint(const Vector3f& point, const OBB& box);
+        static Vector3f ClosestPoint(const Vector3f& point, const Cylinder& cylinder);
+        static Vector3f ClosestPoint(const Vector3f& point, const Cone& cone);
+        static Vector3f ClosestPoint(const Vector3f& point, const Torus& torus);
+
+        /**
+         * 三角形上的最近点（按 Voronoi 区域划分，Ericson《Real-Time Collision Detection》5.1.5）
+         */
+        static Vector3f ClosestPoint(const Vector3f& point, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2);
+
+        //=============================================================================
+        // 点到实心几何体的有符号距离（外部为正，内部为负，绝对值为到表面的距离）
+        //=============================================================================
+
+        static float SignedDistance(const Vector3f& point, const Sphere& sphere);
+        static float SignedDistance(const Vector3f& point, const Capsule& capsule);
+        static float SignedDistance(const Vector3f& point, const AABB& box);
+        static float SignedDistance(const Vector3f& point, const OBB& box);
+        static float SignedDistance(const Vector3f& point, const Cylinder& cylinder);
+        static float SignedDistance(const Vector3f& point, const Cone& cone);
+        static float SignedDistance(const Vector3f& point, const Torus& torus);
+
         //=============================================================================
         // 几何体间距离
         //=============================================================================
@@ -108,6 +167,16 @@ namespace hgl::math
          */
         static float Distance(const Cylinder& a, const Cylinder& b);
 
+        /**
+         * 两AABB间距离（相交为0）
+         */
+        static float Distance(const AABB& a, const AABB& b);
+
+        /**
+         * 两OBB间距离（相交为0）
+         */
+        static float Distance(const OBB& a, const OBB& b);
+
         //=============================================================================
         // 最近点对
         //=============================================================================
@@ -129,6 +198,61 @@ namespace hgl::math
             return result;
         }
 
+        /**
+         * 查找两OBB间最近点对
+         *
+         * 分离的凸多面体最近点必在顶点-面或棱-棱之间：取双方 8 个顶点到对方盒子的
+         * 最近点与 12x12 对棱的最近点中的最小者。
+         * 相交时距离为0，两点均为 A 上距 B 中心最近的点。
+         */
+        static ClosestPointsResult ClosestPoints(const OBB& a, const OBB& b);
+
+        //=============================================================================
+        // 批量点到几何体距离（DistanceBatch.cpp）
+        //
+        // 距离均为到实心几何体的距离，点在内部时为 0；三角形为到三角形面片的距离。
+        // 每个点/每个几何体的计算无分支，可被编译器向量化。
+        //=============================================================================
+
+        /**
+         * N 个点到同一几何体的距离
+         * @param points 查询点
+         * @param out 输出距离，需至少容纳 points.count 个
+         * @param executor 并行执行器，为 nullptr 时在当前线程执行
+         */
+        static void Distance(const BatchPointSOA& points, const Sphere& sphere, float* out, IParallelExecutor* executor = nullptr);
+        static void Distance(const BatchPointSOA& points, const Capsule& capsule, float* out, IParallelExecutor* executor = nullptr);
+        static void Distance(const BatchPointSOA& points, const AABB& box, float* out, IParallelExecutor* executor = nullptr);
+        static void Distance(const BatchPointSOA& points, const OBB& box, float* out, IParallelExecutor* executor = nullptr);
+        static void Distance(const BatchPointSOA& points, const Cylinder& cylinder, float* out, IParallelExecutor* executor = nullptr);
+        static void Distance(const BatchPointSOA& points, const Cone& cone, float* out, IParallelExecutor* executor = nullptr);
+        static void Distance(const BatchPointSOA& points, const Torus& torus, float* out, IParallelExecutor* executor = nullptr);
+        static void Distance(const BatchPointSOA& points, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, float* out, IParallelExecutor* executor = nullptr);
+
+        /**
+         * 单个点到 N 个几何体的最小距离
+         * @param distance 输出最小距离
+         * @param nearest 输出最近几何体下标（可为 nullptr）；点位于多个几何体内部时为其中下标最小者
+         * @return 几何体集合为空时返回 false
+         */
+        static bool MinDistance(const Vector3f& point, const BatchSphereSOA& spheres, float& distance, size_t* nearest = nullptr);
+        static bool MinDistance(const Vector3f& point, const BatchCapsuleSOA& capsules, float& distance, size_t* nearest = nullptr);
+        static bool MinDistance(const Vector3f& point, const BatchAABBSOA& boxes, float& distance, size_t* nearest = nullptr);
+        static bool MinDistance(const Vector3f& point, const BatchOBBSOA& boxes, float& distance, size_t* nearest = nullptr);
+        static bool MinDistance(const Vector3f& point, const BatchCylinderSOA& cylinders, float& distance, size_t* nearest = nullptr);
+        static bool MinDistance(const Vector3f& point, const BatchConeSOA& cones, float& distance, size_t* nearest = nullptr);
+        static bool MinDistance(const Vector3f& point, const BatchTorusSOA& tori, float& distance, size_t* nearest = nullptr);
+        static bool MinDistance(const Vector3f& point, const BatchTriangleSOA& triangles, float& distance, size_t* nearest = nullptr);
+
+        /**
+         * N 个点在同一几何体上的最近点
+         * @param out 输出最近点（调整为 points.count 个）
+         */
+        static void ClosestPoint(const BatchPointSOA& points, const OBB& box, BatchPointSOA& out, IParallelExecutor* executor = nullptr);
+        static void ClosestPoint(const BatchPointSOA& points, const Cone& cone, BatchPointSOA& out, IParallelExecutor* executor = nullptr);
+        static void ClosestPoint(const BatchPointSOA& points, const Torus& torus, BatchPointSOA& out, IParallelExecutor* executor = nullptr);
+        static void ClosestPoint(const BatchPointSOA& points, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, BatchPointSOA& out, IParallelExecutor* executor = nullptr);
+
         //=============================================================================
         // 辅助函数
         //=============================================================================
@@ -159,6 +283,15 @@ namespace hgl::math
         static ClosestPointsResult ClosestPointsOnLineSegments(
             const Vector3f& seg1Start, const Vector3f& seg1End,
             const Vector3f& seg2Start, const Vector3f& seg2End);
+
+        /**
+         * 计算线段到三角形的距离平方
+         *
+         * 线段穿过三角形时返回 0；否则取两端点到三角形、线段到三条边的最小值。
+         */
+        static float SegmentTriangleDistanceSquared(
+            const Vector3f& segStart, const Vector3f& segEnd,
+            const Vector3f& v0, const Vector3f& v1, const Vector3f& v2);
     };
 
 }//namespace hgl::math
@@ -0,0 +1,332 @@
+﻿/**
+ * GJK.h - 基于支撑函数的通用凸体碰撞检测 (GJK + EPA)
+ *
+ * GJK(Gilbert-Johnson-Keerthi) 在 Minkowski 差 A-B 上迭代逼近原点：
+ * - 不相交时给出最近点与距离
+ * - 相交时交给 EPA(Expanding Polytope Algorithm) 求穿透深度与法线
+ *
+ * 任意凸体只需提供支撑函数 GetSupportPoint(shape,dir)，即可与其它凸体组合检测。
+ * 环面不是凸体，其支撑函数描述的是环面的凸包。
+ *
+ * 热启动：
+ * 传入 GJKCache 时，会用上一帧的单纯形（以搜索方向保存）重建初始单纯形，
+ * 静止或缓慢运动的接触通常 1~3 次迭代即可收敛。
+ */
+#pragma once
+
+#include<hgl/math/Vector.h>
+#include<hgl/math/geometry/AABB.h>
+#include<hgl/math/geometry/OBB.h>
+#include<hgl/math/geometry/Triangle.h>
+#include<hgl/math/geometry/LineSegment.h>
+#include<hgl/math/geometry/primitives/Sphere.h>
+#include<hgl/math/geometry/primitives/Capsule.h>
+#include<hgl/math/geometry/primitives/Cylinder.h>
+#include<hgl/math/geometry/primitives/Cone.h>
+#include<hgl/math/geometry/primitives/Torus.h>
+#include<hgl/math/geometry/primitives/ConvexHull.h>
+#include<hgl/math/geometry/queries/CollisionDetector.h>
+#include<cmath>
+
+namespace hgl::math
+{
+    //=============================================================================
+    // 支撑函数：返回几何体在 direction 方向上投影最大的点（direction 无需归一化）
+    //=============================================================================
+
+    namespace gjk_detail
+    {
+        /**
+         * 方向在垂直于 axis 平面上的归一化分量，分量过小时返回零向量
+         */
+        inline Vector3f PerpendicularDirection(const Vector3f &direction,const Vector3f &axis)
+        {
+            const Vector3f perp=direction-axis*Dot(direction,axis);
+            const float len_sq=Dot(perp,perp);
+
+            if(len_sq<1e-12f)
+                return Vector3f(0,0,0);
+
+            return perp/std::sqrt(len_sq);
+        }
+
+        inline Vector3f SafeNormalize(const Vector3f &direction)
+        {
+            const float len_sq=Dot(direction,direction);
+
+            if(len_sq<1e-12f)
+                return Vector3f(1,0,0);
+
+            return direction/std::sqrt(len_sq);
+        }
+    }//namespace gjk_detail
+
+    inline Vector3f GetSupportPoint(const Vector3f &point,const Vector3f &)
+    {
+        return point;
+    }
+
+    inline Vector3f GetSupportPoint(const LineSegment &segment,const Vector3f &direction)
+    {
+        return (Dot(segment.GetEnd()-segment.GetStart(),direction)>=0.0f)?segment.GetEnd():segment.GetStart();
+    }
+
+    inline Vector3f GetSupportPoint(const Sphere &sphere,const Vector3f &direction)
+    {
+        return sphere.GetCenter()+gjk_detail::SafeNormalize(direction)*sphere.GetRadius();
+    }
+
+    inline Vector3f GetSupportPoint(const EllipseSphere &ellipse,const Vector3f &direction)
+    {
+        // Support of an axis aligned ellipsoid: c + R²d / |Rd|
+        const Vector3f &r=ellipse.GetRadius();
+        const Vector3f rd=r*direction;
+        const float len=Length(rd);
+
+        if(len<1e-6f)
+            return ellipse.GetCenter()+Vector3f(r.x,0,0);
+
+        return ellipse.GetCenter()+(r*rd)/len;
+    }
+
+    inline Vector3f GetSupportPoint(const Capsule &capsule,const Vector3f &direction)
+    {
+        const Vector3f &end_point=(Dot(capsule.GetEnd()-capsule.GetStart(),direction)>=0.0f)?capsule.GetEnd():capsule.GetStart();
+
+        return end_point+gjk_detail::SafeNormalize(direction)*capsule.GetRadius();
+    }
+
+    inline Vector3f GetSupportPoint(const Cylinder &cylinder,const Vector3f &direction)
+    {
+        const Vector3f &axis=cylinder.GetAxis();
+        const float half_height=cylinder.GetHeight()*0.5f;
+
+        const Vector3f cap=cylinder.GetCenter()+axis*((Dot(direction,axis)>=0.0f)?half_height:-half_height);
+
+        return cap+gjk_detail::PerpendicularDirection(direction,axis)*cylinder.GetRadius();
+    }
+
+    inline Vector3f GetSupportPoint(const Cone &cone,const Vector3f &direction)
+    {
+        const Vector3f rim=cone.GetBaseCenter()+gjk_detail::PerpendicularDirection(direction,cone.GetAxis())*cone.GetBaseRadius();
+
+        return (Dot(cone.GetApex(),direction)>Dot(rim,direction))?cone.GetApex():rim;
+    }
+
+    inline Vector3f GetSupportPoint(const Torus &torus,const Vector3f &direction)
+    {
+        // Convex hull of the torus: tube circle center furthest along direction, plus tube radius
+        const Vector3f ring=gjk_detail::PerpendicularDirection(direction,torus.GetAxis());
+
+        return torus.GetCenter()+ring*torus.GetMajorRadius()+gjk_detail::SafeNormalize(direction)*torus.GetMinorRadius();
+    }
+
+    inline Vector3f GetSupportPoint(const AABB &box,const Vector3f &direction)
+    {
+        const Vector3f &min_point=box.GetMin();
+        const Vector3f &max_point=box.GetMax();
+
+        return Vector3f(direction.x>=0.0f?max_point.x:min_point.x,
+                        direction.y>=0.0f?max_point.y:min_point.y,
+                        direction.z>=0.0f?max_point.z:min_point.z);
+    }
+
+    inline Vector3f GetSupportPoint(const OBB &box,const Vector3f &direction)
+    {
+        const Vector3f &h=box.GetHalfExtend();
+        Vector3f result=box.GetCenter();
+
+        result+=box.GetAxis(0)*(Dot(direction,box.GetAxis(0))>=0.0f?h.x:-h.x);
+        result+=box.GetAxis(1)*(Dot(direction,box.GetAxis(1))>=0.0f?h.y:-h.y);
+        result+=box.GetAxis(2)*(Dot(direction,box.GetAxis(2))>=0.0f?h.z:-h.z);
+
+        return result;
+    }
+
+    inline Vector3f GetSupportPoint(const Triangle3f &tri,const Vector3f &direction)
+    {
+        const float d0=Dot(tri[0],direction);
+        const float d1=Dot(tri[1],direction);
+        const float d2=Dot(tri[2],direction);
+
+        if(d0>=d1&&d0>=d2)return tri[0];
+        return (d1>=d2)?tri[1]:tri[2];
+    }
+
+    inline Vector3f GetSupportPoint(const ConvexHull &hull,const Vector3f &direction)
+    {
+        return hull.GetSupportPoint(direction);
+    }
+
+    /**
+     * 类型擦除的凸体支撑函数引用（不拥有几何体，生命周期由调用者保证）
+     */
+    struct ConvexSupport
+    {
+        const void *shape=nullptr;
+        Vector3f (*support)(const void *shape,const Vector3f &direction)=nullptr;
+        Vector3f center{0,0,0};        ///<内部点，用于初始搜索方向和退化情况
+
+        Vector3f operator()(const Vector3f &direction)const{return support(shape,direction);}
+    };
+
+    /**
+     * 从任意提供了 GetSupportPoint 重载的几何体创建支撑函数引用
+     */
+    template<typename T>
+    ConvexSupport MakeConvexSupport(const T &shape)
+    {
+        ConvexSupport cs;
+
+        cs.shape=&shape;
+        cs.support=[](const void *s,const Vector3f &d){return GetSupportPoint(*static_cast<const T *>(s),d);};
+
+        if constexpr(requires{shape.GetCenter();})
+            cs.center=shape.GetCenter();
+        else
+            cs.center=(GetSupportPoint(shape,Vector3f(1,0,0))+GetSupportPoint(shape,Vector3f(-1,0,0)))*0.5f;
+
+        return cs;
+    }
+
+    /**
+     * GJK 单纯形顶点
+     */
+    struct GJKVertex
+    {
+        Vector3f w;             ///<Minkowski 差上的点 (a-b)
+        Vector3f a;             ///<A 上的支撑点
+        Vector3f b;             ///<B 上的支撑点
+        Vector3f direction;     ///<求该顶点时的搜索方向（热启动时据此重新求支撑点）
+    };
+
+    /**
+     * GJK 热启动缓存（每个物体对保存一份，跨帧复用）
+     */
+    struct GJKCache
+    {
+        Vector3f directions[4];     ///<上次结束时单纯形各顶点的搜索方向
+        uint32_t count=0;           ///<有效方向数量，0 表示冷启动
+        uint32_t last_iterations=0; ///<上次 GJK 迭代次数（统计用）
+
+        void Reset(){count=0;last_iterations=0;}
+    };
+
+    /**
+     * GJK 查询结果
+     */
+    struct GJKResult
+    {
+        bool intersects=false;          ///<是否相交（含接触）
+        float distance=0.0f;            ///<不相交时的最近距离
+        Vector3f point_a{0,0,0};        ///<A 上的最近点（不相交时有效）
+        Vector3f point_b{0,0,0};        ///<B 上的最近点（不相交时有效）
+        uint32_t iterations=0;          ///<迭代次数
+
+        GJKVertex simplex[4];           ///<结束时的单纯形（相交时供 EPA 使用）
+        uint32_t simplex_count=0;
+    };
+
+    /**
+     * GJK/EPA 通用凸体碰撞检测
+     *
+     * 用法示例：
+     *     Cone cone(...);
+     *     Capsule capsule(...);
+     *     GJKCache cache;                      // 每个物体对一份，跨帧保留
+     *     CollisionInfo info = GJK::TestCollision(cone, capsule, &cache);
+     */
+    class GJK
+    {
+    public:
+
+        static constexpr uint32_t MAX_ITERATIONS    =64;
+        static constexpr uint32_t EPA_MAX_ITERATIONS=64;
+
+        //=============================================================================
+        // 类型擦除接口
+        //=============================================================================
+
+        /**
+         * 仅判断是否相交（找到分离轴即提前退出）
+         * @param cache 热启动缓存，可为 nullptr
+         */
+        static bool Intersects(const ConvexSupport &a,const ConvexSupport &b,GJKCache *cache=nullptr);
+
+        /**
+         * 计算最近距离或判断相交
+         * @param result 输出结果
+         * @param cache 热启动缓存，可为 nullptr
+         * @return 是否相交
+         */
+        static bool Query(const ConvexSupport &a,const ConvexSupport &b,GJKResult &result,GJKCache *cache=nullptr);
+
+        /**
+         * EPA：从 GJK 相交结果求穿透深度与法线
+         * @param gjk 相交的 GJK 结果（使用其单纯形作为初始多面体）
+         * @param info 输出：normal 为 A 指向 B 的方向，point 为 A 上的接触点
+         * @return 是否成功（退化情况下返回 false，info 给出近似值）
+         */
+        static bool EPA(const ConvexSupport &a,const ConvexSupport &b,const GJKResult &gjk,CollisionInfo &info);
+
+        /**
+         * 完整碰撞信息（不相交：distance/point/normal；相交：EPA 穿透信息）
+         * @note 与 CollisionDetector 约定一致：normal 从 A 指向 B，point 在 A 上，相交时 distance=-penetration
+         */
+        static CollisionInfo TestCollision(const ConvexSupport &a,const ConvexSupport &b,GJKCache *cache=nullptr);
+
+        //=============================================================================
+        // 模板便捷接口
+        //=============================================================================
+
+        template<typename A,typename B>
+        static bool Intersects(const A &a,const B &b,GJKCache *cache=nullptr)
+        {
+            return Intersects(MakeConvexSupport(a),MakeConvexSupport(b),cache);
+        }
+
+        template<typename A,typename B>
+        static CollisionInfo TestCollision(const A &a,const B &b,GJKCache *cache=nullptr)
+        {
+            return TestCollision(MakeConvexSupport(a),MakeConvexSupport(b),cache);
+        }
+
+        /**
+         * 计算两个凸体间的最近距离（相交时返回 0）
+         */
+        template<typename A,typename B>
+        static float Distance(const A &a,const B &b,Vector3f *point_a=nullptr,Vector3f *point_b=nullptr,GJKCache *cache=nullptr)
+        {
+            GJKResult result;
+
+            if(Query(MakeConvexSupport(a),MakeConvexSupport(b),result,cache))
+                return 0.0f;
+
+            if(point_a)*point_a=result.point_a;
+            if(point_b)*point_b=result.point_b;
+
+            return result.distance;
+        }
+    };//class GJK
+
+    //=============================================================================
+    // CollisionDetector 中基于 GJK 的模板实现
+    //=============================================================================
+
+    template<typename T>
+    bool CollisionDetector::Intersects(const ConvexHull& hull, const T& shape)
+    {
+        return GJK::Intersects(hull, shape);
+    }
+
+    inline bool CollisionDetector::Intersects(const ConvexHull& a, const ConvexHull& b)
+    {
+        return GJK::Intersects(a, b);
+    }
+
+    template<typename T1, typename T2>
+    CollisionInfo CollisionDetector::TestConvexCollision(const T1& a, const T2& b)
+    {
+        return GJK::TestCollision(a, b);
+    }
+}//namespace hgl::math
@@ -12,6 +12,7 @@
 
 #include<hgl/math/Vector.h>
 #include<hgl/math/geometry/Ray.h>
+#include<hgl/math/geometry/PreparedRay.h>
 #include<hgl/math/geometry/AABB.h>
 #include<hgl/math/geometry/OBB.h>
 #include<hgl/math/geometry/Plane.h>
@@ -23,6 +24,9 @@
 
 namespace hgl::math
 {
+    struct BatchTriangleSOA;
+    struct TrianglePacket8;
+
     /**
      * 射线命中信息
      *
@@ -45,6 +49,21 @@ namespace hgl::math
         }
     };
 
+    /**
+     * 射线-三角形批量测试的最近命中
+     */
+    struct RayTriangleHit
+    {
+        float distance;          // 沿射线的距离（t参数）
+        uint32_t index;          // 命中三角形在批量数据/包中的序号
+        float u, v;              // v1、v2 的重心坐标
+
+        RayTriangleHit()
+            : distance(FLT_MAX), index(UINT32_MAX), u(0), v(0)
+        {
+        }
+    };
+
     /**
      * RaycastQuery - 静态射线相交方法
      *
@@ -134,6 +153,7 @@ namespace hgl::math
 
         /**
          * 测试射线-环面相交
+         * 先用外接球剔除并把起点推进到球面，再精确求解四次方程取最近的非负根
          */
         static bool Intersects(const Ray& ray, const Torus& torus, float& t);
         static bool Intersects(const Ray& ray, const Torus& torus);
@@ -157,6 +177,15 @@ namespace hgl::math
         static bool Intersects(const Ray& ray, const OBB& box);
         static RaycastHit Test(const Ray& ray, const OBB& box);
 
+        /**
+         * 使用预处理射线测试射线-AABB/OBB相交
+         * 同一射线测试大量盒子（如遍历 BVH）时先构造一次 PreparedRay
+         */
+        static bool Intersects(const PreparedRay& ray, const AABB& box, float& t);
+        static bool Intersects(const PreparedRay& ray, const AABB& box);
+        static bool Intersects(const PreparedRay& ray, const OBB& box, float& t);
+        static bool Intersects(const PreparedRay& ray, const OBB& box);
+
         /**
          * 测试射线-平面相交
          */
@@ -191,5 +220,48 @@ namespace hgl::math
                                        const Vector3f& v1,
                                        const Vector3f& v2,
                                        float& t);
+
+        /**
+         * 水密射线-三角形相交测试（Woop/Benthin/Wald 2013，双面）
+         *
+         * 用 PreparedRay 的剪切常量把三角形变换到射线空间后做二维边函数测试，
+         * 共享边上的点不会同时被相邻两个三角形漏掉；边函数为 0 时以 double 重算。
+         *
+         * @param u, v 输出：v1、v2 的重心坐标（与 Möller-Trumbore 版本含义相同）
+         */
+        static bool IntersectsTriangle(const PreparedRay& ray,
+                                       const Vector3f& v0,
+                                       const Vector3f& v1,
+                                       const Vector3f& v2,
+                                       float& t, float& u, float& v);
+
+        static bool IntersectsTriangle(const PreparedRay& ray,
+                                       const Vector3f& v0,
+                                       const Vector3f& v1,
+                                       const Vector3f& v2,
+                                       float& t);
+
+        //=============================================================================
+        // 射线-三角形批量相交（水密，SOA）
+        //=============================================================================
+
+        /**
+         * 一条射线对 8 个三角形的包求最近命中（用于 BVH 叶节点）
+         *
+         * 边函数与距离用 AVX 一次计算 8 个槽位（无 AVX 时逐槽位计算），结果与单个三角形的水密测试一致。
+         *
+         * @param maxDistance 只接受 t<maxDistance 的命中
+         * @param hit 找到更近的命中时写入，index 为包内槽位
+         * @return 是否找到命中
+         */
+        static bool IntersectsTriangles(const PreparedRay& ray, const TrianglePacket8& packet,
+                                        float maxDistance, RayTriangleHit& hit);
+
+        /**
+         * 一条射线对 SOA 三角形数组求最近命中（每 8 个一组走包测试）
+         * @param hit 找到更近的命中时写入，index 为三角形序号
+         */
+        static bool IntersectsTriangles(const PreparedRay& ray, const BatchTriangleSOA& triangles,
+                                        float maxDistance, RayTriangleHit& hit);
     };
 }//namespace hgl::math
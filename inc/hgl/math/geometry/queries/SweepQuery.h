@@ -0,0 +1,106 @@
+﻿/**
+ * SweepQuery.h - 连续碰撞检测（首次接触时间 TOI）
+ *
+ * 离散检测在高速运动时会穿透薄物体（子弹、高速载具），
+ * 缩小时间步长又会成倍增加物理开销。扫掠查询直接求出本帧运动中的首次接触时间：
+ * - 球体/胶囊体对简单几何体：解析求解（射线对 Minkowski 和求交）
+ * - 任意凸体对：保守推进（Conservative Advancement），基于 GJK 距离迭代
+ *
+ * 约定：
+ * - motion 为本帧的位移向量，time 为首次接触时刻占本帧的比例 [0,1]
+ * - normal 从运动体 A 指向目标 B（与 CollisionInfo 一致）
+ * - 双方都运动时，解析接口传入相对位移 motion_a-motion_b，
+ *   此时接触点位于 B 静止的参考系中；TimeOfImpact 直接接受双方位移并返回世界坐标
+ */
+#pragma once
+
+#include<hgl/math/Vector.h>
+#include<hgl/math/geometry/AABB.h>
+#include<hgl/math/geometry/OBB.h>
+#include<hgl/math/geometry/Triangle.h>
+#include<hgl/math/geometry/primitives/Sphere.h>
+#include<hgl/math/geometry/primitives/Capsule.h>
+#include<hgl/math/geometry/queries/GJK.h>
+
+namespace hgl::math
+{
+    /**
+     * 扫掠命中信息
+     */
+    struct SweepHit
+    {
+        bool hit=false;                     ///<本帧内是否发生接触
+        float time=1.0f;                    ///<首次接触时间（本帧运动比例，0~1）
+        Vector3f point{0,0,0};              ///<接触点（接触时刻）
+        Vector3f normal{0,1,0};             ///<接触法线，从 A 指向 B
+        bool initially_overlapping=false;   ///<起始时刻已经重叠（time=0）
+        uint32_t iterations=0;              ///<保守推进迭代次数（解析接口为 0）
+    };
+
+    /**
+     * SweepQuery - 扫掠/首次接触时间查询
+     *
+     * 用法示例：
+     *     SweepHit hit;
+     *     if(SweepQuery::Sweep(bullet, velocity*dt, wall_obb, hit))
+     *         position += velocity*dt*hit.time;
+     */
+    class SweepQuery
+    {
+    public:
+
+        static constexpr float DEFAULT_TOLERANCE=1e-3f;         ///<保守推进的接触距离容差
+        static constexpr uint32_t MAX_ADVANCE_ITERATIONS=32;
+
+        //=============================================================================
+        // 运动球体（解析）
+        //=============================================================================
+
+        static bool Sweep(const Sphere &sphere,const Vector3f &motion,const Sphere &target,SweepHit &hit);
+        static bool Sweep(const Sphere &sphere,const Vector3f &motion,const AABB &box,SweepHit &hit);
+        static bool Sweep(const Sphere &sphere,const Vector3f &motion,const OBB &box,SweepHit &hit);
+        static bool Sweep(const Sphere &sphere,const Vector3f &motion,const Triangle3f &triangle,SweepHit &hit);
+
+        //=============================================================================
+        // 运动胶囊体
+        //=============================================================================
+
+        /**
+         * 胶囊体对球体（解析：球心反向射线对膨胀胶囊体求交）
+         */
+        static bool Sweep(const Capsule &capsule,const Vector3f &motion,const Sphere &target,SweepHit &hit);
+
+        /**
+         * 胶囊体对盒/三角形/胶囊体（保守推进，误差不超过 DEFAULT_TOLERANCE）
+         */
+        static bool Sweep(const Capsule &capsule,const Vector3f &motion,const AABB &box,SweepHit &hit);
+        static bool Sweep(const Capsule &capsule,const Vector3f &motion,const OBB &box,SweepHit &hit);
+        static bool Sweep(const Capsule &capsule,const Vector3f &motion,const Triangle3f &triangle,SweepHit &hit);
+        static bool Sweep(const Capsule &capsule,const Vector3f &motion,const Capsule &target,SweepHit &hit);
+
+        //=============================================================================
+        // 任意凸体（保守推进）
+        //=============================================================================
+
+        /**
+         * 两个平移运动凸体的首次接触时间
+         *
+         * 每步按最近方向上两支撑平面的间隙除以接近速度推进。该间隙对任意方向都
+         * 不大于真实距离，因此推进时间不会越过真实接触时间，不会漏检。
+         * 迭代 MAX_ADVANCE_ITERATIONS 次仍未达到容差时返回 false。
+         *
+         * @param motion_a A 的本帧位移
+         * @param motion_b B 的本帧位移
+         * @param tolerance 距离小于此值即视为接触
+         */
+        static bool ConservativeAdvancement(const ConvexSupport &a,const Vector3f &motion_a,
+                                            const ConvexSupport &b,const Vector3f &motion_b,
+                                            SweepHit &hit,float tolerance=DEFAULT_TOLERANCE);
+
+        template<typename A,typename B>
+        static bool TimeOfImpact(const A &a,const Vector3f &motion_a,const B &b,const Vector3f &motion_b,SweepHit &hit,float tolerance=DEFAULT_TOLERANCE)
+        {
+            return ConservativeAdvancement(MakeConvexSupport(a),motion_a,MakeConvexSupport(b),motion_b,hit,tolerance);
+        }
+    };//class SweepQuery
+}//namespace hgl::math
@@ -1,6 +1,7 @@
 ﻿#include<hgl/math/geometry/AABB.h>
 #include<hgl/math/geometry/OBB.h>
 #include<hgl/math/geometry/Ray.h>
+#include<hgl/math/geometry/PreparedRay.h>
 #include<hgl/math/geometry/Triangle.h>
 #include<algorithm>
 #include<limits>
@@ -210,6 +211,27 @@ namespace hgl::math
         return t_max >= 0.0f;
     }
 
+    bool AABB::IntersectsRay(const PreparedRay &ray, float &distance) const
+    {
+        float t_min, t_max;
+        if (IntersectsRay(ray, t_min, t_max))
+        {
+            distance = t_min >= 0.0f ? t_min : t_max;
+            return distance >= 0.0f;
+        }
+        return false;
+    }
+
+    bool AABB::IntersectsRay(const PreparedRay &ray) const
+    {
+        return ray.IntersectsBox(minPoint, maxPoint);
+    }
+
+    bool AABB::IntersectsRay(const PreparedRay &ray, float &t_min, float &t_max) const
+    {
+        return ray.IntersectsBox(minPoint, maxPoint, 0.0f, std::numeric_limits<float>::infinity(), t_min, t_max);
+    }
+
     int AABB::ClassifyPlane(const Plane &plane) const
     {
         // 计算盒子在平面法线方向的"半径"
@@ -0,0 +1,220 @@
+﻿#include<hgl/math/geometry/BoundingVolumesBatch.h>
+#include<limits>
+
+namespace hgl::math
+{
+    size_t BoundingVolumesBatch::GetChunkSize(const BoundingVolumesDataStorage &storage)
+    {
+        size_t bytes=0;
+
+        if(storage.HasAABB())   bytes+=sizeof(Vector3f)*2;
+        if(storage.HasOBB())    bytes+=sizeof(Vector3f)*5;
+        if(storage.HasSphere()) bytes+=sizeof(Vector3f)+sizeof(float);
+
+        // world + local data are touched together
+        return ComputeChunkSize(bytes*2);
+    }
+
+    void BoundingVolumesBatch::TransformRange(BoundingVolumesDataStorage &storage,size_t begin,size_t end,
+                                              const Matrix4f *world_matrices,IParallelExecutor *executor)
+    {
+        if(!world_matrices)
+            return;
+
+        if(end>storage.GetCount())
+            end=storage.GetCount();
+
+        ParallelForChunks(executor,begin,end,GetChunkSize(storage),
+            [&](size_t,size_t chunk_begin,size_t chunk_end)
+            {
+                storage.RecomputeRange(chunk_begin,chunk_end,world_matrices);
+            });
+
+        // Dirty bits share 64-bit words across chunks, so clear them after the parallel pass
+        storage.ClearDirtyRange(begin,end);
+    }
+
+    namespace
+    {
+        struct MergeChunkResult
+        {
+            Vector3f min_point;
+            Vector3f max_point;
+            BoundingSphere sphere;
+        };
+    }//namespace
+
+    bool BoundingVolumesBatch::MergeRange(const BoundingVolumesDataStorage &storage,size_t begin,size_t end,
+                                          BoundingVolumes &out,IParallelExecutor *executor)
+    {
+        if(end>storage.GetCount())
+            end=storage.GetCount();
+
+        if(begin>=end)
+        {
+            out.Clear();
+            return false;
+        }
+
+        const size_t chunk_size=GetChunkSize(storage);
+        std::vector<MergeChunkResult> chunks(GetChunkCount(begin,end,chunk_size));
+
+        const bool has_sphere=storage.HasSphere();
+        const Vector3f *sphere_centers=storage.GetSphereCenters();
+        const float *sphere_radii=storage.GetSphereRadii();
+
+        ParallelForChunks(executor,begin,end,chunk_size,
+            [&](size_t chunk,size_t chunk_begin,size_t chunk_end)
+            {
+                MergeChunkResult &r=chunks[chunk];
+
+                r.min_point=Vector3f( std::numeric_limits<float>::max());
+                r.max_point=Vector3f(-std::numeric_limits<float>::max());
+                r.sphere.Clear();
+
+                Vector3f box_min,box_max;
+
+                for(size_t i=chunk_begin;i<chunk_end;i++)
+                {
+                    storage.GetWorldAABB(i,box_min,box_max);
+
+                    r.min_point=glm::min(r.min_point,box_min);
+                    r.max_point=glm::max(r.max_point,box_max);
+
+                    if(has_sphere)
+                        r.sphere.Merge(BoundingSphere(sphere_centers[i],sphere_radii[i]));
+                }
+            });
+
+        Vector3f min_point=chunks[0].min_point;
+        Vector3f max_point=chunks[0].max_point;
+        BoundingSphere sphere=chunks[0].sphere;
+
+        for(size_t i=1;i<chunks.size();i++)
+        {
+            min_point=glm::min(min_point,chunks[i].min_point);
+            max_point=glm::max(max_point,chunks[i].max_point);
+            sphere.Merge(chunks[i].sphere);
+        }
+
+        out.aabb.SetMinMax(min_point,max_point);
+        out.obb=ToOBB(out.aabb);
+
+        // Pairwise sphere merging can drift; keep whichever enclosing sphere is tighter
+        const BoundingSphere box_sphere=ToBoundingSphere(out.aabb);
+
+        if(sphere.IsEmpty()||box_sphere.radius<sphere.radius)
+            out.bsphere=box_sphere;
+        else
+            out.bsphere=sphere;
+
+        return true;
+    }
+
+    size_t BoundingVolumesBatch::FrustumCull(const BoundingVolumesDataStorage &storage,size_t begin,size_t end,
+                                             const Frustum &frustum,std::vector<uint32_t> &out_visible,
+                                             IParallelExecutor *executor)
+    {
+        out_visible.clear();
+
+        if(end>storage.GetCount())
+            end=storage.GetCount();
+
+        if(begin>=end)
+            return 0;
+
+        const size_t chunk_size=GetChunkSize(storage);
+        std::vector<std::vector<uint32_t>> chunk_visible(GetChunkCount(begin,end,chunk_size));
+
+        const bool has_sphere=storage.HasSphere();
+        const bool has_aabb=storage.HasAABB();
+        const Vector3f *sphere_centers=storage.GetSphereCenters();
+        const float *sphere_radii=storage.GetSphereRadii();
+        const Vector3f *aabb_min=storage.GetAABBMinPoints();
+        const Vector3f *aabb_max=storage.GetAABBMaxPoints();
+
+        ParallelForChunks(executor,begin,end,chunk_size,
+            [&](size_t chunk,size_t chunk_begin,size_t chunk_end)
+            {
+                std::vector<uint32_t> &visible=chunk_visible[chunk];
+                visible.reserve(chunk_end-chunk_begin);
+
+                for(size_t i=chunk_begin;i<chunk_end;i++)
+                {
+                    // Stage 1: bounding sphere, cheapest test and rejects most invisible entries
+                    if(has_sphere)
+                    {
+                        const Frustum::Scope scope=frustum.SphereIn(sphere_centers[i],sphere_radii[i]);
+
+                        if(scope==Frustum::Scope::OUTSIDE)
+                            continue;
+
+                        if(scope==Frustum::Scope::INSIDE||!has_aabb)
+                        {
+                            visible.push_back(uint32_t(i));
+                            continue;
+                        }
+                    }
+
+                    // Stage 2: AABB for spheres straddling a plane
+                    if(has_aabb)
+                    {
+                        if(frustum.BoxIn(aabb_min[i],aabb_max[i])==Frustum::Scope::OUTSIDE)
+                            continue;
+                    }
+                    else
+                    {
+                        Vector3f box_min,box_max;
+
+                        storage.GetWorldAABB(i,box_min,box_max);
+
+                        if(frustum.BoxIn(box_min,box_max)==Frustum::Scope::OUTSIDE)
+                            continue;
+                    }
+
+                    visible.push_back(uint32_t(i));
+                }
+            });
+
+        // Concatenate in chunk order, so the output stays sorted by index
+        size_t total=0;
+
+        for(const auto &v:chunk_visible)
+            total+=v.size();
+
+        out_visible.reserve(total);
+
+        for(const auto &v:chunk_visible)
+            out_visible.insert(out_visible.end(),v.begin(),v.end());
+
+        return total;
+    }
+
+    void BoundingVolumesBatch::Gather(const BoundingVolumesDataStorage &src,const uint32_t *indices,size_t count,
+                                      BoundingVolumesDataStorage &dst,IParallelExecutor *executor)
+    {
+        if(&src==&dst)
+            return;
+
+        if(dst.GetChannels()!=src.GetChannels())
+            dst=BoundingVolumesDataStorage(src.GetChannels());
+
+        dst.Clear();
+
+        if(!indices||count==0)
+            return;
+
+        dst.Resize(count);
+
+        ParallelForChunks(executor,0,count,GetChunkSize(src),
+            [&](size_t,size_t chunk_begin,size_t chunk_end)
+            {
+                for(size_t i=chunk_begin;i<chunk_end;i++)
+                    dst.CopyEntry(i,src,indices[i]);
+            });
+
+        for(size_t i=0;i<count;i++)
+            if(src.IsDirty(indices[i]))
+                dst.MarkDirty(i);
+    }
+}//namespace hgl::math
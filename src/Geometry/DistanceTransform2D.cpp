@@ -0,0 +1,221 @@
+﻿#include <hgl/math/geometry/DistanceTransform2D.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace hgl::math
+{
+    namespace
+    {
+        // Columns per chunk in the column pass; each chunk walks its strip row by row
+        constexpr size_t COLUMN_STRIP = 256;
+
+        constexpr int MAX_DIMENSION_SUM = 1 << 30;
+
+        bool ValidArguments(const uint8_t* mask, int width, int height, const float* out)
+        {
+            return mask && out && width > 0 && height > 0
+                && int64_t(width) + int64_t(height) < MAX_DIMENSION_SUM;
+        }
+
+        /**
+         * Column pass: g(x,y) = distance to the nearest feature pixel in column x,
+         * or >= inf when the column has none. A pixel is a feature when (mask != 0) != invert.
+         */
+        void ColumnDistances(const uint8_t* mask, uint8_t invert, int width, int height, int32_t inf,
+                             int32_t* g, IParallelExecutor* executor)
+        {
+            const size_t w = size_t(width);
+
+            ParallelForChunks(executor, 0, w, COLUMN_STRIP, [&](size_t, size_t x0, size_t x1)
+            {
+                const uint8_t* m = mask;
+                int32_t* row = g;
+
+                HGL_OMP_SIMD
+                for (size_t x = x0; x < x1; ++x)
+                    row[x] = (uint8_t(m[x] != 0) ^ invert) ? 0 : inf;
+
+                for (int y = 1; y < height; ++y)
+                {
+                    m += w;
+                    const int32_t* prev = row;
+                    row += w;
+
+                    HGL_OMP_SIMD
+                    for (size_t x = x0; x < x1; ++x)
+                        row[x] = (uint8_t(m[x] != 0) ^ invert) ? 0 : std::min(prev[x] + 1, inf);
+                }
+
+                for (int y = height - 2; y >= 0; --y)
+                {
+                    const int32_t* next = row;
+                    row -= w;
+
+                    HGL_OMP_SIMD
+                    for (size_t x = x0; x < x1; ++x)
+                        row[x] = std::min(row[x], next[x] + 1);
+                }
+            });
+        }
+
+        struct EnvelopeScratch
+        {
+            std::vector<int32_t> sites;     // columns whose parabola is on the lower envelope
+            std::vector<double> bounds;     // bounds[k]..bounds[k+1] is where sites[k] is lowest
+        };
+
+        /**
+         * Row pass: lower envelope of the parabolas (x - i)^2 + g(i)^2 over the row,
+         * then write(x, squared distance) for every x. Returns false when the row has no site.
+         */
+        template<typename F>
+        bool RowEnvelope(const int32_t* g, int width, int32_t inf, EnvelopeScratch& scratch, F&& write)
+        {
+            int32_t* v = scratch.sites.data();
+            double* z = scratch.bounds.data();
+            int k = -1;
+
+            auto height_of = [&](int32_t i) { return int64_t(g[i]) * g[i] + int64_t(i) * i; };
+
+            for (int32_t q = 0; q < width; ++q)
+            {
+                if (g[q] >= inf)
+                    continue;
+
+                const int64_t hq = height_of(q);
+                double s = -std::numeric_limits<double>::infinity();
+
+                while (k >= 0)
+                {
+                    s = double(hq - height_of(v[k])) / double(2 * (q - v[k]));
+
+                    if (s > z[k])
+                        break;
+
+                    --k;
+                }
+
+                if (k < 0)
+                    s = -std::numeric_limits<double>::infinity();
+
+                ++k;
+                v[k] = q;
+                z[k] = s;
+            }
+
+            if (k < 0)
+                return false;
+
+            z[k + 1] = std::numeric_limits<double>::infinity();
+
+            int j = 0;
+
+            for (int32_t x = 0; x < width; ++x)
+            {
+                while (z[j + 1] < double(x))
+                    ++j;
+
+                const int64_t dx = x - v[j];
+                write(x, dx * dx + int64_t(g[v[j]]) * g[v[j]]);
+            }
+
+            return true;
+        }
+
+        /**
+         * Runs the row pass over all rows in parallel, one scratch buffer per chunk.
+         */
+        template<typename F>
+        void ForEachRow(int width, int height, IParallelExecutor* executor, F&& func)
+        {
+            const size_t row_bytes = size_t(width) * (sizeof(int32_t) + sizeof(float));
+            const size_t rows_per_chunk = std::max<size_t>(1, PARALLEL_CHUNK_BYTES / row_bytes);
+
+            ParallelForChunks(executor, 0, size_t(height), rows_per_chunk, [&](size_t, size_t row_begin, size_t row_end)
+            {
+                EnvelopeScratch scratch;
+                scratch.sites.resize(size_t(width));
+                scratch.bounds.resize(size_t(width) + 1);
+
+                for (size_t y = row_begin; y < row_end; ++y)
+                    func(y, scratch);
+            });
+        }
+    }//namespace
+
+    bool EuclideanDistanceTransform2D(const uint8_t* feature_mask, int width, int height,
+                                      float* out_distance, IParallelExecutor* executor)
+    {
+        if (!ValidArguments(feature_mask, width, height, out_distance))
+            return false;
+
+        const size_t w = size_t(width);
+        const int32_t inf = width + height;
+
+        std::vector<int32_t> g(w * size_t(height));
+        ColumnDistances(feature_mask, 0, width, height, inf, g.data(), executor);
+
+        ForEachRow(width, height, executor, [&](size_t y, EnvelopeScratch& scratch)
+        {
+            float* out = out_distance + y * w;
+
+            const bool found = RowEnvelope(g.data() + y * w, width, inf, scratch,
+                [&](int32_t x, int64_t d2) { out[x] = float(std::sqrt(double(d2))); });
+
+            if (!found)
+                std::fill(out, out + w, std::numeric_limits<float>::max());
+        });
+
+        return true;
+    }
+
+    bool SignedDistanceTransform2D(const uint8_t* inside_mask, int width, int height,
+                                   float* out_distance, IParallelExecutor* executor)
+    {
+        if (!ValidArguments(inside_mask, width, height, out_distance))
+            return false;
+
+        const size_t w = size_t(width);
+        const size_t count = w * size_t(height);
+        const int32_t inf = width + height;
+
+        // to_inside: distance from outside pixels to the region, to_outside: the reverse
+        std::vector<int32_t> to_inside(count), to_outside(count);
+        ColumnDistances(inside_mask, 0, width, height, inf, to_inside.data(), executor);
+        ColumnDistances(inside_mask, 1, width, height, inf, to_outside.data(), executor);
+
+        ForEachRow(width, height, executor, [&](size_t y, EnvelopeScratch& scratch)
+        {
+            const uint8_t* mask = inside_mask + y * w;
+            float* out = out_distance + y * w;
+
+            // The zero level sits halfway between adjacent inside and outside pixel centres
+            const bool any_inside = RowEnvelope(to_inside.data() + y * w, width, inf, scratch,
+                [&](int32_t x, int64_t d2)
+                {
+                    if (!mask[x])
+                        out[x] = float(std::sqrt(double(d2)) - 0.5);
+                });
+
+            const bool any_outside = RowEnvelope(to_outside.data() + y * w, width, inf, scratch,
+                [&](int32_t x, int64_t d2)
+                {
+                    if (mask[x])
+                        out[x] = float(0.5 - std::sqrt(double(d2)));
+                });
+
+            if (!any_inside || !any_outside)
+                for (size_t x = 0; x < w; ++x)
+                {
+                    if (!mask[x] && !any_inside)
+                        out[x] = std::numeric_limits<float>::max();
+                    else if (mask[x] && !any_outside)
+                        out[x] = std::numeric_limits<float>::lowest();
+                }
+        });
+
+        return true;
+    }
+}//namespace hgl::math
@@ -107,4 +107,26 @@ namespace hgl::math
 
         return(result);
     }
+
+    Frustum::Scope Frustum::BoxIn(const Vector3f &box_min,const Vector3f &box_max) const
+    {
+        Frustum::Scope result = Frustum::Scope::INSIDE;
+
+        for(int i=0; i < 6; i++)
+        {
+            const Vector3f &n=pl[i].normal;
+
+            // P-vertex: corner furthest along the plane normal, N-vertex: the opposite corner
+            const Vector3f vp(n.x>=0?box_max.x:box_min.x,n.y>=0?box_max.y:box_min.y,n.z>=0?box_max.z:box_min.z);
+            const Vector3f vn(n.x>=0?box_min.x:box_max.x,n.y>=0?box_min.y:box_max.y,n.z>=0?box_min.z:box_max.z);
+
+            if (pl[i].Distance(vp) < 0)
+                return Frustum::Scope::OUTSIDE;
+            else
+            if (pl[i].Distance(vn) < 0)
+                result = Frustum::Scope::INTERSECT;
+        }
+
+        return(result);
+    }
 }//namespace hgl::math
@@ -0,0 +1,386 @@
+﻿/**
+ * HeightField.cpp - Heightfield collider
+ *
+ * Queries run in grid space (x,y in cells, z in raw sample units), which is
+ * an axis scale of world space, so ray parameters carry over unchanged.
+ */
+#include<hgl/math/geometry/primitives/HeightField.h>
+#include<hgl/math/geometry/primitives/Sphere.h>
+#include<hgl/math/geometry/primitives/Capsule.h>
+#include<hgl/math/geometry/Ray.h>
+#include<hgl/math/geometry/queries/RaycastQuery.h>
+#include<hgl/math/geometry/queries/DistanceQuery.h>
+#include<algorithm>
+#include<cfloat>
+#include<cmath>
+
+namespace hgl::math
+{
+    namespace
+    {
+        // Clip [t0,t1] against the slab [lo,hi] on one axis
+        bool ClipSlab(float o,float d,float lo,float hi,float &t0,float &t1)
+        {
+            if(d==0.0f)
+                return o>=lo&&o<=hi;
+
+            float a=(lo-o)/d;
+            float b=(hi-o)/d;
+
+            if(a>b)std::swap(a,b);
+
+            t0=std::max(t0,a);
+            t1=std::min(t1,b);
+
+            return t0<=t1;
+        }
+
+        // Distance to leave [lo,hi] along one axis
+        float AxisExit(float o,float inv_d,float d,float lo,float hi)
+        {
+            if(d>0.0f)return (hi-o)*inv_d;
+            if(d<0.0f)return (lo-o)*inv_d;
+
+            return FLT_MAX;
+        }
+    }//namespace
+
+    void HeightField::Clear()
+    {
+        source=nullptr;
+        fetch=nullptr;
+        width=height=0;
+        mips.clear();
+        level_offset.clear();
+        level_width.clear();
+        level_height.clear();
+    }
+
+    void HeightField::BuildMips()
+    {
+        level_offset.clear();
+        level_width.clear();
+        level_height.clear();
+
+        int w=width-1;
+        int h=height-1;
+        size_t total=0;
+
+        for(;;)
+        {
+            level_offset.push_back(total);
+            level_width.push_back(w);
+            level_height.push_back(h);
+            total+=size_t(w)*h;
+
+            if(w==1&&h==1)
+                break;
+
+            w=(w+1)/2;
+            h=(h+1)/2;
+        }
+
+        mips.resize(total);
+
+        for(int level=0;level<GetLevelCount();level++)
+            UpdateLevel(level,0,0,level_width[level]-1,level_height[level]-1);
+    }
+
+    void HeightField::UpdateLevel(int level,int x0,int y0,int x1,int y1)
+    {
+        const int w=level_width[level];
+
+        for(int y=y0;y<=y1;y++)
+        {
+            for(int x=x0;x<=x1;x++)
+            {
+                MinMax &mm=mips[level_offset[level]+size_t(y)*w+x];
+
+                if(level==0)
+                {
+                    const float h00=Sample(x,y),h10=Sample(x+1,y),h01=Sample(x,y+1),h11=Sample(x+1,y+1);
+
+                    mm.min_value=std::min(std::min(h00,h10),std::min(h01,h11));
+                    mm.max_value=std::max(std::max(h00,h10),std::max(h01,h11));
+                    continue;
+                }
+
+                const int cw=level_width[level-1];
+                const int ch=level_height[level-1];
+
+                mm.min_value= FLT_MAX;
+                mm.max_value=-FLT_MAX;
+
+                for(int cy=y*2;cy<=std::min(y*2+1,ch-1);cy++)
+                    for(int cx=x*2;cx<=std::min(x*2+1,cw-1);cx++)
+                    {
+                        const MinMax &child=GetMinMax(level-1,cx,cy);
+
+                        mm.min_value=std::min(mm.min_value,child.min_value);
+                        mm.max_value=std::max(mm.max_value,child.max_value);
+                    }
+            }
+        }
+    }
+
+    void HeightField::Refresh(int x0,int y0,int x1,int y1)
+    {
+        if(!source)
+            return;
+
+        // A sample touches the cells on both sides of it
+        int cx0=std::max(std::min(x0,x1)-1,0);
+        int cy0=std::max(std::min(y0,y1)-1,0);
+        int cx1=std::min(std::max(x0,x1),width-2);
+        int cy1=std::min(std::max(y0,y1),height-2);
+
+        for(int level=0;level<GetLevelCount();level++)
+        {
+            if(cx0>cx1||cy0>cy1)
+                return;
+
+            UpdateLevel(level,cx0,cy0,cx1,cy1);
+
+            cx0/=2;cy0/=2;cx1/=2;cy1/=2;
+        }
+    }
+
+    AABB HeightField::GetBoundingBox()const
+    {
+        AABB box;
+
+        if(!source)
+        {
+            box.Clear();
+            return box;
+        }
+
+        const MinMax &root=GetMinMax(GetLevelCount()-1,0,0);
+
+        box.SetMinMax(origin+Vector3f(0,0,root.min_value)*scale,
+                      origin+Vector3f(float(width-1),float(height-1),root.max_value)*scale);
+
+        return box;
+    }
+
+    void HeightField::GetCellWorld(int cx,int cy,Vector3f corner[4])const
+    {
+        corner[0]=GetSamplePoint(cx  ,cy  );
+        corner[1]=GetSamplePoint(cx+1,cy  );
+        corner[2]=GetSamplePoint(cx+1,cy+1);
+        corner[3]=GetSamplePoint(cx  ,cy+1);
+    }
+
+    /**
+     * lower: triangle (x,y)-(x+1,y)-(x+1,y+1), where the local fx>=fy
+     */
+    Vector3f HeightField::GetCellNormal(int cx,int cy,bool lower)const
+    {
+        const float h00=Sample(cx,cy),h10=Sample(cx+1,cy),h01=Sample(cx,cy+1),h11=Sample(cx+1,cy+1);
+
+        float dzdx,dzdy;
+
+        if(lower)
+        {
+            dzdx=(h10-h00)*scale.z/scale.x;
+            dzdy=(h11-h10)*scale.z/scale.y;
+        }
+        else
+        {
+            dzdx=(h11-h01)*scale.z/scale.x;
+            dzdy=(h01-h00)*scale.z/scale.y;
+        }
+
+        return Normalized(Vector3f(-dzdx,-dzdy,1.0f));
+    }
+
+    bool HeightField::GetHeight(float x,float y,float &z,Vector3f *normal)const
+    {
+        if(!source)
+            return false;
+
+        const float gx=(x-origin.x)/scale.x;
+        const float gy=(y-origin.y)/scale.y;
+
+        if(gx<0.0f||gy<0.0f||gx>float(width-1)||gy>float(height-1))
+            return false;
+
+        const int cx=std::min(int(gx),width-2);
+        const int cy=std::min(int(gy),height-2);
+        const float fx=gx-float(cx);
+        const float fy=gy-float(cy);
+
+        const float h00=Sample(cx,cy),h10=Sample(cx+1,cy),h01=Sample(cx,cy+1),h11=Sample(cx+1,cy+1);
+        const bool lower=fx>=fy;
+
+        const float h=lower?h00+fx*(h10-h00)+fy*(h11-h10)
+                           :h00+fy*(h01-h00)+fx*(h11-h01);
+
+        z=origin.z+h*scale.z;
+
+        if(normal)
+            *normal=GetCellNormal(cx,cy,lower);
+
+        return true;
+    }
+
+    bool HeightField::Raycast(const Ray &ray,float max_distance,HeightFieldHit &hit)const
+    {
+        if(!source)
+            return false;
+
+        const Vector3f o=(ray.origin-origin)/scale;
+        const Vector3f d=ray.direction/scale;
+        const MinMax &root=GetMinMax(GetLevelCount()-1,0,0);
+
+        float t0=0.0f;
+        float t1=max_distance;
+
+        if(!ClipSlab(o.x,d.x,0.0f,float(width-1),t0,t1)
+         ||!ClipSlab(o.y,d.y,0.0f,float(height-1),t0,t1)
+         ||!ClipSlab(o.z,d.z,root.min_value,root.max_value,t0,t1))
+            return false;
+
+        const Vector3f inv_d(d.x!=0.0f?1.0f/d.x:0.0f,d.y!=0.0f?1.0f/d.y:0.0f,0.0f);
+        const float planar=std::max(std::abs(d.x),std::abs(d.y));
+        const float nudge=planar>0.0f?1e-4f/planar:0.0f;        // step just past a block border
+        const Ray grid_ray(o,d);
+        const int levels=GetLevelCount();
+
+        float t=t0;
+
+        while(t<=t1)
+        {
+            const Vector3f p=o+d*t;
+            const int cx=std::clamp(int(std::floor(p.x)),0,width-2);
+            const int cy=std::clamp(int(std::floor(p.y)),0,height-2);
+
+            // Climb to the largest block the ray passes entirely above or below
+            int skip_level=-1;
+            float block_exit=t;
+
+            for(int level=0;level<levels;level++)
+            {
+                const int bx=cx>>level;
+                const int by=cy>>level;
+                const float x_lo=float(bx<<level),x_hi=float(std::min((bx+1)<<level,width-1));
+                const float y_lo=float(by<<level),y_hi=float(std::min((by+1)<<level,height-1));
+
+                const float exit=std::min(t1,std::min(AxisExit(o.x,inv_d.x,d.x,x_lo,x_hi),
+                                                      AxisExit(o.y,inv_d.y,d.y,y_lo,y_hi)));
+
+                const float z0=o.z+d.z*t;
+                const float z1=o.z+d.z*exit;
+                const MinMax &mm=GetMinMax(level,bx,by);
+
+                if(std::min(z0,z1)>mm.max_value||std::max(z0,z1)<mm.min_value)
+                {
+                    skip_level=level;
+                    block_exit=exit;
+                }
+                else break;
+            }
+
+            if(skip_level<0)
+            {
+                // Ray segment overlaps this cell's height range: test its two triangles
+                const Vector3f g00(float(cx  ),float(cy  ),Sample(cx  ,cy  ));
+                const Vector3f g10(float(cx+1),float(cy  ),Sample(cx+1,cy  ));
+                const Vector3f g01(float(cx  ),float(cy+1),Sample(cx  ,cy+1));
+                const Vector3f g11(float(cx+1),float(cy+1),Sample(cx+1,cy+1));
+
+                float best=FLT_MAX,th;
+
+                if(RaycastQuery::IntersectsTriangle(grid_ray,g00,g10,g11,th))best=th;
+                if(RaycastQuery::IntersectsTriangle(grid_ray,g00,g11,g01,th)&&th<best)best=th;
+
+                if(best>=t0&&best<=t1)
+                {
+                    const Vector3f gp=o+d*best;
+
+                    hit.distance=best;
+                    hit.point=ray.origin+ray.direction*best;
+                    hit.normal=GetCellNormal(cx,cy,gp.x-float(cx)>=gp.y-float(cy));
+                    hit.cell_x=cx;
+                    hit.cell_y=cy;
+
+                    if(Dot(hit.normal,ray.direction)>0.0f)
+                        hit.normal=-hit.normal;
+
+                    return true;
+                }
+
+                block_exit=std::min(t1,std::min(AxisExit(o.x,inv_d.x,d.x,float(cx),float(cx+1)),
+                                                AxisExit(o.y,inv_d.y,d.y,float(cy),float(cy+1))));
+            }
+
+            if(block_exit>=t1)
+                break;
+
+            t=block_exit+nudge;
+        }
+
+        return false;
+    }
+
+    template<typename Test>
+    bool HeightField::OverlapCells(const Vector3f &box_min,const Vector3f &box_max,const Test &test)const
+    {
+        if(!source)
+            return false;
+
+        const Vector3f g_min=(box_min-origin)/scale;
+        const Vector3f g_max=(box_max-origin)/scale;
+
+        const int x0=std::max(int(std::floor(g_min.x)),0);
+        const int y0=std::max(int(std::floor(g_min.y)),0);
+        const int x1=std::min(int(std::floor(g_max.x)),width-2);
+        const int y1=std::min(int(std::floor(g_max.y)),height-2);
+
+        Vector3f corner[4];
+
+        for(int cy=y0;cy<=y1;cy++)
+        {
+            for(int cx=x0;cx<=x1;cx++)
+            {
+                const MinMax &mm=GetMinMax(0,cx,cy);
+
+                if(mm.min_value>g_max.z||mm.max_value<g_min.z)
+                    continue;
+
+                GetCellWorld(cx,cy,corner);
+
+                if(test(corner[0],corner[1],corner[2])
+                 ||test(corner[0],corner[2],corner[3]))
+                    return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool HeightField::Overlaps(const Sphere &sphere)const
+    {
+        const Vector3f &center=sphere.GetCenter();
+        const float r=sphere.GetRadius();
+
+        return OverlapCells(center-Vector3f(r),center+Vector3f(r),
+            [&](const Vector3f &a,const Vector3f &b,const Vector3f &c)
+            {
+                return LengthSquared(center-ClosestPointOnTriangle(center,a,b,c))<=r*r;
+            });
+    }
+
+    bool HeightField::Overlaps(const Capsule &capsule)const
+    {
+        const Vector3f &p=capsule.GetStart();
+        const Vector3f &q=capsule.GetEnd();
+        const float r=capsule.GetRadius();
+
+        return OverlapCells(glm::min(p,q)-Vector3f(r),glm::max(p,q)+Vector3f(r),
+            [&](const Vector3f &a,const Vector3f &b,const Vector3f &c)
+            {
+                return DistanceQuery::SegmentTriangleDistanceSquared(p,q,a,b,c)<=r*r;
+            });
+    }
+}//namespace hgl::math
@@ -1,7 +1,9 @@
 ﻿#include<hgl/math/geometry/OBB.h>
 #include<hgl/math/geometry/AABB.h>
 #include<hgl/math/geometry/Ray.h>
+#include<hgl/math/geometry/PreparedRay.h>
 #include<hgl/math/geometry/Triangle.h>
+#include<hgl/math/geometry/queries/DistanceQuery.h>
 #include<algorithm>
 #include<limits>
 #include<cfloat>
@@ -221,25 +223,7 @@ namespace hgl::math
 
     float OBB::Distance(const OBB &other) const
     {
-        if (Intersects(other))
-            return 0.0f;
-
-        // 改进的实现：采样角点计算最近距离
-        Vector3f corners1[8], corners2[8];
-        GetCorners(corners1);
-        other.GetCorners(corners2);
-
-        float min_dist = FLT_MAX;
-
-        // 计算每个角点到另一个 OBB 的距离
-        for (int i = 0; i < 8; i++)
-        {
-            float d1 = DistanceToPoint(corners2[i]);
-            float d2 = other.DistanceToPoint(corners1[i]);
-            min_dist = std::min(min_dist, std::min(d1, d2));
-        }
-
-        return min_dist;
+        return DistanceQuery::Distance(*this,other);
     }
 
     bool OBB::IntersectsAABB(const AABB &aabb) const
@@ -349,8 +333,8 @@ namespace hgl::math
 
             if (std::abs(f_dot) > 1e-6f)
             {
-                float t1 = (e + half_length[i]) / f_dot;
-                float t2 = (e - half_length[i]) / f_dot;
+                float t1 = (-e - half_length[i]) / f_dot;
+                float t2 = (-e + half_length[i]) / f_dot;
 
                 if (t1 > t2) std::swap(t1, t2);
 
@@ -370,6 +354,23 @@ namespace hgl::math
         return t_max >= 0.0f;
     }
 
+    // The slabs are in the box's local frame, so the world-space reciprocals don't apply;
+    // these exist so one PreparedRay can be passed to every ray test
+    bool OBB::IntersectsRay(const PreparedRay &ray, float &distance) const
+    {
+        return IntersectsRay(ray.GetRay(), distance);
+    }
+
+    bool OBB::IntersectsRay(const PreparedRay &ray) const
+    {
+        return IntersectsRay(ray.GetRay());
+    }
+
+    bool OBB::IntersectsRay(const PreparedRay &ray, float &t_min, float &t_max) const
+    {
+        return IntersectsRay(ray.GetRay(), t_min, t_max);
+    }
+
     int OBB::ClassifyPlane(const Plane &plane) const
     {
         // 计算OBB在平面法线方向的"半径"
@@ -395,17 +396,58 @@ namespace hgl::math
 
     bool OBB::IntersectsTriangle(const Triangle3f &triangle) const
     {
-        // TODO: 未实现完整的 SAT 测试
-        // 目前只做基本检查，可能漏掉某些相交情况
+        // SAT in the box's local frame: 3 box axes, the triangle normal and
+        // the 9 cross products of box axes with triangle edges
+        Vector3f v[3];
 
-        // 检查三角形顶点是否在OBB内
-        if (ContainsPoint(triangle[0]) ||
-            ContainsPoint(triangle[1]) ||
-            ContainsPoint(triangle[2]))
-            return true;
+        for (int i = 0; i < 3; i++)
+        {
+            const Vector3f d = triangle[i] - center;
+            v[i] = Vector3f(glm::dot(d, axis[0]), glm::dot(d, axis[1]), glm::dot(d, axis[2]));
+        }
 
-        // 注意：这不是完整实现！可能产生假阴性
-        return false;
+        const Vector3f &h = half_length;
+
+        for (int k = 0; k < 3; k++)
+        {
+            if (std::min({v[0][k], v[1][k], v[2][k]}) > h[k] ||
+                std::max({v[0][k], v[1][k], v[2][k]}) < -h[k])
+                return false;
+        }
+
+        const Vector3f e[3] = { v[1] - v[0], v[2] - v[1], v[0] - v[2] };
+
+        auto separated = [&](const Vector3f &a)
+        {
+            const float p0 = glm::dot(v[0], a);
+            const float p1 = glm::dot(v[1], a);
+            const float p2 = glm::dot(v[2], a);
+            const float r = h.x * std::abs(a.x) + h.y * std::abs(a.y) + h.z * std::abs(a.z);
+
+            return std::min({p0, p1, p2}) > r || std::max({p0, p1, p2}) < -r;
+        };
+
+        const Vector3f normal = glm::cross(e[0], e[1]);
+
+        if (glm::dot(normal, normal) > 1e-12f && separated(normal))
+            return false;
+
+        for (int k = 0; k < 3; k++)
+        {
+            Vector3f box_axis(0, 0, 0);
+            box_axis[k] = 1.0f;
+
+            for (int j = 0; j < 3; j++)
+            {
+                const Vector3f a = glm::cross(box_axis, e[j]);
+
+                // Parallel edge/axis: the other axes already cover this direction
+                if (glm::dot(a, a) > 1e-12f && separated(a))
+                    return false;
+            }
+        }
+
+        return true;
     }
 
     void OBB::ExpandToInclude(const Vector3f &point)
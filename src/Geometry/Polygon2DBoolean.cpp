@@ -0,0 +1,703 @@
+﻿/**
+ * Polygon2DBoolean.cpp - Fixed-point sweep-line polygon booleans and offsetting
+ *
+ * Coordinates are snapped to a power-of-two grid so every orientation test is an
+ * exact int64 cross product. Edges are split until no two of them cross, after
+ * which a left-to-right sweep assigns each edge the winding numbers of the region
+ * directly below it; the result boundary is every edge whose two sides disagree.
+ */
+#include <hgl/math/geometry/Polygon2DBoolean.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <set>
+
+namespace hgl::math
+{
+    namespace
+    {
+        // |coordinate| < 2^29 grid steps keeps every cross product below 2^62
+        constexpr int FIXED_POINT_BITS = 29;
+
+        // Rounded intersections can create new crossings; each pass resolves them
+        constexpr int MAX_SPLIT_PASSES = 32;
+
+        struct FixedPoint
+        {
+            int64_t x, y;
+
+            bool operator==(const FixedPoint& o) const { return x == o.x && y == o.y; }
+            bool operator!=(const FixedPoint& o) const { return !(*this == o); }
+            bool operator<(const FixedPoint& o) const { return x < o.x || (x == o.x && y < o.y); }
+        };
+
+        int64_t Cross(const FixedPoint& o, const FixedPoint& a, const FixedPoint& b)
+        {
+            return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+        }
+
+        int Sign(int64_t v)
+        {
+            return (v > 0) - (v < 0);
+        }
+
+        /**
+         * Edge with a < b in (x, y) order; wind[k] is +1 per loop of input k that
+         * traverses it from a to b and -1 per loop that traverses it from b to a.
+         */
+        struct FixedEdge
+        {
+            FixedPoint a, b;
+            int wind[2];
+        };
+
+        /**
+         * Power-of-two grid step covering every input coordinate
+         */
+        bool ComputeGridStep(const Polygon2DPaths& subject, const Polygon2DPaths& clip, double& step)
+        {
+            double max_abs = 0.0;
+
+            for (const Polygon2DPaths* paths : { &subject, &clip })
+                for (const auto& loop : *paths)
+                    for (const Vector2d& p : loop)
+                    {
+                        if (!std::isfinite(p.x) || !std::isfinite(p.y))
+                            return false;
+
+                        max_abs = std::max(max_abs, std::max(std::abs(p.x), std::abs(p.y)));
+                    }
+
+            int exponent = 0;
+            std::frexp(max_abs > 0.0 ? max_abs : 1.0, &exponent);      // max_abs < 2^exponent
+
+            step = std::ldexp(1.0, exponent - FIXED_POINT_BITS);
+            return true;
+        }
+
+        void AppendEdges(const Polygon2DPaths& paths, int owner, double inv_step, std::vector<FixedEdge>& edges)
+        {
+            std::vector<FixedPoint> loop;
+
+            for (const auto& path : paths)
+            {
+                loop.clear();
+
+                for (const Vector2d& p : path)
+                {
+                    const FixedPoint q{ int64_t(std::llround(p.x * inv_step)), int64_t(std::llround(p.y * inv_step)) };
+
+                    if (loop.empty() || loop.back() != q)
+                        loop.push_back(q);
+                }
+
+                while (loop.size() > 1 && loop.back() == loop.front())
+                    loop.pop_back();
+
+                if (loop.size() < 3)
+                    continue;
+
+                for (size_t i = 0; i < loop.size(); ++i)
+                {
+                    const FixedPoint& p = loop[i];
+                    const FixedPoint& q = loop[(i + 1) % loop.size()];
+
+                    FixedEdge edge{ std::min(p, q), std::max(p, q), { 0, 0 } };
+                    edge.wind[owner] = p < q ? 1 : -1;
+                    edges.push_back(edge);
+                }
+            }
+        }
+
+        /**
+         * Point known to lie on the supporting line of a-b is strictly inside it
+         */
+        bool InsideCollinear(const FixedPoint& p, const FixedPoint& a, const FixedPoint& b)
+        {
+            return a < p && p < b;
+        }
+
+        void AddSplit(std::vector<std::vector<FixedPoint>>& splits, size_t edge, const FixedEdge& e, const FixedPoint& p)
+        {
+            if (p != e.a && p != e.b)
+                splits[edge].push_back(p);
+        }
+
+        /**
+         * Records where edges i and j must be split so that they only meet at endpoints
+         */
+        void IntersectEdges(const std::vector<FixedEdge>& edges, size_t i, size_t j,
+                            std::vector<std::vector<FixedPoint>>& splits)
+        {
+            const FixedEdge& e = edges[i];
+            const FixedEdge& f = edges[j];
+
+            const int64_t d1 = Cross(f.a, f.b, e.a);
+            const int64_t d2 = Cross(f.a, f.b, e.b);
+            const int64_t d3 = Cross(e.a, e.b, f.a);
+            const int64_t d4 = Cross(e.a, e.b, f.b);
+
+            // Endpoints touching the other edge's interior, including collinear overlap
+            if (d1 == 0 && InsideCollinear(e.a, f.a, f.b)) splits[j].push_back(e.a);
+            if (d2 == 0 && InsideCollinear(e.b, f.a, f.b)) splits[j].push_back(e.b);
+            if (d3 == 0 && InsideCollinear(f.a, e.a, e.b)) splits[i].push_back(f.a);
+            if (d4 == 0 && InsideCollinear(f.b, e.a, e.b)) splits[i].push_back(f.b);
+
+            if (Sign(d1) * Sign(d2) >= 0 || Sign(d3) * Sign(d4) >= 0)
+                return;
+
+            // Proper crossing, snapped to the grid
+            const double t = double(d1) / double(d1 - d2);
+            const FixedPoint p{ e.a.x + int64_t(std::llround(double(e.b.x - e.a.x) * t)),
+                                e.a.y + int64_t(std::llround(double(e.b.y - e.a.y) * t)) };
+
+            AddSplit(splits, i, e, p);
+            AddSplit(splits, j, f, p);
+        }
+
+        /**
+         * Splits edges until no two of them cross or overlap except at shared endpoints
+         */
+        void SplitEdges(std::vector<FixedEdge>& edges)
+        {
+            std::vector<std::vector<FixedPoint>> splits;
+            std::vector<size_t> order;
+            std::vector<size_t> active;
+            std::vector<FixedEdge> result;
+
+            for (int pass = 0; pass < MAX_SPLIT_PASSES; ++pass)
+            {
+                splits.assign(edges.size(), {});
+
+                order.resize(edges.size());
+                for (size_t i = 0; i < order.size(); ++i)
+                    order[i] = i;
+
+                std::sort(order.begin(), order.end(), [&](size_t l, size_t r) { return edges[l].a.x < edges[r].a.x; });
+
+                // Sweep over x, testing only edges whose x and y ranges overlap
+                active.clear();
+                bool any = false;
+
+                for (size_t i : order)
+                {
+                    const FixedEdge& e = edges[i];
+                    const int64_t min_y = std::min(e.a.y, e.b.y);
+                    const int64_t max_y = std::max(e.a.y, e.b.y);
+
+                    size_t kept = 0;
+
+                    for (size_t j : active)
+                    {
+                        const FixedEdge& f = edges[j];
+
+                        if (f.b.x < e.a.x)
+                            continue;
+
+                        active[kept++] = j;
+
+                        if (std::max(f.a.y, f.b.y) < min_y || std::min(f.a.y, f.b.y) > max_y)
+                            continue;
+
+                        IntersectEdges(edges, i, j, splits);
+                    }
+
+                    active.resize(kept);
+                    active.push_back(i);
+                }
+
+                result.clear();
+
+                for (size_t i = 0; i < edges.size(); ++i)
+                {
+                    std::vector<FixedPoint>& points = splits[i];
+
+                    if (points.empty())
+                    {
+                        result.push_back(edges[i]);
+                        continue;
+                    }
+
+                    any = true;
+
+                    // Points on a segment from a to b (a < b) are ordered the same way along it
+                    std::sort(points.begin(), points.end());
+                    points.erase(std::unique(points.begin(), points.end()), points.end());
+
+                    FixedPoint start = edges[i].a;
+
+                    for (const FixedPoint& p : points)
+                    {
+                        result.push_back({ start, p, { edges[i].wind[0], edges[i].wind[1] } });
+                        start = p;
+                    }
+
+                    result.push_back({ start, edges[i].b, { edges[i].wind[0], edges[i].wind[1] } });
+                }
+
+                edges.swap(result);
+
+                if (!any)
+                    break;
+            }
+
+            // Snapped split points can fold a piece back onto its own line
+            for (FixedEdge& e : edges)
+                if (e.b < e.a)
+                {
+                    std::swap(e.a, e.b);
+                    e.wind[0] = -e.wind[0];
+                    e.wind[1] = -e.wind[1];
+                }
+        }
+
+        /**
+         * Merges coincident edges, summing their winding contributions
+         */
+        void MergeEdges(std::vector<FixedEdge>& edges)
+        {
+            std::sort(edges.begin(), edges.end(), [](const FixedEdge& l, const FixedEdge& r)
+            {
+                return l.a < r.a || (l.a == r.a && l.b < r.b);
+            });
+
+            size_t count = 0;
+
+            for (const FixedEdge& e : edges)
+            {
+                if (e.a == e.b)
+                    continue;
+
+                if (count > 0 && edges[count - 1].a == e.a && edges[count - 1].b == e.b)
+                {
+                    edges[count - 1].wind[0] += e.wind[0];
+                    edges[count - 1].wind[1] += e.wind[1];
+                }
+                else
+                {
+                    edges[count++] = e;
+                }
+            }
+
+            edges.resize(count);
+        }
+
+        /**
+         * Orders non-crossing edges along the sweep line, bottom to top. Points sharing
+         * an x are swept by increasing y, so "below" a vertical edge is its +x side.
+         */
+        struct SweepOrder
+        {
+            const std::vector<FixedEdge>* edges;
+
+            bool operator()(size_t l, size_t r) const
+            {
+                if (l == r)
+                    return false;
+
+                const FixedEdge& e = (*edges)[l];
+                const FixedEdge& f = (*edges)[r];
+
+                if (e.a == f.a)
+                {
+                    const int64_t c = Cross(e.a, e.b, f.b);
+                    return c != 0 ? c > 0 : l < r;
+                }
+
+                if (e.a < f.a)
+                {
+                    int64_t c = Cross(e.a, e.b, f.a);
+                    if (c == 0)
+                        c = Cross(e.a, e.b, f.b);
+                    return c != 0 ? c > 0 : l < r;
+                }
+
+                int64_t c = Cross(f.a, f.b, e.a);
+                if (c == 0)
+                    c = Cross(f.a, f.b, e.b);
+                return c != 0 ? c < 0 : l < r;
+            }
+        };
+
+        /**
+         * Winding numbers of the region directly below each edge
+         */
+        void ComputeWindingBelow(const std::vector<FixedEdge>& edges, std::vector<std::array<int, 2>>& below)
+        {
+            struct Event
+            {
+                FixedPoint p;
+                bool insert;
+                size_t edge;
+            };
+
+            std::vector<Event> events;
+            events.reserve(edges.size() * 2);
+
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                events.push_back({ edges[i].a, true, i });
+                events.push_back({ edges[i].b, false, i });
+            }
+
+            // Removals before insertions at the same point
+            std::sort(events.begin(), events.end(), [](const Event& l, const Event& r)
+            {
+                if (l.p != r.p)
+                    return l.p < r.p;
+                return l.insert < r.insert;
+            });
+
+            using Status = std::set<size_t, SweepOrder>;
+
+            Status status(SweepOrder{ &edges });
+            std::vector<Status::iterator> position(edges.size());
+            std::vector<size_t> inserted;
+
+            below.assign(edges.size(), { 0, 0 });
+
+            size_t i = 0;
+
+            while (i < events.size())
+            {
+                const FixedPoint p = events[i].p;
+
+                for (; i < events.size() && events[i].p == p && !events[i].insert; ++i)
+                    status.erase(position[events[i].edge]);
+
+                inserted.clear();
+
+                for (; i < events.size() && events[i].p == p; ++i)
+                {
+                    position[events[i].edge] = status.insert(events[i].edge).first;
+                    inserted.push_back(events[i].edge);
+                }
+
+                // Edges fanning out of p are adjacent in the status; resolve them bottom-up
+                std::sort(inserted.begin(), inserted.end(), SweepOrder{ &edges });
+
+                for (size_t e : inserted)
+                {
+                    auto it = position[e];
+
+                    if (it == status.begin())
+                        continue;
+
+                    const size_t prev = *std::prev(it);
+
+                    below[e][0] = below[prev][0] + edges[prev].wind[0];
+                    below[e][1] = below[prev][1] + edges[prev].wind[1];
+                }
+            }
+        }
+
+        bool IsFilled(int winding, Polygon2DFillRule rule)
+        {
+            switch (rule)
+            {
+            case Polygon2DFillRule::EvenOdd:    return (winding & 1) != 0;
+            case Polygon2DFillRule::Positive:   return winding > 0;
+            default:                            return winding != 0;
+            }
+        }
+
+        bool IsInside(bool in_subject, bool in_clip, Polygon2DBooleanOp op)
+        {
+            switch (op)
+            {
+            case Polygon2DBooleanOp::Intersection:  return in_subject && in_clip;
+            case Polygon2DBooleanOp::Difference:    return in_subject && !in_clip;
+            case Polygon2DBooleanOp::Xor:           return in_subject != in_clip;
+            default:                                return in_subject || in_clip;
+            }
+        }
+
+        /**
+         * Links directed boundary edges (interior on the left) into loops. At a vertex
+         * with several unused outgoing edges the sharpest left turn is taken, which
+         * separates loops that only touch at a point.
+         */
+        void TraceLoops(const std::vector<std::pair<FixedPoint, FixedPoint>>& boundary, double step, Polygon2DPaths& out)
+        {
+            std::vector<FixedPoint> vertices;
+            vertices.reserve(boundary.size());
+
+            for (const auto& edge : boundary)
+                vertices.push_back(edge.first);
+
+            std::sort(vertices.begin(), vertices.end());
+            vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+            auto vertex_id = [&](const FixedPoint& p)
+            {
+                return size_t(std::lower_bound(vertices.begin(), vertices.end(), p) - vertices.begin());
+            };
+
+            // Outgoing edges grouped per vertex
+            std::vector<size_t> first(vertices.size() + 1, 0);
+            std::vector<size_t> outgoing(boundary.size());
+
+            for (const auto& edge : boundary)
+                first[vertex_id(edge.first) + 1]++;
+
+            for (size_t v = 0; v < vertices.size(); ++v)
+                first[v + 1] += first[v];
+
+            {
+                std::vector<size_t> fill(first.begin(), first.end() - 1);
+
+                for (size_t e = 0; e < boundary.size(); ++e)
+                    outgoing[fill[vertex_id(boundary[e].first)]++] = e;
+            }
+
+            std::vector<bool> used(boundary.size(), false);
+            std::vector<FixedPoint> loop;
+
+            for (size_t start = 0; start < boundary.size(); ++start)
+            {
+                if (used[start])
+                    continue;
+
+                loop.clear();
+
+                size_t edge = start;
+                const FixedPoint origin = boundary[start].first;
+
+                while (true)
+                {
+                    used[edge] = true;
+                    loop.push_back(boundary[edge].first);
+
+                    const FixedPoint from = boundary[edge].first;
+                    const FixedPoint at = boundary[edge].second;
+
+                    if (at == origin)
+                        break;
+
+                    const size_t v = vertex_id(at);
+                    const double in_x = double(at.x - from.x);
+                    const double in_y = double(at.y - from.y);
+
+                    size_t best = size_t(-1);
+                    double best_turn = 0.0;
+
+                    for (size_t k = first[v]; k < first[v + 1]; ++k)
+                    {
+                        const size_t candidate = outgoing[k];
+
+                        if (used[candidate])
+                            continue;
+
+                        const double out_x = double(boundary[candidate].second.x - at.x);
+                        const double out_y = double(boundary[candidate].second.y - at.y);
+                        const double turn = std::atan2(in_x * out_y - in_y * out_x, in_x * out_x + in_y * out_y);
+
+                        if (best == size_t(-1) || turn > best_turn)
+                        {
+                            best = candidate;
+                            best_turn = turn;
+                        }
+                    }
+
+                    if (best == size_t(-1))
+                        break;
+
+                    edge = best;
+                }
+
+                // Drop collinear vertices left behind by edge splitting
+                bool changed = true;
+
+                while (changed && loop.size() >= 3)
+                {
+                    changed = false;
+
+                    for (size_t i = 0; i < loop.size() && loop.size() >= 3;)
+                    {
+                        const FixedPoint& prev = loop[(i + loop.size() - 1) % loop.size()];
+                        const FixedPoint& next = loop[(i + 1) % loop.size()];
+
+                        if (Cross(prev, loop[i], next) == 0)
+                        {
+                            loop.erase(loop.begin() + i);
+                            changed = true;
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
+
+                if (loop.size() < 3)
+                    continue;
+
+                std::vector<Vector2d>& path = out.emplace_back();
+                path.reserve(loop.size());
+
+                for (const FixedPoint& p : loop)
+                    path.emplace_back(double(p.x) * step, double(p.y) * step);
+            }
+        }
+
+        Vector2d EdgeNormal(const Vector2d& a, const Vector2d& b)
+        {
+            const Vector2d d = b - a;
+            const double length = std::sqrt(d.x * d.x + d.y * d.y);
+
+            return length > 0.0 ? Vector2d(d.y / length, -d.x / length) : Vector2d(0.0, 0.0);
+        }
+
+        /**
+         * Raw offset of one closed loop; self-intersections are left for the final union
+         */
+        void OffsetLoop(const std::vector<Vector2d>& loop, double delta, Polygon2DJoinType join,
+                        double miter_limit, double arc_step, std::vector<Vector2d>& out)
+        {
+            const size_t n = loop.size();
+
+            std::vector<Vector2d> normals(n);
+
+            for (size_t i = 0; i < n; ++i)
+                normals[i] = EdgeNormal(loop[i], loop[(i + 1) % n]);
+
+            out.clear();
+
+            for (size_t i = 0; i < n; ++i)
+            {
+                const Vector2d& p = loop[i];
+                const Vector2d& n1 = normals[(i + n - 1) % n];
+                const Vector2d& n2 = normals[i];
+
+                const double sin_a = n1.x * n2.y - n1.y * n2.x;
+                const double cos_a = n1.x * n2.x + n1.y * n2.y;
+
+                // Offset edges overlap at this corner: route through the vertex and let the union clean up
+                if (sin_a * delta < 0.0)
+                {
+                    out.push_back(p + n1 * delta);
+                    out.push_back(p);
+                    out.push_back(p + n2 * delta);
+                    continue;
+                }
+
+                if (join == Polygon2DJoinType::Round)
+                {
+                    const double angle = std::atan2(sin_a, cos_a);
+                    const int steps = std::max(1, int(std::ceil(std::abs(angle) / arc_step)));
+
+                    for (int k = 0; k <= steps; ++k)
+                    {
+                        const double a = angle * double(k) / double(steps);
+                        const double c = std::cos(a);
+                        const double s = std::sin(a);
+
+                        out.push_back(p + Vector2d(n1.x * c - n1.y * s, n1.x * s + n1.y * c) * delta);
+                    }
+
+                    continue;
+                }
+
+                // Miter length is |delta| / cos(half angle) = |delta| * sqrt(2 / (1 + cos_a))
+                if ((1.0 + cos_a) * miter_limit * miter_limit >= 2.0)
+                {
+                    out.push_back(p + (n1 + n2) * (delta / (1.0 + cos_a)));
+                }
+                else
+                {
+                    out.push_back(p + n1 * delta);
+                    out.push_back(p + n2 * delta);
+                }
+            }
+        }
+    }//namespace
+
+    bool Polygon2DBoolean(const Polygon2DPaths& subject,
+                          const Polygon2DPaths& clip,
+                          Polygon2DBooleanOp op,
+                          Polygon2DPaths& out,
+                          Polygon2DFillRule fill_rule)
+    {
+        out.clear();
+
+        double step;
+
+        if (!ComputeGridStep(subject, clip, step))
+            return false;
+
+        std::vector<FixedEdge> edges;
+
+        AppendEdges(subject, 0, 1.0 / step, edges);
+        AppendEdges(clip, 1, 1.0 / step, edges);
+
+        if (edges.empty())
+            return true;
+
+        SplitEdges(edges);
+        MergeEdges(edges);
+
+        std::vector<std::array<int, 2>> below;
+        ComputeWindingBelow(edges, below);
+
+        std::vector<std::pair<FixedPoint, FixedPoint>> boundary;
+
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            const FixedEdge& e = edges[i];
+
+            const bool inside_below = IsInside(IsFilled(below[i][0], fill_rule),
+                                               IsFilled(below[i][1], fill_rule), op);
+            const bool inside_above = IsInside(IsFilled(below[i][0] + e.wind[0], fill_rule),
+                                               IsFilled(below[i][1] + e.wind[1], fill_rule), op);
+
+            if (inside_below == inside_above)
+                continue;
+
+            // Interior on the left: above an edge running from a to b
+            if (inside_above)
+                boundary.emplace_back(e.a, e.b);
+            else
+                boundary.emplace_back(e.b, e.a);
+        }
+
+        TraceLoops(boundary, step, out);
+        return true;
+    }
+
+    bool Polygon2DOffset(const Polygon2DPaths& paths,
+                         double delta,
+                         Polygon2DPaths& out,
+                         Polygon2DJoinType join,
+                         double miter_limit,
+                         double arc_tolerance)
+    {
+        out.clear();
+
+        if (!std::isfinite(delta))
+            return false;
+
+        // Normalise orientation: outer loops CCW, holes CW
+        Polygon2DPaths normalized;
+
+        if (!Polygon2DBoolean(paths, {}, Polygon2DBooleanOp::Union, normalized))
+            return false;
+
+        if (delta == 0.0 || normalized.empty())
+        {
+            out = std::move(normalized);
+            return true;
+        }
+
+        const double radius = std::abs(delta);
+        const double tolerance = arc_tolerance > 0.0 ? std::min(arc_tolerance, radius) : radius * 0.005;
+        const double arc_step = 2.0 * std::acos(1.0 - tolerance / radius);
+
+        Polygon2DPaths raw(normalized.size());
+
+        for (size_t i = 0; i < normalized.size(); ++i)
+            OffsetLoop(normalized[i], delta, join, std::max(miter_limit, 1.0), arc_step, raw[i]);
+
+        return Polygon2DBoolean(raw, {}, Polygon2DBooleanOp::Union, out, Polygon2DFillRule::Positive);
+    }
+}//namespace hgl::math
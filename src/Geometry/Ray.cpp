@@ -2,8 +2,11 @@
 #include<hgl/math/geometry/primitives/Sphere.h>
 #include<hgl/math/geometry/AABB.h>
 #include<hgl/math/geometry/OBB.h>
+#include<hgl/math/geometry/BatchQueryStructures.h>
+#include<hgl/math/ParallelFor.h>
 #include<hgl/graph/CameraInfo.h>
 #include<cmath>
+#include<algorithm>
 
 namespace hgl::math
 {
@@ -69,6 +72,116 @@ namespace hgl::math
             direction=glm::normalize(Vector3f(far_point-near_point));
     }
 
+    namespace
+    {
+        /**
+         * Homogeneous near/far points of window coordinate (x,y) are
+         *     base + x*step_x + y*step_y
+         * because NDC is affine in the window coordinate and Inverse is linear.
+         */
+        struct UnProjectBasis
+        {
+            Vector4f near_base;
+            Vector4f far_base;
+            Vector4f step_x;
+            Vector4f step_y;
+        };
+
+        UnProjectBasis MakeUnProjectBasis(const Matrix4f &Inverse,const Vector2u &viewport,bool reversed_z)
+        {
+            // Same mapping as RayUnProjectZO: ndc = 2*win/viewport-1
+            const Vector4f col_x=Inverse[0];
+            const Vector4f col_y=Inverse[1];
+            const Vector4f col_z=Inverse[2];
+            const Vector4f base=Inverse[3]-col_x-col_y;
+
+            UnProjectBasis basis;
+
+            basis.step_x=col_x*(2.0f/float(viewport.x));
+            basis.step_y=col_y*(2.0f/float(viewport.y));
+            basis.near_base=base+col_z*(reversed_z?1.0f:0.0f);
+            basis.far_base =base+col_z*(reversed_z?0.0f:1.0f);
+
+            return basis;
+        }
+
+        void StoreUnProjectedRay(BatchRaySOA &rays,size_t index,Vector4f near_point,Vector4f far_point)
+        {
+            if(near_point.w!=0.0f)
+                near_point/=near_point.w;
+
+            Vector3f direction;
+
+            // Infinite far plane: far_point is already a direction
+            if(std::fabs(far_point.w)<=1e-7f)
+                direction=glm::normalize(Vector3f(far_point));
+            else
+                direction=glm::normalize(Vector3f(far_point/far_point.w-near_point));
+
+            rays.Set(index,Vector3f(near_point),direction);
+        }
+    }//namespace
+
+    void GenerateViewportRays(BatchRaySOA &rays,const graph::CameraInfo *ci,const Vector2u &viewport_size,
+                              const Vector2i &start,const Vector2u &size,IParallelExecutor *executor)
+    {
+        if(!ci||viewport_size.x==0||viewport_size.y==0)
+        {
+            rays.Resize(0);
+            return;
+        }
+
+        const UnProjectBasis basis=MakeUnProjectBasis(ci->inverse_vp,viewport_size,ci->use_reversed_z!=0);
+        const size_t width=size.x;
+
+        rays.Resize(width*size.y);
+
+        if(width==0)
+            return;
+
+        // Whole rows per chunk, about PARALLEL_CHUNK_BYTES of output each
+        const size_t row_bytes=width*sizeof(float)*6;
+        const size_t rows_per_chunk=std::max<size_t>(1,PARALLEL_CHUNK_BYTES/row_bytes);
+
+        ParallelForChunks(executor,0,size.y,rows_per_chunk,[&](size_t,size_t row_begin,size_t row_end)
+        {
+            for(size_t row=row_begin;row<row_end;row++)
+            {
+                const float y=float(start.y+int(row));
+                const Vector4f near_row=basis.near_base+basis.step_y*y+basis.step_x*float(start.x);
+                const Vector4f far_row =basis.far_base +basis.step_y*y+basis.step_x*float(start.x);
+
+                for(size_t col=0;col<width;col++)
+                {
+                    const float x=float(col);
+
+                    StoreUnProjectedRay(rays,row*width+col,near_row+basis.step_x*x,far_row+basis.step_x*x);
+                }
+            }
+        });
+    }
+
+    void GenerateViewportRays(BatchRaySOA &rays,const graph::CameraInfo *ci,const Vector2u &viewport_size,
+                              const Vector2i *points,size_t count)
+    {
+        if(!ci||!points||viewport_size.x==0||viewport_size.y==0)
+        {
+            rays.Resize(0);
+            return;
+        }
+
+        const UnProjectBasis basis=MakeUnProjectBasis(ci->inverse_vp,viewport_size,ci->use_reversed_z!=0);
+
+        rays.Resize(count);
+
+        for(size_t i=0;i<count;i++)
+        {
+            const Vector4f offset=basis.step_x*float(points[i].x)+basis.step_y*float(points[i].y);
+
+            StoreUnProjectedRay(rays,i,basis.near_base+offset,basis.far_base+offset);
+        }
+    }
+
     /**
      * 从屏幕坐标生成拾取射线 (Vulkan Z-up)
      *
@@ -3,6 +3,272 @@
 
 namespace hgl::math
 {
+    namespace
+    {
+        constexpr uint32_t NO_SEGMENT = 0xFFFFFFFFu;
+
+        // 网格格数上限，防止过小的 cell_size 耗尽内存
+        constexpr size_t MAX_INDEX_CELLS = size_t(1) << 22;
+
+        // 退化线段没有方向，给出默认法线而不是 NaN
+        Vector2f LeftNormal(const Vector2f& delta, float length)
+        {
+            if (!(length > 0.0f))
+                return Vector2f(0, 1);
+
+            return Vector2f(-delta.y, delta.x) / length;
+        }
+
+        // 两条首尾相接线段在公共顶点处的伪法线；不相接或法线相互抵消时沿用本线段法线
+        Vector2f VertexNormal(const ShorelineSegment& seg, const ShorelineSegment& other, bool joined)
+        {
+            if (!joined || !(other.length > 0.0f))
+                return seg.normal;
+
+            // 退化线段的法线没有意义，直接取相邻线段的
+            if (!(seg.length > 0.0f))
+                return other.normal;
+
+            const Vector2f sum = seg.normal + other.normal;
+            const float len = glm::length(sum);
+
+            return len > 1e-6f ? sum / len : seg.normal;
+        }
+    }
+
+    void ShorelineSegmentIndex::Clear()
+    {
+        segments_.clear();
+        cell_start_.clear();
+        cell_segments_.clear();
+        origin_ = Vector2f(0, 0);
+        cell_size_ = 1;
+        inv_cell_size_ = 1;
+        cells_x_ = 0;
+        cells_y_ = 0;
+    }
+
+    void ShorelineSegmentIndex::CellOf(const Vector2f& p, int& cx, int& cy) const
+    {
+        const float fx = (p.x - origin_.x) * inv_cell_size_;
+        const float fy = (p.y - origin_.y) * inv_cell_size_;
+
+        // 取反比较使 NaN 也落到第 0 格
+        cx = !(fx >= 0.0f) ? 0 : (fx >= float(cells_x_) ? cells_x_ - 1 : int(fx));
+        cy = !(fy >= 0.0f) ? 0 : (fy >= float(cells_y_) ? cells_y_ - 1 : int(fy));
+    }
+
+    void ShorelineSegmentIndex::Build(const std::vector<ShorelineContour>& contours, float cell_size)
+    {
+        Clear();
+
+        Vector2f bmin( std::numeric_limits<float>::max());
+        Vector2f bmax(-std::numeric_limits<float>::max());
+        double total_length = 0;
+
+        for (size_t c = 0; c < contours.size(); ++c)
+        {
+            const auto& segs = contours[c].segments;
+            const size_t m = segs.size();
+
+            for (size_t k = 0; k < m; ++k)
+            {
+                const ShorelineSegment& seg = segs[k];
+                const ShorelineSegment& prev = segs[k > 0 ? k - 1 : m - 1];
+                const ShorelineSegment& next = segs[k + 1 < m ? k + 1 : 0];
+
+                if (!std::isfinite(seg.start.x) || !std::isfinite(seg.start.y)
+                 || !std::isfinite(seg.end.x) || !std::isfinite(seg.end.y))
+                    continue;
+
+                IndexedSegment s;
+                s.start = seg.start;
+                s.delta = seg.end - seg.start;
+
+                const float len_sq = glm::dot(s.delta, s.delta);
+                s.inv_length_sq = len_sq >= 1e-8f ? 1.0f / len_sq : 0.0f;
+                s.length = seg.length;
+                s.accumulated_length = seg.accumulated_length;
+                s.normal = seg.normal;
+                s.start_normal = VertexNormal(seg, prev, m > 1 && prev.end == seg.start);
+                s.end_normal = VertexNormal(seg, next, m > 1 && seg.end == next.start);
+                s.contour_id = static_cast<int>(c);
+
+                segments_.push_back(s);
+
+                bmin = glm::min(bmin, glm::min(seg.start, seg.end));
+                bmax = glm::max(bmax, glm::max(seg.start, seg.end));
+                total_length += std::sqrt(len_sq);
+            }
+        }
+
+        if (segments_.empty())
+            return;
+
+        const size_t n = segments_.size();
+        const Vector2f extent = bmax - bmin;
+
+        if (!(cell_size > 0.0f) || !std::isfinite(cell_size))
+        {
+            // 约每格一条线段：不小于平均线段长度，格数不超过线段数
+            const double avg = total_length / double(n);
+            const double by_area = std::sqrt(double(extent.x) * double(extent.y) / double(n));
+
+            cell_size = float(std::max(avg, by_area));
+
+            if (!(cell_size > 0.0f))
+                cell_size = std::max(std::max(extent.x, extent.y), 1.0f);
+        }
+
+        for (;;)
+        {
+            const double cx = std::floor(double(extent.x) / cell_size) + 1.0;
+            const double cy = std::floor(double(extent.y) / cell_size) + 1.0;
+
+            if (cx * cy <= double(MAX_INDEX_CELLS))
+            {
+                cells_x_ = int(cx);
+                cells_y_ = int(cy);
+                break;
+            }
+
+            cell_size *= 2.0f;
+        }
+
+        origin_ = bmin;
+        cell_size_ = cell_size;
+        inv_cell_size_ = 1.0f / cell_size;
+
+        // 按线段包围盒覆盖的格子分桶（CSR 布局）
+        const size_t cell_count = size_t(cells_x_) * size_t(cells_y_);
+        cell_start_.assign(cell_count + 1, 0);
+
+        auto for_each_cell = [&](const IndexedSegment& s, auto&& func)
+        {
+            int x0, y0, x1, y1;
+            CellOf(s.start, x0, y0);
+            CellOf(s.start + s.delta, x1, y1);
+
+            if (x0 > x1) std::swap(x0, x1);
+            if (y0 > y1) std::swap(y0, y1);
+
+            for (int y = y0; y <= y1; ++y)
+                for (int x = x0; x <= x1; ++x)
+                    func(size_t(y) * size_t(cells_x_) + size_t(x));
+        };
+
+        for (const auto& s : segments_)
+            for_each_cell(s, [&](size_t cell) { ++cell_start_[cell + 1]; });
+
+        for (size_t i = 0; i < cell_count; ++i)
+            cell_start_[i + 1] += cell_start_[i];
+
+        cell_segments_.resize(cell_start_[cell_count]);
+
+        std::vector<uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+
+        for (size_t i = 0; i < n; ++i)
+            for_each_cell(segments_[i], [&](size_t cell) { cell_segments_[fill[cell]++] = uint32_t(i); });
+    }
+
+    bool ShorelineSegmentIndex::Query(const Vector2f& point, ShorelineQueryResult& result, float max_distance) const
+    {
+        result = ShorelineQueryResult();
+
+        if (segments_.empty() || !std::isfinite(point.x) || !std::isfinite(point.y))
+            return false;
+
+        int cx, cy;
+        CellOf(point, cx, cy);
+
+        float best_sq = max_distance < std::numeric_limits<float>::max()
+                      ? max_distance * max_distance
+                      : std::numeric_limits<float>::max();
+        uint32_t best = NO_SEGMENT;
+        float best_t = 0;
+
+        auto test_cell = [&](int x, int y)
+        {
+            const size_t cell = size_t(y) * size_t(cells_x_) + size_t(x);
+
+            for (uint32_t k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k)
+            {
+                const uint32_t id = cell_segments_[k];
+                const IndexedSegment& s = segments_[id];
+
+                const Vector2f ap = point - s.start;
+                const float t = glm::clamp(glm::dot(ap, s.delta) * s.inv_length_sq, 0.0f, 1.0f);
+                const Vector2f d = ap - t * s.delta;
+                const float dist_sq = glm::dot(d, d);
+
+                // 距离相等取序号较小者，使结果与访问顺序无关
+                if (dist_sq < best_sq || (dist_sq == best_sq && id < best))
+                {
+                    best_sq = dist_sq;
+                    best = id;
+                    best_t = t;
+                }
+            }
+        };
+
+        const int max_ring = std::max(std::max(cx, cells_x_ - 1 - cx), std::max(cy, cells_y_ - 1 - cy));
+
+        for (int r = 0; r <= max_ring; ++r)
+        {
+            const int x0 = std::max(cx - r, 0);
+            const int x1 = std::min(cx + r, cells_x_ - 1);
+            const int y0 = std::max(cy - r, 0);
+            const int y1 = std::min(cy + r, cells_y_ - 1);
+
+            for (int y = y0; y <= y1; ++y)
+            {
+                if (y == cy - r || y == cy + r)
+                {
+                    for (int x = x0; x <= x1; ++x)
+                        test_cell(x, y);
+                }
+                else
+                {
+                    if (cx - r >= 0)        test_cell(cx - r, y);
+                    if (cx + r < cells_x_)  test_cell(cx + r, y);
+                }
+            }
+
+            // 第 r 圈之外的格子与查询点至少相距 r 个格宽
+            const float reach = float(r) * cell_size_;
+
+            if (reach * reach >= best_sq || reach > max_distance)
+                break;
+        }
+
+        if (best == NO_SEGMENT)
+            return false;
+
+        const IndexedSegment& s = segments_[best];
+
+        result.distance = std::sqrt(best_sq);
+        result.closest_point = s.start + best_t * s.delta;
+        result.distance_along_contour = s.accumulated_length + best_t * s.length;
+        // 最近点落在端点时按顶点伪法线判断内外，单条线段的法线在尖角处会给错符号
+        result.normal = best_t <= 0.0f ? s.start_normal : (best_t >= 1.0f ? s.end_normal : s.normal);
+        result.contour_id = s.contour_id;
+        return true;
+    }
+
+    void ShorelineSegmentIndex::QueryBatch(const Vector2f* points, size_t count, ShorelineQueryResult* results,
+                                           IParallelExecutor* executor, float max_distance) const
+    {
+        if (!points || !results || count == 0)
+            return;
+
+        ParallelForChunks(executor, 0, count, ComputeChunkSize(sizeof(ShorelineQueryResult)),
+            [&](size_t, size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    Query(points[i], results[i], max_distance);
+            });
+    }
+
     void ShallowWaterMeshData::ExportToArrays(float** vertex_data, int* vertex_count, int vertex_stride,
                            uint32_t** index_data, int* index_count)
     {
@@ -86,9 +352,8 @@ namespace hgl::math
             seg.length = glm::length(seg.end - seg.start);
             seg.accumulated_length = accumulated;
 
-            // 计算法线（指向陆地，即向右旋转90度）
-            Vector2f dir = glm::normalize(seg.end - seg.start);
-            seg.normal = Vector2f(dir.y, -dir.x);
+            // 计算法线（指向陆地）：等高线定向为高处在左侧，即向左旋转90度
+            seg.normal = LeftNormal(seg.end - seg.start, seg.length);
 
             shoreline.segments.push_back(seg);
             accumulated += seg.length;
@@ -103,8 +368,7 @@ namespace hgl::math
             seg.length = glm::length(seg.end - seg.start);
             seg.accumulated_length = accumulated;
 
-            Vector2f dir = glm::normalize(seg.end - seg.start);
-            seg.normal = Vector2f(dir.y, -dir.x);
+            seg.normal = LeftNormal(seg.end - seg.start, seg.length);
 
             shoreline.segments.push_back(seg);
             accumulated += seg.length;
@@ -136,7 +400,7 @@ namespace hgl::math
         }
     }
 
-    ShallowWaterMeshData ShallowWaterDataExtractor::Extract()
+    ShallowWaterMeshData ShallowWaterDataExtractor::Extract(IParallelExecutor* executor)
     {
         ShallowWaterMeshData mesh_data;
 
@@ -146,12 +410,119 @@ namespace hgl::math
         // 提取海岸线
         ExtractShorelineOnly(mesh_data.shore_contours, mesh_data.deep_water_contours);
 
-        // 简化实现：这里返回空的网格数据
-        // 完整实现需要：
-        // 1. 生成规则网格
-        // 2. 计算每个顶点到海岸线的距离
-        // 3. 生成三角形索引
-        // 4. 计算UV和法线信息
+        ShorelineSegmentIndex index;
+        index.Build(mesh_data.shore_contours);
+
+        if (index.IsEmpty())
+            return mesh_data;
+
+        const float spacing = config_.grid_spacing > 0.0f ? config_.grid_spacing : 1.0f;
+        const float depth = std::max(config_.max_wave_depth, 0.0f);
+
+        // 在海岸线包围盒外扩海浪带宽度的范围内生成规则网格
+        Vector2f bmin( std::numeric_limits<float>::max());
+        Vector2f bmax(-std::numeric_limits<float>::max());
+
+        for (const auto& contour : mesh_data.shore_contours)
+            for (const auto& seg : contour.segments)
+            {
+                bmin = glm::min(bmin, glm::min(seg.start, seg.end));
+                bmax = glm::max(bmax, glm::max(seg.start, seg.end));
+            }
+
+        bmin -= Vector2f(depth + spacing);
+        bmax += Vector2f(depth + spacing);
+
+        const double nx_d = std::ceil(double(bmax.x - bmin.x) / spacing) + 1.0;
+        const double ny_d = std::ceil(double(bmax.y - bmin.y) / spacing) + 1.0;
+
+        if (!(nx_d * ny_d < double(std::numeric_limits<uint32_t>::max())))
+            return mesh_data;
+
+        const size_t nx = size_t(nx_d);
+        const size_t ny = size_t(ny_d);
+        const size_t grid_count = nx * ny;
+
+        std::vector<Vector2f> positions(grid_count);
+
+        for (size_t y = 0; y < ny; ++y)
+            for (size_t x = 0; x < nx; ++x)
+                positions[y * nx + x] = bmin + Vector2f(float(x) * spacing, float(y) * spacing);
+
+        // 超出海浪带一个格对角线的点不会属于保留的格子，可限制搜索半径
+        std::vector<ShorelineQueryResult> hits(grid_count);
+        index.QueryBatch(positions.data(), grid_count, hits.data(), executor, depth + spacing * 2.0f);
+
+        std::vector<float> signed_distance(grid_count);
+
+        for (size_t i = 0; i < grid_count; ++i)
+        {
+            const ShorelineQueryResult& hit = hits[i];
+            float d = hit.distance;
+
+            // 法线指向陆地，位于法线一侧为负
+            if (hit.contour_id >= 0 && glm::dot(positions[i] - hit.closest_point, hit.normal) > 0.0f)
+                d = -d;
+
+            signed_distance[i] = d;
+        }
+
+        auto in_band = [&](size_t i)
+        {
+            return signed_distance[i] >= -spacing && signed_distance[i] <= depth;
+        };
+
+        // 只保留与海浪带相交的格子，其角点压缩存入顶点列表
+        std::vector<uint32_t> remap(grid_count, NO_SEGMENT);
+
+        auto emit = [&](size_t i) -> uint32_t
+        {
+            if (remap[i] != NO_SEGMENT)
+                return remap[i];
+
+            const ShorelineQueryResult& hit = hits[i];
+
+            ShallowWaterVertex v;
+            v.position = positions[i];
+            v.distance_to_shore = signed_distance[i];
+            v.shore_normal = hit.normal;
+            v.contour_id = hit.contour_id;
+
+            if (hit.contour_id >= 0)
+            {
+                const float total = mesh_data.shore_contours[hit.contour_id].total_length;
+                v.contour_position = total > 0.0f ? glm::clamp(hit.distance_along_contour / total, 0.0f, 1.0f) : 0.0f;
+            }
+
+            v.depth_normalized = depth > 0.0f ? glm::clamp(signed_distance[i] / depth, 0.0f, 1.0f) : 0.0f;
+
+            remap[i] = static_cast<uint32_t>(mesh_data.vertices.size());
+            mesh_data.vertices.push_back(v);
+            return remap[i];
+        };
+
+        for (size_t y = 0; y + 1 < ny; ++y)
+            for (size_t x = 0; x + 1 < nx; ++x)
+            {
+                const size_t i00 = y * nx + x;
+                const size_t i10 = i00 + 1;
+                const size_t i01 = i00 + nx;
+                const size_t i11 = i01 + 1;
+
+                if (!in_band(i00) && !in_band(i10) && !in_band(i01) && !in_band(i11))
+                    continue;
+
+                const uint32_t v00 = emit(i00);
+                const uint32_t v10 = emit(i10);
+                const uint32_t v11 = emit(i11);
+                const uint32_t v01 = emit(i01);
+
+                if (config_.generate_indices)
+                {
+                    mesh_data.indices.insert(mesh_data.indices.end(), { v00, v10, v11 });
+                    mesh_data.indices.insert(mesh_data.indices.end(), { v00, v11, v01 });
+                }
+            }
 
         return mesh_data;
     }
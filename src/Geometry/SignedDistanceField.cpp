@@ -0,0 +1,389 @@
+﻿/**
+ * SignedDistanceField.cpp - Sparse brick SDF baking and sampling
+ *
+ * Samples live on a regular lattice; sample (x,y,z) belongs to brick (x/8,y/8,z/8).
+ * Trilinear lookups whose 2x2x2 footprint stays inside one brick read it directly,
+ * the rest fall back to per-sample brick lookup.
+ */
+#include<hgl/math/geometry/primitives/SignedDistanceField.h>
+#include<hgl/math/geometry/primitives/TriangleMesh.h>
+#include<hgl/math/geometry/PreparedRay.h>
+#include<hgl/math/geometry/Ray.h>
+#include<hgl/math/geometry/BatchQueryStructures.h>
+#include<hgl/math/geometry/queries/CollisionDispatch.h>
+#include<hgl/math/geometry/queries/DistanceQuery.h>
+#include<hgl/math/geometry/queries/GJK.h>
+#include<hgl/math/ParallelFor.h>
+#include<algorithm>
+#include<cfloat>
+#include<cmath>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr int B=SignedDistanceField::BRICK_SIZE;
+        constexpr uint32_t MAX_PARITY_HITS=256;
+
+        // Slightly off-axis so parity rays rarely graze edges or vertices of grid-aligned meshes
+        const Vector3f PARITY_DIRECTIONS[3]=
+        {
+            Normalized(Vector3f(1.0f,0.0137f,0.0071f)),
+            Normalized(Vector3f(0.0093f,1.0f,0.0121f)),
+            Normalized(Vector3f(0.0059f,0.0103f,1.0f))
+        };
+
+        /**
+         * Signed distance to a closed triangle mesh, clamped to the search radius
+         */
+        struct MeshEvaluator
+        {
+            struct State
+            {
+                TriangleMeshCache cache;
+            };
+
+            const TriangleMesh &mesh;
+            float step;                     // advance past each parity hit
+
+            MeshEvaluator(const TriangleMesh &m):mesh(m)
+            {
+                const AABB box=mesh.GetBoundingBox();
+
+                step=std::max(Length(box.GetMax()-box.GetMin())*1e-5f,1e-6f);
+            }
+
+            uint32_t CountCrossings(const Vector3f &point,const Vector3f &direction)const
+            {
+                Vector3f origin=point;
+                uint32_t count=0;
+                MeshRayHit hit;
+
+                while(count<MAX_PARITY_HITS&&mesh.Raycast(PreparedRay(Ray(origin,direction)),FLT_MAX,hit))
+                {
+                    ++count;
+                    origin+=direction*(hit.distance+step);
+                }
+
+                return count;
+            }
+
+            bool IsInside(const Vector3f &point)const
+            {
+                int votes=0;
+
+                for(const Vector3f &direction:PARITY_DIRECTIONS)
+                    if(CountCrossings(point,direction)&1)
+                        ++votes;
+
+                return votes>=2;
+            }
+
+            float operator()(const Vector3f &point,float radius,State &state)const
+            {
+                MeshClosestPoint closest;
+
+                const float distance=mesh.ClosestPoint(point,radius,closest,&state.cache)?closest.distance:radius;
+
+                return IsInside(point)?-distance:distance;
+            }
+        };
+
+        /**
+         * Union of primitive shapes, clamped to the search radius
+         */
+        struct ShapeEvaluator
+        {
+            struct State{};
+
+            const CollisionShapeSet &shapes;
+
+            float operator()(const Vector3f &point,float radius,State &)const
+            {
+                float d=radius;
+
+                for(size_t i=0;i<shapes.sphere_count;i++)   d=std::min(d,DistanceQuery::SignedDistance(point,shapes.spheres[i]));
+                for(size_t i=0;i<shapes.capsule_count;i++)  d=std::min(d,DistanceQuery::SignedDistance(point,shapes.capsules[i]));
+                for(size_t i=0;i<shapes.cylinder_count;i++) d=std::min(d,DistanceQuery::SignedDistance(point,shapes.cylinders[i]));
+                for(size_t i=0;i<shapes.cone_count;i++)     d=std::min(d,DistanceQuery::SignedDistance(point,shapes.cones[i]));
+                for(size_t i=0;i<shapes.torus_count;i++)    d=std::min(d,DistanceQuery::SignedDistance(point,shapes.tori[i]));
+                for(size_t i=0;i<shapes.aabb_count;i++)     d=std::min(d,DistanceQuery::SignedDistance(point,shapes.aabbs[i]));
+                for(size_t i=0;i<shapes.obb_count;i++)      d=std::min(d,DistanceQuery::SignedDistance(point,shapes.obbs[i]));
+
+                for(size_t i=0;i<shapes.hull_count;i++)
+                    d=std::min(d,GJK::Distance(point,shapes.hulls[i]));
+
+                for(size_t i=0;i<shapes.triangle_count;i++)
+                {
+                    const Triangle3f &tri=shapes.triangles[i];
+
+                    d=std::min(d,Length(point-ClosestPointOnTriangle(point,tri[0],tri[1],tri[2])));
+                }
+
+                return std::max(d,-radius);
+            }
+        };
+    }//namespace
+
+    void SignedDistanceField::Clear()
+    {
+        origin=Vector3f(0,0,0);
+        voxel_size=inv_voxel_size=1.0f;
+        max_distance=0.0f;
+
+        for(int i=0;i<3;i++)
+            sample_count[i]=brick_count[i]=0;
+
+        bricks.clear();
+        samples.clear();
+    }
+
+    bool SignedDistanceField::Setup(const AABB &bounds,float voxel,float band)
+    {
+        Clear();
+
+        if(!(voxel>0.0f)||!(band>0.0f))
+            return false;
+
+        const Vector3f size=bounds.GetMax()-bounds.GetMin();
+
+        for(int i=0;i<3;i++)
+        {
+            if(!(size[i]>=0.0f)||size[i]/voxel>=float(MAX_SAMPLES_PER_AXIS))
+                return false;
+
+            sample_count[i]=std::max(int(std::ceil(size[i]/voxel))+1,2);
+            brick_count[i]=(sample_count[i]+B-1)/B;
+        }
+
+        origin=bounds.GetMin();
+        voxel_size=voxel;
+        inv_voxel_size=1.0f/voxel;
+        max_distance=band;
+
+        bricks.assign(size_t(brick_count[0])*brick_count[1]*brick_count[2],Brick{UNIFORM_BRICK,band});
+        return true;
+    }
+
+    template<typename Evaluator>
+    void SignedDistanceField::BakeBricks(const Evaluator &evaluator,IParallelExecutor *executor)
+    {
+        const size_t total=bricks.size();
+        const size_t row=size_t(brick_count[0]);
+        const size_t slice=row*brick_count[1];
+
+        auto brick_base=[&](size_t index)
+            {
+                return Vector3f(float(index%row*B),float(index/row%brick_count[1]*B),float(index/slice*B));
+            };
+
+        // Pass 1: one distance per brick center. The field is 1-Lipschitz, so a center farther than
+        // band + half diagonal leaves every sample of the brick clamped with the same sign.
+        const float half_diagonal=0.5f*float(B-1)*voxel_size*std::sqrt(3.0f);
+        const float skip_radius=max_distance+half_diagonal;
+
+        ParallelForChunks(executor,0,total,1,[&](size_t,size_t begin,size_t end)
+            {
+                typename Evaluator::State state;
+
+                for(size_t i=begin;i<end;i++)
+                {
+                    const Vector3f center=origin+(brick_base(i)+Vector3f(0.5f*(B-1)))*voxel_size;
+                    const float d=evaluator(center,skip_radius,state);
+
+                    if(std::abs(d)>=skip_radius)
+                        bricks[i]=Brick{UNIFORM_BRICK,d>0.0f?max_distance:-max_distance};
+                    else
+                        bricks[i]=Brick{0,0.0f};
+                }
+            });
+
+        uint32_t dense=0;
+
+        for(Brick &brick:bricks)
+            if(brick.offset!=UNIFORM_BRICK)
+                brick.offset=BRICK_VOLUME*dense++;
+
+        samples.resize(size_t(dense)*BRICK_VOLUME);
+
+        // Pass 2: full samples for bricks near the surface
+        ParallelForChunks(executor,0,total,1,[&](size_t,size_t begin,size_t end)
+            {
+                typename Evaluator::State state;
+
+                for(size_t i=begin;i<end;i++)
+                {
+                    if(bricks[i].offset==UNIFORM_BRICK)
+                        continue;
+
+                    const Vector3f base=brick_base(i);
+                    float *out=samples.data()+bricks[i].offset;
+
+                    for(int z=0;z<B;z++)
+                    for(int y=0;y<B;y++)
+                    for(int x=0;x<B;x++)
+                    {
+                        const Vector3f p=origin+(base+Vector3f(float(x),float(y),float(z)))*voxel_size;
+
+                        *out++=std::clamp(evaluator(p,max_distance,state),-max_distance,max_distance);
+                    }
+                }
+            });
+    }
+
+    bool SignedDistanceField::Bake(const TriangleMesh &mesh,const AABB &bounds,float voxel,float band,IParallelExecutor *executor)
+    {
+        if(mesh.IsEmpty()||!Setup(bounds,voxel,band))
+        {
+            Clear();
+            return false;
+        }
+
+        BakeBricks(MeshEvaluator(mesh),executor);
+        return true;
+    }
+
+    bool SignedDistanceField::Bake(const CollisionShapeSet &shapes,const AABB &bounds,float voxel,float band,IParallelExecutor *executor)
+    {
+        if(!Setup(bounds,voxel,band))
+            return false;
+
+        BakeBricks(ShapeEvaluator{shapes},executor);
+        return true;
+    }
+
+    AABB SignedDistanceField::GetBoundingBox()const
+    {
+        AABB box;
+
+        box.SetMinMax(origin,origin+Vector3f(float(sample_count[0]-1),float(sample_count[1]-1),float(sample_count[2]-1))*voxel_size);
+        return box;
+    }
+
+    float SignedDistanceField::GetSample(int x,int y,int z)const
+    {
+        const Brick &brick=bricks[(size_t(z/B)*brick_count[1]+y/B)*brick_count[0]+x/B];
+
+        if(brick.offset==UNIFORM_BRICK)
+            return brick.value;
+
+        return samples[brick.offset+((z%B)*B+(y%B))*B+(x%B)];
+    }
+
+    float SignedDistanceField::Interpolate(const Vector3f &point,Vector3f *gradient)const
+    {
+        int i[3];
+        float f[3];
+
+        for(int a=0;a<3;a++)
+        {
+            const float g=std::clamp((point[a]-origin[a])*inv_voxel_size,0.0f,float(sample_count[a]-1));
+
+            i[a]=std::min(int(g),sample_count[a]-2);
+            f[a]=g-float(i[a]);
+        }
+
+        float c[8];        // c[(dz*2+dy)*2+dx]
+
+        const int lx=i[0]%B,ly=i[1]%B,lz=i[2]%B;
+
+        if(lx<B-1&&ly<B-1&&lz<B-1)
+        {
+            const Brick &brick=bricks[(size_t(i[2]/B)*brick_count[1]+i[1]/B)*brick_count[0]+i[0]/B];
+
+            if(brick.offset==UNIFORM_BRICK)
+            {
+                if(gradient)
+                    *gradient=Vector3f(0,0,0);
+
+                return brick.value;
+            }
+
+            const float *s=samples.data()+brick.offset+(lz*B+ly)*B+lx;
+
+            c[0]=s[0];      c[1]=s[1];
+            c[2]=s[B];      c[3]=s[B+1];
+            c[4]=s[B*B];    c[5]=s[B*B+1];
+            c[6]=s[B*B+B];  c[7]=s[B*B+B+1];
+        }
+        else
+        {
+            for(int k=0;k<8;k++)
+                c[k]=GetSample(i[0]+(k&1),i[1]+((k>>1)&1),i[2]+(k>>2));
+        }
+
+        const float fx=f[0],fy=f[1],fz=f[2];
+
+        const float c00=c[0]+(c[1]-c[0])*fx;
+        const float c10=c[2]+(c[3]-c[2])*fx;
+        const float c01=c[4]+(c[5]-c[4])*fx;
+        const float c11=c[6]+(c[7]-c[6])*fx;
+
+        const float c0=c00+(c10-c00)*fy;
+        const float c1=c01+(c11-c01)*fy;
+
+        if(gradient)
+        {
+            const float gx0=(c[1]-c[0])+((c[3]-c[2])-(c[1]-c[0]))*fy;
+            const float gx1=(c[5]-c[4])+((c[7]-c[6])-(c[5]-c[4]))*fy;
+
+            gradient->x=(gx0+(gx1-gx0)*fz)*inv_voxel_size;
+            gradient->y=((c10-c00)+((c11-c01)-(c10-c00))*fz)*inv_voxel_size;
+            gradient->z=(c1-c0)*inv_voxel_size;
+        }
+
+        return c0+(c1-c0)*fz;
+    }
+
+    float SignedDistanceField::Sample(const Vector3f &point,Vector3f *gradient)const
+    {
+        if(bricks.empty())
+        {
+            if(gradient)
+                *gradient=Vector3f(0,0,0);
+
+            return 0.0f;
+        }
+
+        const Vector3f lo=origin;
+        const Vector3f hi=origin+Vector3f(float(sample_count[0]-1),float(sample_count[1]-1),float(sample_count[2]-1))*voxel_size;
+        const Vector3f clamped(std::clamp(point.x,lo.x,hi.x),std::clamp(point.y,lo.y,hi.y),std::clamp(point.z,lo.z,hi.z));
+
+        const Vector3f outside=point-clamped;
+        const float outside_distance=Length(outside);
+
+        if(outside_distance<=0.0f)
+            return Interpolate(point,gradient);
+
+        if(gradient)
+            *gradient=outside/outside_distance;
+
+        return Interpolate(clamped,nullptr)+outside_distance;
+    }
+
+    Vector3f SignedDistanceField::ClosestPoint(const Vector3f &point)const
+    {
+        Vector3f gradient;
+        const float d=Sample(point,&gradient);
+        const float len=Length(gradient);
+
+        if(len<=0.0f)
+            return point;
+
+        return point-gradient*(d/len);
+    }
+
+    void SignedDistanceField::Sample(const BatchPointSOA &points,float *distance,Vector3f *gradient,IParallelExecutor *executor)const
+    {
+        if(!distance)
+            return;
+
+        const size_t bytes=sizeof(float)*4+(gradient?sizeof(Vector3f):0);
+
+        ParallelForChunks(executor,0,points.count,ComputeChunkSize(bytes),[&](size_t,size_t begin,size_t end)
+            {
+                for(size_t i=begin;i<end;i++)
+                    distance[i]=Sample(points.Get(i),gradient?gradient+i:nullptr);
+            });
+    }
+}//namespace hgl::math
@@ -0,0 +1,636 @@
+﻿/**
+ * TriangleMesh.cpp - Static triangle mesh collider
+ *
+ * The BVH is built top-down with binned SAH and flattened in depth first
+ * order: the left child directly follows its parent, so a node only stores
+ * the right child index. Traversal uses a fixed size stack.
+ */
+#include<hgl/math/geometry/primitives/TriangleMesh.h>
+#include<hgl/math/geometry/primitives/Sphere.h>
+#include<hgl/math/geometry/primitives/Capsule.h>
+#include<hgl/math/geometry/OBB.h>
+#include<hgl/math/geometry/Ray.h>
+#include<hgl/math/geometry/PreparedRay.h>
+#include<hgl/math/geometry/queries/RaycastQuery.h>
+#include<hgl/math/geometry/queries/DistanceQuery.h>
+#include<algorithm>
+#include<cfloat>
+#include<numeric>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr uint32_t SAH_BIN_COUNT=12;
+
+        using Node=TriangleMesh::Node;
+
+        float HalfSurfaceArea(const Vector3f &min_point,const Vector3f &max_point)
+        {
+            const Vector3f e=max_point-min_point;
+
+            return e.x*e.y+e.y*e.z+e.z*e.x;
+        }
+
+        bool BoxOverlap(const Node &node,const Vector3f &min_point,const Vector3f &max_point)
+        {
+            return node.min_point.x<=max_point.x&&node.max_point.x>=min_point.x
+                 &&node.min_point.y<=max_point.y&&node.max_point.y>=min_point.y
+                 &&node.min_point.z<=max_point.z&&node.max_point.z>=min_point.z;
+        }
+
+        float BoxDistanceSquared(const Node &node,const Vector3f &p)
+        {
+            const Vector3f d=glm::max(glm::max(node.min_point-p,p-node.max_point),Vector3f(0,0,0));
+
+            return Dot(d,d);
+        }
+
+        /**
+         * Slab test, returns the entry distance through t_enter
+         */
+        bool RayBox(const Node &node,const PreparedRay &ray,float t_max,float &t_enter)
+        {
+            float t_exit;
+            return ray.IntersectsBox(node.min_point,node.max_point,0.0f,t_max,t_enter,t_exit);
+        }
+
+        /**
+         * Depth first traversal; visit returns true to stop
+         */
+        template<typename BoxTest,typename Visit>
+        bool Traverse(const std::vector<Node> &nodes,const std::vector<uint32_t> &order,BoxTest &&box_test,Visit &&visit)
+        {
+            if(nodes.empty())
+                return false;
+
+            uint32_t stack[TriangleMesh::MAX_DEPTH];
+            uint32_t sp=0;
+
+            stack[sp++]=0;
+
+            while(sp>0)
+            {
+                const uint32_t index=stack[--sp];
+                const Node &node=nodes[index];
+
+                if(!box_test(node))
+                    continue;
+
+                if(node.count>0)
+                {
+                    for(uint32_t i=0;i<node.count;i++)
+                        if(visit(order[node.first+i]))
+                            return true;
+
+                    continue;
+                }
+
+                stack[sp++]=node.first;
+                stack[sp++]=index+1;
+            }
+
+            return false;
+        }
+    }//namespace
+
+    void TriangleMesh::Clear()
+    {
+        vertices.clear();
+        indices.clear();
+        triangle_order.clear();
+        nodes.clear();
+        depth=0;
+    }
+
+    bool TriangleMesh::Set(const Vector3f *v,uint32_t vertex_count,const uint32_t *idx,uint32_t index_count)
+    {
+        Clear();
+
+        if(!v||!idx||vertex_count==0||index_count==0||index_count%3!=0)
+            return false;
+
+        for(uint32_t i=0;i<index_count;i++)
+            if(idx[i]>=vertex_count)
+                return false;
+
+        vertices.assign(v,v+vertex_count);
+        indices.assign(idx,idx+index_count);
+
+        const uint32_t tri_count=index_count/3;
+
+        std::vector<Vector3f> centroids(tri_count);
+        std::vector<Vector3f> tri_min(tri_count);
+        std::vector<Vector3f> tri_max(tri_count);
+
+        for(uint32_t i=0;i<tri_count;i++)
+        {
+            Vector3f a,b,c;
+            GetVertices(i,a,b,c);
+
+            tri_min[i]=glm::min(a,glm::min(b,c));
+            tri_max[i]=glm::max(a,glm::max(b,c));
+            centroids[i]=(a+b+c)/3.0f;
+        }
+
+        triangle_order.resize(tri_count);
+        std::iota(triangle_order.begin(),triangle_order.end(),0u);
+
+        nodes.reserve(tri_count*2);
+        Build(0,tri_count,1,centroids,tri_min,tri_max);
+
+        return true;
+    }
+
+    uint32_t TriangleMesh::Build(uint32_t first,uint32_t count,uint32_t level,std::vector<Vector3f> &centroids,std::vector<Vector3f> &tri_min,std::vector<Vector3f> &tri_max)
+    {
+        const uint32_t node_index=uint32_t(nodes.size());
+
+        nodes.push_back(Node());
+
+        Vector3f box_min( FLT_MAX, FLT_MAX, FLT_MAX),box_max(-FLT_MAX,-FLT_MAX,-FLT_MAX);
+        Vector3f cen_min( FLT_MAX, FLT_MAX, FLT_MAX),cen_max(-FLT_MAX,-FLT_MAX,-FLT_MAX);
+
+        for(uint32_t i=first;i<first+count;i++)
+        {
+            const uint32_t tri=triangle_order[i];
+
+            box_min=glm::min(box_min,tri_min[tri]);
+            box_max=glm::max(box_max,tri_max[tri]);
+            cen_min=glm::min(cen_min,centroids[tri]);
+            cen_max=glm::max(cen_max,centroids[tri]);
+        }
+
+        nodes[node_index].min_point=box_min;
+        nodes[node_index].max_point=box_max;
+        depth=std::max(depth,level);
+
+        if(count<=MAX_LEAF_TRIANGLES||level>=MAX_DEPTH-1)
+        {
+            nodes[node_index].first=first;
+            nodes[node_index].count=count;
+            return node_index;
+        }
+
+        // Binned SAH along the longest centroid axis
+        const Vector3f extent=cen_max-cen_min;
+        const int axis=(extent.x>=extent.y&&extent.x>=extent.z)?0:(extent.y>=extent.z?1:2);
+
+        uint32_t *begin=triangle_order.data()+first;
+        uint32_t *end=begin+count;
+        uint32_t *middle=begin+count/2;
+
+        if(extent[axis]>0.0f)
+        {
+            struct Bin
+            {
+                Vector3f min_point{ FLT_MAX, FLT_MAX, FLT_MAX};
+                Vector3f max_point{-FLT_MAX,-FLT_MAX,-FLT_MAX};
+                uint32_t count=0;
+            };
+
+            Bin bins[SAH_BIN_COUNT];
+            const float scale=float(SAH_BIN_COUNT)/extent[axis];
+
+            auto bin_of=[&](uint32_t tri)
+            {
+                const int b=int((centroids[tri][axis]-cen_min[axis])*scale);
+
+                return uint32_t(std::clamp(b,0,int(SAH_BIN_COUNT)-1));
+            };
+
+            for(uint32_t *it=begin;it<end;++it)
+            {
+                Bin &bin=bins[bin_of(*it)];
+
+                bin.min_point=glm::min(bin.min_point,tri_min[*it]);
+                bin.max_point=glm::max(bin.max_point,tri_max[*it]);
+                ++bin.count;
+            }
+
+            // Right to left sweep stores the right side cost of each split
+            float right_cost[SAH_BIN_COUNT];
+            Bin acc;
+
+            for(uint32_t i=SAH_BIN_COUNT-1;i>0;i--)
+            {
+                acc.min_point=glm::min(acc.min_point,bins[i].min_point);
+                acc.max_point=glm::max(acc.max_point,bins[i].max_point);
+                acc.count+=bins[i].count;
+                right_cost[i]=acc.count?acc.count*HalfSurfaceArea(acc.min_point,acc.max_point):0.0f;
+            }
+
+            acc=Bin();
+
+            float best_cost=FLT_MAX;
+            uint32_t best_split=0;
+
+            for(uint32_t i=1;i<SAH_BIN_COUNT;i++)
+            {
+                acc.min_point=glm::min(acc.min_point,bins[i-1].min_point);
+                acc.max_point=glm::max(acc.max_point,bins[i-1].max_point);
+                acc.count+=bins[i-1].count;
+
+                const float cost=(acc.count?acc.count*HalfSurfaceArea(acc.min_point,acc.max_point):0.0f)+right_cost[i];
+
+                if(cost<best_cost)
+                {
+                    best_cost=cost;
+                    best_split=i;
+                }
+            }
+
+            middle=std::partition(begin,end,[&](uint32_t tri){return bin_of(tri)<best_split;});
+        }
+
+        // All centroids in one bin: fall back to a median split
+        if(middle==begin||middle==end)
+        {
+            middle=begin+count/2;
+            std::nth_element(begin,middle,end,[&](uint32_t l,uint32_t r){return centroids[l][axis]<centroids[r][axis];});
+        }
+
+        const uint32_t left_count=uint32_t(middle-begin);
+
+        Build(first,left_count,level+1,centroids,tri_min,tri_max);
+
+        const uint32_t right=Build(first+left_count,count-left_count,level+1,centroids,tri_min,tri_max);
+
+        nodes[node_index].first=right;
+        nodes[node_index].count=0;
+
+        return node_index;
+    }
+
+    Vector3f TriangleMesh::GetTriangleNormal(uint32_t tri)const
+    {
+        Vector3f a,b,c;
+        GetVertices(tri,a,b,c);
+
+        const Vector3f n=Cross(b-a,c-a);
+        const float len=Length(n);
+
+        return len>0.0f?n/len:Vector3f(0,0,0);
+    }
+
+    AABB TriangleMesh::GetBoundingBox()const
+    {
+        AABB box;
+
+        if(nodes.empty())
+            box.Clear();
+        else
+            box.SetMinMax(nodes[0].min_point,nodes[0].max_point);
+
+        return box;
+    }
+
+    bool TriangleMesh::Raycast(const Ray &ray,float max_distance,MeshRayHit &hit)const
+    {
+        return Raycast(PreparedRay(ray),max_distance,hit);
+    }
+
+    bool TriangleMesh::Raycast(const PreparedRay &ray,float max_distance,MeshRayHit &hit)const
+    {
+        if(nodes.empty())
+            return false;
+
+        uint32_t stack[MAX_DEPTH];
+        float stack_t[MAX_DEPTH];
+        uint32_t sp=0;
+        float best=max_distance;
+        bool found=false;
+
+        float t_enter;
+
+        if(!RayBox(nodes[0],ray,best,t_enter))
+            return false;
+
+        stack[sp]=0;
+        stack_t[sp++]=t_enter;
+
+        while(sp>0)
+        {
+            --sp;
+
+            if(stack_t[sp]>best)
+                continue;
+
+            const uint32_t index=stack[sp];
+            const Node &node=nodes[index];
+
+            if(node.count>0)
+            {
+                for(uint32_t i=0;i<node.count;i++)
+                {
+                    const uint32_t tri=triangle_order[node.first+i];
+                    Vector3f a,b,c;
+                    float t,u,v;
+
+                    GetVertices(tri,a,b,c);
+
+                    if(!RaycastQuery::IntersectsTriangle(ray,a,b,c,t,u,v)||t>best)
+                        continue;
+
+                    best=t;
+                    found=true;
+                    hit.distance=t;
+                    hit.triangle=tri;
+                    hit.u=u;
+                    hit.v=v;
+                }
+
+                continue;
+            }
+
+            // Push the farther child first so the nearer one is visited next
+            float t_left,t_right;
+            const bool hit_left =RayBox(nodes[index+1],ray,best,t_left);
+            const bool hit_right=RayBox(nodes[node.first],ray,best,t_right);
+
+            if(hit_left&&hit_right)
+            {
+                if(t_left<=t_right)
+                {
+                    stack[sp]=node.first;   stack_t[sp++]=t_right;
+                    stack[sp]=index+1;      stack_t[sp++]=t_left;
+                }
+                else
+                {
+                    stack[sp]=index+1;      stack_t[sp++]=t_left;
+                    stack[sp]=node.first;   stack_t[sp++]=t_right;
+                }
+            }
+            else if(hit_left)
+            {
+                stack[sp]=index+1;      stack_t[sp++]=t_left;
+            }
+            else if(hit_right)
+            {
+                stack[sp]=node.first;   stack_t[sp++]=t_right;
+            }
+        }
+
+        if(!found)
+            return false;
+
+        hit.point=ray.origin+ray.direction*hit.distance;
+        hit.normal=GetTriangleNormal(hit.triangle);
+
+        if(Dot(hit.normal,ray.direction)>0.0f)
+            hit.normal=-hit.normal;
+
+        return true;
+    }
+
+    bool TriangleMesh::RaycastAny(const Ray &ray,float max_distance)const
+    {
+        return RaycastAny(PreparedRay(ray),max_distance);
+    }
+
+    bool TriangleMesh::RaycastAny(const PreparedRay &ray,float max_distance)const
+    {
+        return Traverse(nodes,triangle_order,
+            [&](const Node &node){float t;return RayBox(node,ray,max_distance,t);},
+            [&](uint32_t tri)
+            {
+                Vector3f a,b,c;
+                float t;
+
+                GetVertices(tri,a,b,c);
+                return RaycastQuery::IntersectsTriangle(ray,a,b,c,t)&&t<=max_distance;
+            });
+    }
+
+    //--------------------------------------------------------------------------------------------
+    // Overlap tests
+    //--------------------------------------------------------------------------------------------
+
+    namespace
+    {
+        struct SphereOverlap
+        {
+            Vector3f center;
+            float radius_squared;
+
+            explicit SphereOverlap(const Sphere &sphere)
+                :center(sphere.GetCenter()),radius_squared(sphere.GetRadius()*sphere.GetRadius()){}
+
+            bool Box(const Node &node)const{return BoxDistanceSquared(node,center)<=radius_squared;}
+
+            bool Triangle(const Vector3f &a,const Vector3f &b,const Vector3f &c)const
+            {
+                return LengthSquared(center-ClosestPointOnTriangle(center,a,b,c))<=radius_squared;
+            }
+        };
+
+        struct CapsuleOverlap
+        {
+            Vector3f p,q;
+            float radius;
+            Vector3f box_min,box_max;
+
+            explicit CapsuleOverlap(const Capsule &capsule)
+                :p(capsule.GetStart()),q(capsule.GetEnd()),radius(capsule.GetRadius())
+            {
+                box_min=glm::min(p,q)-Vector3f(radius);
+                box_max=glm::max(p,q)+Vector3f(radius);
+            }
+
+            bool Box(const Node &node)const{return BoxOverlap(node,box_min,box_max);}
+
+            bool Triangle(const Vector3f &a,const Vector3f &b,const Vector3f &c)const
+            {
+                return DistanceQuery::SegmentTriangleDistanceSquared(p,q,a,b,c)<=radius*radius;
+            }
+        };
+
+        struct OBBOverlap
+        {
+            const OBB &obb;
+            Vector3f box_min,box_max;
+
+            explicit OBBOverlap(const OBB &o):obb(o)
+            {
+                Vector3f half(0,0,0);
+
+                for(int i=0;i<3;i++)
+                    half+=glm::abs(obb.GetAxis(i))*obb.GetHalfExtend()[i];
+
+                box_min=obb.GetCenter()-half;
+                box_max=obb.GetCenter()+half;
+            }
+
+            bool Box(const Node &node)const{return BoxOverlap(node,box_min,box_max);}
+
+            bool Triangle(const Vector3f &a,const Vector3f &b,const Vector3f &c)const
+            {
+                return obb.IntersectsTriangle(Triangle3f(a,b,c));
+            }
+        };
+
+        struct BoundingBoxOverlap
+        {
+            Vector3f box_min,box_max;
+
+            explicit BoundingBoxOverlap(const AABB &box):box_min(box.GetMin()),box_max(box.GetMax()){}
+
+            bool Box(const Node &node)const{return BoxOverlap(node,box_min,box_max);}
+
+            bool Triangle(const Vector3f &a,const Vector3f &b,const Vector3f &c)const
+            {
+                const Node tri_box{glm::min(a,glm::min(b,c)),0,glm::max(a,glm::max(b,c)),0};
+
+                return BoxOverlap(tri_box,box_min,box_max);
+            }
+        };
+    }//namespace
+
+    template<typename Test>
+    bool TriangleMesh::OverlapAny(const Test &test,TriangleMeshCache *cache)const
+    {
+        auto tri_test=[&](uint32_t tri)
+        {
+            Vector3f a,b,c;
+            GetVertices(tri,a,b,c);
+
+            return test.Triangle(a,b,c);
+        };
+
+        // Resting contacts keep touching the same triangle, so try it before traversing
+        if(cache&&cache->triangle<GetTriangleCount()&&tri_test(cache->triangle))
+            return true;
+
+        uint32_t found=MESH_INVALID_TRIANGLE;
+
+        const bool hit=Traverse(nodes,triangle_order,
+            [&](const Node &node){return test.Box(node);},
+            [&](uint32_t tri)
+            {
+                if(!tri_test(tri))
+                    return false;
+
+                found=tri;
+                return true;
+            });
+
+        if(cache&&hit)
+            cache->triangle=found;
+
+        return hit;
+    }
+
+    template<typename Test>
+    uint32_t TriangleMesh::OverlapAll(const Test &test,std::vector<uint32_t> &out)const
+    {
+        const size_t start=out.size();
+
+        Traverse(nodes,triangle_order,
+            [&](const Node &node){return test.Box(node);},
+            [&](uint32_t tri)
+            {
+                Vector3f a,b,c;
+                GetVertices(tri,a,b,c);
+
+                if(test.Triangle(a,b,c))
+                    out.push_back(tri);
+
+                return false;
+            });
+
+        return uint32_t(out.size()-start);
+    }
+
+    bool TriangleMesh::Overlaps(const Sphere &sphere,TriangleMeshCache *cache)const{return OverlapAny(SphereOverlap(sphere),cache);}
+    bool TriangleMesh::Overlaps(const Capsule &capsule,TriangleMeshCache *cache)const{return OverlapAny(CapsuleOverlap(capsule),cache);}
+    bool TriangleMesh::Overlaps(const OBB &obb,TriangleMeshCache *cache)const{return OverlapAny(OBBOverlap(obb),cache);}
+
+    uint32_t TriangleMesh::QueryOverlaps(const Sphere &sphere,std::vector<uint32_t> &out)const{return OverlapAll(SphereOverlap(sphere),out);}
+    uint32_t TriangleMesh::QueryOverlaps(const Capsule &capsule,std::vector<uint32_t> &out)const{return OverlapAll(CapsuleOverlap(capsule),out);}
+    uint32_t TriangleMesh::QueryOverlaps(const OBB &obb,std::vector<uint32_t> &out)const{return OverlapAll(OBBOverlap(obb),out);}
+    uint32_t TriangleMesh::QueryBoundingBox(const AABB &box,std::vector<uint32_t> &out)const{return OverlapAll(BoundingBoxOverlap(box),out);}
+
+    //--------------------------------------------------------------------------------------------
+    // Closest point
+    //--------------------------------------------------------------------------------------------
+
+    bool TriangleMesh::ClosestPoint(const Vector3f &point,float max_distance,MeshClosestPoint &result,TriangleMeshCache *cache)const
+    {
+        if(nodes.empty())
+            return false;
+
+        float best_d2=max_distance<FLT_MAX?max_distance*max_distance:FLT_MAX;
+        bool found=false;
+
+        auto test_triangle=[&](uint32_t tri)
+        {
+            Vector3f a,b,c;
+            GetVertices(tri,a,b,c);
+
+            const Vector3f closest=ClosestPointOnTriangle(point,a,b,c);
+            const float d2=LengthSquared(point-closest);
+
+            if(d2>best_d2||(found&&d2==best_d2))
+                return;
+
+            best_d2=d2;
+            found=true;
+            result.point=closest;
+            result.triangle=tri;
+        };
+
+        // The previous closest triangle usually still is, which shrinks the search radius up front
+        if(cache&&cache->triangle<GetTriangleCount())
+            test_triangle(cache->triangle);
+
+        uint32_t stack[MAX_DEPTH];
+        float stack_d2[MAX_DEPTH];
+        uint32_t sp=0;
+
+        stack[sp]=0;
+        stack_d2[sp++]=BoxDistanceSquared(nodes[0],point);
+
+        while(sp>0)
+        {
+            --sp;
+
+            if(stack_d2[sp]>best_d2)
+                continue;
+
+            const uint32_t index=stack[sp];
+            const Node &node=nodes[index];
+
+            if(node.count>0)
+            {
+                for(uint32_t i=0;i<node.count;i++)
+                    test_triangle(triangle_order[node.first+i]);
+
+                continue;
+            }
+
+            const float d_left =BoxDistanceSquared(nodes[index+1],point);
+            const float d_right=BoxDistanceSquared(nodes[node.first],point);
+
+            if(d_left<=d_right)
+            {
+                stack[sp]=node.first;   stack_d2[sp++]=d_right;
+                stack[sp]=index+1;      stack_d2[sp++]=d_left;
+            }
+            else
+            {
+                stack[sp]=index+1;      stack_d2[sp++]=d_left;
+                stack[sp]=node.first;   stack_d2[sp++]=d_right;
+            }
+        }
+
+        if(!found)
+            return false;
+
+        result.distance=std::sqrt(best_d2);
+
+        if(cache)
+            cache->triangle=result.triangle;
+
+        return true;
+    }
+}//namespace hgl::math
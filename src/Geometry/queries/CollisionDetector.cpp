@@ -410,4 +410,33 @@ namespace hgl::math
         return aabb.IntersectsOBB(obb);
     }
 
+    //=============================================================================
+    // Convex pairs without a dedicated closed-form test: GJK
+    //=============================================================================
+
+    bool CollisionDetector::Intersects(const Cone& cone, const Capsule& capsule)
+    {
+        return GJK::Intersects(cone, capsule);
+    }
+
+    bool CollisionDetector::Intersects(const Cone& a, const Cone& b)
+    {
+        return GJK::Intersects(a, b);
+    }
+
+    bool CollisionDetector::Intersects(const Cone& cone, const Cylinder& cylinder)
+    {
+        return GJK::Intersects(cone, cylinder);
+    }
+
+    bool CollisionDetector::Intersects(const Cone& cone, const OBB& box)
+    {
+        return GJK::Intersects(cone, box);
+    }
+
+    bool CollisionDetector::Intersects(const Cylinder& cylinder, const OBB& box)
+    {
+        return GJK::Intersects(cylinder, box);
+    }
+
 }//namespace hgl::math
@@ -0,0 +1,237 @@
+﻿/**
+ * CollisionDispatch.cpp - Type bucketed batch collision dispatch
+ *
+ * Pairs are counting-sorted by (typeA,typeB). Each bucket runs through a
+ * kernel instantiated for that exact type combination, so the inner loop
+ * has no type switch. Kernels are stored in a table generated at compile
+ * time from the shape type list.
+ */
+#include<hgl/math/geometry/queries/CollisionDispatch.h>
+#include<hgl/math/geometry/queries/GJK.h>
+#include<hgl/math/ParallelFor.h>
+#include<algorithm>
+#include<array>
+#include<tuple>
+#include<utility>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr uint32_t BUCKET_COUNT=SHAPE_TYPE_COUNT*SHAPE_TYPE_COUNT;
+        constexpr uint8_t INVALID_BUCKET=0xFF;
+        constexpr size_t DISPATCH_CHUNK_PAIRS=256;          // Narrowphase work dominates memory traffic
+
+        static_assert(BUCKET_COUNT<INVALID_BUCKET);
+
+        // Order must match ShapeType
+        using ShapeTypeList=std::tuple<Sphere,Capsule,Cylinder,Cone,Torus,AABB,OBB,ConvexHull,Triangle3f>;
+
+        static_assert((std::tuple_size_v<ShapeTypeList>)==SHAPE_TYPE_COUNT);
+
+        const Sphere     *GetShapes(const CollisionShapeSet &s,const Sphere *    ){return s.spheres;}
+        const Capsule    *GetShapes(const CollisionShapeSet &s,const Capsule *   ){return s.capsules;}
+        const Cylinder   *GetShapes(const CollisionShapeSet &s,const Cylinder *  ){return s.cylinders;}
+        const Cone       *GetShapes(const CollisionShapeSet &s,const Cone *      ){return s.cones;}
+        const Torus      *GetShapes(const CollisionShapeSet &s,const Torus *     ){return s.tori;}
+        const AABB       *GetShapes(const CollisionShapeSet &s,const AABB *      ){return s.aabbs;}
+        const OBB        *GetShapes(const CollisionShapeSet &s,const OBB *       ){return s.obbs;}
+        const ConvexHull *GetShapes(const CollisionShapeSet &s,const ConvexHull *){return s.hulls;}
+        const Triangle3f *GetShapes(const CollisionShapeSet &s,const Triangle3f *){return s.triangles;}
+
+        template<typename A,typename B>
+        CollisionInfo Collide(const A &a,const B &b)
+        {
+            if constexpr(requires{CollisionDetector::TestCollision(a,b);})
+                return CollisionDetector::TestCollision(a,b);
+            else
+                return GJK::TestCollision(a,b);
+        }
+
+        template<typename A,typename B>
+        bool Overlap(const A &a,const B &b)
+        {
+            if constexpr(requires{CollisionDetector::Intersects(a,b);})
+                return CollisionDetector::Intersects(a,b);
+            else
+                return GJK::Intersects(a,b);
+        }
+
+        template<typename R>
+        using BucketKernel=void(*)(const CollisionShapeSet &,const CollisionPair *,const uint32_t *,size_t,R *);
+
+        template<typename A,typename B>
+        void CollideBucket(const CollisionShapeSet &shapes,const CollisionPair *pairs,const uint32_t *indices,size_t count,CollisionInfo *results)
+        {
+            const A *shapes_a=GetShapes(shapes,static_cast<const A *>(nullptr));
+            const B *shapes_b=GetShapes(shapes,static_cast<const B *>(nullptr));
+
+            for(size_t i=0;i<count;i++)
+            {
+                const uint32_t index=indices[i];
+                const CollisionPair &pair=pairs[index];
+
+                results[index]=Collide(shapes_a[pair.a.index],shapes_b[pair.b.index]);
+            }
+        }
+
+        template<typename A,typename B>
+        void OverlapBucket(const CollisionShapeSet &shapes,const CollisionPair *pairs,const uint32_t *indices,size_t count,uint8_t *results)
+        {
+            const A *shapes_a=GetShapes(shapes,static_cast<const A *>(nullptr));
+            const B *shapes_b=GetShapes(shapes,static_cast<const B *>(nullptr));
+
+            for(size_t i=0;i<count;i++)
+            {
+                const uint32_t index=indices[i];
+                const CollisionPair &pair=pairs[index];
+
+                results[index]=Overlap(shapes_a[pair.a.index],shapes_b[pair.b.index])?1:0;
+            }
+        }
+
+        template<size_t I>
+        using ShapeA=std::tuple_element_t<I/SHAPE_TYPE_COUNT,ShapeTypeList>;
+
+        template<size_t I>
+        using ShapeB=std::tuple_element_t<I%SHAPE_TYPE_COUNT,ShapeTypeList>;
+
+        template<size_t... I>
+        constexpr std::array<BucketKernel<CollisionInfo>,BUCKET_COUNT> MakeCollideTable(std::index_sequence<I...>)
+        {
+            return {{&CollideBucket<ShapeA<I>,ShapeB<I>>...}};
+        }
+
+        template<size_t... I>
+        constexpr std::array<BucketKernel<uint8_t>,BUCKET_COUNT> MakeOverlapTable(std::index_sequence<I...>)
+        {
+            return {{&OverlapBucket<ShapeA<I>,ShapeB<I>>...}};
+        }
+
+        constexpr auto COLLIDE_TABLE=MakeCollideTable(std::make_index_sequence<BUCKET_COUNT>{});
+        constexpr auto OVERLAP_TABLE=MakeOverlapTable(std::make_index_sequence<BUCKET_COUNT>{});
+
+        /**
+         * Run every bucket; with an executor the sorted order is split into
+         * chunks and each chunk runs the bucket segments it covers
+         */
+        template<typename R>
+        void RunBuckets(const std::array<BucketKernel<R>,BUCKET_COUNT> &table,
+                        const uint32_t *bucket_begin,const std::vector<uint32_t> &order,
+                        const CollisionShapeSet &shapes,const CollisionPair *pairs,R *results,
+                        IParallelExecutor *executor)
+        {
+            ParallelForChunks(executor,0,order.size(),DISPATCH_CHUNK_PAIRS,[&](size_t,size_t begin,size_t end)
+            {
+                for(uint32_t key=0;key<BUCKET_COUNT;key++)
+                {
+                    const size_t first=std::max<size_t>(bucket_begin[key],begin);
+                    const size_t last =std::min<size_t>(bucket_begin[key+1],end);
+
+                    if(first<last)
+                        table[key](shapes,pairs,order.data()+first,last-first,results);
+                }
+            });
+        }
+    }//namespace
+
+    size_t CollisionShapeSet::GetCount(ShapeType type)const
+    {
+        switch(type)
+        {
+            case ShapeType::Sphere:     return sphere_count;
+            case ShapeType::Capsule:    return capsule_count;
+            case ShapeType::Cylinder:   return cylinder_count;
+            case ShapeType::Cone:       return cone_count;
+            case ShapeType::Torus:      return torus_count;
+            case ShapeType::AABB:       return aabb_count;
+            case ShapeType::OBB:        return obb_count;
+            case ShapeType::ConvexHull: return hull_count;
+            case ShapeType::Triangle:   return triangle_count;
+            default:                    return 0;
+        }
+    }
+
+    CollisionDispatcher::CollisionDispatcher()
+    {
+        std::fill(bucket_begin,bucket_begin+BUCKET_COUNT+1,0u);
+    }
+
+    void CollisionDispatcher::Bucket(const CollisionShapeSet &shapes,const CollisionPair *pairs,size_t count)
+    {
+        uint32_t bucket_size[BUCKET_COUNT]={};
+
+        pair_keys.resize(count);
+        invalid_count=0;
+
+        for(size_t i=0;i<count;i++)
+        {
+            if(!shapes.IsValid(pairs[i].a)||!shapes.IsValid(pairs[i].b))
+            {
+                pair_keys[i]=INVALID_BUCKET;
+                ++invalid_count;
+                continue;
+            }
+
+            const uint8_t key=uint8_t(uint32_t(pairs[i].a.type)*SHAPE_TYPE_COUNT+uint32_t(pairs[i].b.type));
+
+            pair_keys[i]=key;
+            ++bucket_size[key];
+        }
+
+        bucket_begin[0]=0;
+
+        for(uint32_t key=0;key<BUCKET_COUNT;key++)
+            bucket_begin[key+1]=bucket_begin[key]+bucket_size[key];
+
+        order.resize(bucket_begin[BUCKET_COUNT]);
+
+        uint32_t cursor[BUCKET_COUNT];
+        std::copy(bucket_begin,bucket_begin+BUCKET_COUNT,cursor);
+
+        for(size_t i=0;i<count;i++)
+            if(pair_keys[i]!=INVALID_BUCKET)
+                order[cursor[pair_keys[i]]++]=uint32_t(i);
+    }
+
+    void CollisionDispatcher::Dispatch(const CollisionShapeSet &shapes,const CollisionPair *pairs,size_t count,CollisionInfo *results,IParallelExecutor *executor)
+    {
+        if(!pairs||!results)
+            return;
+
+        Bucket(shapes,pairs,count);
+
+        if(invalid_count>0)
+            for(size_t i=0;i<count;i++)
+                if(pair_keys[i]==INVALID_BUCKET)
+                    results[i]=CollisionInfo();
+
+        RunBuckets(COLLIDE_TABLE,bucket_begin,order,shapes,pairs,results,executor);
+    }
+
+    void CollisionDispatcher::DispatchIntersects(const CollisionShapeSet &shapes,const CollisionPair *pairs,size_t count,uint8_t *results,IParallelExecutor *executor)
+    {
+        if(!pairs||!results)
+            return;
+
+        Bucket(shapes,pairs,count);
+
+        if(invalid_count>0)
+            for(size_t i=0;i<count;i++)
+                if(pair_keys[i]==INVALID_BUCKET)
+                    results[i]=0;
+
+        RunBuckets(OVERLAP_TABLE,bucket_begin,order,shapes,pairs,results,executor);
+    }
+
+    uint32_t CollisionDispatcher::GetActiveBucketCount()const
+    {
+        uint32_t active=0;
+
+        for(uint32_t key=0;key<BUCKET_COUNT;key++)
+            if(bucket_begin[key+1]>bucket_begin[key])
+                ++active;
+
+        return active;
+    }
+}//namespace hgl::math
@@ -0,0 +1,459 @@
+﻿/**
+ * CollisionPipeline.cpp - Uniform grid broadphase feeding the batch dispatcher
+ *
+ * Every stage writes into per-chunk storage and is merged with a prefix sum,
+ * so no stage takes a lock. Duplicate pairs are avoided without a hash set:
+ * two proxies sharing several cells only report the pair from the cell that
+ * contains the minimum corner of their AABB intersection.
+ */
+#include<hgl/math/geometry/queries/CollisionPipeline.h>
+#include<hgl/math/geometry/queries/GJK.h>
+#include<hgl/math/ParallelFor.h>
+#include<algorithm>
+#include<cfloat>
+#include<cmath>
+#include<cstring>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr uint8_t PROXY_GRID        =0;
+        constexpr uint8_t PROXY_OVERSIZED   =1;
+        constexpr uint8_t PROXY_INVALID     =2;
+
+        constexpr uint32_t CELL_COORD_BITS  =21;
+        constexpr uint32_t CELL_COORD_MAX   =(1u<<CELL_COORD_BITS)-1;
+
+        constexpr size_t PROXY_CHUNK        =1024;
+        constexpr size_t CELL_CHUNK         =64;
+
+        template<typename T>
+        void ShapeBounds(const T &shape,Vector3f &min_point,Vector3f &max_point)
+        {
+            if constexpr(requires{shape.GetBoundingBox();})
+            {
+                const AABB box=shape.GetBoundingBox();
+
+                min_point=box.GetMin();
+                max_point=box.GetMax();
+            }
+            else
+            {
+                // Extreme points along the coordinate axes bound any convex shape exactly
+                for(int axis=0;axis<3;axis++)
+                {
+                    Vector3f dir(0,0,0);
+                    dir[axis]=1.0f;
+
+                    max_point[axis]=GetSupportPoint(shape, dir)[axis];
+                    min_point[axis]=GetSupportPoint(shape,-dir)[axis];
+                }
+            }
+        }
+
+        void ShapeBounds(const AABB &box,Vector3f &min_point,Vector3f &max_point)
+        {
+            min_point=box.GetMin();
+            max_point=box.GetMax();
+        }
+
+        void GetProxyBounds(const CollisionShapeSet &shapes,const ShapeRef &ref,Vector3f &min_point,Vector3f &max_point)
+        {
+            switch(ref.type)
+            {
+                case ShapeType::Sphere:     ShapeBounds(shapes.spheres  [ref.index],min_point,max_point);break;
+                case ShapeType::Capsule:    ShapeBounds(shapes.capsules [ref.index],min_point,max_point);break;
+                case ShapeType::Cylinder:   ShapeBounds(shapes.cylinders[ref.index],min_point,max_point);break;
+                case ShapeType::Cone:       ShapeBounds(shapes.cones    [ref.index],min_point,max_point);break;
+                case ShapeType::Torus:      ShapeBounds(shapes.tori     [ref.index],min_point,max_point);break;
+                case ShapeType::AABB:       ShapeBounds(shapes.aabbs    [ref.index],min_point,max_point);break;
+                case ShapeType::OBB:        ShapeBounds(shapes.obbs     [ref.index],min_point,max_point);break;
+                case ShapeType::ConvexHull: ShapeBounds(shapes.hulls    [ref.index],min_point,max_point);break;
+                case ShapeType::Triangle:   ShapeBounds(shapes.triangles[ref.index],min_point,max_point);break;
+                default:                    min_point=max_point=Vector3f(0,0,0);break;
+            }
+        }
+
+        uint32_t ToCell(float value,float origin,float inv_cell)
+        {
+            const float c=std::floor((value-origin)*inv_cell);
+
+            if(c<=0.0f)return 0;
+            if(c>=float(CELL_COORD_MAX))return CELL_COORD_MAX;
+
+            return uint32_t(c);
+        }
+
+        uint64_t PackCell(uint32_t x,uint32_t y,uint32_t z)
+        {
+            return uint64_t(x)|(uint64_t(y)<<CELL_COORD_BITS)|(uint64_t(z)<<(CELL_COORD_BITS*2));
+        }
+
+        float MaxComponent(const Vector3f &v)
+        {
+            return std::max(v.x,std::max(v.y,v.z));
+        }
+    }//namespace
+
+    uint64_t CollisionPipeline::GetCellKey(const Vector3f &point)const
+    {
+        const float inv_cell=1.0f/used_cell_size;
+
+        return PackCell(ToCell(point.x,grid_origin.x,inv_cell),
+                        ToCell(point.y,grid_origin.y,inv_cell),
+                        ToCell(point.z,grid_origin.z,inv_cell));
+    }
+
+    void CollisionPipeline::ComputeBounds(const CollisionShapeSet &shapes,const ShapeRef *proxies,size_t count,IParallelExecutor *executor)
+    {
+        bounds.resize(count);
+        proxy_state.resize(count);
+
+        ParallelForChunks(executor,0,count,PROXY_CHUNK,[&](size_t,size_t begin,size_t end)
+        {
+            for(size_t i=begin;i<end;i++)
+            {
+                if(!shapes.IsValid(proxies[i]))
+                {
+                    proxy_state[i]=PROXY_INVALID;
+                    continue;
+                }
+
+                GetProxyBounds(shapes,proxies[i],bounds[i].min_point,bounds[i].max_point);
+                proxy_state[i]=PROXY_GRID;
+            }
+        });
+
+        Vector3f scene_min( FLT_MAX, FLT_MAX, FLT_MAX);
+        Vector3f scene_max(-FLT_MAX,-FLT_MAX,-FLT_MAX);
+        double extent_sum=0;
+        uint32_t valid=0;
+
+        for(size_t i=0;i<count;i++)
+        {
+            if(proxy_state[i]==PROXY_INVALID)
+                continue;
+
+            scene_min=glm::min(scene_min,bounds[i].min_point);
+            scene_max=glm::max(scene_max,bounds[i].max_point);
+            extent_sum+=MaxComponent(bounds[i].max_point-bounds[i].min_point);
+            ++valid;
+        }
+
+        stats.proxy_count=valid;
+
+        if(valid==0)
+        {
+            grid_origin=Vector3f(0,0,0);
+            used_cell_size=cell_size>0.0f?cell_size:1.0f;
+            return;
+        }
+
+        const float scene_extent=MaxComponent(scene_max-scene_min);
+
+        // Auto size: twice the mean object extent keeps most objects within 8 cells
+        float cell=cell_size>0.0f?cell_size:float(2.0*extent_sum/valid);
+
+        if(cell<=0.0f)          // Only points: spread them over roughly one per cell
+            cell=scene_extent/std::max(1.0f,std::cbrt(float(valid)));
+
+        if(cell<=0.0f)
+            cell=1.0f;
+
+        grid_origin=scene_min;
+        used_cell_size=std::max(cell,scene_extent/float(CELL_COORD_MAX));
+    }
+
+    void CollisionPipeline::BuildGrid(size_t count,IParallelExecutor *executor)
+    {
+        const float inv_cell=1.0f/used_cell_size;
+
+        entry_offset.resize(count+1);
+
+        ParallelForChunks(executor,0,count,PROXY_CHUNK,[&](size_t,size_t begin,size_t end)
+        {
+            for(size_t i=begin;i<end;i++)
+            {
+                entry_offset[i]=0;
+
+                if(proxy_state[i]==PROXY_INVALID)
+                    continue;
+
+                const ProxyBounds &box=bounds[i];
+                uint64_t cells=1;
+
+                for(int axis=0;axis<3;axis++)
+                    cells*=ToCell(box.max_point[axis],grid_origin[axis],inv_cell)
+                          -ToCell(box.min_point[axis],grid_origin[axis],inv_cell)+1;
+
+                if(cells>max_cells_per_proxy)
+                {
+                    proxy_state[i]=PROXY_OVERSIZED;
+                    continue;
+                }
+
+                entry_offset[i]=uint32_t(cells);
+            }
+        });
+
+        uint32_t total=0;
+
+        oversized.clear();
+
+        for(size_t i=0;i<count;i++)
+        {
+            const uint32_t n=entry_offset[i];
+
+            entry_offset[i]=total;
+            total+=n;
+
+            if(proxy_state[i]==PROXY_OVERSIZED)
+                oversized.push_back(uint32_t(i));
+        }
+
+        entry_offset[count]=total;
+        entries.resize(total);
+
+        ParallelForChunks(executor,0,count,PROXY_CHUNK,[&](size_t,size_t begin,size_t end)
+        {
+            for(size_t i=begin;i<end;i++)
+            {
+                if(proxy_state[i]!=PROXY_GRID)
+                    continue;
+
+                const ProxyBounds &box=bounds[i];
+
+                const uint32_t lx=ToCell(box.min_point.x,grid_origin.x,inv_cell),hx=ToCell(box.max_point.x,grid_origin.x,inv_cell);
+                const uint32_t ly=ToCell(box.min_point.y,grid_origin.y,inv_cell),hy=ToCell(box.max_point.y,grid_origin.y,inv_cell);
+                const uint32_t lz=ToCell(box.min_point.z,grid_origin.z,inv_cell),hz=ToCell(box.max_point.z,grid_origin.z,inv_cell);
+
+                CellEntry *out=entries.data()+entry_offset[i];
+
+                for(uint32_t z=lz;z<=hz;z++)
+                    for(uint32_t y=ly;y<=hy;y++)
+                        for(uint32_t x=lx;x<=hx;x++)
+                            *out++={PackCell(x,y,z),uint32_t(i)};
+            }
+        });
+
+        // Sorting by (cell,proxy) makes the pair order independent of the thread count
+        std::sort(entries.begin(),entries.end(),[](const CellEntry &l,const CellEntry &r)
+        {
+            return l.cell<r.cell||(l.cell==r.cell&&l.proxy<r.proxy);
+        });
+
+        cell_begin.clear();
+
+        for(uint32_t e=0;e<total;e++)
+            if(e==0||entries[e].cell!=entries[e-1].cell)
+                cell_begin.push_back(e);
+
+        const uint32_t occupied=uint32_t(cell_begin.size());
+
+        cell_begin.push_back(total);
+
+        stats.oversized_proxy_count=uint32_t(oversized.size());
+        stats.cell_entry_count=total;
+        stats.occupied_cell_count=occupied;
+    }
+
+    void CollisionPipeline::GeneratePairs(size_t count,IParallelExecutor *executor)
+    {
+        const size_t cell_count=cell_begin.size()-1;
+        const size_t grid_chunks=GetChunkCount(0,cell_count,CELL_CHUNK);
+        const size_t oversized_chunks=oversized.empty()?0:GetChunkCount(0,count,PROXY_CHUNK);
+        const size_t chunk_count=grid_chunks+oversized_chunks;
+
+        // Only grow, so per-chunk buffers keep their capacity between frames
+        if(chunk_pairs.size()<chunk_count)
+            chunk_pairs.resize(chunk_count);
+
+        chunk_tests.assign(chunk_count,0);
+
+        auto overlap=[this](uint32_t a,uint32_t b)
+        {
+            const ProxyBounds &ba=bounds[a];
+            const ProxyBounds &bb=bounds[b];
+
+            return ba.max_point.x>=bb.min_point.x&&bb.max_point.x>=ba.min_point.x
+                 &&ba.max_point.y>=bb.min_point.y&&bb.max_point.y>=ba.min_point.y
+                 &&ba.max_point.z>=bb.min_point.z&&bb.max_point.z>=ba.min_point.z;
+        };
+
+        ParallelForChunks(executor,0,cell_count,CELL_CHUNK,[&](size_t chunk,size_t begin,size_t end)
+        {
+            std::vector<ProxyPair> &out=chunk_pairs[chunk];
+            uint64_t tests=0;
+
+            out.clear();
+
+            for(size_t c=begin;c<end;c++)
+            {
+                const uint32_t first=cell_begin[c];
+                const uint32_t last=cell_begin[c+1];
+                const uint64_t cell=entries[first].cell;
+
+                for(uint32_t i=first;i<last;i++)
+                {
+                    const uint32_t a=entries[i].proxy;
+
+                    for(uint32_t j=i+1;j<last;j++)
+                    {
+                        const uint32_t b=entries[j].proxy;
+
+                        ++tests;
+
+                        if(!overlap(a,b))
+                            continue;
+
+                        // Report the pair only from the cell owning the intersection's minimum corner
+                        if(GetCellKey(glm::max(bounds[a].min_point,bounds[b].min_point))!=cell)
+                            continue;
+
+                        out.push_back({a,b});
+                    }
+                }
+            }
+
+            chunk_tests[chunk]=tests;
+        });
+
+        // Oversized proxies are tested against every proxy outside the grid
+        ParallelForChunks(executor,0,oversized_chunks?count:0,PROXY_CHUNK,[&](size_t chunk,size_t begin,size_t end)
+        {
+            std::vector<ProxyPair> &out=chunk_pairs[grid_chunks+chunk];
+            uint64_t tests=0;
+
+            out.clear();
+
+            for(size_t p=begin;p<end;p++)
+            {
+                if(proxy_state[p]==PROXY_INVALID)
+                    continue;
+
+                const uint32_t proxy=uint32_t(p);
+
+                for(const uint32_t big:oversized)
+                {
+                    // Between two oversized proxies only the lower index reports
+                    if(proxy_state[p]==PROXY_OVERSIZED&&big>=proxy)
+                        continue;
+
+                    ++tests;
+
+                    if(overlap(big,proxy))
+                        out.push_back({std::min(big,proxy),std::max(big,proxy)});
+                }
+            }
+
+            chunk_tests[grid_chunks+chunk]=tests;
+        });
+
+        MergePairs(chunk_count,executor);
+    }
+
+    void CollisionPipeline::MergePairs(size_t chunk_count,IParallelExecutor *executor)
+    {
+        chunk_offset.resize(chunk_count+1);
+
+        uint32_t total=0;
+        uint64_t tests=0;
+
+        for(size_t i=0;i<chunk_count;i++)
+        {
+            chunk_offset[i]=total;
+            total+=uint32_t(chunk_pairs[i].size());
+            tests+=chunk_tests[i];
+        }
+
+        chunk_offset[chunk_count]=total;
+        proxy_pairs.resize(total);
+
+        ParallelForChunks(executor,0,chunk_count,1,[&](size_t,size_t begin,size_t end)
+        {
+            for(size_t i=begin;i<end;i++)
+                if(!chunk_pairs[i].empty())
+                    memcpy(proxy_pairs.data()+chunk_offset[i],chunk_pairs[i].data(),chunk_pairs[i].size()*sizeof(ProxyPair));
+        });
+
+        stats.broadphase_test_count=tests;
+        stats.broadphase_pair_count=total;
+    }
+
+    const std::vector<ProxyPair> &CollisionPipeline::FindPairs(const CollisionShapeSet &shapes,const ShapeRef *proxies,size_t count,IParallelExecutor *executor)
+    {
+        stats.Clear();
+        proxy_pairs.clear();
+        contacts.clear();
+
+        if(!proxies||count==0)
+            return proxy_pairs;
+
+        ComputeBounds(shapes,proxies,count,executor);
+
+        if(stats.proxy_count<2)
+            return proxy_pairs;
+
+        BuildGrid(count,executor);
+        GeneratePairs(count,executor);
+
+        return proxy_pairs;
+    }
+
+    const std::vector<CollisionContact> &CollisionPipeline::Run(const CollisionShapeSet &shapes,const ShapeRef *proxies,size_t count,IParallelExecutor *executor)
+    {
+        FindPairs(shapes,proxies,count,executor);
+
+        const size_t pair_count=proxy_pairs.size();
+
+        if(pair_count==0)
+            return contacts;
+
+        narrow_pairs.resize(pair_count);
+        narrow_results.resize(pair_count);
+
+        ParallelForChunks(executor,0,pair_count,ComputeChunkSize(sizeof(CollisionPair)),[&](size_t,size_t begin,size_t end)
+        {
+            for(size_t i=begin;i<end;i++)
+                narrow_pairs[i]={proxies[proxy_pairs[i].a],proxies[proxy_pairs[i].b]};
+        });
+
+        dispatcher.Dispatch(shapes,narrow_pairs.data(),pair_count,narrow_results.data(),executor);
+
+        // Compact hits: count per chunk, prefix sum, then each chunk writes its own range
+        const size_t chunk_size=ComputeChunkSize(sizeof(CollisionInfo));
+        const size_t chunk_count=GetChunkCount(0,pair_count,chunk_size);
+
+        chunk_offset.assign(chunk_count+1,0);
+
+        ParallelForChunks(executor,0,pair_count,chunk_size,[&](size_t chunk,size_t begin,size_t end)
+        {
+            uint32_t hits=0;
+
+            for(size_t i=begin;i<end;i++)
+                if(narrow_results[i].intersects)
+                    ++hits;
+
+            chunk_offset[chunk+1]=hits;
+        });
+
+        for(size_t i=0;i<chunk_count;i++)
+            chunk_offset[i+1]+=chunk_offset[i];
+
+        contacts.resize(chunk_offset[chunk_count]);
+
+        ParallelForChunks(executor,0,pair_count,chunk_size,[&](size_t chunk,size_t begin,size_t end)
+        {
+            CollisionContact *out=contacts.data()+chunk_offset[chunk];
+
+            for(size_t i=begin;i<end;i++)
+                if(narrow_results[i].intersects)
+                    *out++={proxy_pairs[i].a,proxy_pairs[i].b,narrow_results[i]};
+        });
+
+        stats.contact_count=uint32_t(contacts.size());
+
+        return contacts;
+    }
+}//namespace hgl::math
@@ -0,0 +1,879 @@
+﻿/**
+ * ContactManifold.cpp - Multi-point contact manifold generation and caching
+ *
+ * Box-box uses SAT to pick the axis of least penetration. Face axes clip the
+ * incident face against the side planes of the reference face
+ * (Sutherland-Hodgman); edge axes yield a single closest-point contact.
+ *
+ * General convex pairs take the EPA normal, sample the support mapping of
+ * each shape along slightly tilted normals to recover the touching feature
+ * (vertex, edge or face polygon in winding order) and clip those features.
+ */
+#include<hgl/math/geometry/queries/ContactManifold.h>
+#include<hgl/math/geometry/queries/DistanceQuery.h>
+#include<cmath>
+#include<cfloat>
+#include<numbers>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr uint32_t MAX_CLIP_POINTS  =16;
+        constexpr uint32_t FEATURE_SAMPLES  =8;
+        constexpr float FEATURE_TILT        =0.1f;      // Tangent offset of feature sampling directions
+        constexpr float FACE_AXIS_BIAS      =0.95f;     // Edge axis must beat face axes by 5% to be chosen
+        constexpr float FACE_ALIGN_COS      =0.95f;     // Normal vs face normal alignment for face clipping
+        constexpr uint32_t EDGE_FEATURE     =0x80000000u;
+
+        struct ClipVertex
+        {
+            Vector3f p;
+            uint32_t id;
+        };
+
+        struct ClipPolygon
+        {
+            ClipVertex v[MAX_CLIP_POINTS];
+            uint32_t count=0;
+
+            void Push(const Vector3f &p,uint32_t id)
+            {
+                if(count<MAX_CLIP_POINTS)
+                    v[count++]={p,id};
+            }
+        };
+
+        float Sign(float v){return v>=0.0f?1.0f:-1.0f;}
+
+        void PerpendicularBasis(const Vector3f &n,Vector3f &t1,Vector3f &t2)
+        {
+            const Vector3f ref=(std::fabs(n.x)<0.577f)?Vector3f(1,0,0):Vector3f(0,1,0);
+
+            t1=Normalized(Cross(n,ref));
+            t2=Cross(n,t1);
+        }
+
+        /**
+         * Keep the part of the polygon (or segment / point) with dot(n,p)<=d
+         */
+        void ClipAgainstPlane(const ClipPolygon &in,const Vector3f &n,float d,uint32_t plane_id,ClipPolygon &out)
+        {
+            out.count=0;
+
+            if(in.count==0)
+                return;
+
+            // A two point "polygon" is an open segment: clip its single edge only
+            const uint32_t edge_count=(in.count==2)?1:in.count;
+
+            for(uint32_t i=0;i<edge_count;i++)
+            {
+                const ClipVertex &cur=in.v[i];
+                const ClipVertex &next=in.v[(i+1)%in.count];
+
+                const float dc=Dot(n,cur.p)-d;
+                const float dn=Dot(n,next.p)-d;
+
+                if(dc<=0.0f)
+                    out.Push(cur.p,cur.id);
+
+                if((dc<0.0f&&dn>0.0f)||(dc>0.0f&&dn<0.0f))
+                {
+                    const float t=dc/(dc-dn);
+
+                    out.Push(cur.p+(next.p-cur.p)*t,(cur.id&0xFFFF00FFu)|((plane_id+1)<<8));
+                }
+            }
+
+            if(in.count==2&&Dot(n,in.v[1].p)-d<=0.0f)
+                out.Push(in.v[1].p,in.v[1].id);
+        }
+
+        /**
+         * Clip the incident polygon against the side planes of a convex reference polygon
+         * @param ref reference polygon vertices in winding order
+         * @param n reference face normal
+         */
+        void ClipAgainstReference(const Vector3f *ref,uint32_t ref_count,const Vector3f &n,const ClipPolygon &incident,ClipPolygon &result)
+        {
+            Vector3f centroid(0,0,0);
+
+            for(uint32_t i=0;i<ref_count;i++)
+                centroid+=ref[i];
+
+            centroid/=float(ref_count);
+
+            ClipPolygon buffer[2];
+            uint32_t cur=0;
+
+            buffer[0]=incident;
+
+            for(uint32_t i=0;i<ref_count;i++)
+            {
+                const Vector3f &r0=ref[i];
+                const Vector3f &r1=ref[(i+1)%ref_count];
+
+                Vector3f m=Cross(r1-r0,n);
+                const float len=Length(m);
+
+                if(len<1e-6f)
+                    continue;
+
+                m/=len;
+
+                if(Dot(m,centroid-r0)>0.0f)
+                    m=-m;
+
+                ClipAgainstPlane(buffer[cur],m,Dot(m,r0),i,buffer[cur^1]);
+                cur^=1;
+
+                if(buffer[cur].count==0)
+                    break;
+            }
+
+            result=buffer[cur];
+        }
+
+        /**
+         * Sample the support mapping around direction to recover the touching feature.
+         * Samples sweep around the normal, so the result is already in winding order.
+         * @return number of feature points (1 = vertex, 2 = edge, 3+ = face)
+         */
+        uint32_t SupportFeature(const ConvexSupport &shape,const Vector3f &direction,Vector3f *out)
+        {
+            Vector3f t1,t2;
+            PerpendicularBasis(direction,t1,t2);
+
+            const float max_dot=Dot(direction,shape(direction));
+            uint32_t count=0;
+
+            for(uint32_t k=0;k<FEATURE_SAMPLES;k++)
+            {
+                const float angle=float(k)*(2.0f*std::numbers::pi_v<float>/float(FEATURE_SAMPLES));
+                const Vector3f p=shape(direction+(t1*std::cos(angle)+t2*std::sin(angle))*FEATURE_TILT);
+
+                if(Dot(direction,p)<max_dot-ContactManifoldQuery::LINEAR_SLOP)
+                    continue;
+
+                if(count>0&&LengthSquared(p-out[count-1])<ContactManifoldQuery::LINEAR_SLOP*ContactManifoldQuery::LINEAR_SLOP)
+                    continue;
+
+                out[count++]=p;
+            }
+
+            if(count>1&&LengthSquared(out[count-1]-out[0])<ContactManifoldQuery::LINEAR_SLOP*ContactManifoldQuery::LINEAR_SLOP)
+                --count;
+
+            if(count==0)
+                out[count++]=shape(direction);
+
+            return count;
+        }
+
+        /**
+         * Merge near-duplicate points (keeping the deeper one), reduce to 4 and store
+         */
+        bool FinishManifold(ContactPoint *candidates,uint32_t count,const Vector3f &normal,ContactManifold &manifold)
+        {
+            uint32_t unique=0;
+
+            for(uint32_t i=0;i<count;i++)
+            {
+                bool merged=false;
+
+                for(uint32_t j=0;j<unique;j++)
+                {
+                    if(LengthSquared(candidates[i].point_b-candidates[j].point_b)<ContactManifoldQuery::LINEAR_SLOP*ContactManifoldQuery::LINEAR_SLOP)
+                    {
+                        if(candidates[i].penetration>candidates[j].penetration)
+                            candidates[j]=candidates[i];
+
+                        merged=true;
+                        break;
+                    }
+                }
+
+                if(!merged)
+                    candidates[unique++]=candidates[i];
+            }
+
+            manifold.normal=normal;
+            manifold.count=ContactManifoldQuery::ReduceContacts(candidates,unique,normal,manifold.points);
+
+            return manifold.count>0;
+        }
+
+        ContactPoint MakeContact(const Vector3f &point_a,const Vector3f &point_b,float penetration,uint32_t feature_id)
+        {
+            ContactPoint cp;
+
+            cp.point_a=point_a;
+            cp.point_b=point_b;
+            cp.penetration=penetration>0.0f?penetration:0.0f;
+            cp.feature_id=feature_id;
+
+            return cp;
+        }
+
+        /**
+         * Single contact from EPA, used when no feature clipping applies
+         */
+        bool SingleContact(const CollisionInfo &info,ContactManifold &manifold)
+        {
+            if(!info.intersects)
+                return false;
+
+            manifold.normal=info.normal;
+            manifold.points[0]=MakeContact(info.point,info.point-info.normal*info.penetration,info.penetration,0);
+            manifold.count=1;
+
+            return true;
+        }
+    }//namespace
+
+    uint32_t ContactManifoldQuery::ReduceContacts(const ContactPoint *candidates,uint32_t count,const Vector3f &normal,ContactPoint *out)
+    {
+        if(count<=ContactManifold::MAX_POINTS)
+        {
+            for(uint32_t i=0;i<count;i++)
+                out[i]=candidates[i];
+
+            return count;
+        }
+
+        // 1. Deepest point
+        uint32_t i0=0;
+
+        for(uint32_t i=1;i<count;i++)
+            if(candidates[i].penetration>candidates[i0].penetration)
+                i0=i;
+
+        const Vector3f &p0=candidates[i0].point_b;
+
+        // 2. Farthest from the first
+        uint32_t i1=i0==0?1:0;
+        float best=-1.0f;
+
+        for(uint32_t i=0;i<count;i++)
+        {
+            const float d=LengthSquared(candidates[i].point_b-p0);
+
+            if(i!=i0&&d>best)
+            {
+                best=d;
+                i1=i;
+            }
+        }
+
+        const Vector3f &p1=candidates[i1].point_b;
+
+        // 3. Largest triangle area with the first two
+        uint32_t i2=i0;
+        float best_area=0.0f;
+        float orientation=1.0f;
+
+        for(uint32_t i=0;i<count;i++)
+        {
+            if(i==i0||i==i1)
+                continue;
+
+            const float area=Dot(Cross(p1-p0,candidates[i].point_b-p0),normal);
+
+            if(i2==i0||std::fabs(area)>best_area)
+            {
+                best_area=std::fabs(area);
+                orientation=Sign(area);
+                i2=i;
+            }
+        }
+
+        const Vector3f &p2=candidates[i2].point_b;
+
+        // 4. Point furthest outside the triangle
+        const Vector3f tri[3]={p0,p1,p2};
+        uint32_t i3=i0;
+        float most_outside=FLT_MAX;
+
+        for(uint32_t i=0;i<count;i++)
+        {
+            if(i==i0||i==i1||i==i2)
+                continue;
+
+            float min_area=FLT_MAX;
+
+            for(int e=0;e<3;e++)
+            {
+                const float area=Dot(Cross(tri[(e+1)%3]-tri[e],candidates[i].point_b-tri[e]),normal)*orientation;
+
+                if(area<min_area)
+                    min_area=area;
+            }
+
+            if(i3==i0||min_area<most_outside)
+            {
+                most_outside=min_area;
+                i3=i;
+            }
+        }
+
+        out[0]=candidates[i0];
+        out[1]=candidates[i1];
+        out[2]=candidates[i2];
+        out[3]=candidates[i3];
+
+        return 4;
+    }
+
+    //=============================================================================
+    // OBB-OBB
+    //=============================================================================
+
+    bool ContactManifoldQuery::Generate(const OBB &a,const OBB &b,ContactManifold &manifold)
+    {
+        manifold.Clear();
+
+        const Vector3f axis_a[3]={a.GetAxis(0),a.GetAxis(1),a.GetAxis(2)};
+        const Vector3f axis_b[3]={b.GetAxis(0),b.GetAxis(1),b.GetAxis(2)};
+        const float ext_a[3]={a.GetHalfExtend().x,a.GetHalfExtend().y,a.GetHalfExtend().z};
+        const float ext_b[3]={b.GetHalfExtend().x,b.GetHalfExtend().y,b.GetHalfExtend().z};
+
+        const Vector3f t=b.GetCenter()-a.GetCenter();
+
+        float abs_r[3][3];
+
+        for(int i=0;i<3;i++)
+            for(int j=0;j<3;j++)
+                abs_r[i][j]=std::fabs(Dot(axis_a[i],axis_b[j]))+1e-6f;
+
+        enum class AxisType{FaceA,FaceB,Edge};
+
+        AxisType best_type=AxisType::FaceA;
+        int best_i=0,best_j=0;
+        float best_pen=FLT_MAX;
+        Vector3f best_axis(0,1,0);
+
+        for(int i=0;i<3;i++)
+        {
+            const float rb=ext_b[0]*abs_r[i][0]+ext_b[1]*abs_r[i][1]+ext_b[2]*abs_r[i][2];
+            const float pen=ext_a[i]+rb-std::fabs(Dot(t,axis_a[i]));
+
+            if(pen<0.0f)
+                return false;
+
+            if(pen<best_pen)
+            {
+                best_pen=pen;
+                best_type=AxisType::FaceA;
+                best_i=i;
+                best_axis=axis_a[i];
+            }
+        }
+
+        for(int j=0;j<3;j++)
+        {
+            const float ra=ext_a[0]*abs_r[0][j]+ext_a[1]*abs_r[1][j]+ext_a[2]*abs_r[2][j];
+            const float pen=ra+ext_b[j]-std::fabs(Dot(t,axis_b[j]));
+
+            if(pen<0.0f)
+                return false;
+
+            if(pen<best_pen)
+            {
+                best_pen=pen;
+                best_type=AxisType::FaceB;
+                best_i=j;
+                best_axis=axis_b[j];
+            }
+        }
+
+        const float face_pen=best_pen;
+
+        for(int i=0;i<3;i++)
+        {
+            for(int j=0;j<3;j++)
+            {
+                Vector3f l=Cross(axis_a[i],axis_b[j]);
+                const float len=Length(l);
+
+                if(len<1e-5f)
+                    continue;       // Parallel edges, covered by the face axes
+
+                l/=len;
+
+                float ra=0.0f,rb=0.0f;
+
+                for(int k=0;k<3;k++)
+                {
+                    ra+=ext_a[k]*std::fabs(Dot(axis_a[k],l));
+                    rb+=ext_b[k]*std::fabs(Dot(axis_b[k],l));
+                }
+
+                const float pen=ra+rb-std::fabs(Dot(t,l));
+
+                if(pen<0.0f)
+                    return false;
+
+                if(pen<FACE_AXIS_BIAS*face_pen&&pen<best_pen)
+                {
+                    best_pen=pen;
+                    best_type=AxisType::Edge;
+                    best_i=i;
+                    best_j=j;
+                    best_axis=l;
+                }
+            }
+        }
+
+        const Vector3f normal=best_axis*Sign(Dot(t,best_axis));
+
+        if(best_type==AxisType::Edge)
+        {
+            // Edges of each box parallel to the separating edge pair, closest to the other box
+            Vector3f edge_a=a.GetCenter();
+            Vector3f edge_b=b.GetCenter();
+
+            for(int k=0;k<3;k++)
+            {
+                if(k!=best_i)edge_a+=axis_a[k]*(ext_a[k]*Sign(Dot(normal,axis_a[k])));
+                if(k!=best_j)edge_b-=axis_b[k]*(ext_b[k]*Sign(Dot(normal,axis_b[k])));
+            }
+
+            const Vector3f half_a=axis_a[best_i]*ext_a[best_i];
+            const Vector3f half_b=axis_b[best_j]*ext_b[best_j];
+
+            const ClosestPointsResult closest=DistanceQuery::ClosestPointsOnLineSegments(edge_a-half_a,edge_a+half_a,edge_b-half_b,edge_b+half_b);
+
+            manifold.normal=normal;
+            manifold.points[0]=MakeContact(closest.pointOnA,closest.pointOnB,best_pen,EDGE_FEATURE|uint32_t(best_i*3+best_j));
+            manifold.count=1;
+            return true;
+        }
+
+        const bool ref_is_a=(best_type==AxisType::FaceA);
+
+        const OBB &ref=ref_is_a?a:b;
+        const OBB &inc=ref_is_a?b:a;
+
+        const Vector3f ref_normal=ref_is_a?normal:-normal;      // Reference face normal, towards the incident box
+
+        // Reference face
+        const int ri=best_i;
+        const int ru=(ri+1)%3;
+        const int rv=(ri+2)%3;
+        const float ref_ext[3]={ref.GetHalfExtend().x,ref.GetHalfExtend().y,ref.GetHalfExtend().z};
+        const float ref_side=Sign(Dot(ref_normal,ref.GetAxis(ri)));
+
+        const Vector3f ref_center=ref.GetCenter()+ref.GetAxis(ri)*(ref_ext[ri]*ref_side);
+        const Vector3f ref_u=ref.GetAxis(ru)*ref_ext[ru];
+        const Vector3f ref_v=ref.GetAxis(rv)*ref_ext[rv];
+
+        const Vector3f ref_face[4]=
+        {
+            ref_center+ref_u+ref_v,
+            ref_center-ref_u+ref_v,
+            ref_center-ref_u-ref_v,
+            ref_center+ref_u-ref_v
+        };
+
+        // Incident face: the face of the other box most anti-parallel to the reference normal
+        int ii=0;
+        float best_dot=-1.0f;
+
+        for(int k=0;k<3;k++)
+        {
+            const float d=std::fabs(Dot(ref_normal,inc.GetAxis(k)));
+
+            if(d>best_dot)
+            {
+                best_dot=d;
+                ii=k;
+            }
+        }
+
+        const int iu=(ii+1)%3;
+        const int iv=(ii+2)%3;
+        const float inc_ext[3]={inc.GetHalfExtend().x,inc.GetHalfExtend().y,inc.GetHalfExtend().z};
+        const float inc_side=-Sign(Dot(ref_normal,inc.GetAxis(ii)));
+
+        const Vector3f inc_center=inc.GetCenter()+inc.GetAxis(ii)*(inc_ext[ii]*inc_side);
+        const Vector3f inc_u=inc.GetAxis(iu)*inc_ext[iu];
+        const Vector3f inc_v=inc.GetAxis(iv)*inc_ext[iv];
+
+        const uint32_t inc_face_id=uint32_t(ii*2+(inc_side>0.0f?1:0))<<4;
+
+        ClipPolygon incident;
+
+        incident.Push(inc_center+inc_u+inc_v,inc_face_id|0);
+        incident.Push(inc_center-inc_u+inc_v,inc_face_id|1);
+        incident.Push(inc_center-inc_u-inc_v,inc_face_id|2);
+        incident.Push(inc_center+inc_u-inc_v,inc_face_id|3);
+
+        ClipPolygon clipped;
+        ClipAgainstReference(ref_face,4,ref_normal,incident,clipped);
+
+        const float plane_d=Dot(ref_normal,ref_center);
+        const uint32_t ref_face_id=uint32_t((ref_is_a?0:6)+ri*2+(ref_side>0.0f?1:0))<<24;
+
+        ContactPoint candidates[MAX_CLIP_POINTS];
+        uint32_t count=0;
+
+        for(uint32_t k=0;k<clipped.count;k++)
+        {
+            const Vector3f &p=clipped.v[k].p;
+            const float depth=plane_d-Dot(ref_normal,p);
+
+            if(depth<-LINEAR_SLOP)
+                continue;
+
+            const Vector3f on_ref=p+ref_normal*depth;
+
+            candidates[count++]=ref_is_a?MakeContact(on_ref,p,depth,ref_face_id|clipped.v[k].id)
+                                        :MakeContact(p,on_ref,depth,ref_face_id|clipped.v[k].id);
+        }
+
+        if(count==0)
+            return SingleContact(GJK::TestCollision(a,b),manifold);
+
+        return FinishManifold(candidates,count,normal,manifold);
+    }
+
+    //=============================================================================
+    // Capsule-OBB
+    //=============================================================================
+
+    bool ContactManifoldQuery::Generate(const Capsule &capsule,const OBB &box,ContactManifold &manifold)
+    {
+        manifold.Clear();
+
+        const float radius=capsule.GetRadius();
+        const LineSegment core(capsule.GetStart(),capsule.GetEnd());
+
+        Vector3f normal;
+        GJKResult gjk;
+
+        if(!GJK::Query(MakeConvexSupport(core),MakeConvexSupport(box),gjk)&&gjk.distance>1e-6f)
+        {
+            if(gjk.distance>radius)
+                return false;
+
+            normal=(gjk.point_b-gjk.point_a)/gjk.distance;
+
+            manifold.normal=normal;
+            manifold.points[0]=MakeContact(gjk.point_a+normal*radius,gjk.point_b,radius-gjk.distance,2);
+            manifold.count=1;
+        }
+        else
+        {
+            // Core segment inside the box: full EPA against the capsule
+            if(!SingleContact(GJK::TestCollision(capsule,box),manifold))
+                return false;
+
+            manifold.points[0].feature_id=2;
+            normal=manifold.normal;
+        }
+
+        // Box face facing the capsule
+        int k=0;
+        float best_dot=-1.0f;
+
+        for(int i=0;i<3;i++)
+        {
+            const float d=std::fabs(Dot(normal,box.GetAxis(i)));
+
+            if(d>best_dot)
+            {
+                best_dot=d;
+                k=i;
+            }
+        }
+
+        if(best_dot<FACE_ALIGN_COS)
+            return true;
+
+        const float ext[3]={box.GetHalfExtend().x,box.GetHalfExtend().y,box.GetHalfExtend().z};
+        const float side=-Sign(Dot(normal,box.GetAxis(k)));
+        const Vector3f face_normal=box.GetAxis(k)*side;
+        const Vector3f face_center=box.GetCenter()+face_normal*ext[k];
+
+        // Clip the core segment to the face rectangle (Liang-Barsky)
+        const Vector3f p0=core.GetStart();
+        const Vector3f d=core.GetEnd()-p0;
+
+        float t0=0.0f,t1=1.0f;
+
+        for(int s=1;s<=2;s++)
+        {
+            const int axis=(k+s)%3;
+            const Vector3f &u=box.GetAxis(axis);
+
+            const float pu=Dot(u,p0-face_center);
+            const float du=Dot(u,d);
+
+            if(std::fabs(du)<1e-8f)
+            {
+                if(std::fabs(pu)>ext[axis])
+                    return true;
+
+                continue;
+            }
+
+            float ta=(-ext[axis]-pu)/du;
+            float tb=( ext[axis]-pu)/du;
+
+            if(ta>tb)std::swap(ta,tb);
+
+            t0=std::max(t0,ta);
+            t1=std::min(t1,tb);
+
+            if(t0>t1)
+                return true;
+        }
+
+        ContactPoint candidates[2];
+        uint32_t count=0;
+        const uint32_t face_id=uint32_t(k*2+(side>0.0f?1:0))<<8;
+
+        for(uint32_t e=0;e<2;e++)
+        {
+            const Vector3f q=p0+d*(e==0?t0:t1);
+            const float dist=Dot(face_normal,q-face_center);
+            const float pen=radius-dist;
+
+            if(pen<0.0f)
+                continue;
+
+            candidates[count++]=MakeContact(q-face_normal*radius,q-face_normal*dist,pen,face_id|e);
+        }
+
+        if(count<2||LengthSquared(candidates[0].point_b-candidates[1].point_b)<LINEAR_SLOP*LINEAR_SLOP)
+            return true;        // Tilted or short capsule: keep the single closest contact
+
+        return FinishManifold(candidates,count,-face_normal,manifold);
+    }
+
+    //=============================================================================
+    // General convex pairs
+    //=============================================================================
+
+    bool ContactManifoldQuery::GenerateConvex(const ConvexSupport &a,const ConvexSupport &b,ContactManifold &manifold,GJKCache *cache)
+    {
+        manifold.Clear();
+
+        const CollisionInfo info=GJK::TestCollision(a,b,cache);
+
+        if(!SingleContact(info,manifold))
+            return false;
+
+        const Vector3f &n=info.normal;
+
+        Vector3f feature_a[FEATURE_SAMPLES];
+        Vector3f feature_b[FEATURE_SAMPLES];
+
+        const uint32_t count_a=SupportFeature(a, n,feature_a);     // A's feature facing B
+        const uint32_t count_b=SupportFeature(b,-n,feature_b);     // B's feature facing A
+
+        const float max_a=Dot(n,feature_a[0]);
+        const float min_b=Dot(n,feature_b[0]);
+
+        ContactPoint candidates[MAX_CLIP_POINTS];
+        uint32_t count=0;
+
+        if(count_a>=3||count_b>=3)
+        {
+            const bool ref_is_a=(count_a>=3);
+
+            ClipPolygon incident;
+
+            if(ref_is_a)
+                for(uint32_t i=0;i<count_b;i++)incident.Push(feature_b[i],i);
+            else
+                for(uint32_t i=0;i<count_a;i++)incident.Push(feature_a[i],i);
+
+            ClipPolygon clipped;
+
+            if(ref_is_a)
+                ClipAgainstReference(feature_a,count_a, n,incident,clipped);
+            else
+                ClipAgainstReference(feature_b,count_b,-n,incident,clipped);
+
+            for(uint32_t i=0;i<clipped.count;i++)
+            {
+                const Vector3f &p=clipped.v[i].p;
+
+                if(ref_is_a)
+                {
+                    const float pen=max_a-Dot(n,p);
+
+                    if(pen>=-LINEAR_SLOP)
+                        candidates[count++]=MakeContact(p+n*pen,p,pen,clipped.v[i].id);
+                }
+                else
+                {
+                    const float pen=Dot(n,p)-min_b;
+
+                    if(pen>=-LINEAR_SLOP)
+                        candidates[count++]=MakeContact(p,p-n*pen,pen,clipped.v[i].id);
+                }
+            }
+        }
+        else if(count_a==2&&count_b==2)
+        {
+            // Parallel edges: keep the overlapping part of B's edge
+            const Vector3f dir_a=Normalized(feature_a[1]-feature_a[0]);
+            const Vector3f edge_b=feature_b[1]-feature_b[0];
+
+            if(std::fabs(Dot(dir_a,Normalized(edge_b)))>=FACE_ALIGN_COS)
+            {
+                const float a0=Dot(dir_a,feature_a[0]);
+                const float a1=Dot(dir_a,feature_a[1]);
+                const float b0=Dot(dir_a,feature_b[0]);
+                const float db=Dot(dir_a,edge_b);
+
+                float t0=(a0-b0)/db;
+                float t1=(a1-b0)/db;
+
+                if(t0>t1)std::swap(t0,t1);
+
+                t0=std::max(t0,0.0f);
+                t1=std::min(t1,1.0f);
+
+                if(t0<=t1)
+                {
+                    for(uint32_t e=0;e<2;e++)
+                    {
+                        const Vector3f p=feature_b[0]+edge_b*(e==0?t0:t1);
+                        const float pen=max_a-Dot(n,p);
+
+                        if(pen>=-LINEAR_SLOP)
+                            candidates[count++]=MakeContact(p+n*pen,p,pen,e);
+                    }
+                }
+            }
+        }
+
+        if(count<2)
+            return true;        // Keep the EPA contact
+
+        return FinishManifold(candidates,count,n,manifold);
+    }
+
+    //=============================================================================
+    // ContactManifoldCache
+    //=============================================================================
+
+    ContactManifold &ContactManifoldCache::Update(uint64_t pair_id,const ContactManifold &fresh)
+    {
+        Entry &entry=entries[pair_id];
+
+        ContactManifold result=fresh;
+
+        // Only inherit from a manifold generated last frame with a similar normal
+        const ContactManifold &old=entry.manifold;
+        const bool inherit=old.count>0
+                         &&entry.manifold_frame+1>=frame
+                         &&Dot(old.normal,fresh.normal)>=normal_tolerance;
+
+        if(inherit)
+        {
+            bool used[ContactManifold::MAX_POINTS]={};
+            const float match_sq=match_distance*match_distance;
+
+            for(uint32_t i=0;i<result.count;i++)
+            {
+                ContactPoint &cp=result.points[i];
+                const Vector3f pos=cp.GetPosition();
+
+                int best=-1;
+                float best_dist=match_sq;
+
+                for(uint32_t j=0;j<old.count;j++)
+                {
+                    if(used[j])
+                        continue;
+
+                    const float d=LengthSquared(old.points[j].GetPosition()-pos);
+
+                    if(d>match_sq)
+                        continue;
+
+                    // Same feature wins outright, otherwise nearest
+                    if(old.points[j].feature_id==cp.feature_id)
+                    {
+                        best=int(j);
+                        break;
+                    }
+
+                    if(d<=best_dist)
+                    {
+                        best_dist=d;
+                        best=int(j);
+                    }
+                }
+
+                if(best<0)
+                    continue;
+
+                used[best]=true;
+
+                cp.normal_impulse    =old.points[best].normal_impulse;
+                cp.tangent_impulse[0]=old.points[best].tangent_impulse[0];
+                cp.tangent_impulse[1]=old.points[best].tangent_impulse[1];
+                cp.lifetime          =old.points[best].lifetime+1;
+            }
+        }
+
+        entry.manifold=result;
+        entry.manifold_frame=frame;
+        entry.last_frame=frame;
+
+        return entry.manifold;
+    }
+
+    GJKCache *ContactManifoldCache::GetGJKCache(uint64_t pair_id)
+    {
+        Entry &entry=entries[pair_id];
+
+        entry.last_frame=frame;
+
+        return &entry.gjk;
+    }
+
+    ContactManifold *ContactManifoldCache::Find(uint64_t pair_id)
+    {
+        auto it=entries.find(pair_id);
+
+        if(it==entries.end()||it->second.manifold_frame!=frame)
+            return nullptr;
+
+        return &it->second.manifold;
+    }
+
+    const ContactManifold *ContactManifoldCache::Find(uint64_t pair_id)const
+    {
+        auto it=entries.find(pair_id);
+
+        if(it==entries.end()||it->second.manifold_frame!=frame)
+            return nullptr;
+
+        return &it->second.manifold;
+    }
+
+    uint32_t ContactManifoldCache::RemoveStale(uint32_t max_age)
+    {
+        uint32_t removed=0;
+
+        for(auto it=entries.begin();it!=entries.end();)
+        {
+            if(frame-it->second.last_frame>=max_age)
+            {
+                it=entries.erase(it);
+                ++removed;
+            }
+            else
+                ++it;
+        }
+
+        return removed;
+    }
+}//namespace hgl::math
@@ -0,0 +1,442 @@
+﻿/**
+ * ContainmentBatch.cpp - Three-state classification of many objects against one container
+ *
+ * Each (container, object type) pair is a branch-free lane function returning the
+ * 2-bit state of object i. Containers are reduced to plain values (and, for the
+ * OBB-AABB separating axis test, precomputed axes and projected radii) before the
+ * loop. Lanes are evaluated into a small byte buffer and then packed four per byte.
+ */
+#include<hgl/math/geometry/queries/ContainmentQuery.h>
+#include<hgl/math/geometry/BatchQueryStructures.h>
+#include<hgl/math/ParallelFor.h>
+#include<algorithm>
+#include<cmath>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr size_t STATE_BLOCK = 256;        // lanes evaluated before each packing pass
+        constexpr int GOLDEN_STEPS = 24;           // bracket shrinks to 0.618^24 (~1e-5) of the segment
+        constexpr float GOLDEN_RATIO = 0.618034f;
+        constexpr float AXIS_EPSILON = 1e-6f;      // inflates cross-axis projections of near-parallel edges
+
+        // Chunks hold a multiple of PARALLEL_CHUNK_ALIGNMENT objects, so two chunks never write the same byte
+        static_assert(PARALLEL_CHUNK_ALIGNMENT % 4 == 0, "chunks must start on a state byte boundary");
+        static_assert(STATE_BLOCK % 4 == 0, "blocks must start on a state byte boundary");
+
+        inline uint8_t State(bool inside, bool outside)
+        {
+            return uint8_t(!outside) + uint8_t(inside && !outside);
+        }
+
+        inline float SegmentDistanceSquared(const Vector3f& p, const Vector3f& a, const Vector3f& ab, float inv_len2)
+        {
+            const float t = std::clamp(Dot(p - a, ab) * inv_len2, 0.0f, 1.0f);
+            const Vector3f d = p - (a + ab * t);
+
+            return Dot(d, d);
+        }
+
+        inline float BoxDistanceSquared(const Vector3f& p, const Vector3f& min_point, const Vector3f& max_point)
+        {
+            const float ex = std::max(std::max(min_point.x - p.x, p.x - max_point.x), 0.0f);
+            const float ey = std::max(std::max(min_point.y - p.y, p.y - max_point.y), 0.0f);
+            const float ez = std::max(std::max(min_point.z - p.z, p.z - max_point.z), 0.0f);
+
+            return ex * ex + ey * ey + ez * ez;
+        }
+
+        /**
+         * Lower bound of the distance between segment a+ab*t and a box.
+         *
+         * f(t) = |a+ab*t - box| is convex and |ab|-Lipschitz, so after a fixed number
+         * of golden-section steps the minimum lies in [lo,hi] and is at least
+         * min(f1,f2) - |ab|*(hi-lo).
+         */
+        inline float SegmentBoxDistanceLowerBound(const Vector3f& a, const Vector3f& ab, float length,
+                                                  const Vector3f& min_point, const Vector3f& max_point)
+        {
+            float lo = 0.0f, hi = 1.0f;
+            float x1 = 1.0f - GOLDEN_RATIO, x2 = GOLDEN_RATIO;
+            float f1 = BoxDistanceSquared(a + ab * x1, min_point, max_point);
+            float f2 = BoxDistanceSquared(a + ab * x2, min_point, max_point);
+
+            for (int step = 0; step < GOLDEN_STEPS; step++)
+            {
+                const bool left = f1 < f2;          // minimum in [lo,x2], otherwise in [x1,hi]
+
+                lo = left ? lo : x1;
+                hi = left ? x2 : hi;
+
+                const float e = left ? hi - GOLDEN_RATIO * (hi - lo) : lo + GOLDEN_RATIO * (hi - lo);
+                const float fe = BoxDistanceSquared(a + ab * e, min_point, max_point);
+
+                const float nx1 = left ? e : x2;
+                const float nf1 = left ? fe : f2;
+                const float nx2 = left ? x1 : e;
+                const float nf2 = left ? f1 : fe;
+
+                x1 = nx1; f1 = nf1;
+                x2 = nx2; f2 = nf2;
+            }
+
+            return std::sqrt(std::min(f1, f2)) - length * (hi - lo);
+        }
+
+        /**
+         * Separating axis data of an OBB container against world-aligned boxes.
+         * Everything that depends only on the container is computed once.
+         */
+        struct OBBAxes
+        {
+            Vector3f center;
+            Vector3f axis[3];
+            Vector3f abs_axis[3];           // |axis[i]| per component
+            float half[3];
+
+            float world_radius[3];          // container radius projected on world axis k
+
+            Vector3f cross[9];              // axis[i] x e_k
+            Vector3f abs_cross[9];          // |cross| per component, inflated by AXIS_EPSILON
+            float cross_radius[9];          // container radius projected on cross[n]
+
+            explicit OBBAxes(const OBB& box)
+            {
+                center = box.GetCenter();
+
+                const Vector3f h = box.GetHalfExtend();
+                half[0] = h.x; half[1] = h.y; half[2] = h.z;
+
+                for (int i = 0; i < 3; i++)
+                {
+                    axis[i] = box.GetAxis(i);
+                    abs_axis[i] = Vector3f(std::abs(axis[i].x), std::abs(axis[i].y), std::abs(axis[i].z));
+                }
+
+                for (int k = 0; k < 3; k++)
+                    world_radius[k] = half[0] * abs_axis[0][k] + half[1] * abs_axis[1][k] + half[2] * abs_axis[2][k];
+
+                for (int i = 0; i < 3; i++)
+                    for (int k = 0; k < 3; k++)
+                    {
+                        Vector3f e(0, 0, 0);
+                        e[k] = 1.0f;
+
+                        const int n = i * 3 + k;
+                        cross[n] = Cross(axis[i], e);
+                        abs_cross[n] = Vector3f(std::abs(cross[n].x) + AXIS_EPSILON,
+                                                std::abs(cross[n].y) + AXIS_EPSILON,
+                                                std::abs(cross[n].z) + AXIS_EPSILON);
+                        cross_radius[n] = half[0] * std::abs(Dot(axis[0], cross[n]))
+                                        + half[1] * std::abs(Dot(axis[1], cross[n]))
+                                        + half[2] * std::abs(Dot(axis[2], cross[n]));
+                    }
+            }
+
+            uint8_t Classify(const Vector3f& box_center, const Vector3f& extent) const
+            {
+                const Vector3f d = box_center - center;
+
+                bool inside = true;
+                bool outside = false;
+
+                for (int i = 0; i < 3; i++)
+                {
+                    const float t = std::abs(Dot(d, axis[i]));
+                    const float r = Dot(abs_axis[i], extent);
+
+                    inside = inside && (t + r <= half[i]);
+                    outside = outside || (t > half[i] + r);
+                }
+
+                for (int k = 0; k < 3; k++)
+                    outside = outside || (std::abs(d[k]) > world_radius[k] + extent[k]);
+
+                for (int n = 0; n < 9; n++)
+                    outside = outside || (std::abs(Dot(d, cross[n])) > cross_radius[n] + Dot(abs_cross[n], extent));
+
+                return State(inside, outside);
+            }
+        };
+
+        /**
+         * states[i] = lane(i), packed four per byte
+         */
+        template<typename Lane>
+        void ClassifyLanes(size_t count, BatchContainmentResults& out, IParallelExecutor* executor, const Lane& lane)
+        {
+            out.Resize(count);
+
+            uint8_t* packed = out.states.data();
+
+            ParallelForChunks(executor, 0, count, ComputeChunkSize(sizeof(float) * 6),
+                [&](size_t, size_t begin, size_t end)
+                {
+                    uint8_t state[STATE_BLOCK];
+
+                    for (size_t block = begin; block < end; block += STATE_BLOCK)
+                    {
+                        const size_t n = std::min(STATE_BLOCK, end - block);
+                        const size_t padded = (n + 3) & ~size_t(3);
+
+                        HGL_OMP_SIMD
+                        for (size_t i = 0; i < n; i++)
+                            state[i] = lane(block + i);
+
+                        for (size_t i = n; i < padded; i++)
+                            state[i] = 0;
+
+                        for (size_t i = 0; i < padded; i += 4)
+                            packed[(block + i) / 4] = uint8_t(state[i] | (state[i + 1] << 2) | (state[i + 2] << 4) | (state[i + 3] << 6));
+                    }
+                });
+        }
+    }//namespace
+
+    //=============================================================================
+    // AABB container
+    //=============================================================================
+
+    void ContainmentQuery::Classify(const AABB& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f minPoint = container.GetMin();
+        const Vector3f maxPoint = container.GetMax();
+        const float* px = points.x.data();
+        const float* py = points.y.data();
+        const float* pz = points.z.data();
+
+        ClassifyLanes(points.count, out, executor, [&](size_t i)
+        {
+            const bool inside = px[i] >= minPoint.x && px[i] <= maxPoint.x
+                             && py[i] >= minPoint.y && py[i] <= maxPoint.y
+                             && pz[i] >= minPoint.z && pz[i] <= maxPoint.z;
+
+            return State(inside, !inside);
+        });
+    }
+
+    void ContainmentQuery::Classify(const AABB& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f minPoint = container.GetMin();
+        const Vector3f maxPoint = container.GetMax();
+
+        ClassifyLanes(spheres.count, out, executor, [&](size_t i)
+        {
+            const Vector3f c(spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]);
+            const float r = spheres.radius[i];
+
+            const bool inside = c.x - r >= minPoint.x && c.x + r <= maxPoint.x
+                             && c.y - r >= minPoint.y && c.y + r <= maxPoint.y
+                             && c.z - r >= minPoint.z && c.z + r <= maxPoint.z;
+
+            return State(inside, BoxDistanceSquared(c, minPoint, maxPoint) > r * r);
+        });
+    }
+
+    void ContainmentQuery::Classify(const AABB& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f minPoint = container.GetMin();
+        const Vector3f maxPoint = container.GetMax();
+
+        ClassifyLanes(boxes.count, out, executor, [&](size_t i)
+        {
+            const bool inside = boxes.minX[i] >= minPoint.x && boxes.maxX[i] <= maxPoint.x
+                             && boxes.minY[i] >= minPoint.y && boxes.maxY[i] <= maxPoint.y
+                             && boxes.minZ[i] >= minPoint.z && boxes.maxZ[i] <= maxPoint.z;
+
+            const bool outside = boxes.minX[i] > maxPoint.x || boxes.maxX[i] < minPoint.x
+                              || boxes.minY[i] > maxPoint.y || boxes.maxY[i] < minPoint.y
+                              || boxes.minZ[i] > maxPoint.z || boxes.maxZ[i] < minPoint.z;
+
+            return State(inside, outside);
+        });
+    }
+
+    //=============================================================================
+    // OBB container
+    //=============================================================================
+
+    void ContainmentQuery::Classify(const OBB& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f center = container.GetCenter();
+        const Vector3f a0 = container.GetAxis(0);
+        const Vector3f a1 = container.GetAxis(1);
+        const Vector3f a2 = container.GetAxis(2);
+        const Vector3f half = container.GetHalfExtend();
+
+        ClassifyLanes(points.count, out, executor, [&](size_t i)
+        {
+            const Vector3f d = Vector3f(points.x[i], points.y[i], points.z[i]) - center;
+
+            const bool inside = std::abs(Dot(d, a0)) <= half.x
+                             && std::abs(Dot(d, a1)) <= half.y
+                             && std::abs(Dot(d, a2)) <= half.z;
+
+            return State(inside, !inside);
+        });
+    }
+
+    void ContainmentQuery::Classify(const OBB& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f center = container.GetCenter();
+        const Vector3f a0 = container.GetAxis(0);
+        const Vector3f a1 = container.GetAxis(1);
+        const Vector3f a2 = container.GetAxis(2);
+        const Vector3f half = container.GetHalfExtend();
+
+        ClassifyLanes(spheres.count, out, executor, [&](size_t i)
+        {
+            const Vector3f d = Vector3f(spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]) - center;
+            const float r = spheres.radius[i];
+
+            const float lx = std::abs(Dot(d, a0));
+            const float ly = std::abs(Dot(d, a1));
+            const float lz = std::abs(Dot(d, a2));
+
+            const float ex = std::max(lx - half.x, 0.0f);
+            const float ey = std::max(ly - half.y, 0.0f);
+            const float ez = std::max(lz - half.z, 0.0f);
+
+            const bool inside = lx + r <= half.x && ly + r <= half.y && lz + r <= half.z;
+
+            return State(inside, ex * ex + ey * ey + ez * ez > r * r);
+        });
+    }
+
+    void ContainmentQuery::Classify(const OBB& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const OBBAxes axes(container);
+
+        ClassifyLanes(boxes.count, out, executor, [&](size_t i)
+        {
+            const Vector3f minPoint(boxes.minX[i], boxes.minY[i], boxes.minZ[i]);
+            const Vector3f maxPoint(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+
+            return axes.Classify((minPoint + maxPoint) * 0.5f, (maxPoint - minPoint) * 0.5f);
+        });
+    }
+
+    //=============================================================================
+    // Sphere container
+    //=============================================================================
+
+    void ContainmentQuery::Classify(const Sphere& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f center = container.GetCenter();
+        const float radius2 = container.GetRadius() * container.GetRadius();
+
+        ClassifyLanes(points.count, out, executor, [&](size_t i)
+        {
+            const Vector3f d = Vector3f(points.x[i], points.y[i], points.z[i]) - center;
+            const bool inside = Dot(d, d) <= radius2;
+
+            return State(inside, !inside);
+        });
+    }
+
+    void ContainmentQuery::Classify(const Sphere& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f center = container.GetCenter();
+        const float radius = container.GetRadius();
+
+        ClassifyLanes(spheres.count, out, executor, [&](size_t i)
+        {
+            const float distance = Length(Vector3f(spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]) - center);
+            const float r = spheres.radius[i];
+
+            return State(distance + r <= radius, distance > radius + r);
+        });
+    }
+
+    void ContainmentQuery::Classify(const Sphere& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f center = container.GetCenter();
+        const float radius2 = container.GetRadius() * container.GetRadius();
+
+        ClassifyLanes(boxes.count, out, executor, [&](size_t i)
+        {
+            const Vector3f minPoint(boxes.minX[i], boxes.minY[i], boxes.minZ[i]);
+            const Vector3f maxPoint(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+
+            // Farthest corner from the center, per axis
+            const float fx = std::max(std::abs(center.x - minPoint.x), std::abs(center.x - maxPoint.x));
+            const float fy = std::max(std::abs(center.y - minPoint.y), std::abs(center.y - maxPoint.y));
+            const float fz = std::max(std::abs(center.z - minPoint.z), std::abs(center.z - maxPoint.z));
+
+            return State(fx * fx + fy * fy + fz * fz <= radius2,
+                         BoxDistanceSquared(center, minPoint, maxPoint) > radius2);
+        });
+    }
+
+    //=============================================================================
+    // Capsule container
+    //=============================================================================
+
+    void ContainmentQuery::Classify(const Capsule& container, const BatchPointSOA& points, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f a = container.GetStart();
+        const Vector3f ab = container.GetEnd() - a;
+        const float lengthSq = Dot(ab, ab);
+        const float invLength2 = lengthSq > 0.0f ? 1.0f / lengthSq : 0.0f;
+        const float radius2 = container.GetRadius() * container.GetRadius();
+
+        ClassifyLanes(points.count, out, executor, [&](size_t i)
+        {
+            const bool inside = SegmentDistanceSquared(Vector3f(points.x[i], points.y[i], points.z[i]), a, ab, invLength2) <= radius2;
+
+            return State(inside, !inside);
+        });
+    }
+
+    void ContainmentQuery::Classify(const Capsule& container, const BatchSphereSOA& spheres, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f a = container.GetStart();
+        const Vector3f ab = container.GetEnd() - a;
+        const float lengthSq = Dot(ab, ab);
+        const float invLength2 = lengthSq > 0.0f ? 1.0f / lengthSq : 0.0f;
+        const float radius = container.GetRadius();
+
+        ClassifyLanes(spheres.count, out, executor, [&](size_t i)
+        {
+            const Vector3f c(spheres.centerX[i], spheres.centerY[i], spheres.centerZ[i]);
+            const float distance = std::sqrt(SegmentDistanceSquared(c, a, ab, invLength2));
+            const float r = spheres.radius[i];
+
+            // The point of the sphere farthest from the axis lies on the line through
+            // its center and the closest axis point, so both tests are exact
+            return State(distance + r <= radius, distance > radius + r);
+        });
+    }
+
+    void ContainmentQuery::Classify(const Capsule& container, const BatchAABBSOA& boxes, BatchContainmentResults& out, IParallelExecutor* executor)
+    {
+        const Vector3f a = container.GetStart();
+        const Vector3f ab = container.GetEnd() - a;
+        const float lengthSq = Dot(ab, ab);
+        const float length = std::sqrt(lengthSq);
+        const float invLength2 = lengthSq > 0.0f ? 1.0f / lengthSq : 0.0f;
+        const float radius = container.GetRadius();
+        const float radius2 = radius * radius;
+
+        ClassifyLanes(boxes.count, out, executor, [&](size_t i)
+        {
+            const Vector3f minPoint(boxes.minX[i], boxes.minY[i], boxes.minZ[i]);
+            const Vector3f maxPoint(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+
+            // The capsule is convex: the box is inside when all eight corners are
+            bool inside = true;
+            for (int corner = 0; corner < 8; corner++)
+            {
+                const Vector3f p((corner & 1) ? maxPoint.x : minPoint.x,
+                                 (corner & 2) ? maxPoint.y : minPoint.y,
+                                 (corner & 4) ? maxPoint.z : minPoint.z);
+
+                inside = inside && SegmentDistanceSquared(p, a, ab, invLength2) <= radius2;
+            }
+
+            return State(inside, SegmentBoxDistanceLowerBound(a, ab, length, minPoint, maxPoint) > radius);
+        });
+    }
+
+}//namespace hgl::math
@@ -0,0 +1,575 @@
+﻿/**
+ * DistanceBatch.cpp - Point-to-primitive distances for many points / many primitives
+ *
+ * Every primitive is reduced to a branch-free lane function of one point.
+ * N points vs. one primitive runs the lane over SoA point columns in cache-sized
+ * chunks (optionally on an executor); one point vs. N primitives evaluates blocks
+ * of lanes into a small buffer and then scans it for the minimum, so the
+ * distance loop itself stays vectorizable.
+ *
+ * Closest points use the same scheme: every candidate feature is evaluated and
+ * one is selected, instead of branching on the Voronoi region. Triangle distances
+ * are the length to the triangle closest point, so they match the scalar query.
+ */
+#include<hgl/math/geometry/queries/DistanceQuery.h>
+#include<hgl/math/geometry/BatchQueryStructures.h>
+#include<hgl/math/geometry/OBB.h>
+#include<hgl/math/geometry/primitives/Cone.h>
+#include<hgl/math/geometry/primitives/Torus.h>
+#include<hgl/math/ParallelFor.h>
+#include<algorithm>
+#include<cmath>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr size_t MIN_BLOCK = 256;          // lanes evaluated before each min scan
+
+        inline float SafeInverse(float value)
+        {
+            return value > 0.0f ? 1.0f / value : 0.0f;
+        }
+
+        //=========================================================================
+        // Lane functions (distance to the solid, 0 inside)
+        //=========================================================================
+
+        inline float SphereDistance(const Vector3f& p, const Vector3f& center, float radius)
+        {
+            return std::max(Length(p - center) - radius, 0.0f);
+        }
+
+        /**
+         * @param inv_len2 1/|ab|^2, 0 for a degenerate axis (capsule becomes a sphere at a)
+         */
+        inline float CapsuleDistance(const Vector3f& p, const Vector3f& a, const Vector3f& ab, float inv_len2, float radius)
+        {
+            const float t = std::clamp(Dot(p - a, ab) * inv_len2, 0.0f, 1.0f);
+
+            return std::max(Length(p - (a + ab * t)) - radius, 0.0f);
+        }
+
+        inline float AABBDistance(const Vector3f& p, const Vector3f& min_point, const Vector3f& max_point)
+        {
+            const float ex = std::max(std::max(min_point.x - p.x, p.x - max_point.x), 0.0f);
+            const float ey = std::max(std::max(min_point.y - p.y, p.y - max_point.y), 0.0f);
+            const float ez = std::max(std::max(min_point.z - p.z, p.z - max_point.z), 0.0f);
+
+            return std::sqrt(ex * ex + ey * ey + ez * ez);
+        }
+
+        inline float OBBDistance(const Vector3f& p, const Vector3f& center,
+                                 const Vector3f& a0, const Vector3f& a1, const Vector3f& a2, const Vector3f& half)
+        {
+            const Vector3f d = p - center;
+
+            const float ex = std::max(std::abs(Dot(d, a0)) - half.x, 0.0f);
+            const float ey = std::max(std::abs(Dot(d, a1)) - half.y, 0.0f);
+            const float ez = std::max(std::abs(Dot(d, a2)) - half.z, 0.0f);
+
+            return std::sqrt(ex * ex + ey * ey + ez * ez);
+        }
+
+        /**
+         * Split p-origin into the coordinate along axis (h) and the distance from the axis (q)
+         */
+        inline void AxialCoordinates(const Vector3f& p, const Vector3f& origin, const Vector3f& axis, float& h, float& q)
+        {
+            const Vector3f d = p - origin;
+
+            h = Dot(d, axis);
+            q = Length(d - axis * h);
+        }
+
+        inline float CylinderDistance(const Vector3f& p, const Vector3f& center, const Vector3f& axis, float half_height, float radius)
+        {
+            float h, q;
+            AxialCoordinates(p, center, axis, h, q);
+
+            const float dh = std::max(std::abs(h) - half_height, 0.0f);
+            const float dq = std::max(q - radius, 0.0f);
+
+            return std::sqrt(dh * dh + dq * dq);
+        }
+
+        /**
+         * In the (h,q) half plane the cone is the triangle apex (0,0), rim (H,R), base center (H,0).
+         * Outside it, the closest feature is either the base segment or the slant segment.
+         *
+         * @param inv_slant2 1/(H^2+R^2)
+         */
+        inline float ConeDistance(const Vector3f& p, const Vector3f& apex, const Vector3f& axis, float height, float radius, float inv_slant2)
+        {
+            float h, q;
+            AxialCoordinates(p, apex, axis, h, q);
+
+            const float bh = h - height;
+            const float bq = std::max(q - radius, 0.0f);
+            const float base2 = bh * bh + bq * bq;
+
+            const float t = std::clamp((h * height + q * radius) * inv_slant2, 0.0f, 1.0f);
+            const float sh = h - t * height;
+            const float sq = q - t * radius;
+            const float slant2 = sh * sh + sq * sq;
+
+            const bool inside = (h <= height) && (q * height <= h * radius);
+
+            return inside ? 0.0f : std::sqrt(std::min(base2, slant2));
+        }
+
+        inline float TorusDistance(const Vector3f& p, const Vector3f& center, const Vector3f& axis, float major_radius, float minor_radius)
+        {
+            float h, q;
+            AxialCoordinates(p, center, axis, h, q);
+
+            const float dq = q - major_radius;
+
+            return std::max(std::sqrt(dq * dq + h * h) - minor_radius, 0.0f);
+        }
+
+        //=========================================================================
+        // Closest point lane functions (the point itself when inside)
+        //=========================================================================
+
+        inline Vector3f OBBClosestPoint(const Vector3f& p, const Vector3f& center,
+                                        const Vector3f& a0, const Vector3f& a1, const Vector3f& a2, const Vector3f& half)
+        {
+            const Vector3f d = p - center;
+
+            return center
+                 + a0 * std::clamp(Dot(d, a0), -half.x, half.x)
+                 + a1 * std::clamp(Dot(d, a1), -half.y, half.y)
+                 + a2 * std::clamp(Dot(d, a2), -half.z, half.z);
+        }
+
+        inline Vector3f ConeClosestPoint(const Vector3f& p, const Vector3f& apex, const Vector3f& axis, float height, float radius, float inv_slant2)
+        {
+            const Vector3f d = p - apex;
+            const float h = Dot(d, axis);
+            const Vector3f radial = d - axis * h;
+            const float q = Length(radial);
+            const Vector3f radial_dir = radial * SafeInverse(q);
+
+            const float base_q = std::min(q, radius);
+            const float base2 = (h - height) * (h - height) + (q - base_q) * (q - base_q);
+
+            const float t = std::clamp((h * height + q * radius) * inv_slant2, 0.0f, 1.0f);
+            const float slant_h = t * height;
+            const float slant_q = t * radius;
+            const float slant2 = (h - slant_h) * (h - slant_h) + (q - slant_q) * (q - slant_q);
+
+            const bool inside = (h <= height) && (q * height <= h * radius);
+            const bool use_base = base2 <= slant2;
+
+            const float out_h = inside ? h : (use_base ? height : slant_h);
+            const float out_q = inside ? q : (use_base ? base_q : slant_q);
+
+            return apex + axis * out_h + radial_dir * out_q;
+        }
+
+        /**
+         * @param fallback unit radial direction used for points on the axis
+         */
+        inline Vector3f TorusClosestPoint(const Vector3f& p, const Vector3f& center, const Vector3f& axis, const Vector3f& fallback,
+                                          float major_radius, float minor_radius)
+        {
+            const Vector3f d = p - center;
+            const Vector3f radial = d - axis * Dot(d, axis);
+            const float q = Length(radial);
+            const Vector3f radial_dir = q > 0.0f ? radial / q : fallback;
+
+            const Vector3f tube_center = center + radial_dir * major_radius;
+            const Vector3f to_point = p - tube_center;
+            const float len = Length(to_point);
+            const float scale = len > minor_radius ? minor_radius / len : 1.0f;
+
+            return tube_center + to_point * scale;
+        }
+
+        /**
+         * Branch-free form of the Voronoi region walk in ClosestPointOnTriangle (Triangle.h):
+         * the same dot products and region tests, but every candidate is computed and the
+         * first region in the scalar test order wins, so batch and scalar results agree.
+         * Divisions of regions that are not selected may yield inf/nan and are discarded.
+         */
+        inline Vector3f TriangleClosestPoint(const Vector3f& p, const Vector3f& a, const Vector3f& b, const Vector3f& c)
+        {
+            const Vector3f ab = b - a;
+            const Vector3f ac = c - a;
+            const Vector3f ap = p - a;
+            const Vector3f bp = p - b;
+            const Vector3f cp = p - c;
+
+            const float d1 = Dot(ab, ap);
+            const float d2 = Dot(ac, ap);
+            const float d3 = Dot(ab, bp);
+            const float d4 = Dot(ac, bp);
+            const float d5 = Dot(ab, cp);
+            const float d6 = Dot(ac, cp);
+
+            const float va = d3 * d6 - d5 * d4;
+            const float vb = d5 * d2 - d1 * d6;
+            const float vc = d1 * d4 - d3 * d2;
+            const float sum = va + vb + vc;
+
+            const bool in_a  = (d1 <= 0.0f) && (d2 <= 0.0f);
+            const bool in_b  = (d3 >= 0.0f) && (d4 <= d3);
+            const bool in_ab = (vc <= 0.0f) && (d1 >= 0.0f) && (d3 <= 0.0f);
+            const bool in_c  = (d6 >= 0.0f) && (d5 <= d6);
+            const bool in_ac = (vb <= 0.0f) && (d2 >= 0.0f) && (d6 <= 0.0f);
+            const bool in_bc = (va <= 0.0f) && ((d4 - d3) >= 0.0f) && ((d5 - d6) >= 0.0f);
+
+            const Vector3f on_ab = a + ab * (d1 / (d1 - d3));
+            const Vector3f on_ac = a + ac * (d2 / (d2 - d6));
+            const Vector3f on_bc = b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+            const Vector3f face = (sum == 0.0f) ? a : a + ab * (vb / sum) + ac * (vc / sum);
+
+            Vector3f result = in_bc ? on_bc : face;
+            result = in_ac ? on_ac : result;
+            result = in_c  ? c     : result;
+            result = in_ab ? on_ab : result;
+            result = in_b  ? b     : result;
+
+            return in_a ? a : result;
+        }
+
+        inline float TriangleDistance(const Vector3f& p, const Vector3f& a, const Vector3f& b, const Vector3f& c)
+        {
+            return Length(p - TriangleClosestPoint(p, a, b, c));
+        }
+
+        //=========================================================================
+        // Drivers
+        //=========================================================================
+
+        /**
+         * out[i] = lane(point i) over cache-sized chunks of the point columns
+         */
+        template<typename Lane>
+        void PointsDistance(const BatchPointSOA& points, float* out, IParallelExecutor* executor, const Lane& lane)
+        {
+            if (!out)
+                return;
+
+            const float* px = points.x.data();
+            const float* py = points.y.data();
+            const float* pz = points.z.data();
+
+            ParallelForChunks(executor, 0, points.count, ComputeChunkSize(sizeof(float) * 4),
+                [&](size_t, size_t begin, size_t end)
+                {
+                    HGL_OMP_SIMD
+                    for (size_t i = begin; i < end; i++)
+                        out[i] = lane(Vector3f(px[i], py[i], pz[i]));
+                });
+        }
+
+        /**
+         * out[i] = lane(point i), written into the SoA output columns
+         */
+        template<typename Lane>
+        void PointsClosest(const BatchPointSOA& points, BatchPointSOA& out, IParallelExecutor* executor, const Lane& lane)
+        {
+            out.Resize(points.count);
+
+            const float* px = points.x.data();
+            const float* py = points.y.data();
+            const float* pz = points.z.data();
+
+            float* ox = out.x.data();
+            float* oy = out.y.data();
+            float* oz = out.z.data();
+
+            ParallelForChunks(executor, 0, points.count, ComputeChunkSize(sizeof(float) * 6),
+                [&](size_t, size_t begin, size_t end)
+                {
+                    HGL_OMP_SIMD
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        const Vector3f c = lane(Vector3f(px[i], py[i], pz[i]));
+
+                        ox[i] = c.x;
+                        oy[i] = c.y;
+                        oz[i] = c.z;
+                    }
+                });
+        }
+
+        /**
+         * Minimum of lane(i) over [0,count), stopping once a primitive contains the point
+         */
+        template<typename Lane>
+        bool MinLaneDistance(size_t count, float& distance, size_t* nearest, const Lane& lane)
+        {
+            if (count == 0)
+                return false;
+
+            float block[MIN_BLOCK];
+            float best = lane(0);
+            size_t best_index = 0;
+
+            for (size_t base = 1; base < count && best > 0.0f; base += MIN_BLOCK)
+            {
+                const size_t n = std::min(MIN_BLOCK, count - base);
+
+                HGL_OMP_SIMD
+                for (size_t i = 0; i < n; i++)
+                    block[i] = lane(base + i);
+
+                for (size_t i = 0; i < n; i++)
+                {
+                    if (block[i] < best)
+                    {
+                        best = block[i];
+                        best_index = base + i;
+                    }
+                }
+            }
+
+            distance = best;
+
+            if (nearest)
+                *nearest = best_index;
+
+            return true;
+        }
+    }//namespace
+
+    //=============================================================================
+    // N points vs. one primitive
+    //=============================================================================
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const Sphere& sphere, float* out, IParallelExecutor* executor)
+    {
+        const Vector3f center = sphere.GetCenter();
+        const float radius = sphere.GetRadius();
+
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return SphereDistance(p, center, radius); });
+    }
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const Capsule& capsule, float* out, IParallelExecutor* executor)
+    {
+        const Vector3f a = capsule.GetStart();
+        const Vector3f ab = capsule.GetEnd() - a;
+        const float inv_len2 = SafeInverse(Dot(ab, ab));
+        const float radius = capsule.GetRadius();
+
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return CapsuleDistance(p, a, ab, inv_len2, radius); });
+    }
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const AABB& box, float* out, IParallelExecutor* executor)
+    {
+        const Vector3f min_point = box.GetMin();
+        const Vector3f max_point = box.GetMax();
+
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return AABBDistance(p, min_point, max_point); });
+    }
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const OBB& box, float* out, IParallelExecutor* executor)
+    {
+        const Vector3f center = box.GetCenter();
+        const Vector3f a0 = box.GetAxis(0);
+        const Vector3f a1 = box.GetAxis(1);
+        const Vector3f a2 = box.GetAxis(2);
+        const Vector3f half = box.GetHalfExtend();
+
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return OBBDistance(p, center, a0, a1, a2, half); });
+    }
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const Cylinder& cylinder, float* out, IParallelExecutor* executor)
+    {
+        const Vector3f center = cylinder.GetCenter();
+        const Vector3f axis = cylinder.GetAxis();
+        const float half_height = cylinder.GetHeight() * 0.5f;
+        const float radius = cylinder.GetRadius();
+
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return CylinderDistance(p, center, axis, half_height, radius); });
+    }
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const Cone& cone, float* out, IParallelExecutor* executor)
+    {
+        const Vector3f apex = cone.GetApex();
+        const Vector3f axis = cone.GetAxis();
+        const float height = cone.GetHeight();
+        const float radius = cone.GetBaseRadius();
+        const float inv_slant2 = SafeInverse(height * height + radius * radius);
+
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return ConeDistance(p, apex, axis, height, radius, inv_slant2); });
+    }
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const Torus& torus, float* out, IParallelExecutor* executor)
+    {
+        const Vector3f center = torus.GetCenter();
+        const Vector3f axis = torus.GetAxis();
+        const float major_radius = torus.GetMajorRadius();
+        const float minor_radius = torus.GetMinorRadius();
+
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return TorusDistance(p, center, axis, major_radius, minor_radius); });
+    }
+
+    void DistanceQuery::Distance(const BatchPointSOA& points, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, float* out, IParallelExecutor* executor)
+    {
+        PointsDistance(points, out, executor, [&](const Vector3f& p) { return TriangleDistance(p, v0, v1, v2); });
+    }
+
+    //=============================================================================
+    // One point vs. N primitives
+    //=============================================================================
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchSphereSOA& spheres, float& distance, size_t* nearest)
+    {
+        const float* cx = spheres.centerX.data(); const float* cy = spheres.centerY.data(); const float* cz = spheres.centerZ.data();
+        const float* r = spheres.radius.data();
+
+        return MinLaneDistance(spheres.count, distance, nearest, [&](size_t i)
+            {
+                return SphereDistance(point, Vector3f(cx[i], cy[i], cz[i]), r[i]);
+            });
+    }
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchCapsuleSOA& capsules, float& distance, size_t* nearest)
+    {
+        const float* sx = capsules.startX.data(); const float* sy = capsules.startY.data(); const float* sz = capsules.startZ.data();
+        const float* ex = capsules.endX.data(); const float* ey = capsules.endY.data(); const float* ez = capsules.endZ.data();
+        const float* r = capsules.radius.data();
+
+        return MinLaneDistance(capsules.count, distance, nearest, [&](size_t i)
+            {
+                const Vector3f a(sx[i], sy[i], sz[i]);
+                const Vector3f ab = Vector3f(ex[i], ey[i], ez[i]) - a;
+
+                return CapsuleDistance(point, a, ab, SafeInverse(Dot(ab, ab)), r[i]);
+            });
+    }
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchAABBSOA& boxes, float& distance, size_t* nearest)
+    {
+        const float* nx = boxes.minX.data(); const float* ny = boxes.minY.data(); const float* nz = boxes.minZ.data();
+        const float* xx = boxes.maxX.data(); const float* xy = boxes.maxY.data(); const float* xz = boxes.maxZ.data();
+
+        return MinLaneDistance(boxes.count, distance, nearest, [&](size_t i)
+            {
+                return AABBDistance(point, Vector3f(nx[i], ny[i], nz[i]), Vector3f(xx[i], xy[i], xz[i]));
+            });
+    }
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchOBBSOA& boxes, float& distance, size_t* nearest)
+    {
+        const float* cx = boxes.centerX.data(); const float* cy = boxes.centerY.data(); const float* cz = boxes.centerZ.data();
+        const float* hx = boxes.halfX.data(); const float* hy = boxes.halfY.data(); const float* hz = boxes.halfZ.data();
+        const float* a[3][3];
+
+        for (int i = 0; i < 3; i++)
+            for (int c = 0; c < 3; c++)
+                a[i][c] = boxes.axis[i][c].data();
+
+        return MinLaneDistance(boxes.count, distance, nearest, [&](size_t i)
+            {
+                return OBBDistance(point, Vector3f(cx[i], cy[i], cz[i]),
+                                   Vector3f(a[0][0][i], a[0][1][i], a[0][2][i]),
+                                   Vector3f(a[1][0][i], a[1][1][i], a[1][2][i]),
+                                   Vector3f(a[2][0][i], a[2][1][i], a[2][2][i]),
+                                   Vector3f(hx[i], hy[i], hz[i]));
+            });
+    }
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchCylinderSOA& cylinders, float& distance, size_t* nearest)
+    {
+        const float* cx = cylinders.centerX.data(); const float* cy = cylinders.centerY.data(); const float* cz = cylinders.centerZ.data();
+        const float* ax = cylinders.axisX.data(); const float* ay = cylinders.axisY.data(); const float* az = cylinders.axisZ.data();
+        const float* h = cylinders.height.data();
+        const float* r = cylinders.radius.data();
+
+        return MinLaneDistance(cylinders.count, distance, nearest, [&](size_t i)
+            {
+                return CylinderDistance(point, Vector3f(cx[i], cy[i], cz[i]), Vector3f(ax[i], ay[i], az[i]), h[i] * 0.5f, r[i]);
+            });
+    }
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchConeSOA& cones, float& distance, size_t* nearest)
+    {
+        const float* px = cones.apexX.data(); const float* py = cones.apexY.data(); const float* pz = cones.apexZ.data();
+        const float* ax = cones.axisX.data(); const float* ay = cones.axisY.data(); const float* az = cones.axisZ.data();
+        const float* h = cones.height.data();
+        const float* r = cones.radius.data();
+
+        return MinLaneDistance(cones.count, distance, nearest, [&](size_t i)
+            {
+                return ConeDistance(point, Vector3f(px[i], py[i], pz[i]), Vector3f(ax[i], ay[i], az[i]),
+                                    h[i], r[i], SafeInverse(h[i] * h[i] + r[i] * r[i]));
+            });
+    }
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchTorusSOA& tori, float& distance, size_t* nearest)
+    {
+        const float* cx = tori.centerX.data(); const float* cy = tori.centerY.data(); const float* cz = tori.centerZ.data();
+        const float* ax = tori.axisX.data(); const float* ay = tori.axisY.data(); const float* az = tori.axisZ.data();
+        const float* R = tori.majorRadius.data();
+        const float* r = tori.minorRadius.data();
+
+        return MinLaneDistance(tori.count, distance, nearest, [&](size_t i)
+            {
+                return TorusDistance(point, Vector3f(cx[i], cy[i], cz[i]), Vector3f(ax[i], ay[i], az[i]), R[i], r[i]);
+            });
+    }
+
+    bool DistanceQuery::MinDistance(const Vector3f& point, const BatchTriangleSOA& triangles, float& distance, size_t* nearest)
+    {
+        const float* v[3][3];
+
+        for (int i = 0; i < 3; i++)
+            for (int axis = 0; axis < 3; axis++)
+                v[i][axis] = triangles.GetData(i, axis);
+
+        return MinLaneDistance(triangles.count, distance, nearest, [&](size_t i)
+            {
+                return TriangleDistance(point,
+                                        Vector3f(v[0][0][i], v[0][1][i], v[0][2][i]),
+                                        Vector3f(v[1][0][i], v[1][1][i], v[1][2][i]),
+                                        Vector3f(v[2][0][i], v[2][1][i], v[2][2][i]));
+            });
+    }
+
+    //=============================================================================
+    // N points vs. one primitive: closest points
+    //=============================================================================
+
+    void DistanceQuery::ClosestPoint(const BatchPointSOA& points, const OBB& box, BatchPointSOA& out, IParallelExecutor* executor)
+    {
+        const Vector3f center = box.GetCenter();
+        const Vector3f a0 = box.GetAxis(0);
+        const Vector3f a1 = box.GetAxis(1);
+        const Vector3f a2 = box.GetAxis(2);
+        const Vector3f half = box.GetHalfExtend();
+
+        PointsClosest(points, out, executor, [&](const Vector3f& p) { return OBBClosestPoint(p, center, a0, a1, a2, half); });
+    }
+
+    void DistanceQuery::ClosestPoint(const BatchPointSOA& points, const Cone& cone, BatchPointSOA& out, IParallelExecutor* executor)
+    {
+        const Vector3f apex = cone.GetApex();
+        const Vector3f axis = cone.GetAxis();
+        const float height = cone.GetHeight();
+        const float radius = cone.GetBaseRadius();
+        const float inv_slant2 = SafeInverse(height * height + radius * radius);
+
+        PointsClosest(points, out, executor, [&](const Vector3f& p) { return ConeClosestPoint(p, apex, axis, height, radius, inv_slant2); });
+    }
+
+    void DistanceQuery::ClosestPoint(const BatchPointSOA& points, const Torus& torus, BatchPointSOA& out, IParallelExecutor* executor)
+    {
+        const Vector3f center = torus.GetCenter();
+        const Vector3f axis = torus.GetAxis();
+        const Vector3f fallback = Normalized(Cross(axis, std::abs(axis.x) < 0.9f ? Vector3f(1, 0, 0) : Vector3f(0, 1, 0)));
+        const float major_radius = torus.GetMajorRadius();
+        const float minor_radius = torus.GetMinorRadius();
+
+        PointsClosest(points, out, executor, [&](const Vector3f& p) { return TorusClosestPoint(p, center, axis, fallback, major_radius, minor_radius); });
+    }
+
+    void DistanceQuery::ClosestPoint(const BatchPointSOA& points, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, BatchPointSOA& out, IParallelExecutor* executor)
+    {
+        PointsClosest(points, out, executor, [&](const Vector3f& p) { return TriangleClosestPoint(p, v0, v1, v2); });
+    }
+}//namespace hgl::math
@@ -5,6 +5,14 @@
  */
 #include<hgl/math/geometry/queries/DistanceQuery.h>
 #include<hgl/math/MathUtils.h>
+#include<hgl/math/geometry/queries/RaycastQuery.h>
+#include<hgl/math/geometry/OBB.h>
+#include<hgl/math/geometry/primitives/Cone.h>
+#include<hgl/math/geometry/primitives/Torus.h>
+#include<hgl/math/geometry/Triangle.h>
+#include<algorithm>
+#include<cfloat>
+#include<cmath>
 
 namespace hgl::math
 {
@@ -30,7 +38,260 @@ namespace hgl::math
 
     float DistanceQuery::Distance(const Vector3f& point, const Cylinder& cylinder)
     {
-        return cylinder.DistanceToPoint(point);
+        return Length(point - ClosestPoint(point, cylinder));
+    }
+
+    float DistanceQuery::Distance(const Vector3f& point, const OBB& box)
+    {
+        return box.DistanceToPoint(point);
+    }
+
+    float DistanceQuery::Distance(const Vector3f& point, const Cone& cone)
+    {
+        return Length(point - ClosestPoint(point, cone));
+    }
+
+    float DistanceQuery::Distance(const Vector3f& point, const Torus& torus)
+    {
+        return Length(point - ClosestPoint(point, torus));
+    }
+
+    float DistanceQuery::Distance(const Vector3f& point, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2)
+    {
+        return Length(point - ClosestPointOnTriangle(point, v0, v1, v2));
+    }
+
+    //=============================================================================
+    // Signed point-to-solid distance
+    //=============================================================================
+
+    namespace
+    {
+        /**
+         * Signed distance to an axis aligned box given the point relative to its center
+         */
+        float BoxSignedDistance(const Vector3f& local, const Vector3f& half)
+        {
+            const Vector3f q(std::abs(local.x) - half.x, std::abs(local.y) - half.y, std::abs(local.z) - half.z);
+            const Vector3f outside(std::max(q.x, 0.0f), std::max(q.y, 0.0f), std::max(q.z, 0.0f));
+
+            return Length(outside) + std::min(std::max(q.x, std::max(q.y, q.z)), 0.0f);
+        }
+
+        /**
+         * Coordinate along the axis (h) and distance from it (q)
+         */
+        void AxialCoordinates(const Vector3f& point, const Vector3f& origin, const Vector3f& axis, float& h, float& q)
+        {
+            const Vector3f d = point - origin;
+
+            h = Dot(d, axis);
+            q = Length(d - axis * h);
+        }
+
+        /**
+         * Same as above, also returning the unit radial direction (zero on the axis)
+         */
+        void AxialCoordinates(const Vector3f& point, const Vector3f& origin, const Vector3f& axis, float& h, float& q, Vector3f& radialDir)
+        {
+            const Vector3f d = point - origin;
+
+            h = Dot(d, axis);
+
+            const Vector3f radial = d - axis * h;
+            q = Length(radial);
+            radialDir = q > 0.0f ? radial / q : Vector3f(0, 0, 0);
+        }
+    }//namespace
+
+    float DistanceQuery::SignedDistance(const Vector3f& point, const Sphere& sphere)
+    {
+        return Length(point - sphere.GetCenter()) - sphere.GetRadius();
+    }
+
+    float DistanceQuery::SignedDistance(const Vector3f& point, const Capsule& capsule)
+    {
+        const Vector3f axisPoint = ClosestPointOnLineSegment(point, capsule.GetStart(), capsule.GetEnd());
+
+        return Length(point - axisPoint) - capsule.GetRadius();
+    }
+
+    float DistanceQuery::SignedDistance(const Vector3f& point, const AABB& box)
+    {
+        return BoxSignedDistance(point - box.GetCenter(), box.GetLength() * 0.5f);
+    }
+
+    float DistanceQuery::SignedDistance(const Vector3f& point, const OBB& box)
+    {
+        const Vector3f d = point - box.GetCenter();
+        const Vector3f local(Dot(d, box.GetAxis(0)), Dot(d, box.GetAxis(1)), Dot(d, box.GetAxis(2)));
+
+        return BoxSignedDistance(local, box.GetHalfExtend());
+    }
+
+    float DistanceQuery::SignedDistance(const Vector3f& point, const Cylinder& cylinder)
+    {
+        float h, q;
+        AxialCoordinates(point, cylinder.GetCenter(), cylinder.GetAxis(), h, q);
+
+        // 2D box in the (radial, axial) half plane
+        const float dq = q - cylinder.GetRadius();
+        const float dh = std::abs(h) - cylinder.GetHeight() * 0.5f;
+        const float ox = std::max(dq, 0.0f);
+        const float oy = std::max(dh, 0.0f);
+
+        return std::sqrt(ox * ox + oy * oy) + std::min(std::max(dq, dh), 0.0f);
+    }
+
+    float DistanceQuery::SignedDistance(const Vector3f& point, const Cone& cone)
+    {
+        float h, q;
+        AxialCoordinates(point, cone.GetApex(), cone.GetAxis(), h, q);
+
+        const float height = cone.GetHeight();
+        const float radius = cone.GetBaseRadius();
+        const float slant = std::sqrt(height * height + radius * radius);
+
+        if (slant <= 0.0f)
+            return Length(point - cone.GetApex());
+
+        // The (h,q) cross section is the triangle apex (0,0), rim (H,R), base center (H,0)
+        if (h <= height && q * height <= h * radius)
+        {
+            // Inside a convex section the nearest boundary lies on the base or slant line
+            const float toBase = height - h;
+            const float toSlant = (h * radius - q * height) / slant;
+
+            return -std::min(toBase, toSlant);
+        }
+
+        const float bh = h - height;
+        const float bq = std::max(q - radius, 0.0f);
+
+        const float t = std::clamp((h * height + q * radius) / (slant * slant), 0.0f, 1.0f);
+        const float sh = h - t * height;
+        const float sq = q - t * radius;
+
+        return std::sqrt(std::min(bh * bh + bq * bq, sh * sh + sq * sq));
+    }
+
+    float DistanceQuery::SignedDistance(const Vector3f& point, const Torus& torus)
+    {
+        float h, q;
+        AxialCoordinates(point, torus.GetCenter(), torus.GetAxis(), h, q);
+
+        const float dq = q - torus.GetMajorRadius();
+
+        return std::sqrt(dq * dq + h * h) - torus.GetMinorRadius();
+    }
+
+    //=============================================================================
+    // Closest point on solid
+    //=============================================================================
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const Sphere& sphere)
+    {
+        const Vector3f d = point - sphere.GetCenter();
+        const float len = Length(d);
+
+        if (len <= sphere.GetRadius())
+            return point;
+
+        return sphere.GetCenter() + d * (sphere.GetRadius() / len);
+    }
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const Capsule& capsule)
+    {
+        const Vector3f axisPoint = ClosestPointOnLineSegment(point, capsule.GetStart(), capsule.GetEnd());
+        const Vector3f d = point - axisPoint;
+        const float len = Length(d);
+
+        if (len <= capsule.GetRadius())
+            return point;
+
+        return axisPoint + d * (capsule.GetRadius() / len);
+    }
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const AABB& box)
+    {
+        return box.ClampPoint(point);
+    }
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const OBB& box)
+    {
+        return box.ClosestPoint(point);
+    }
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const Cylinder& cylinder)
+    {
+        float h, q;
+        Vector3f radialDir;
+        AxialCoordinates(point, cylinder.GetCenter(), cylinder.GetAxis(), h, q, radialDir);
+
+        const float halfHeight = cylinder.GetHeight() * 0.5f;
+
+        return cylinder.GetCenter()
+             + cylinder.GetAxis() * std::clamp(h, -halfHeight, halfHeight)
+             + radialDir * std::min(q, cylinder.GetRadius());
+    }
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const Cone& cone)
+    {
+        float h, q;
+        Vector3f radialDir;
+        AxialCoordinates(point, cone.GetApex(), cone.GetAxis(), h, q, radialDir);
+
+        const float height = cone.GetHeight();
+        const float radius = cone.GetBaseRadius();
+
+        // (h,q) cross section: triangle apex (0,0), rim (H,R), base center (H,0)
+        if (h <= height && q * height <= h * radius)
+            return point;
+
+        // Nearest point on the base segment
+        const float baseQ = std::min(q, radius);
+        const float baseD2 = (h - height) * (h - height) + (q - baseQ) * (q - baseQ);
+
+        // Nearest point on the slant segment
+        const float slant2 = height * height + radius * radius;
+        const float t = slant2 > 0.0f ? std::clamp((h * height + q * radius) / slant2, 0.0f, 1.0f) : 0.0f;
+        const float slantH = t * height;
+        const float slantQ = t * radius;
+        const float slantD2 = (h - slantH) * (h - slantH) + (q - slantQ) * (q - slantQ);
+
+        if (baseD2 <= slantD2)
+            return cone.GetApex() + cone.GetAxis() * height + radialDir * baseQ;
+
+        return cone.GetApex() + cone.GetAxis() * slantH + radialDir * slantQ;
+    }
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const Torus& torus)
+    {
+        float h, q;
+        Vector3f radialDir;
+        AxialCoordinates(point, torus.GetCenter(), torus.GetAxis(), h, q, radialDir);
+
+        if (q <= 0.0f)
+        {
+            // On the axis every point of the tube circle is equally near; pick one
+            const Vector3f& axis = torus.GetAxis();
+
+            radialDir = Normalized(Cross(axis, std::abs(axis.x) < 0.9f ? Vector3f(1, 0, 0) : Vector3f(0, 1, 0)));
+        }
+
+        const Vector3f tubeCenter = torus.GetCenter() + radialDir * torus.GetMajorRadius();
+        const Vector3f d = point - tubeCenter;
+        const float len = Length(d);
+
+        if (len <= torus.GetMinorRadius())
+            return point;
+
+        return tubeCenter + d * (torus.GetMinorRadius() / len);
+    }
+
+    Vector3f DistanceQuery::ClosestPoint(const Vector3f& point, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2)
+    {
+        return ClosestPointOnTriangle(point, v0, v1, v2);
     }
 
     //=============================================================================
@@ -67,10 +328,89 @@ namespace hgl::math
         return approxDist > 0.0f ? approxDist : 0.0f;
     }
 
+    float DistanceQuery::Distance(const AABB& a, const AABB& b)
+    {
+        const Vector3f& aMin = a.GetMin();
+        const Vector3f& aMax = a.GetMax();
+        const Vector3f& bMin = b.GetMin();
+        const Vector3f& bMax = b.GetMax();
+
+        const float gx = std::max(std::max(aMin.x - bMax.x, bMin.x - aMax.x), 0.0f);
+        const float gy = std::max(std::max(aMin.y - bMax.y, bMin.y - aMax.y), 0.0f);
+        const float gz = std::max(std::max(aMin.z - bMax.z, bMin.z - aMax.z), 0.0f);
+
+        return std::sqrt(gx * gx + gy * gy + gz * gz);
+    }
+
+    float DistanceQuery::Distance(const OBB& a, const OBB& b)
+    {
+        return ClosestPoints(a, b).distance;
+    }
+
     //=============================================================================
     // Closest point pairs
     //=============================================================================
 
+    ClosestPointsResult DistanceQuery::ClosestPoints(const OBB& a, const OBB& b)
+    {
+        ClosestPointsResult result;
+
+        if (a.Intersects(b))
+        {
+            result.pointOnA = result.pointOnB = a.ClosestPoint(b.GetCenter());
+            return result;
+        }
+
+        Vector3f cornersA[8], cornersB[8];
+        a.GetCorners(cornersA);
+        b.GetCorners(cornersB);
+
+        float best = FLT_MAX;
+
+        auto consider = [&](const Vector3f& onA, const Vector3f& onB)
+        {
+            const float d2 = LengthSquared(onB - onA);
+
+            if (d2 < best)
+            {
+                best = d2;
+                result.pointOnA = onA;
+                result.pointOnB = onB;
+            }
+        };
+
+        // Vertex against the other box (vertex-face, vertex-edge, vertex-vertex)
+        for (int i = 0; i < 8; i++)
+        {
+            consider(cornersA[i], b.ClosestPoint(cornersA[i]));
+            consider(a.ClosestPoint(cornersB[i]), cornersB[i]);
+        }
+
+        // Edge against edge; corners whose indices differ in one bit form the 12 edges
+        for (int i = 0; i < 8; i++)
+        for (int edgeA = 1; edgeA < 8; edgeA <<= 1)
+        {
+            if (i & edgeA)
+                continue;
+
+            for (int j = 0; j < 8; j++)
+            for (int edgeB = 1; edgeB < 8; edgeB <<= 1)
+            {
+                if (j & edgeB)
+                    continue;
+
+                const ClosestPointsResult edge = ClosestPointsOnLineSegments(
+                    cornersA[i], cornersA[i | edgeA],
+                    cornersB[j], cornersB[j | edgeB]);
+
+                consider(edge.pointOnA, edge.pointOnB);
+            }
+        }
+
+        result.distance = std::sqrt(best);
+        return result;
+    }
+
     ClosestPointsResult DistanceQuery::ClosestPoints(const Capsule& a, const Capsule& b)
     {
         ClosestPointsResult result = ClosestPointsOnLineSegments(
@@ -225,4 +565,29 @@ namespace hgl::math
         return result;
     }
 
+    float DistanceQuery::SegmentTriangleDistanceSquared(
+        const Vector3f& segStart, const Vector3f& segEnd,
+        const Vector3f& v0, const Vector3f& v1, const Vector3f& v2)
+    {
+        float t;
+
+        // Segment crosses the triangle
+        if (RaycastQuery::IntersectsTriangle(Ray(segStart, segEnd - segStart), v0, v1, v2, t) && t <= 1.0f)
+            return 0.0f;
+
+        float best = std::min(LengthSquared(segStart - ClosestPointOnTriangle(segStart, v0, v1, v2)),
+                              LengthSquared(segEnd - ClosestPointOnTriangle(segEnd, v0, v1, v2)));
+
+        const Vector3f edge[4] = { v0, v1, v2, v0 };
+
+        for (int i = 0; i < 3; i++)
+        {
+            const float d = ClosestPointsOnLineSegments(segStart, segEnd, edge[i], edge[i + 1]).distance;
+
+            best = std::min(best, d * d);
+        }
+
+        return best;
+    }
+
 }//namespace hgl::math
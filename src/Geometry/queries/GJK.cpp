@@ -0,0 +1,762 @@
+﻿/**
+ * GJK.cpp - GJK distance / intersection and EPA penetration depth
+ *
+ * GJK follows the closest-point-on-simplex formulation (Ericson, "Real-Time
+ * Collision Detection", 9.5): each iteration reduces the simplex to the
+ * smallest sub-simplex containing the point closest to the origin.
+ *
+ * EPA expands the terminating GJK simplex into a polytope and repeatedly
+ * splits the face closest to the origin until the support distance along
+ * its normal stops growing.
+ */
+#include<hgl/math/geometry/queries/GJK.h>
+#include<vector>
+#include<cmath>
+#include<cfloat>
+#include<numbers>
+#include<algorithm>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr float GJK_RELATIVE_TOLERANCE  =1e-6f;     // Relative convergence of |v|^2
+        constexpr float GJK_ABSOLUTE_TOLERANCE  =1e-5f;     // Distance bound gap considered converged
+        constexpr float FLAT_TETRAHEDRON_RATIO  =1e-4f;     // Vertex height below this fraction of the extent counts as flat
+        constexpr float GJK_CONTACT_TOLERANCE_SQ=1e-10f;    // |v|^2 below this counts as touching
+        constexpr float EPA_TOLERANCE           =1e-4f;     // Support distance growth considered converged
+        constexpr float DEGENERATE_EPSILON      =1e-12f;
+
+        GJKVertex MakeVertex(const ConvexSupport &a,const ConvexSupport &b,const Vector3f &direction)
+        {
+            GJKVertex v;
+
+            v.direction=direction;
+            v.a=a(direction);
+            v.b=b(-direction);
+            v.w=v.a-v.b;
+
+            return v;
+        }
+
+        //=============================================================================
+        // Closest point to origin on simplex features; lambda receives barycentrics
+        //=============================================================================
+
+        void ClosestOnSegment(const Vector3f &a,const Vector3f &b,float *lambda)
+        {
+            const Vector3f ab=b-a;
+            const float len_sq=Dot(ab,ab);
+
+            if(len_sq<DEGENERATE_EPSILON)
+            {
+                lambda[0]=1.0f;lambda[1]=0.0f;
+                return;
+            }
+
+            const float t=-Dot(a,ab)/len_sq;
+
+            if(t<=0.0f)     {lambda[0]=1.0f;    lambda[1]=0.0f;}
+            else if(t>=1.0f){lambda[0]=0.0f;    lambda[1]=1.0f;}
+            else            {lambda[0]=1.0f-t;  lambda[1]=t;}
+        }
+
+        double DotD(const Vector3f &a,const Vector3f &b)
+        {
+            return double(a.x)*b.x+double(a.y)*b.y+double(a.z)*b.z;
+        }
+
+        /**
+         * Region tests in double: near contact the triangle is often a long sliver
+         * (one support point far from two close ones) and the float products below
+         * cancel badly enough to tilt the closest point by a visible angle
+         */
+        void ClosestOnTriangle(const Vector3f &a,const Vector3f &b,const Vector3f &c,float *lambda)
+        {
+            const Vector3f ab=b-a;
+            const Vector3f ac=c-a;
+
+            lambda[0]=lambda[1]=lambda[2]=0.0f;
+
+            // Vertex region A
+            const double d1=-DotD(ab,a);
+            const double d2=-DotD(ac,a);
+            if(d1<=0.0&&d2<=0.0){lambda[0]=1.0f;return;}
+
+            // Vertex region B
+            const double d3=-DotD(ab,b);
+            const double d4=-DotD(ac,b);
+            if(d3>=0.0&&d4<=d3){lambda[1]=1.0f;return;}
+
+            // Edge region AB
+            const double vc=d1*d4-d3*d2;
+            if(vc<=0.0&&d1>=0.0&&d3<=0.0)
+            {
+                const float v=float(d1/(d1-d3));
+                lambda[0]=1.0f-v;lambda[1]=v;
+                return;
+            }
+
+            // Vertex region C
+            const double d5=-DotD(ab,c);
+            const double d6=-DotD(ac,c);
+            if(d6>=0.0&&d5<=d6){lambda[2]=1.0f;return;}
+
+            // Edge region AC
+            const double vb=d5*d2-d1*d6;
+            if(vb<=0.0&&d2>=0.0&&d6<=0.0)
+            {
+                const float w=float(d2/(d2-d6));
+                lambda[0]=1.0f-w;lambda[2]=w;
+                return;
+            }
+
+            // Edge region BC
+            const double va=d3*d6-d5*d4;
+            if(va<=0.0&&(d4-d3)>=0.0&&(d5-d6)>=0.0)
+            {
+                const float w=float((d4-d3)/((d4-d3)+(d5-d6)));
+                lambda[1]=1.0f-w;lambda[2]=w;
+                return;
+            }
+
+            const double sum=va+vb+vc;
+
+            if(std::fabs(sum)<DEGENERATE_EPSILON)
+            {
+                // Collinear triangle: fall back to the best of its edges
+                float best_dist=FLT_MAX;
+                const Vector3f *pts[3]={&a,&b,&c};
+
+                for(int e=0;e<3;e++)
+                {
+                    const int i0=e,i1=(e+1)%3;
+                    float l[2];
+
+                    ClosestOnSegment(*pts[i0],*pts[i1],l);
+
+                    const Vector3f p=*pts[i0]*l[0]+*pts[i1]*l[1];
+                    const float dist=Dot(p,p);
+
+                    if(dist<best_dist)
+                    {
+                        best_dist=dist;
+                        lambda[0]=lambda[1]=lambda[2]=0.0f;
+                        lambda[i0]=l[0];
+                        lambda[i1]=l[1];
+                    }
+                }
+
+                return;
+            }
+
+            lambda[1]=float(vb/sum);
+            lambda[2]=float(vc/sum);
+            lambda[0]=float(va/sum);
+        }
+
+        /**
+         * @return true if the origin is inside the tetrahedron
+         */
+        bool ClosestOnTetrahedron(const Vector3f *w,float *lambda)
+        {
+            // Each face with the index of the opposite vertex
+            constexpr int faces[4][4]=
+            {
+                {0,1,2,3},
+                {0,2,3,1},
+                {0,3,1,2},
+                {1,3,2,0}
+            };
+
+            bool any_outside=false;
+            float best_dist=FLT_MAX;
+
+            lambda[0]=lambda[1]=lambda[2]=lambda[3]=0.0f;
+
+            float extent_sq=0.0f;
+
+            for(int i=1;i<4;i++)
+            {
+                const Vector3f d=w[i]-w[0];
+                extent_sq=std::max(extent_sq,Dot(d,d));
+            }
+
+            const float flat_tolerance=FLAT_TETRAHEDRON_RATIO*std::sqrt(extent_sq);
+
+            for(const auto &f:faces)
+            {
+                const Vector3f &a=w[f[0]];
+                const Vector3f n=Cross(w[f[1]]-a,w[f[2]]-a);
+
+                const float side_origin=-Dot(n,a);
+                const float side_opposite=Dot(n,w[f[3]]-a);
+
+                // Origin on the other side of this face than the opposite vertex,
+                // or a flat tetrahedron where the face test is meaningless.
+                // side_opposite is the opposite vertex height times |n|, so the
+                // flatness test scales with the simplex instead of being absolute.
+                if(side_origin*side_opposite>=0.0f&&std::fabs(side_opposite)>flat_tolerance*Length(n))
+                    continue;
+
+                any_outside=true;
+
+                float l[3];
+                ClosestOnTriangle(w[f[0]],w[f[1]],w[f[2]],l);
+
+                const Vector3f p=w[f[0]]*l[0]+w[f[1]]*l[1]+w[f[2]]*l[2];
+                const float dist=Dot(p,p);
+
+                if(dist<best_dist)
+                {
+                    best_dist=dist;
+                    lambda[0]=lambda[1]=lambda[2]=lambda[3]=0.0f;
+                    lambda[f[0]]=l[0];
+                    lambda[f[1]]=l[1];
+                    lambda[f[2]]=l[2];
+                }
+            }
+
+            if(any_outside)
+                return false;
+
+            lambda[0]=lambda[1]=lambda[2]=lambda[3]=0.25f;
+            return true;
+        }
+
+        /**
+         * Reduce the simplex to the feature closest to the origin
+         * @param v receives the closest point
+         * @return true if the origin is enclosed by a full tetrahedron
+         */
+        bool SolveSimplex(GJKVertex *simplex,uint32_t &count,Vector3f &v)
+        {
+            float lambda[4]={1.0f,0.0f,0.0f,0.0f};
+            bool inside=false;
+
+            if(count==2)
+                ClosestOnSegment(simplex[0].w,simplex[1].w,lambda);
+            else if(count==3)
+                ClosestOnTriangle(simplex[0].w,simplex[1].w,simplex[2].w,lambda);
+            else if(count==4)
+            {
+                const Vector3f w[4]={simplex[0].w,simplex[1].w,simplex[2].w,simplex[3].w};
+                inside=ClosestOnTetrahedron(w,lambda);
+            }
+
+            if(inside)
+            {
+                v=Vector3f(0,0,0);
+                return true;
+            }
+
+            uint32_t kept=0;
+            v=Vector3f(0,0,0);
+
+            for(uint32_t i=0;i<count;i++)
+            {
+                if(lambda[i]<=0.0f)
+                    continue;
+
+                v+=simplex[i].w*lambda[i];
+                simplex[kept]=simplex[i];
+                lambda[kept]=lambda[i];
+                ++kept;
+            }
+
+            if(kept==0)
+            {
+                kept=1;
+                v=simplex[0].w;
+            }
+
+            count=kept;
+            return false;
+        }
+
+        void ComputeWitnessPoints(const GJKVertex *simplex,uint32_t count,Vector3f &point_a,Vector3f &point_b)
+        {
+            float lambda[4]={1.0f,0.0f,0.0f,0.0f};
+
+            if(count==2)
+                ClosestOnSegment(simplex[0].w,simplex[1].w,lambda);
+            else if(count==3)
+                ClosestOnTriangle(simplex[0].w,simplex[1].w,simplex[2].w,lambda);
+
+            point_a=Vector3f(0,0,0);
+            point_b=Vector3f(0,0,0);
+
+            for(uint32_t i=0;i<count;i++)
+            {
+                point_a+=simplex[i].a*lambda[i];
+                point_b+=simplex[i].b*lambda[i];
+            }
+        }
+
+        bool ContainsVertex(const GJKVertex *simplex,uint32_t count,const Vector3f &w)
+        {
+            for(uint32_t i=0;i<count;i++)
+            {
+                const Vector3f d=simplex[i].w-w;
+
+                if(Dot(d,d)<DEGENERATE_EPSILON)
+                    return true;
+            }
+
+            return false;
+        }
+
+        void StoreCache(GJKCache *cache,const GJKVertex *simplex,uint32_t count,uint32_t iterations)
+        {
+            if(!cache)
+                return;
+
+            cache->count=count;
+            cache->last_iterations=iterations;
+
+            for(uint32_t i=0;i<count;i++)
+                cache->directions[i]=simplex[i].direction;
+        }
+
+        /**
+         * Core GJK loop
+         * @param early_out stop as soon as a separating axis is found (no witness points)
+         */
+        bool RunGJK(const ConvexSupport &a,const ConvexSupport &b,GJKResult &result,GJKCache *cache,bool early_out)
+        {
+            GJKVertex *simplex=result.simplex;
+            uint32_t count=0;
+
+            // Warm start: rebuild last frame's simplex from its search directions
+            if(cache&&cache->count>0)
+            {
+                for(uint32_t i=0;i<cache->count&&i<4;i++)
+                {
+                    const GJKVertex vertex=MakeVertex(a,b,cache->directions[i]);
+
+                    if(!ContainsVertex(simplex,count,vertex.w))
+                        simplex[count++]=vertex;
+                }
+            }
+
+            if(count==0)
+            {
+                Vector3f direction=b.center-a.center;
+
+                if(Dot(direction,direction)<DEGENERATE_EPSILON)
+                    direction=Vector3f(1,0,0);
+
+                simplex[count++]=MakeVertex(a,b,direction);
+            }
+
+            Vector3f v;
+            uint32_t iterations=0;
+            bool unsolved=true;
+            bool separated=false;       // Some support along -v failed to reach the origin
+            float previous_vv=FLT_MAX;
+
+            result.intersects=false;
+
+            while(iterations<GJK::MAX_ITERATIONS)
+            {
+                ++iterations;
+
+                unsolved=false;
+
+                if(SolveSimplex(simplex,count,v))
+                {
+                    result.intersects=true;
+                    break;
+                }
+
+                const float vv=Dot(v,v);
+
+                if(vv<GJK_CONTACT_TOLERANCE_SQ)
+                {
+                    result.intersects=true;
+                    break;
+                }
+
+                const GJKVertex vertex=MakeVertex(a,b,-v);
+                const float vw=Dot(v,vertex.w);
+
+                // Support along -v doesn't reach the origin: separating axis found
+                if(vw>0.0f)
+                {
+                    separated=true;
+
+                    if(early_out)
+                        break;
+                }
+
+                // (vv-vw)/|v| bounds the distance error; curved supports only approach
+                // it asymptotically, so a purely relative test never fires for them
+                if(vv-vw<=GJK_RELATIVE_TOLERANCE*vv+GJK_ABSOLUTE_TOLERANCE*std::sqrt(vv))
+                    break;
+
+                // No progress left (|v| stopped shrinking or the support repeats)
+                if(vv>=previous_vv||ContainsVertex(simplex,count,vertex.w))
+                    break;
+
+                previous_vv=vv;
+
+                simplex[count++]=vertex;
+                unsolved=true;
+            }
+
+            // Iteration limit reached right after adding a vertex: reduce once more
+            if(unsolved)
+                result.intersects=SolveSimplex(simplex,count,v);
+
+            // Stopped without a separating axis: the shapes are within rounding of
+            // touching, report contact rather than a separation we cannot prove
+            if(!separated)
+                result.intersects=true;
+
+            result.simplex_count=count;
+            result.iterations=iterations;
+
+            StoreCache(cache,simplex,count,iterations);
+
+            if(result.intersects)
+            {
+                result.distance=0.0f;
+                return true;
+            }
+
+            if(!early_out)
+            {
+                ComputeWitnessPoints(simplex,count,result.point_a,result.point_b);
+                result.distance=Length(v);
+            }
+
+            return false;
+        }
+
+        //=============================================================================
+        // EPA helpers
+        //=============================================================================
+
+        struct EPAFace
+        {
+            uint32_t index[3];
+            Vector3f normal;
+            float distance;
+        };
+
+        struct EPAEdge
+        {
+            uint32_t a,b;
+        };
+
+        /**
+         * Build an outward facing face; interior is a point strictly inside the polytope
+         */
+        bool MakeFace(const std::vector<GJKVertex> &vertices,uint32_t i0,uint32_t i1,uint32_t i2,const Vector3f &interior,EPAFace &face)
+        {
+            const Vector3f &p0=vertices[i0].w;
+            Vector3f n=Cross(vertices[i1].w-p0,vertices[i2].w-p0);
+            const float len=Length(n);
+
+            if(len<DEGENERATE_EPSILON)
+                return false;
+
+            n/=len;
+
+            if(Dot(n,p0-interior)<0.0f)
+            {
+                n=-n;
+                std::swap(i1,i2);
+            }
+
+            face.index[0]=i0;
+            face.index[1]=i1;
+            face.index[2]=i2;
+            face.normal=n;
+            face.distance=Dot(n,p0);
+            return true;
+        }
+
+        void AddHorizonEdge(std::vector<EPAEdge> &edges,uint32_t a,uint32_t b)
+        {
+            // An edge shared by two removed faces appears in opposite winding; drop both
+            for(size_t i=0;i<edges.size();i++)
+            {
+                if(edges[i].a==b&&edges[i].b==a)
+                {
+                    edges[i]=edges.back();
+                    edges.pop_back();
+                    return;
+                }
+            }
+
+            edges.push_back({a,b});
+        }
+
+        /**
+         * Grow a GJK simplex of 1..3 vertices into a non-degenerate tetrahedron
+         */
+        bool ExpandToTetrahedron(const ConvexSupport &a,const ConvexSupport &b,std::vector<GJKVertex> &vertices)
+        {
+            static const Vector3f axes[6]=
+            {
+                Vector3f( 1,0,0),Vector3f(-1,0,0),
+                Vector3f(0, 1,0),Vector3f(0,-1,0),
+                Vector3f(0,0, 1),Vector3f(0,0,-1)
+            };
+
+            constexpr float SPREAD_EPSILON=1e-6f;
+
+            if(vertices.size()==1)
+            {
+                for(const Vector3f &axis:axes)
+                {
+                    const GJKVertex v=MakeVertex(a,b,axis);
+
+                    if(Length(v.w-vertices[0].w)>SPREAD_EPSILON)
+                    {
+                        vertices.push_back(v);
+                        break;
+                    }
+                }
+
+                if(vertices.size()<2)
+                    return false;
+            }
+
+            if(vertices.size()==2)
+            {
+                const Vector3f line=gjk_detail::SafeNormalize(vertices[1].w-vertices[0].w);
+
+                // Axis least aligned with the line gives a stable perpendicular
+                const Vector3f ref=(std::fabs(line.x)<std::fabs(line.y))
+                                  ?((std::fabs(line.x)<std::fabs(line.z))?Vector3f(1,0,0):Vector3f(0,0,1))
+                                  :((std::fabs(line.y)<std::fabs(line.z))?Vector3f(0,1,0):Vector3f(0,0,1));
+
+                const Vector3f p1=gjk_detail::SafeNormalize(Cross(line,ref));
+                const Vector3f p2=Cross(line,p1);
+
+                for(int i=0;i<6;i++)
+                {
+                    const float angle=float(i)*(std::numbers::pi_v<float>/3.0f);
+                    const GJKVertex v=MakeVertex(a,b,p1*std::cos(angle)+p2*std::sin(angle));
+                    const Vector3f off_line=Cross(v.w-vertices[0].w,line);
+
+                    if(Length(off_line)>SPREAD_EPSILON)
+                    {
+                        vertices.push_back(v);
+                        break;
+                    }
+                }
+
+                if(vertices.size()<3)
+                    return false;
+            }
+
+            if(vertices.size()==3)
+            {
+                const Vector3f n=gjk_detail::SafeNormalize(Cross(vertices[1].w-vertices[0].w,vertices[2].w-vertices[0].w));
+
+                GJKVertex v=MakeVertex(a,b,n);
+
+                if(std::fabs(Dot(v.w-vertices[0].w,n))<=SPREAD_EPSILON)
+                    v=MakeVertex(a,b,-n);
+
+                if(std::fabs(Dot(v.w-vertices[0].w,n))<=SPREAD_EPSILON)
+                    return false;
+
+                vertices.push_back(v);
+            }
+
+            return true;
+        }
+
+        /**
+         * Witness points for the projection of the origin onto an EPA face
+         */
+        void FaceContact(const std::vector<GJKVertex> &vertices,const EPAFace &face,Vector3f &point_a,Vector3f &point_b)
+        {
+            const GJKVertex &v0=vertices[face.index[0]];
+            const GJKVertex &v1=vertices[face.index[1]];
+            const GJKVertex &v2=vertices[face.index[2]];
+
+            const Vector3f p=face.normal*face.distance;
+
+            const Vector3f e0=v1.w-v0.w;
+            const Vector3f e1=v2.w-v0.w;
+            const Vector3f e2=p-v0.w;
+
+            const float d00=Dot(e0,e0);
+            const float d01=Dot(e0,e1);
+            const float d11=Dot(e1,e1);
+            const float d20=Dot(e2,e0);
+            const float d21=Dot(e2,e1);
+            const float denom=d00*d11-d01*d01;
+
+            float u=1.0f,v=0.0f,w=0.0f;
+
+            if(std::fabs(denom)>DEGENERATE_EPSILON)
+            {
+                v=(d11*d20-d01*d21)/denom;
+                w=(d00*d21-d01*d20)/denom;
+                u=1.0f-v-w;
+            }
+
+            point_a=v0.a*u+v1.a*v+v2.a*w;
+            point_b=v0.b*u+v1.b*v+v2.b*w;
+        }
+    }//namespace
+
+    bool GJK::Intersects(const ConvexSupport &a,const ConvexSupport &b,GJKCache *cache)
+    {
+        GJKResult result;
+
+        return RunGJK(a,b,result,cache,true);
+    }
+
+    bool GJK::Query(const ConvexSupport &a,const ConvexSupport &b,GJKResult &result,GJKCache *cache)
+    {
+        return RunGJK(a,b,result,cache,false);
+    }
+
+    bool GJK::EPA(const ConvexSupport &a,const ConvexSupport &b,const GJKResult &gjk,CollisionInfo &info)
+    {
+        info.intersects=true;
+        info.penetration=0.0f;
+        info.distance=0.0f;
+        info.normal=gjk_detail::SafeNormalize(b.center-a.center);
+        info.point=a(info.normal);
+
+        if(gjk.simplex_count==0)
+            return false;
+
+        std::vector<GJKVertex> vertices(gjk.simplex,gjk.simplex+gjk.simplex_count);
+
+        vertices.reserve(EPA_MAX_ITERATIONS+4);
+
+        if(!ExpandToTetrahedron(a,b,vertices))
+            return false;       // Flat contact (touching); zero penetration is the right answer
+
+        const Vector3f interior=(vertices[0].w+vertices[1].w+vertices[2].w+vertices[3].w)*0.25f;
+
+        std::vector<EPAFace> faces;
+        std::vector<EPAEdge> horizon;
+
+        faces.reserve(EPA_MAX_ITERATIONS*2+4);
+
+        {
+            constexpr uint32_t tetra[4][3]={{0,1,2},{0,2,3},{0,3,1},{1,3,2}};
+
+            for(const auto &t:tetra)
+            {
+                EPAFace face;
+
+                if(!MakeFace(vertices,t[0],t[1],t[2],interior,face))
+                    return false;
+
+                faces.push_back(face);
+            }
+        }
+
+        size_t closest=0;
+        bool converged=false;
+
+        for(uint32_t iteration=0;iteration<EPA_MAX_ITERATIONS;iteration++)
+        {
+            closest=0;
+
+            for(size_t i=1;i<faces.size();i++)
+                if(faces[i].distance<faces[closest].distance)
+                    closest=i;
+
+            const EPAFace &face=faces[closest];
+            const GJKVertex support=MakeVertex(a,b,face.normal);
+            const float support_distance=Dot(support.w,face.normal);
+
+            if(support_distance-face.distance<=EPA_TOLERANCE)
+            {
+                converged=true;
+                break;
+            }
+
+            const uint32_t new_index=uint32_t(vertices.size());
+            vertices.push_back(support);
+
+            // Remove every face that sees the new vertex, collecting the horizon
+            horizon.clear();
+
+            for(size_t i=0;i<faces.size();)
+            {
+                const EPAFace &f=faces[i];
+
+                if(Dot(f.normal,support.w-vertices[f.index[0]].w)>0.0f)
+                {
+                    AddHorizonEdge(horizon,f.index[0],f.index[1]);
+                    AddHorizonEdge(horizon,f.index[1],f.index[2]);
+                    AddHorizonEdge(horizon,f.index[2],f.index[0]);
+
+                    faces[i]=faces.back();
+                    faces.pop_back();
+                }
+                else
+                    ++i;
+            }
+
+            for(const EPAEdge &edge:horizon)
+            {
+                EPAFace new_face;
+
+                if(MakeFace(vertices,edge.a,edge.b,new_index,interior,new_face))
+                    faces.push_back(new_face);
+            }
+
+            if(faces.empty())
+                return false;
+        }
+
+        if(!converged)
+        {
+            closest=0;
+
+            for(size_t i=1;i<faces.size();i++)
+                if(faces[i].distance<faces[closest].distance)
+                    closest=i;
+        }
+
+        const EPAFace &result=faces[closest];
+        Vector3f point_a,point_b;
+
+        FaceContact(vertices,result,point_a,point_b);
+
+        const float depth=result.distance>0.0f?result.distance:0.0f;
+
+        info.normal=result.normal;
+        info.penetration=depth;
+        info.distance=-depth;
+        info.point=point_a;
+
+        return converged;
+    }
+
+    CollisionInfo GJK::TestCollision(const ConvexSupport &a,const ConvexSupport &b,GJKCache *cache)
+    {
+        CollisionInfo info;
+        GJKResult result;
+
+        if(RunGJK(a,b,result,cache,false))
+        {
+            EPA(a,b,result,info);
+            return info;
+        }
+
+        info.intersects=false;
+        info.distance=result.distance;
+        info.point=result.point_a;
+        info.penetration=0.0f;
+
+        if(result.distance>0.0f)
+            info.normal=(result.point_b-result.point_a)/result.distance;
+
+        return info;
+    }
+}//namespace hgl::math
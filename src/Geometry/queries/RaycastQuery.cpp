@@ -5,6 +5,9 @@
  */
 #include<hgl/math/geometry/queries/RaycastQuery.h>
 #include<hgl/math/MathUtils.h>
+#include<hgl/math/Polynomial.h>
+#include<algorithm>
+#include<limits>
 
 namespace hgl::math
 {
@@ -165,16 +168,78 @@ namespace hgl::math
     }
 
     //=============================================================================
-    // Ray-Torus intersection (stub implementations)
+    // Ray-Torus intersection
     //=============================================================================
 
     bool RaycastQuery::Intersects(const Ray& ray, const Torus& torus, float& t)
     {
-        // Stub implementation
-        Vector3f center = torus.GetCenter();
-        float boundingRadius = torus.GetMajorRadius() + torus.GetMinorRadius();
-        Sphere boundingSphere(center, boundingRadius);
-        return Intersects(ray, boundingSphere, t);
+        const Vector3f center = torus.GetCenter();
+        const float outer = torus.GetMajorRadius() + torus.GetMinorRadius();
+
+        // Bounding sphere early-out; also gives a start point close to the torus,
+        // which keeps the quartic coefficients small and well conditioned
+        Vector3f oc = ray.origin - center;
+        const double dd = double(ray.direction.x) * ray.direction.x
+                        + double(ray.direction.y) * ray.direction.y
+                        + double(ray.direction.z) * ray.direction.z;
+        if (dd <= 0.0)
+            return false;
+
+        const double b = double(oc.x) * ray.direction.x + double(oc.y) * ray.direction.y + double(oc.z) * ray.direction.z;
+        const double c = double(oc.x) * oc.x + double(oc.y) * oc.y + double(oc.z) * oc.z - double(outer) * outer;
+        const double disc = b * b - dd * c;
+
+        if (disc < 0.0)
+            return false;
+
+        const double sqrtDisc = std::sqrt(disc);
+        const double tFar = (-b + sqrtDisc) / dd;
+        if (tFar < 0.0)
+            return false;
+
+        // The outer equator touches the bounding sphere, so a hit there is a root at
+        // (almost) zero from the entry point and rounding can push it negative.
+        // Start one tube radius before the entry so that root stays clearly positive.
+        const double len = std::sqrt(dd);
+        const double tStart = std::max((-b - sqrtDisc) / dd - torus.GetMinorRadius() / len, 0.0);
+
+        // Solve in double with a unit direction, measured from the start point:
+        // (|p|^2 + R^2 - r^2)^2 = 4R^2 (|p|^2 - (p.axis)^2)
+        const double dx = ray.direction.x / len, dy = ray.direction.y / len, dz = ray.direction.z / len;
+        const double ox = oc.x + ray.direction.x * tStart;
+        const double oy = oc.y + ray.direction.y * tStart;
+        const double oz = oc.z + ray.direction.z * tStart;
+
+        const Vector3f& axis = torus.GetAxis();
+        const double R2 = double(torus.GetMajorRadius()) * torus.GetMajorRadius();
+        const double r2 = double(torus.GetMinorRadius()) * torus.GetMinorRadius();
+
+        const double od = ox * dx + oy * dy + oz * dz;
+        const double oo = ox * ox + oy * oy + oz * oz;
+        const double oa = ox * axis.x + oy * axis.y + oz * axis.z;
+        const double da = dx * axis.x + dy * axis.y + dz * axis.z;
+
+        const double beta = 2.0 * od;
+        const double gamma = oo + R2 - r2;
+
+        double roots[4];
+        const int count = SolveQuartic(1.0,
+                                       2.0 * beta,
+                                       beta * beta + 2.0 * gamma - 4.0 * R2 * (1.0 - da * da),
+                                       2.0 * beta * gamma - 8.0 * R2 * (od - oa * da),
+                                       gamma * gamma - 4.0 * R2 * (oo - oa * oa),
+                                       roots);
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (roots[i] < 0.0)
+                continue;
+
+            t = float(tStart + roots[i] / len);
+            return true;
+        }
+
+        return false;
     }
 
     bool RaycastQuery::Intersects(const Ray& ray, const Torus& torus)
@@ -190,7 +255,18 @@ namespace hgl::math
         {
             hit.hit = true;
             hit.point = ray.origin + ray.direction * hit.distance;
-            hit.normal = Vector3f(0, 1, 0);
+
+            // Normal points away from the tube center circle
+            const Vector3f& axis = torus.GetAxis();
+            Vector3f local = hit.point - torus.GetCenter();
+            Vector3f planar = local - axis * Dot(local, axis);
+            float planarLength = Length(planar);
+
+            Vector3f tubeCenter = planarLength > 0.0001f
+                ? planar * (torus.GetMajorRadius() / planarLength)
+                : Vector3f(0, 0, 0);
+
+            hit.normal = Normalized(local - tubeCenter);
         }
         return hit;
     }
@@ -248,16 +324,40 @@ namespace hgl::math
         return hit;
     }
 
+    bool RaycastQuery::Intersects(const PreparedRay& ray, const AABB& box, float& t)
+    {
+        // Same convention as the Ray overload: from inside the box, report the exit
+        const float inf = std::numeric_limits<float>::infinity();
+        float tNear, tFar;
+        if (!ray.IntersectsBox(box.GetMin(), box.GetMax(), -inf, inf, tNear, tFar) || tFar < 0)
+            return false;
+
+        t = tNear >= 0 ? tNear : tFar;
+        return true;
+    }
+
+    bool RaycastQuery::Intersects(const PreparedRay& ray, const AABB& box)
+    {
+        return ray.IntersectsBox(box.GetMin(), box.GetMax());
+    }
+
     //=============================================================================
-    // Ray-OBB intersection (stub)
+    // Ray-OBB intersection
     //=============================================================================
 
     bool RaycastQuery::Intersects(const Ray& ray, const OBB& box, float& t)
     {
-        // Stub: use AABB of the OBB
-        AABB aabb;
-        aabb.SetMinMax(box.GetMin(), box.GetMax());
-        return Intersects(ray, aabb, t);
+        return box.IntersectsRay(ray, t);
+    }
+
+    bool RaycastQuery::Intersects(const PreparedRay& ray, const OBB& box, float& t)
+    {
+        return box.IntersectsRay(ray, t);
+    }
+
+    bool RaycastQuery::Intersects(const PreparedRay& ray, const OBB& box)
+    {
+        return box.IntersectsRay(ray);
     }
 
     bool RaycastQuery::Intersects(const Ray& ray, const OBB& box)
@@ -358,4 +458,66 @@ namespace hgl::math
         return IntersectsTriangle(ray, v0, v1, v2, t, u, v);
     }
 
+    //=============================================================================
+    // Watertight ray-triangle intersection (Woop, Benthin, Wald 2013)
+    //=============================================================================
+
+    bool RaycastQuery::IntersectsTriangle(const PreparedRay& ray,
+                                         const Vector3f& v0,
+                                         const Vector3f& v1,
+                                         const Vector3f& v2,
+                                         float& t, float& u, float& v)
+    {
+        const int kx = ray.kx, ky = ray.ky, kz = ray.kz;
+        const Vector3f& S = ray.shear;
+
+        // Vertices relative to the ray origin, sheared so the ray runs along +z
+        const Vector3f A = v0 - ray.origin;
+        const Vector3f B = v1 - ray.origin;
+        const Vector3f C = v2 - ray.origin;
+
+        const float Ax = A[kx] - S.x * A[kz], Ay = A[ky] - S.y * A[kz];
+        const float Bx = B[kx] - S.x * B[kz], By = B[ky] - S.y * B[kz];
+        const float Cx = C[kx] - S.x * C[kz], Cy = C[ky] - S.y * C[kz];
+
+        // Scaled barycentrics from 2D edge functions
+        float U = Cx * By - Cy * Bx;
+        float V = Ax * Cy - Ay * Cx;
+        float W = Bx * Ay - By * Ax;
+
+        // Exactly on an edge the float result depends on rounding; recompute in double
+        if (U == 0.0f || V == 0.0f || W == 0.0f)
+        {
+            U = float(double(Cx) * double(By) - double(Cy) * double(Bx));
+            V = float(double(Ax) * double(Cy) - double(Ay) * double(Cx));
+            W = float(double(Bx) * double(Ay) - double(By) * double(Ax));
+        }
+
+        if ((U < 0.0f || V < 0.0f || W < 0.0f) && (U > 0.0f || V > 0.0f || W > 0.0f))
+            return false;
+
+        const float det = U + V + W;
+        if (det == 0.0f)
+            return false;
+
+        const float T = U * (S.z * A[kz]) + V * (S.z * B[kz]) + W * (S.z * C[kz]);
+        const float invDet = 1.0f / det;
+
+        t = T * invDet;
+        u = V * invDet;
+        v = W * invDet;
+
+        return t > 0.0000001f;
+    }
+
+    bool RaycastQuery::IntersectsTriangle(const PreparedRay& ray,
+                                         const Vector3f& v0,
+                                         const Vector3f& v1,
+                                         const Vector3f& v2,
+                                         float& t)
+    {
+        float u, v;
+        return IntersectsTriangle(ray, v0, v1, v2, t, u, v);
+    }
+
 }//namespace hgl::math
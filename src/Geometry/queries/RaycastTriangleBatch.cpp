@@ -0,0 +1,217 @@
+﻿/**
+ * RaycastTriangleBatch.cpp - Watertight ray vs. SoA triangle batches
+ *
+ * Woop/Benthin/Wald edge functions for one ray against 8 triangles at a time.
+ * The 8-wide part is AVX when available; lanes whose edge functions land exactly
+ * on zero are recomputed in double like the single triangle test.
+ */
+#include<hgl/math/geometry/queries/RaycastQuery.h>
+#include<hgl/math/geometry/BatchQueryStructures.h>
+
+#if defined(__AVX__)
+#include<immintrin.h>
+#endif
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr uint32_t LANES = TrianglePacket8::WIDTH;
+        constexpr float MIN_DISTANCE = 0.0000001f;
+
+        /**
+         * Column pointers for one block of 8 triangles: col[vertex][axis][lane]
+         */
+        struct Block
+        {
+            const float* col[3][3];
+        };
+
+        struct EdgeValues
+        {
+            alignas(32) float U[LANES];
+            alignas(32) float V[LANES];
+            alignas(32) float W[LANES];
+            alignas(32) float T[LANES];
+        };
+
+        void ComputeEdges(const PreparedRay& ray, const Block& block, EdgeValues& out)
+        {
+            const int kx = ray.kx, ky = ray.ky, kz = ray.kz;
+
+        #if defined(__AVX__)
+            const __m256 ox = _mm256_set1_ps(ray.origin[kx]);
+            const __m256 oy = _mm256_set1_ps(ray.origin[ky]);
+            const __m256 oz = _mm256_set1_ps(ray.origin[kz]);
+            const __m256 sx = _mm256_set1_ps(ray.shear.x);
+            const __m256 sy = _mm256_set1_ps(ray.shear.y);
+            const __m256 sz = _mm256_set1_ps(ray.shear.z);
+
+            __m256 px[3], py[3], pz[3];
+
+            for (int i = 0; i < 3; i++)
+            {
+                const __m256 z = _mm256_sub_ps(_mm256_loadu_ps(block.col[i][kz]), oz);
+
+                px[i] = _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(block.col[i][kx]), ox), _mm256_mul_ps(sx, z));
+                py[i] = _mm256_sub_ps(_mm256_sub_ps(_mm256_loadu_ps(block.col[i][ky]), oy), _mm256_mul_ps(sy, z));
+                pz[i] = _mm256_mul_ps(sz, z);
+            }
+
+            const __m256 U = _mm256_sub_ps(_mm256_mul_ps(px[2], py[1]), _mm256_mul_ps(py[2], px[1]));
+            const __m256 V = _mm256_sub_ps(_mm256_mul_ps(px[0], py[2]), _mm256_mul_ps(py[0], px[2]));
+            const __m256 W = _mm256_sub_ps(_mm256_mul_ps(px[1], py[0]), _mm256_mul_ps(py[1], px[0]));
+            const __m256 T = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(U, pz[0]), _mm256_mul_ps(V, pz[1])), _mm256_mul_ps(W, pz[2]));
+
+            _mm256_store_ps(out.U, U);
+            _mm256_store_ps(out.V, V);
+            _mm256_store_ps(out.W, W);
+            _mm256_store_ps(out.T, T);
+        #else
+            for (uint32_t lane = 0; lane < LANES; lane++)
+            {
+                float px[3], py[3], pz[3];
+
+                for (int i = 0; i < 3; i++)
+                {
+                    const float z = block.col[i][kz][lane] - ray.origin[kz];
+
+                    px[i] = (block.col[i][kx][lane] - ray.origin[kx]) - ray.shear.x * z;
+                    py[i] = (block.col[i][ky][lane] - ray.origin[ky]) - ray.shear.y * z;
+                    pz[i] = ray.shear.z * z;
+                }
+
+                out.U[lane] = px[2] * py[1] - py[2] * px[1];
+                out.V[lane] = px[0] * py[2] - py[0] * px[2];
+                out.W[lane] = px[1] * py[0] - py[1] * px[0];
+                out.T[lane] = out.U[lane] * pz[0] + out.V[lane] * pz[1] + out.W[lane] * pz[2];
+            }
+        #endif
+        }
+
+        /**
+         * Exact-zero edge functions depend on rounding; redo that lane in double
+         */
+        void RecomputeLane(const PreparedRay& ray, const Block& block, uint32_t lane, float& U, float& V, float& W)
+        {
+            const int kx = ray.kx, ky = ray.ky, kz = ray.kz;
+            double px[3], py[3];
+
+            for (int i = 0; i < 3; i++)
+            {
+                const float z = block.col[i][kz][lane] - ray.origin[kz];
+
+                px[i] = (block.col[i][kx][lane] - ray.origin[kx]) - ray.shear.x * z;
+                py[i] = (block.col[i][ky][lane] - ray.origin[ky]) - ray.shear.y * z;
+            }
+
+            U = float(px[2] * py[1] - py[2] * px[1]);
+            V = float(px[0] * py[2] - py[0] * px[2]);
+            W = float(px[1] * py[0] - py[1] * px[0]);
+        }
+
+        /**
+         * Test the first `lanes` triangles of a block, keep the closest hit below best
+         */
+        bool TestBlock(const PreparedRay& ray, const Block& block, uint32_t lanes, uint32_t baseIndex, float& best, RayTriangleHit& hit)
+        {
+            EdgeValues e;
+            ComputeEdges(ray, block, e);
+
+            bool found = false;
+
+            for (uint32_t lane = 0; lane < lanes; lane++)
+            {
+                float U = e.U[lane], V = e.V[lane], W = e.W[lane], T = e.T[lane];
+
+                if (U == 0.0f || V == 0.0f || W == 0.0f)
+                {
+                    RecomputeLane(ray, block, lane, U, V, W);
+
+                    // T has to follow the corrected barycentrics
+                    const int kz = ray.kz;
+                    T = U * (ray.shear.z * (block.col[0][kz][lane] - ray.origin[kz]))
+                      + V * (ray.shear.z * (block.col[1][kz][lane] - ray.origin[kz]))
+                      + W * (ray.shear.z * (block.col[2][kz][lane] - ray.origin[kz]));
+                }
+
+                if ((U < 0.0f || V < 0.0f || W < 0.0f) && (U > 0.0f || V > 0.0f || W > 0.0f))
+                    continue;
+
+                const float det = U + V + W;
+                if (det == 0.0f)
+                    continue;
+
+                const float invDet = 1.0f / det;
+                const float t = T * invDet;
+
+                if (t <= MIN_DISTANCE || t >= best)
+                    continue;
+
+                best = t;
+                hit.distance = t;
+                hit.index = baseIndex + lane;
+                hit.u = V * invDet;
+                hit.v = W * invDet;
+                found = true;
+            }
+
+            return found;
+        }
+    }//namespace
+
+    bool RaycastQuery::IntersectsTriangles(const PreparedRay& ray, const TrianglePacket8& packet,
+                                           float maxDistance, RayTriangleHit& hit)
+    {
+        if (packet.count == 0)
+            return false;
+
+        Block block;
+
+        for (int i = 0; i < 3; ++i)
+            for (int axis = 0; axis < 3; ++axis)
+                block.col[i][axis] = packet.vertex[i][axis];
+
+        float best = maxDistance;
+        return TestBlock(ray, block, packet.count, 0, best, hit);
+    }
+
+    bool RaycastQuery::IntersectsTriangles(const PreparedRay& ray, const BatchTriangleSOA& triangles,
+                                           float maxDistance, RayTriangleHit& hit)
+    {
+        const size_t count = triangles.count;
+        const size_t full = count - count % LANES;
+
+        float best = maxDistance;
+        bool found = false;
+        Block block;
+
+        for (size_t first = 0; first < full; first += LANES)
+        {
+            for (int i = 0; i < 3; ++i)
+                for (int axis = 0; axis < 3; ++axis)
+                    block.col[i][axis] = triangles.GetData(i, axis) + first;
+
+            found |= TestBlock(ray, block, LANES, uint32_t(first), best, hit);
+        }
+
+        if (full < count)
+        {
+            // Copy the tail into a padded packet so the 8-wide loads stay in bounds
+            TrianglePacket8 tail;
+
+            for (size_t index = full; index < count; ++index)
+                for (int i = 0; i < 3; ++i)
+                    for (int axis = 0; axis < 3; ++axis)
+                        tail.vertex[i][axis][index - full] = triangles.GetData(i, axis)[index];
+
+            for (int i = 0; i < 3; ++i)
+                for (int axis = 0; axis < 3; ++axis)
+                    block.col[i][axis] = tail.vertex[i][axis];
+
+            found |= TestBlock(ray, block, uint32_t(count - full), uint32_t(full), best, hit);
+        }
+
+        return found;
+    }
+}//namespace hgl::math
@@ -0,0 +1,510 @@
+﻿/**
+ * SweepQuery.cpp - Swept (continuous) collision tests
+ *
+ * Analytic tests reduce a moving sphere to a moving point against the
+ * Minkowski sum of the target and the sphere (rounded box, rounded
+ * triangle, inflated sphere/capsule), following Ericson, "Real-Time
+ * Collision Detection", 5.5.
+ *
+ * Conservative advancement steps by the gap between the support planes
+ * along the closest-feature direction divided by the approach speed. That
+ * gap is a lower bound of the distance for any direction, so every step
+ * stays at or before the first contact even with an inexact GJK normal.
+ */
+#include<hgl/math/geometry/queries/SweepQuery.h>
+#include<hgl/math/geometry/queries/DistanceQuery.h>
+#include<bit>
+#include<cmath>
+#include<cfloat>
+#include<algorithm>
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr float PARALLEL_EPSILON=1e-8f;
+
+        Vector3f FallbackNormal(const Vector3f &motion)
+        {
+            const float len=Length(motion);
+
+            return len>PARALLEL_EPSILON?motion/len:Vector3f(0,1,0);
+        }
+
+        Vector3f SafeDirection(const Vector3f &from,const Vector3f &to,const Vector3f &motion)
+        {
+            const Vector3f diff=to-from;
+            const float len=Length(diff);
+
+            return len>1e-6f?diff/len:FallbackNormal(motion);
+        }
+
+        /**
+         * Earliest t in [0,1] at which p+d*t is inside sphere (c,r); starting inside gives 0
+         */
+        bool SegmentSphere(const Vector3f &p,const Vector3f &d,const Vector3f &c,float r,float &t)
+        {
+            const Vector3f m=p-c;
+            const float cc=Dot(m,m)-r*r;
+
+            if(cc<=0.0f)
+            {
+                t=0.0f;
+                return true;
+            }
+
+            const float b=Dot(m,d);
+
+            if(b>=0.0f)
+                return false;       // Moving away
+
+            const float a=Dot(d,d);
+            const float disc=b*b-a*cc;
+
+            if(disc<0.0f)
+                return false;
+
+            t=(-b-std::sqrt(disc))/a;
+            return t<=1.0f;
+        }
+
+        /**
+         * Side surface of the finite cylinder around segment a-b (caps excluded)
+         */
+        bool SegmentCylinderSide(const Vector3f &p,const Vector3f &d,const Vector3f &a,const Vector3f &b,float r,float &t)
+        {
+            const Vector3f ab=b-a;
+            const Vector3f m=p-a;
+
+            const float dd=Dot(ab,ab);
+            const float md=Dot(m,ab);
+            const float nd=Dot(d,ab);
+            const float nn=Dot(d,d);
+            const float mn=Dot(m,d);
+
+            const float aa=dd*nn-nd*nd;
+
+            if(aa<=PARALLEL_EPSILON*dd*nn)
+                return false;       // Moving parallel to the axis: only the end spheres can be hit
+
+            const float k=Dot(m,m)-r*r;
+            const float cc=dd*k-md*md;
+            const float bb=dd*mn-nd*md;
+            const float disc=bb*bb-aa*cc;
+
+            if(disc<0.0f)
+                return false;
+
+            t=(-bb-std::sqrt(disc))/aa;
+
+            if(t<0.0f||t>1.0f)
+                return false;
+
+            const float axial=md+t*nd;
+            return axial>=0.0f&&axial<=dd;
+        }
+
+        /**
+         * Earliest t in [0,1] at which p+d*t is inside capsule (a,b,r)
+         */
+        bool SegmentCapsule(const Vector3f &p,const Vector3f &d,const Vector3f &a,const Vector3f &b,float r,float &t)
+        {
+            if(LengthSquared(p-DistanceQuery::ClosestPointOnLineSegment(p,a,b))<=r*r)
+            {
+                t=0.0f;
+                return true;
+            }
+
+            float best=FLT_MAX;
+            float candidate;
+
+            if(SegmentCylinderSide(p,d,a,b,r,candidate))best=candidate;
+            if(SegmentSphere(p,d,a,r,candidate)&&candidate<best)best=candidate;
+            if(SegmentSphere(p,d,b,r,candidate)&&candidate<best)best=candidate;
+
+            t=best;
+            return best<=1.0f;
+        }
+
+        void SetInitialOverlap(SweepHit &hit,const Vector3f &center,const Vector3f &closest,const Vector3f &motion)
+        {
+            hit.hit=true;
+            hit.time=0.0f;
+            hit.initially_overlapping=true;
+            hit.point=closest;
+            hit.normal=SafeDirection(center,closest,motion);
+        }
+
+        /**
+         * Moving sphere against an axis aligned box given by min/max
+         */
+        bool SweepSphereBox(const Vector3f &c,float r,const Vector3f &d,const Vector3f &box_min,const Vector3f &box_max,SweepHit &hit)
+        {
+            hit=SweepHit();
+
+            const Vector3f start_closest=glm::clamp(c,box_min,box_max);
+
+            if(LengthSquared(start_closest-c)<=r*r)
+            {
+                SetInitialOverlap(hit,c,start_closest,d);
+                return true;
+            }
+
+            // Ray against the box expanded by r
+            float t_min=0.0f;
+            float t_max=1.0f;
+
+            for(int i=0;i<3;i++)
+            {
+                const float lo=box_min[i]-r;
+                const float hi=box_max[i]+r;
+
+                if(std::fabs(d[i])<PARALLEL_EPSILON)
+                {
+                    if(c[i]<lo||c[i]>hi)
+                        return false;
+
+                    continue;
+                }
+
+                const float inv=1.0f/d[i];
+                float t1=(lo-c[i])*inv;
+                float t2=(hi-c[i])*inv;
+
+                if(t1>t2)std::swap(t1,t2);
+
+                t_min=std::max(t_min,t1);
+                t_max=std::min(t_max,t2);
+
+                if(t_min>t_max)
+                    return false;
+            }
+
+            // Which Voronoi region of the original box the hit point lies in
+            const Vector3f q=c+d*t_min;
+            uint32_t below=0,above=0;
+
+            for(int i=0;i<3;i++)
+            {
+                if(q[i]<box_min[i])below|=1u<<i;
+                if(q[i]>box_max[i])above|=1u<<i;
+            }
+
+            const uint32_t mask=below|above;
+            float t=t_min;
+
+            if(std::popcount(mask)>=2)
+            {
+                // Edge or vertex region: the rounded part is a set of edge capsules
+                Vector3f corner;
+
+                for(int i=0;i<3;i++)
+                    corner[i]=(above&(1u<<i))?box_max[i]:box_min[i];
+
+                float best=FLT_MAX;
+
+                for(int i=0;i<3;i++)
+                {
+                    // Edges along axes not in the mask (edge region), or all three edges from the corner
+                    if(std::popcount(mask)==2&&(mask&(1u<<i)))
+                        continue;
+
+                    Vector3f e0=corner;
+                    Vector3f e1=corner;
+
+                    if(mask&(1u<<i))
+                        e1[i]=(above&(1u<<i))?box_min[i]:box_max[i];
+                    else
+                    {
+                        e0[i]=box_min[i];
+                        e1[i]=box_max[i];
+                    }
+
+                    float candidate;
+
+                    if(SegmentCapsule(c,d,e0,e1,r,candidate)&&candidate<best)
+                        best=candidate;
+                }
+
+                if(best>1.0f)
+                    return false;
+
+                t=best;
+            }
+
+            const Vector3f center=c+d*t;
+            const Vector3f closest=glm::clamp(center,box_min,box_max);
+
+            hit.hit=true;
+            hit.time=t;
+            hit.point=closest;
+            hit.normal=SafeDirection(center,closest,d);
+            return true;
+        }
+
+        struct TranslatedSupport
+        {
+            const ConvexSupport *shape;
+            Vector3f offset;
+        };
+
+        Vector3f TranslatedSupportPoint(const void *s,const Vector3f &direction)
+        {
+            const TranslatedSupport *ts=static_cast<const TranslatedSupport *>(s);
+
+            return (*ts->shape)(direction)+ts->offset;
+        }
+    }//namespace
+
+    //=============================================================================
+    // Moving sphere
+    //=============================================================================
+
+    bool SweepQuery::Sweep(const Sphere &sphere,const Vector3f &motion,const Sphere &target,SweepHit &hit)
+    {
+        hit=SweepHit();
+
+        float t;
+
+        if(!SegmentSphere(sphere.GetCenter(),motion,target.GetCenter(),sphere.GetRadius()+target.GetRadius(),t))
+            return false;
+
+        const Vector3f center=sphere.GetCenter()+motion*t;
+
+        hit.hit=true;
+        hit.time=t;
+        hit.initially_overlapping=(t<=0.0f);
+        hit.normal=SafeDirection(center,target.GetCenter(),motion);
+        hit.point=center+hit.normal*sphere.GetRadius();
+        return true;
+    }
+
+    bool SweepQuery::Sweep(const Sphere &sphere,const Vector3f &motion,const AABB &box,SweepHit &hit)
+    {
+        return SweepSphereBox(sphere.GetCenter(),sphere.GetRadius(),motion,box.GetMin(),box.GetMax(),hit);
+    }
+
+    bool SweepQuery::Sweep(const Sphere &sphere,const Vector3f &motion,const OBB &box,SweepHit &hit)
+    {
+        // Solve in the box frame, where it is an AABB
+        const Vector3f offset=sphere.GetCenter()-box.GetCenter();
+
+        const Vector3f local_center(Dot(offset,box.GetAxis(0)),Dot(offset,box.GetAxis(1)),Dot(offset,box.GetAxis(2)));
+        const Vector3f local_motion(Dot(motion,box.GetAxis(0)),Dot(motion,box.GetAxis(1)),Dot(motion,box.GetAxis(2)));
+
+        const Vector3f &h=box.GetHalfExtend();
+
+        if(!SweepSphereBox(local_center,sphere.GetRadius(),local_motion,-h,h,hit))
+            return false;
+
+        const Vector3f p=hit.point;
+        const Vector3f n=hit.normal;
+
+        hit.point=box.GetCenter()+box.GetAxis(0)*p.x+box.GetAxis(1)*p.y+box.GetAxis(2)*p.z;
+        hit.normal=box.GetAxis(0)*n.x+box.GetAxis(1)*n.y+box.GetAxis(2)*n.z;
+        return true;
+    }
+
+    bool SweepQuery::Sweep(const Sphere &sphere,const Vector3f &motion,const Triangle3f &triangle,SweepHit &hit)
+    {
+        hit=SweepHit();
+
+        const Vector3f &c=sphere.GetCenter();
+        const float r=sphere.GetRadius();
+        const Vector3f &v0=triangle[0];
+        const Vector3f &v1=triangle[1];
+        const Vector3f &v2=triangle[2];
+
+        const Vector3f start_closest=ClosestPointOnTriangle(c,v0,v1,v2);
+
+        if(LengthSquared(start_closest-c)<=r*r)
+        {
+            SetInitialOverlap(hit,c,start_closest,motion);
+            return true;
+        }
+
+        // Face: plane offset by r towards the sphere
+        Vector3f n=Cross(v1-v0,v2-v0);
+        const float len=Length(n);
+
+        if(len>PARALLEL_EPSILON)
+        {
+            n/=len;
+
+            float dist=Dot(n,c-v0);
+
+            if(dist<0.0f)
+            {
+                n=-n;
+                dist=-dist;
+            }
+
+            const float approach=-Dot(n,motion);
+
+            if(approach>PARALLEL_EPSILON)
+            {
+                const float t=(dist-r)/approach;
+
+                if(t>=0.0f&&t<=1.0f)
+                {
+                    const Vector3f q=c+motion*t-n*r;
+
+                    const float s0=Dot(Cross(v1-v0,q-v0),n);
+                    const float s1=Dot(Cross(v2-v1,q-v1),n);
+                    const float s2=Dot(Cross(v0-v2,q-v2),n);
+
+                    if((s0>=0.0f&&s1>=0.0f&&s2>=0.0f)||(s0<=0.0f&&s1<=0.0f&&s2<=0.0f))
+                    {
+                        hit.hit=true;
+                        hit.time=t;
+                        hit.point=q;
+                        hit.normal=-n;
+                        return true;
+                    }
+                }
+            }
+        }
+
+        // Edges and vertices: capsules around the three edges
+        float best=FLT_MAX;
+        float candidate;
+
+        if(SegmentCapsule(c,motion,v0,v1,r,candidate)&&candidate<best)best=candidate;
+        if(SegmentCapsule(c,motion,v1,v2,r,candidate)&&candidate<best)best=candidate;
+        if(SegmentCapsule(c,motion,v2,v0,r,candidate)&&candidate<best)best=candidate;
+
+        if(best>1.0f)
+            return false;
+
+        const Vector3f center=c+motion*best;
+
+        hit.hit=true;
+        hit.time=best;
+        hit.point=ClosestPointOnTriangle(center,v0,v1,v2);
+        hit.normal=SafeDirection(center,hit.point,motion);
+        return true;
+    }
+
+    //=============================================================================
+    // Moving capsule
+    //=============================================================================
+
+    bool SweepQuery::Sweep(const Capsule &capsule,const Vector3f &motion,const Sphere &target,SweepHit &hit)
+    {
+        hit=SweepHit();
+
+        // Sphere center moving backwards against the capsule inflated by the sphere radius
+        float t;
+
+        if(!SegmentCapsule(target.GetCenter(),-motion,capsule.GetStart(),capsule.GetEnd(),capsule.GetRadius()+target.GetRadius(),t))
+            return false;
+
+        const Vector3f offset=motion*t;
+        const Vector3f closest=DistanceQuery::ClosestPointOnLineSegment(target.GetCenter(),capsule.GetStart()+offset,capsule.GetEnd()+offset);
+
+        hit.hit=true;
+        hit.time=t;
+        hit.initially_overlapping=(t<=0.0f);
+        hit.normal=SafeDirection(closest,target.GetCenter(),motion);
+        hit.point=closest+hit.normal*capsule.GetRadius();
+        return true;
+    }
+
+    bool SweepQuery::Sweep(const Capsule &capsule,const Vector3f &motion,const AABB &box,SweepHit &hit)
+    {
+        return TimeOfImpact(capsule,motion,box,Vector3f(0,0,0),hit);
+    }
+
+    bool SweepQuery::Sweep(const Capsule &capsule,const Vector3f &motion,const OBB &box,SweepHit &hit)
+    {
+        return TimeOfImpact(capsule,motion,box,Vector3f(0,0,0),hit);
+    }
+
+    bool SweepQuery::Sweep(const Capsule &capsule,const Vector3f &motion,const Triangle3f &triangle,SweepHit &hit)
+    {
+        return TimeOfImpact(capsule,motion,triangle,Vector3f(0,0,0),hit);
+    }
+
+    bool SweepQuery::Sweep(const Capsule &capsule,const Vector3f &motion,const Capsule &target,SweepHit &hit)
+    {
+        return TimeOfImpact(capsule,motion,target,Vector3f(0,0,0),hit);
+    }
+
+    //=============================================================================
+    // Conservative advancement
+    //=============================================================================
+
+    bool SweepQuery::ConservativeAdvancement(const ConvexSupport &a,const Vector3f &motion_a,
+                                             const ConvexSupport &b,const Vector3f &motion_b,
+                                             SweepHit &hit,float tolerance)
+    {
+        hit=SweepHit();
+
+        // Work in B's frame: only A moves, by the relative motion
+        const Vector3f relative=motion_a-motion_b;
+
+        TranslatedSupport moved{&a,Vector3f(0,0,0)};
+
+        ConvexSupport moving;
+        moving.shape=&moved;
+        moving.support=TranslatedSupportPoint;
+        moving.center=a.center;
+
+        float t=0.0f;
+
+        for(uint32_t iteration=0;iteration<MAX_ADVANCE_ITERATIONS;iteration++)
+        {
+            moved.offset=relative*t;
+            moving.center=a.center+moved.offset;
+            hit.iterations=iteration+1;
+
+            // No warm start: a simplex carried over from the previous step can
+            // leave GJK with a stale closest feature and an overestimated step
+            GJKResult result;
+
+            if(GJK::Query(moving,b,result))
+            {
+                // Only possible at the start: advancement never passes the contact
+                CollisionInfo info;
+                GJK::EPA(moving,b,result,info);
+
+                hit.hit=true;
+                hit.time=t;
+                hit.initially_overlapping=(t<=0.0f);
+                hit.normal=info.normal;
+                hit.point=info.point+motion_b*t;
+                return true;
+            }
+
+            const Vector3f normal=SafeDirection(result.point_a,result.point_b,relative);
+
+            // Gap between the support planes along the witness normal: a lower bound of the
+            // distance for any normal, so stepping by it cannot pass the contact even though
+            // the normal is only float-accurate once the witness points get close
+            const float gap=Dot(normal,b(-normal)-moving(normal));
+
+            if(gap<=tolerance)
+            {
+                hit.hit=true;
+                hit.time=t;
+                hit.normal=normal;
+                hit.point=result.point_a+motion_b*t;
+                return true;
+            }
+
+            const float approach=Dot(relative,normal);
+
+            if(approach<=PARALLEL_EPSILON)
+                return false;       // That plane separates the shapes for the whole motion
+
+            // Stop half a tolerance short so the final query stays separated
+            t+=(gap-tolerance*0.5f)/approach;
+
+            if(t>1.0f)
+                return false;
+        }
+
+        // Iteration limit before reaching the tolerance: the contact is not established
+        return false;
+    }
+}//namespace hgl::math
@@ -0,0 +1,47 @@
+﻿/**
+ * ParallelFor.cpp - std::thread 并行执行器实现
+ */
+
+#include<hgl/math/ParallelFor.h>
+#include<thread>
+#include<atomic>
+#include<vector>
+
+namespace hgl::math
+{
+    ThreadParallelExecutor::ThreadParallelExecutor(uint32_t workers)
+    {
+        if(workers==0)
+            workers=std::thread::hardware_concurrency();
+
+        worker_count=workers?workers:1;
+    }
+
+    void ThreadParallelExecutor::Execute(size_t task_count,const std::function<void(size_t task_index)> &task)
+    {
+        if(task_count==0)
+            return;
+
+        const size_t thread_count=(task_count<worker_count)?task_count:worker_count;
+
+        // Workers pull task indices from a shared counter, so uneven tasks balance out
+        std::atomic<size_t> next_task{0};
+
+        auto worker=[&]()
+            {
+                for(size_t i=next_task.fetch_add(1,std::memory_order_relaxed);i<task_count;i=next_task.fetch_add(1,std::memory_order_relaxed))
+                    task(i);
+            };
+
+        std::vector<std::thread> threads;
+        threads.reserve(thread_count-1);
+
+        for(size_t i=1;i<thread_count;i++)
+            threads.emplace_back(worker);
+
+        worker();       // the calling thread participates as well
+
+        for(auto &t:threads)
+            t.join();
+    }
+}//namespace hgl::math
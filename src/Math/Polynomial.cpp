@@ -0,0 +1,527 @@
+﻿/**
+ * Polynomial.cpp - Closed-form cubic/quartic roots
+ *
+ * CubicLane/QuarticLane are written once over a lane type: double for the
+ * scalar solvers, and 4 doubles in an AVX register for the batch solvers
+ * when __AVX__ is available. Every lane runs all formula branches and
+ * selects with masks; the AVX acos/cos/cbrt are polynomial approximations
+ * that the Newton polish brings to full precision.
+ */
+#include<hgl/math/Polynomial.h>
+#include<cmath>
+#include<algorithm>
+#include<numbers>
+#include<type_traits>
+
+#if defined(__AVX__)
+#include<immintrin.h>
+#endif
+
+namespace hgl::math
+{
+    namespace
+    {
+        constexpr double TWO_PI=2.0*std::numbers::pi;
+
+        // Relative slack that lets a discriminant lost to rounding still yield a (double) root
+        constexpr double DISC_EPSILON=1e-12;
+
+        // Scalar lane: plain double and bool masks
+
+        inline double Select(bool m,double a,double b){return m?a:b;}
+        inline bool Select(bool m,bool a,bool b){return m?a:b;}
+        inline bool And(bool a,bool b){return a&&b;}
+        inline bool Or(bool a,bool b){return a||b;}
+        inline double Sqrt(double x){return std::sqrt(x);}
+        inline double Abs(double x){return std::fabs(x);}
+        inline double Min(double a,double b){return std::min(a,b);}
+        inline double Max(double a,double b){return std::max(a,b);}
+        inline double CopySign(double mag,double sgn){return std::copysign(mag,sgn);}
+        inline double Acos(double x){return std::acos(x);}
+        inline double Cos(double x){return std::cos(x);}
+        inline double Cbrt(double x){return std::cbrt(x);}
+
+#if defined(__AVX__)
+        // AVX lane: 4 doubles, masks are all-ones/all-zeros lanes
+
+        struct Lane4
+        {
+            __m256d v;
+
+            Lane4()=default;
+            Lane4(__m256d x):v(x){}
+            Lane4(double x):v(_mm256_set1_pd(x)){}
+        };
+
+        struct Mask4
+        {
+            __m256d m;
+        };
+
+        inline Lane4 operator+(const Lane4 &a,const Lane4 &b){return _mm256_add_pd(a.v,b.v);}
+        inline Lane4 operator-(const Lane4 &a,const Lane4 &b){return _mm256_sub_pd(a.v,b.v);}
+        inline Lane4 operator*(const Lane4 &a,const Lane4 &b){return _mm256_mul_pd(a.v,b.v);}
+        inline Lane4 operator/(const Lane4 &a,const Lane4 &b){return _mm256_div_pd(a.v,b.v);}
+        inline Lane4 operator-(const Lane4 &a){return _mm256_xor_pd(a.v,_mm256_set1_pd(-0.0));}
+
+        inline Mask4 operator< (const Lane4 &a,const Lane4 &b){return {_mm256_cmp_pd(a.v,b.v,_CMP_LT_OQ)};}
+        inline Mask4 operator<=(const Lane4 &a,const Lane4 &b){return {_mm256_cmp_pd(a.v,b.v,_CMP_LE_OQ)};}
+        inline Mask4 operator> (const Lane4 &a,const Lane4 &b){return {_mm256_cmp_pd(a.v,b.v,_CMP_GT_OQ)};}
+        inline Mask4 operator>=(const Lane4 &a,const Lane4 &b){return {_mm256_cmp_pd(a.v,b.v,_CMP_GE_OQ)};}
+        inline Mask4 operator==(const Lane4 &a,const Lane4 &b){return {_mm256_cmp_pd(a.v,b.v,_CMP_EQ_OQ)};}
+        inline Mask4 operator!=(const Lane4 &a,const Lane4 &b){return {_mm256_cmp_pd(a.v,b.v,_CMP_NEQ_UQ)};}
+
+        // and/andnot rather than blendv: GCC rewrites blendv as a sign test, which AVX1 has to scalarize
+        inline Lane4 Select(const Mask4 &m,const Lane4 &a,const Lane4 &b){return _mm256_or_pd(_mm256_and_pd(m.m,a.v),_mm256_andnot_pd(m.m,b.v));}
+        inline Mask4 Select(const Mask4 &m,const Mask4 &a,const Mask4 &b){return {_mm256_or_pd(_mm256_and_pd(m.m,a.m),_mm256_andnot_pd(m.m,b.m))};}
+        inline Mask4 And(const Mask4 &a,const Mask4 &b){return {_mm256_and_pd(a.m,b.m)};}
+        inline Mask4 Or(const Mask4 &a,const Mask4 &b){return {_mm256_or_pd(a.m,b.m)};}
+        inline Lane4 Sqrt(const Lane4 &x){return _mm256_sqrt_pd(x.v);}
+        inline Lane4 Abs(const Lane4 &x){return _mm256_andnot_pd(_mm256_set1_pd(-0.0),x.v);}
+        inline Lane4 Min(const Lane4 &a,const Lane4 &b){return _mm256_min_pd(a.v,b.v);}
+        inline Lane4 Max(const Lane4 &a,const Lane4 &b){return _mm256_max_pd(a.v,b.v);}
+
+        inline Lane4 CopySign(const Lane4 &mag,const Lane4 &sgn)
+        {
+            const __m256d sign=_mm256_set1_pd(-0.0);
+
+            return _mm256_or_pd(_mm256_andnot_pd(sign,mag.v),_mm256_and_pd(sign,sgn.v));
+        }
+
+        // acos on [-1,1] (Abramowitz-Stegun 4.4.46, |error|<=2e-8)
+        inline Lane4 Acos(const Lane4 &x)
+        {
+            const Lane4 ax=Abs(x);
+
+            Lane4 p=-0.0012624911;
+            p=p*ax+0.0066700901;
+            p=p*ax-0.0170881256;
+            p=p*ax+0.0308918810;
+            p=p*ax-0.0501743046;
+            p=p*ax+0.0889789874;
+            p=p*ax-0.2145988016;
+            p=p*ax+1.5707963050;
+
+            const Lane4 r=Sqrt(Max(Lane4(1.0)-ax,0.0))*p;
+
+            return Select(x<Lane4(0.0),Lane4(std::numbers::pi)-r,r);
+        }
+
+        // cos on [-pi,pi]: Taylor series of the half angle, then cos(x)=2cos^2(x/2)-1
+        inline Lane4 Cos(const Lane4 &x)
+        {
+            const Lane4 h=x*0.5;
+            const Lane4 h2=h*h;
+
+            // (-1)^n/(2n)! for n=10..0
+            Lane4 c=1.0/2432902008176640000.0;
+            c=c*h2-1.0/6402373705728000.0;
+            c=c*h2+1.0/20922789888000.0;
+            c=c*h2-1.0/87178291200.0;
+            c=c*h2+1.0/479001600.0;
+            c=c*h2-1.0/3628800.0;
+            c=c*h2+1.0/40320.0;
+            c=c*h2-1.0/720.0;
+            c=c*h2+1.0/24.0;
+            c=c*h2-0.5;
+            c=c*h2+1.0;
+
+            return c*c*2.0-1.0;
+        }
+
+        // cbrt of x>=0: exact power-of-two range reduction, float bit-trick estimate, three Halley steps
+        inline Lane4 Cbrt(const Lane4 &x)
+        {
+            Lane4 t=x;
+            Lane4 scale=1.0;
+
+            const double big[4]  ={0x1p576, 0x1p288, 0x1p144, 0x1p72};
+            const double small[4]={0x1p-576,0x1p-288,0x1p-144,0x1p-72};
+            const double root[4] ={0x1p192, 0x1p96,  0x1p48,  0x1p24};
+            const double iroot[4]={0x1p-192,0x1p-96, 0x1p-48, 0x1p-24};
+
+            for(int i=0;i<4;i++)
+            {
+                const Mask4 over=t>Lane4(big[i]);
+                t=Select(over,t*small[i],t);
+                scale=Select(over,scale*root[i],scale);
+
+                const Mask4 under=t<Lane4(small[i]);
+                t=Select(under,t*big[i],t);
+                scale=Select(under,scale*iroot[i],scale);
+            }
+
+            // bits(cbrt(f))~=bits(f)/3+B1 (B1 as in fdlibm cbrtf), a few percent off
+            const __m128 f=_mm256_cvtpd_ps(t.v);
+            const __m128i third=_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_castps_si128(f)),_mm_set1_ps(1.0f/3.0f)));
+            Lane4 y=_mm256_cvtps_pd(_mm_castsi128_ps(_mm_add_epi32(third,_mm_set1_epi32(709958130))));
+
+            for(int i=0;i<3;i++)
+            {
+                const Lane4 y3=y*y*y;
+                y=y*(y3+t*2.0)/(y3*2.0+t);
+            }
+
+            return Select(x==Lane4(0.0),Lane4(0.0),y*scale);
+        }
+#endif//__AVX__
+
+        template<typename T,typename F>
+        inline T Polish(T x,const F &poly)
+        {
+            // Two guarded Newton steps: a step is kept only if it shrinks the residual,
+            // which keeps near-multiple roots from being thrown away by a tiny derivative
+            for(int i=0;i<2;i++)
+            {
+                T f,df;
+                poly(x,f,df);
+
+                const T step=Select(df!=0.0,f/df,0.0);
+                const T nx=x-step;
+
+                T nf,ndf;
+                poly(nx,nf,ndf);
+
+                x=Select(Abs(nf)<Abs(f),nx,x);
+            }
+
+            return x;
+        }
+
+        template<typename T>
+        inline void Sort2(T &a,T &b)
+        {
+            const T lo=Min(a,b);
+            b=Max(a,b);
+            a=lo;
+        }
+
+        /**
+         * Real roots of the monic cubic x^3+B*x^2+C*x+D, ascending.
+         * Every lane runs the trigonometric and the Cardano formula and selects one.
+         * @return root count of each lane (3 or 1)
+         */
+        template<typename T>
+        inline T CubicLane(const T &B,const T &C,const T &D,T out[3])
+        {
+            const T Q=(B*B-3.0*C)/9.0;
+            const T R=(2.0*B*B*B-9.0*B*C+27.0*D)/54.0;
+            const T Q3=Q*Q*Q;
+            const T R2=R*R;
+            const T shift=B/3.0;
+
+            const auto three=And(Q>0.0,R2<=Q3*(1.0+DISC_EPSILON));
+
+            // Three real roots
+            const T sq=Sqrt(Max(Q,0.0));
+            const T ratio=Select(three,R/(sq*sq*sq),0.0);
+            const T theta=Acos(Min(Max(ratio,-1.0),1.0));
+
+            T t0=-2.0*sq*Cos(theta/3.0)-shift;
+            T t1=-2.0*sq*Cos((theta+TWO_PI)/3.0)-shift;
+            T t2=-2.0*sq*Cos((theta-TWO_PI)/3.0)-shift;
+
+            // One real root
+            const T A=-CopySign(Cbrt(Abs(R)+Sqrt(Max(R2-Q3,0.0))),R);
+            const T one=A+Select(A!=0.0,Q/A,0.0)-shift;
+
+            t0=Select(three,t0,one);
+            t1=Select(three,t1,one);
+            t2=Select(three,t2,one);
+
+            const auto poly=[&B,&C,&D](const T &x,T &f,T &df)
+            {
+                f=((x+B)*x+C)*x+D;
+                df=(3.0*x+2.0*B)*x+C;
+            };
+
+            t0=Polish(t0,poly);
+            t1=Polish(t1,poly);
+            t2=Polish(t2,poly);
+
+            Sort2(t0,t1);
+            Sort2(t1,t2);
+            Sort2(t0,t1);
+
+            out[0]=t0;
+            out[1]=t1;
+            out[2]=t2;
+
+            return Select(three,3.0,1.0);
+        }
+
+        /**
+         * Real roots of the monic quartic x^4+B*x^3+C*x^2+D*x+E, ascending (Ferrari).
+         * Unused slots are filled with +inf.
+         * @return root count of each lane
+         */
+        template<typename T>
+        inline T QuarticLane(const T &B,const T &C,const T &D,const T &E,T out[4])
+        {
+            // Depressed quartic y^4+p*y^2+q*y+r with x=y-B/4
+            const T s4=B*0.25;
+            const T s4_2=s4*s4;
+            const T p=C-6.0*s4_2;
+            const T q=D-2.0*C*s4+8.0*s4_2*s4;
+            const T r=E-D*s4+C*s4_2-3.0*s4_2*s4_2;
+
+            // Largest root of the resolvent cubic m^3+p*m^2+(p^2/4-r)*m-q^2/8;
+            // a single real root fills all three slots, so the last slot is always the largest
+            T res[3];
+            CubicLane<T>(p,p*p*0.25-r,-q*q*0.125,res);
+            const T m=Max(res[2],0.0);
+
+            const T scale=Abs(p)+Sqrt(Abs(r));
+            const T s=Sqrt(2.0*m);
+            const auto biquadratic=Or(s<=1e-9*Sqrt(scale),Abs(q)<=1e-14*scale*Sqrt(scale));
+
+            T y[4];
+            std::remove_const_t<decltype(biquadratic)> valid[4];
+
+            // General case: (y^2+p/2+m)^2=(s*y-q/(2s))^2 splits into two quadratics
+            {
+                const T h=p*0.5+m;
+                const T k=Select(biquadratic,0.0,q/(2.0*s));
+                const T slack=DISC_EPSILON*(s*s+4.0*Abs(h)+4.0*Abs(k));
+
+                const T d1=s*s-4.0*(h+k);
+                const T d2=s*s-4.0*(h-k);
+                const T r1=Sqrt(Max(d1,0.0));
+                const T r2=Sqrt(Max(d2,0.0));
+
+                y[0]=( s-r1)*0.5;   y[1]=( s+r1)*0.5;
+                y[2]=(-s-r2)*0.5;   y[3]=(-s+r2)*0.5;
+                valid[0]=valid[1]=d1>=-slack;
+                valid[2]=valid[3]=d2>=-slack;
+            }
+
+            // q==0: z^2+p*z+r with z=y^2
+            {
+                const T dz=p*p-4.0*r;
+                const T rz=Sqrt(Max(dz,0.0));
+                const T slack=DISC_EPSILON*(p*p+4.0*Abs(r));
+                const T z0=(-p-rz)*0.5;
+                const T z1=(-p+rz)*0.5;
+                const T zslack=DISC_EPSILON*scale;
+                const T w0=Sqrt(Max(z0,0.0));
+                const T w1=Sqrt(Max(z1,0.0));
+                const auto ok0=And(dz>=-slack,z0>=-zslack);
+                const auto ok1=And(dz>=-slack,z1>=-zslack);
+
+                y[0]=Select(biquadratic,-w0,y[0]);  valid[0]=Select(biquadratic,ok0,valid[0]);
+                y[1]=Select(biquadratic, w0,y[1]);  valid[1]=Select(biquadratic,ok0,valid[1]);
+                y[2]=Select(biquadratic,-w1,y[2]);  valid[2]=Select(biquadratic,ok1,valid[2]);
+                y[3]=Select(biquadratic, w1,y[3]);  valid[3]=Select(biquadratic,ok1,valid[3]);
+            }
+
+            const auto poly=[&B,&C,&D,&E](const T &x,T &f,T &df)
+            {
+                f=(((x+B)*x+C)*x+D)*x+E;
+                df=((4.0*x+3.0*B)*x+2.0*C)*x+D;
+            };
+
+            T count=0.0;
+            T x[4];
+
+            for(int i=0;i<4;i++)
+            {
+                x[i]=Select(valid[i],Polish(y[i]-s4,poly),HUGE_VAL);
+                count=count+Select(valid[i],1.0,0.0);
+            }
+
+            Sort2(x[0],x[1]);
+            Sort2(x[2],x[3]);
+            Sort2(x[0],x[2]);
+            Sort2(x[1],x[3]);
+            Sort2(x[1],x[2]);
+
+            for(int i=0;i<4;i++)
+                out[i]=x[i];
+
+            return count;
+        }
+
+        // Leading coefficients below this (relative to the others) are treated as zero
+        inline bool IsDegenerate(double a,double b,double c,double d,double e=0.0)
+        {
+            return std::fabs(a)<=1e-12*(std::fabs(b)+std::fabs(c)+std::fabs(d)+std::fabs(e));
+        }
+    }//namespace
+
+    int SolveQuadratic(double a,double b,double c,double roots[2])
+    {
+        if(a==0.0||IsDegenerate(a,b,c,0.0))
+        {
+            if(b==0.0)
+                return 0;
+
+            roots[0]=-c/b;
+            return 1;
+        }
+
+        const double disc=b*b-4.0*a*c;
+
+        if(disc<-DISC_EPSILON*(b*b+4.0*std::fabs(a*c)))
+            return 0;
+
+        if(disc<=0.0)
+        {
+            roots[0]=-b/(2.0*a);
+            return 1;
+        }
+
+        // Citardauq form avoids cancellation between -b and the square root
+        const double t=-0.5*(b+std::copysign(std::sqrt(disc),b));
+
+        roots[0]=t/a;
+        roots[1]=(t!=0.0)?c/t:-roots[0];
+
+        Sort2(roots[0],roots[1]);
+        return 2;
+    }
+
+    int SolveCubic(double a,double b,double c,double d,double roots[3])
+    {
+        if(a==0.0||IsDegenerate(a,b,c,d))
+            return SolveQuadratic(b,c,d,roots);
+
+        return int(CubicLane(b/a,c/a,d/a,roots));
+    }
+
+    int SolveQuartic(double a,double b,double c,double d,double e,double roots[4])
+    {
+        if(a==0.0||IsDegenerate(a,b,c,d,e))
+            return SolveCubic(b,c,d,e,roots);
+
+        return int(QuarticLane(b/a,c/a,d/a,e/a,roots));
+    }
+
+    void SolveCubicBatch(const float *a,const float *b,const float *c,const float *d,size_t count,
+                         float *roots,uint8_t *root_count)
+    {
+        if(!a||!b||!c||!d||!roots||!root_count)
+            return;
+
+        size_t i=0;
+
+#if defined(__AVX__)
+        // 4 equations per iteration
+        for(;i+4<=count;i+=4)
+        {
+            const Lane4 la=_mm256_cvtps_pd(_mm_loadu_ps(a+i));
+            const Lane4 inv=Select(la!=0.0,1.0/la,0.0);
+
+            Lane4 r[3];
+            const Lane4 n=CubicLane<Lane4>(Lane4(_mm256_cvtps_pd(_mm_loadu_ps(b+i)))*inv,
+                                           Lane4(_mm256_cvtps_pd(_mm_loadu_ps(c+i)))*inv,
+                                           Lane4(_mm256_cvtps_pd(_mm_loadu_ps(d+i)))*inv,r);
+
+            alignas(32) double rn[4];
+            alignas(32) double rk[3][4];
+
+            _mm256_store_pd(rn,n.v);
+            for(int k=0;k<3;k++)
+                _mm256_store_pd(rk[k],r[k].v);
+
+            for(int j=0;j<4;j++)
+            {
+                root_count[i+j]=uint8_t(rn[j]);
+
+                for(int k=0;k<3;k++)
+                    roots[(i+j)*3+k]=float(rk[k][j]);
+            }
+        }
+#endif//__AVX__
+
+        for(;i<count;i++)
+        {
+            const double inv=(a[i]!=0.0f)?1.0/double(a[i]):0.0;
+            double r[3];
+
+            root_count[i]=uint8_t(CubicLane(b[i]*inv,c[i]*inv,d[i]*inv,r));
+
+            roots[i*3  ]=float(r[0]);
+            roots[i*3+1]=float(r[1]);
+            roots[i*3+2]=float(r[2]);
+        }
+
+        // Rare lanes that are really quadratics go through the scalar path
+        for(i=0;i<count;i++)
+        {
+            if(!IsDegenerate(a[i],b[i],c[i],d[i]))
+                continue;
+
+            double r[3];
+            const int n=SolveQuadratic(b[i],c[i],d[i],r);
+
+            root_count[i]=uint8_t(n);
+            for(int k=0;k<n;k++)
+                roots[i*3+k]=float(r[k]);
+        }
+    }
+
+    void SolveQuarticBatch(const float *a,const float *b,const float *c,const float *d,const float *e,size_t count,
+                           float *roots,uint8_t *root_count)
+    {
+        if(!a||!b||!c||!d||!e||!roots||!root_count)
+            return;
+
+        size_t i=0;
+
+#if defined(__AVX__)
+        // 4 equations per iteration
+        for(;i+4<=count;i+=4)
+        {
+            const Lane4 la=_mm256_cvtps_pd(_mm_loadu_ps(a+i));
+            const Lane4 inv=Select(la!=0.0,1.0/la,0.0);
+
+            Lane4 r[4];
+            const Lane4 n=QuarticLane<Lane4>(Lane4(_mm256_cvtps_pd(_mm_loadu_ps(b+i)))*inv,
+                                             Lane4(_mm256_cvtps_pd(_mm_loadu_ps(c+i)))*inv,
+                                             Lane4(_mm256_cvtps_pd(_mm_loadu_ps(d+i)))*inv,
+                                             Lane4(_mm256_cvtps_pd(_mm_loadu_ps(e+i)))*inv,r);
+
+            alignas(32) double rn[4];
+            alignas(32) double rk[4][4];
+
+            _mm256_store_pd(rn,n.v);
+            for(int k=0;k<4;k++)
+                _mm256_store_pd(rk[k],r[k].v);
+
+            for(int j=0;j<4;j++)
+            {
+                root_count[i+j]=uint8_t(rn[j]);
+
+                for(int k=0;k<4;k++)
+                    roots[(i+j)*4+k]=float(rk[k][j]);
+            }
+        }
+#endif//__AVX__
+
+        for(;i<count;i++)
+        {
+            const double inv=(a[i]!=0.0f)?1.0/double(a[i]):0.0;
+            double r[4];
+
+            root_count[i]=uint8_t(QuarticLane(b[i]*inv,c[i]*inv,d[i]*inv,e[i]*inv,r));
+
+            roots[i*4  ]=float(r[0]);
+            roots[i*4+1]=float(r[1]);
+            roots[i*4+2]=float(r[2]);
+            roots[i*4+3]=float(r[3]);
+        }
+
+        for(i=0;i<count;i++)
+        {
+            if(!IsDegenerate(a[i],b[i],c[i],d[i],e[i]))
+                continue;
+
+            double r[3];
+            const int n=SolveCubic(b[i],c[i],d[i],e[i],r);
+
+            root_count[i]=uint8_t(n);
+            for(int k=0;k<n;k++)
+                roots[i*4+k]=float(r[k]);
+        }
+    }
+}//namespace hgl::math
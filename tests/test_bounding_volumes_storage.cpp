@@ -1,5 +1,6 @@
 ﻿// BoundingVolumesDataStorage 测试和使用示例
 #include<hgl/math/geometry/BoundingVolumesDataStorage.h>
+#include<hgl/math/geometry/BoundingVolumesBatch.h>
 #include<iostream>
 #include<chrono>
 
@@ -345,6 +346,115 @@ void CompareSOAvsAOS()
     std::cout << std::endl;
 }
 
+void TestChannelsAndDirty()
+{
+    std::cout << "=== 测试通道选择与脏标记 ===" << std::endl;
+
+    // 只存储 AABB + Sphere
+    BoundingVolumesDataStorage storage(100, BoundingVolumeChannel::AABBSphere);
+
+    for (int i = 0; i < 100; i++)
+    {
+        BoundingVolumes bv;
+        bv.SetFromAABB(Vector3f(-1, -1, -1), Vector3f(1, 1, 1));
+        storage.Add(bv);
+    }
+
+    std::cout << "OBB arrays empty: " << (storage.obbCenters.empty() ? "YES" : "NO") << std::endl;
+    std::cout << "Data consistency: " << (storage.ValidateConsistency() ? "OK" : "FAILED") << std::endl;
+
+    // 世界矩阵：每个元素沿 X 平移 i
+    std::vector<Matrix4f> world(100);
+    for (int i = 0; i < 100; i++)
+        world[i] = glm::translate(Matrix4f(1.0f), Vector3f(float(i), 0, 0));
+
+    // 只有 3 个元素变化
+    storage.MarkDirty(5);
+    storage.MarkDirty(70);
+    storage.MarkDirty(99);
+    std::cout << "Dirty count: " << storage.GetDirtyCount() << " (expected 3)" << std::endl;
+
+    size_t rebuilt = storage.RecomputeDirty(world.data());
+    std::cout << "Rebuilt: " << rebuilt << " (expected 3)" << std::endl;
+
+    BoundingVolumes bv;
+    storage.Get(70, bv);
+    std::cout << "BV[70] AABB center: (" << bv.aabb.GetCenter().x << ", ...) (expected 70)" << std::endl;
+    std::cout << "BV[70] sphere center: (" << bv.bsphere.GetCenter().x << ", ...) (expected 70)" << std::endl;
+
+    storage.Get(6, bv);
+    std::cout << "BV[6] AABB center: (" << bv.aabb.GetCenter().x << ", ...) (expected 0, not dirty)" << std::endl;
+
+    // 修改本地包围体后重建
+    BoundingVolumes local;
+    local.SetFromAABB(Vector3f(0, 0, 0), Vector3f(2, 2, 2));
+    storage.SetLocal(6, local);
+    storage.RecomputeDirty(world.data());
+    storage.Get(6, bv);
+    std::cout << "BV[6] after SetLocal AABB min: (" << bv.aabb.GetMin().x << ", ...) (expected 6)" << std::endl;
+
+    // 点集只计算需要的通道(跳过 OBB 拟合)
+    const float pts[] = { 0,0,0, 1,0,0, 0,1,0, 0,0,1, 1,1,1 };
+    BoundingVolumes from_points;
+    from_points.SetFromPoints(pts, 5, 3, BoundingVolumeChannel::AABBSphere);
+    std::cout << "SetFromPoints(AABB+Sphere) AABB size: (" << from_points.aabb.GetLength().x << ", "
+              << from_points.aabb.GetLength().y << ", " << from_points.aabb.GetLength().z << ")" << std::endl;
+
+    storage.PrintStats();
+    std::cout << std::endl;
+}
+
+void TestParallelBatch()
+{
+    std::cout << "=== 测试并行批量操作 ===" << std::endl;
+
+    const size_t NUM = 20000;
+    BoundingVolumesDataStorage storage(NUM, BoundingVolumeChannel::AABBSphere);
+    std::vector<Matrix4f> world(NUM);
+
+    for (size_t i = 0; i < NUM; i++)
+    {
+        BoundingVolumes bv;
+        bv.SetFromAABB(Vector3f(-0.5f), Vector3f(0.5f));
+        storage.Add(bv);
+
+        world[i] = glm::translate(Matrix4f(1.0f), Vector3f(float(i % 200) - 100.0f, 0, -float(i / 200)));
+    }
+
+    ThreadParallelExecutor executor(4);
+
+    BoundingVolumesDataStorage serial_storage = storage;
+
+    BoundingVolumesBatch::TransformRange(storage, 0, NUM, world.data(), &executor);
+    BoundingVolumesBatch::TransformRange(serial_storage, 0, NUM, world.data(), nullptr);
+
+    BoundingVolumes a, b;
+    storage.Get(NUM - 1, a);
+    serial_storage.Get(NUM - 1, b);
+    std::cout << "Parallel == serial transform: " << (a.aabb.GetCenter() == b.aabb.GetCenter() ? "YES" : "NO") << std::endl;
+
+    BoundingVolumes merged;
+    BoundingVolumesBatch::MergeRange(storage, 0, NUM, merged, &executor);
+    std::cout << "Merged AABB min: (" << merged.aabb.GetMin().x << ", " << merged.aabb.GetMin().y << ", " << merged.aabb.GetMin().z
+              << ") max: (" << merged.aabb.GetMax().x << ", " << merged.aabb.GetMax().y << ", " << merged.aabb.GetMax().z << ")" << std::endl;
+
+    Matrix4f proj = glm::perspectiveRH_ZO(glm::radians(60.0f), 1.0f, 0.1f, 50.0f);
+    Frustum frustum(proj);
+
+    std::vector<uint32_t> visible_parallel, visible_serial;
+    BoundingVolumesBatch::FrustumCull(storage, 0, NUM, frustum, visible_parallel, &executor);
+    BoundingVolumesBatch::FrustumCull(storage, 0, NUM, frustum, visible_serial, nullptr);
+    std::cout << "Visible: " << visible_parallel.size() << " / " << NUM
+              << " (parallel == serial: " << (visible_parallel == visible_serial ? "YES" : "NO") << ")" << std::endl;
+
+    BoundingVolumesDataStorage survivors;
+    BoundingVolumesBatch::Gather(storage, visible_parallel.data(), visible_parallel.size(), survivors, &executor);
+    std::cout << "Survivors: " << survivors.GetCount()
+              << " consistency: " << (survivors.ValidateConsistency() ? "OK" : "FAILED") << std::endl;
+
+    std::cout << std::endl;
+}
+
 int main()
 {
     std::cout << "BoundingVolumesDataStorage 测试程序" << std::endl;
@@ -356,6 +466,8 @@ int main()
     TestCollisionDetection();
     TestTransformation();
     TestSwapAndRemove();
+    TestChannelsAndDirty();
+    TestParallelBatch();
     TestPerformance();
     CompareSOAvsAOS();
 
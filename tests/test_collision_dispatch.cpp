@@ -0,0 +1,286 @@
+﻿/**
+ * test_collision_dispatch.cpp
+ *
+ * Test cases for type bucketed batch collision dispatch
+ */
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <hgl/math/geometry/queries/CollisionDispatch.h>
+#include <hgl/math/geometry/queries/GJK.h>
+#include <hgl/math/ParallelFor.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Test Scene
+// ============================================================================
+
+struct TestScene
+{
+    std::vector<Sphere> spheres;
+    std::vector<Capsule> capsules;
+    std::vector<AABB> aabbs;
+    std::vector<OBB> obbs;
+    std::vector<Cone> cones;
+    std::vector<Triangle3f> triangles;
+
+    CollisionShapeSet set;
+
+    TestScene()
+    {
+        spheres.push_back(Sphere(Vector3f(0, 0, 0), 1.0f));
+        spheres.push_back(Sphere(Vector3f(1.5f, 0, 0), 1.0f));
+        spheres.push_back(Sphere(Vector3f(10, 0, 0), 0.5f));
+
+        capsules.push_back(Capsule(Vector3f(0, -2, 0), Vector3f(0, 2, 0), 0.5f));
+
+        AABB box;
+        box.SetMinMax(Vector3f(0.5f, -1, -1), Vector3f(2.5f, 1, 1));
+        aabbs.push_back(box);
+
+        obbs.push_back(OBB(Vector3f(0, 0, 1.2f), Vector3f(1, 1, 0.5f)));
+
+        cones.push_back(Cone(Vector3f(0, 3, 0), Vector3f(0, -1, 0), 2.0f, 1.0f));
+
+        triangles.push_back(Triangle3f(Vector3f(-2, 0.5f, -2), Vector3f(2, 0.5f, -2), Vector3f(0, 0.5f, 2)));
+
+        set.spheres = spheres.data();       set.sphere_count = spheres.size();
+        set.capsules = capsules.data();     set.capsule_count = capsules.size();
+        set.aabbs = aabbs.data();           set.aabb_count = aabbs.size();
+        set.obbs = obbs.data();             set.obb_count = obbs.size();
+        set.cones = cones.data();           set.cone_count = cones.size();
+        set.triangles = triangles.data();   set.triangle_count = triangles.size();
+    }
+};
+
+CollisionPair MakePair(ShapeType ta, uint32_t ia, ShapeType tb, uint32_t ib)
+{
+    CollisionPair pair;
+    pair.a.type = ta; pair.a.index = ia;
+    pair.b.type = tb; pair.b.index = ib;
+    return pair;
+}
+
+std::vector<CollisionPair> MakeMixedPairs()
+{
+    return {
+        MakePair(ShapeType::Sphere, 0, ShapeType::Sphere, 1),
+        MakePair(ShapeType::Sphere, 0, ShapeType::AABB, 0),
+        MakePair(ShapeType::Capsule, 0, ShapeType::Sphere, 2),
+        MakePair(ShapeType::Sphere, 1, ShapeType::Sphere, 2),
+        MakePair(ShapeType::Cone, 0, ShapeType::Capsule, 0),
+        MakePair(ShapeType::OBB, 0, ShapeType::Triangle, 0),
+        MakePair(ShapeType::Sphere, 2, ShapeType::AABB, 0),
+        MakePair(ShapeType::Triangle, 0, ShapeType::Sphere, 0),
+        MakePair(ShapeType::Sphere, 0, ShapeType::Sphere, 2),
+    };
+}
+
+// ============================================================================
+// Dispatch Tests
+// ============================================================================
+
+void test_dispatch_matches_per_pair() {
+    TestScene scene;
+    std::vector<CollisionPair> pairs = MakeMixedPairs();
+    std::vector<CollisionInfo> results(pairs.size());
+
+    CollisionDispatcher dispatcher;
+    dispatcher.Dispatch(scene.set, pairs.data(), pairs.size(), results.data());
+
+    // Analytic combination
+    CollisionInfo ss = CollisionDetector::TestCollision(scene.spheres[0], scene.spheres[1]);
+    ASSERT_TRUE(results[0].intersects);
+    ASSERT_NEAR(results[0].penetration, ss.penetration, 1e-5f);
+
+    // GJK combinations
+    CollisionInfo sb = GJK::TestCollision(scene.spheres[0], scene.aabbs[0]);
+    ASSERT_TRUE(results[1].intersects == sb.intersects);
+    ASSERT_NEAR(results[1].penetration, sb.penetration, 1e-5f);
+
+    ASSERT_FALSE(results[2].intersects);
+    ASSERT_FALSE(results[3].intersects);
+
+    CollisionInfo cc = GJK::TestCollision(scene.cones[0], scene.capsules[0]);
+    ASSERT_TRUE(results[4].intersects);
+    ASSERT_NEAR(results[4].penetration, cc.penetration, 1e-4f);
+
+    CollisionInfo ot = GJK::TestCollision(scene.obbs[0], scene.triangles[0]);
+    ASSERT_TRUE(results[5].intersects == ot.intersects);
+
+    ASSERT_FALSE(results[6].intersects);
+    ASSERT_TRUE(results[7].intersects);
+    ASSERT_FALSE(results[8].intersects);
+}
+
+void test_dispatch_intersects() {
+    TestScene scene;
+    std::vector<CollisionPair> pairs = MakeMixedPairs();
+    std::vector<uint8_t> results(pairs.size(), 0xFF);
+
+    CollisionDispatcher dispatcher;
+    dispatcher.DispatchIntersects(scene.set, pairs.data(), pairs.size(), results.data());
+
+    const uint8_t expected[] = {1, 1, 0, 0, 1, 1, 0, 1, 0};
+
+    for (size_t i = 0; i < pairs.size(); i++)
+        ASSERT_TRUE(results[i] == expected[i]);
+}
+
+// ============================================================================
+// Bucket Tests
+// ============================================================================
+
+void test_bucket_sizes() {
+    TestScene scene;
+    std::vector<CollisionPair> pairs = MakeMixedPairs();
+    std::vector<CollisionInfo> results(pairs.size());
+
+    CollisionDispatcher dispatcher;
+    dispatcher.Dispatch(scene.set, pairs.data(), pairs.size(), results.data());
+
+    ASSERT_TRUE(dispatcher.GetBucketSize(ShapeType::Sphere, ShapeType::Sphere) == 3);
+    ASSERT_TRUE(dispatcher.GetBucketSize(ShapeType::Sphere, ShapeType::AABB) == 2);
+    ASSERT_TRUE(dispatcher.GetBucketSize(ShapeType::AABB, ShapeType::Sphere) == 0);
+    ASSERT_TRUE(dispatcher.GetBucketSize(ShapeType::Cone, ShapeType::Capsule) == 1);
+    ASSERT_TRUE(dispatcher.GetActiveBucketCount() == 6);
+    ASSERT_TRUE(dispatcher.GetInvalidPairCount() == 0);
+
+    // Buffers are reused; a smaller second batch replaces the bucket layout
+    pairs.resize(1);
+    dispatcher.Dispatch(scene.set, pairs.data(), pairs.size(), results.data());
+
+    ASSERT_TRUE(dispatcher.GetBucketSize(ShapeType::Sphere, ShapeType::Sphere) == 1);
+    ASSERT_TRUE(dispatcher.GetBucketSize(ShapeType::Sphere, ShapeType::AABB) == 0);
+    ASSERT_TRUE(dispatcher.GetActiveBucketCount() == 1);
+}
+
+void test_invalid_pairs() {
+    TestScene scene;
+    std::vector<CollisionPair> pairs = {
+        MakePair(ShapeType::Sphere, 0, ShapeType::Sphere, 1),
+        MakePair(ShapeType::Sphere, 0, ShapeType::Sphere, 7),       // index out of range
+        MakePair(ShapeType::Torus, 0, ShapeType::Sphere, 0),        // no tori in the set
+    };
+    std::vector<CollisionInfo> results(pairs.size());
+    results[1].intersects = true;
+    results[2].intersects = true;
+
+    CollisionDispatcher dispatcher;
+    dispatcher.Dispatch(scene.set, pairs.data(), pairs.size(), results.data());
+
+    ASSERT_TRUE(dispatcher.GetInvalidPairCount() == 2);
+    ASSERT_TRUE(results[0].intersects);
+    ASSERT_FALSE(results[1].intersects);
+    ASSERT_FALSE(results[2].intersects);
+}
+
+// ============================================================================
+// Parallel Tests
+// ============================================================================
+
+void test_parallel_dispatch() {
+    TestScene scene;
+
+    // Many spheres on a line, each overlapping its neighbour, plus mixed pairs
+    std::vector<Sphere> spheres;
+    for (int i = 0; i < 200; i++)
+        spheres.push_back(Sphere(Vector3f(float(i) * 1.5f, 0, 0), 1.0f));
+
+    scene.set.spheres = spheres.data();
+    scene.set.sphere_count = spheres.size();
+
+    std::vector<CollisionPair> pairs;
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        const uint32_t a = i % 200;
+        const uint32_t b = (i * 7 + 1) % 200;
+
+        switch (i % 4)
+        {
+            case 0: pairs.push_back(MakePair(ShapeType::Sphere, a, ShapeType::Sphere, b)); break;
+            case 1: pairs.push_back(MakePair(ShapeType::Sphere, a, ShapeType::AABB, 0)); break;
+            case 2: pairs.push_back(MakePair(ShapeType::Capsule, 0, ShapeType::Sphere, a)); break;
+            case 3: pairs.push_back(MakePair(ShapeType::Sphere, a, ShapeType::OBB, 0)); break;
+        }
+    }
+
+    std::vector<CollisionInfo> serial(pairs.size());
+    std::vector<CollisionInfo> parallel(pairs.size());
+
+    CollisionDispatcher dispatcher;
+    dispatcher.Dispatch(scene.set, pairs.data(), pairs.size(), serial.data());
+
+    ThreadParallelExecutor executor(4);
+    dispatcher.Dispatch(scene.set, pairs.data(), pairs.size(), parallel.data(), &executor);
+
+    for (size_t i = 0; i < pairs.size(); i++)
+    {
+        ASSERT_TRUE(serial[i].intersects == parallel[i].intersects);
+        ASSERT_NEAR(serial[i].penetration, parallel[i].penetration, 1e-6f);
+    }
+
+    std::vector<uint8_t> overlap(pairs.size());
+    dispatcher.DispatchIntersects(scene.set, pairs.data(), pairs.size(), overlap.data(), &executor);
+
+    for (size_t i = 0; i < pairs.size(); i++)
+        ASSERT_TRUE((overlap[i] != 0) == serial[i].intersects);
+}
+
+void test_empty_batch() {
+    TestScene scene;
+    CollisionPair pair = MakePair(ShapeType::Sphere, 0, ShapeType::Sphere, 1);
+    CollisionInfo info;
+
+    CollisionDispatcher dispatcher;
+    dispatcher.Dispatch(scene.set, &pair, 0, &info);
+
+    ASSERT_TRUE(dispatcher.GetActiveBucketCount() == 0);
+    ASSERT_FALSE(info.intersects);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::cout << "=== Collision Dispatch Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Dispatch Tests ---" << std::endl;
+    TEST(dispatch_matches_per_pair);
+    TEST(dispatch_intersects);
+
+    std::cout << std::endl << "--- Bucket Tests ---" << std::endl;
+    TEST(bucket_sizes);
+    TEST(invalid_pairs);
+    TEST(empty_batch);
+
+    std::cout << std::endl << "--- Parallel Tests ---" << std::endl;
+    TEST(parallel_dispatch);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
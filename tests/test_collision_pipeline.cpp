@@ -0,0 +1,263 @@
+﻿/**
+ * test_collision_pipeline.cpp
+ *
+ * Test cases for the broadphase to narrowphase collision pipeline
+ */
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <set>
+#include <utility>
+#include <vector>
+#include <hgl/math/geometry/queries/CollisionPipeline.h>
+#include <hgl/math/ParallelFor.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Deterministic pseudo random scene of spheres
+std::vector<Sphere> MakeSphereField(int count, float extent, float radius)
+{
+    std::vector<Sphere> spheres;
+    uint32_t seed = 12345;
+
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return float(seed >> 8) / float(1u << 24);
+    };
+
+    for (int i = 0; i < count; i++)
+        spheres.push_back(Sphere(Vector3f(next() * extent, next() * extent, next() * extent), radius * (0.5f + next())));
+
+    return spheres;
+}
+
+std::vector<ShapeRef> MakeProxies(ShapeType type, size_t count)
+{
+    std::vector<ShapeRef> proxies(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        proxies[i].type = type;
+        proxies[i].index = uint32_t(i);
+    }
+
+    return proxies;
+}
+
+std::set<std::pair<uint32_t, uint32_t>> BruteForceContacts(const std::vector<Sphere> &spheres)
+{
+    std::set<std::pair<uint32_t, uint32_t>> result;
+
+    for (uint32_t i = 0; i < spheres.size(); i++)
+        for (uint32_t j = i + 1; j < spheres.size(); j++)
+            if (CollisionDetector::Intersects(spheres[i], spheres[j]))
+                result.insert({i, j});
+
+    return result;
+}
+
+// ============================================================================
+// Broadphase Tests
+// ============================================================================
+
+void test_pairs_are_unique() {
+    std::vector<Sphere> spheres = MakeSphereField(500, 20.0f, 0.6f);
+    std::vector<ShapeRef> proxies = MakeProxies(ShapeType::Sphere, spheres.size());
+
+    CollisionShapeSet shapes;
+    shapes.spheres = spheres.data();
+    shapes.sphere_count = spheres.size();
+
+    CollisionPipeline pipeline;
+    const std::vector<ProxyPair> &pairs = pipeline.FindPairs(shapes, proxies.data(), proxies.size());
+
+    std::set<std::pair<uint32_t, uint32_t>> unique;
+    for (const ProxyPair &p : pairs)
+    {
+        ASSERT_TRUE(p.a < p.b);
+        unique.insert({p.a, p.b});
+    }
+
+    ASSERT_TRUE(unique.size() == pairs.size());
+    ASSERT_TRUE(pipeline.GetStats().broadphase_pair_count == pairs.size());
+    ASSERT_TRUE(pipeline.GetStats().proxy_count == 500);
+    ASSERT_TRUE(pipeline.GetStats().occupied_cell_count > 1);
+
+    // The grid must test far fewer pairs than brute force
+    ASSERT_TRUE(pipeline.GetStats().broadphase_test_count < 500u * 499u / 2u / 4u);
+}
+
+void test_matches_brute_force() {
+    std::vector<Sphere> spheres = MakeSphereField(400, 15.0f, 0.7f);
+    std::vector<ShapeRef> proxies = MakeProxies(ShapeType::Sphere, spheres.size());
+
+    CollisionShapeSet shapes;
+    shapes.spheres = spheres.data();
+    shapes.sphere_count = spheres.size();
+
+    CollisionPipeline pipeline;
+    const std::vector<CollisionContact> &contacts = pipeline.Run(shapes, proxies.data(), proxies.size());
+
+    std::set<std::pair<uint32_t, uint32_t>> found;
+    for (const CollisionContact &c : contacts)
+    {
+        ASSERT_TRUE(c.info.intersects);
+        found.insert({c.proxy_a, c.proxy_b});
+    }
+
+    ASSERT_TRUE(found == BruteForceContacts(spheres));
+    ASSERT_TRUE(pipeline.GetStats().contact_count == contacts.size());
+    ASSERT_TRUE(pipeline.GetStats().contact_count <= pipeline.GetStats().broadphase_pair_count);
+}
+
+void test_oversized_proxies() {
+    std::vector<Sphere> spheres = MakeSphereField(100, 10.0f, 0.3f);
+    spheres.push_back(Sphere(Vector3f(5, 5, 5), 4.0f));        // covers most of the grid
+    spheres.push_back(Sphere(Vector3f(6, 5, 5), 4.0f));        // overlaps the other big sphere
+
+    std::vector<ShapeRef> proxies = MakeProxies(ShapeType::Sphere, spheres.size());
+
+    CollisionShapeSet shapes;
+    shapes.spheres = spheres.data();
+    shapes.sphere_count = spheres.size();
+
+    CollisionPipeline pipeline(0.5f, 64);
+    const std::vector<CollisionContact> &contacts = pipeline.Run(shapes, proxies.data(), proxies.size());
+
+    ASSERT_TRUE(pipeline.GetStats().oversized_proxy_count == 2);
+
+    std::set<std::pair<uint32_t, uint32_t>> found;
+    for (const CollisionContact &c : contacts)
+        found.insert({c.proxy_a, c.proxy_b});
+
+    ASSERT_TRUE(found.size() == contacts.size());
+    ASSERT_TRUE(found == BruteForceContacts(spheres));
+}
+
+void test_mixed_shapes_and_invalid() {
+    std::vector<Sphere> spheres = { Sphere(Vector3f(0, 0, 0), 1.0f), Sphere(Vector3f(10, 0, 0), 1.0f) };
+    std::vector<OBB> obbs = { OBB(Vector3f(1.5f, 0, 0), Vector3f(1, 1, 1)) };
+    std::vector<Capsule> capsules = { Capsule(Vector3f(10, -3, 0), Vector3f(10, 3, 0), 0.5f) };
+
+    CollisionShapeSet shapes;
+    shapes.spheres = spheres.data();    shapes.sphere_count = spheres.size();
+    shapes.obbs = obbs.data();          shapes.obb_count = obbs.size();
+    shapes.capsules = capsules.data();  shapes.capsule_count = capsules.size();
+
+    std::vector<ShapeRef> proxies(5);
+    proxies[0] = {ShapeType::Sphere, 0};
+    proxies[1] = {ShapeType::OBB, 0};
+    proxies[2] = {ShapeType::Sphere, 1};
+    proxies[3] = {ShapeType::Capsule, 0};
+    proxies[4] = {ShapeType::Sphere, 9};       // invalid
+
+    CollisionPipeline pipeline;
+    const std::vector<CollisionContact> &contacts = pipeline.Run(shapes, proxies.data(), proxies.size());
+
+    ASSERT_TRUE(pipeline.GetStats().proxy_count == 4);
+    ASSERT_TRUE(contacts.size() == 2);
+    ASSERT_TRUE(contacts[0].proxy_a == 0 && contacts[0].proxy_b == 1);
+    ASSERT_TRUE(contacts[1].proxy_a == 2 && contacts[1].proxy_b == 3);
+    ASSERT_TRUE(contacts[0].info.penetration > 0.0f);
+}
+
+// ============================================================================
+// Parallel Tests
+// ============================================================================
+
+void test_parallel_matches_serial() {
+    std::vector<Sphere> spheres = MakeSphereField(3000, 40.0f, 0.8f);
+    std::vector<ShapeRef> proxies = MakeProxies(ShapeType::Sphere, spheres.size());
+
+    CollisionShapeSet shapes;
+    shapes.spheres = spheres.data();
+    shapes.sphere_count = spheres.size();
+
+    CollisionPipeline serial;
+    serial.Run(shapes, proxies.data(), proxies.size());
+
+    ThreadParallelExecutor executor(4);
+    CollisionPipeline parallel;
+
+    // Run twice so the second frame reuses the buffers
+    parallel.Run(shapes, proxies.data(), proxies.size(), &executor);
+    parallel.Run(shapes, proxies.data(), proxies.size(), &executor);
+
+    const std::vector<CollisionContact> &a = serial.GetContacts();
+    const std::vector<CollisionContact> &b = parallel.GetContacts();
+
+    ASSERT_TRUE(a.size() == b.size());
+    ASSERT_TRUE(a.size() > 0);
+
+    // Output order does not depend on the thread count
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        ASSERT_TRUE(a[i].proxy_a == b[i].proxy_a);
+        ASSERT_TRUE(a[i].proxy_b == b[i].proxy_b);
+        ASSERT_NEAR(a[i].info.penetration, b[i].info.penetration, 1e-6f);
+    }
+
+    ASSERT_TRUE(serial.GetStats().broadphase_test_count == parallel.GetStats().broadphase_test_count);
+}
+
+void test_empty_and_single() {
+    CollisionShapeSet shapes;
+    CollisionPipeline pipeline;
+
+    ASSERT_TRUE(pipeline.Run(shapes, nullptr, 0).empty());
+
+    Sphere sphere(Vector3f(0, 0, 0), 1.0f);
+    shapes.spheres = &sphere;
+    shapes.sphere_count = 1;
+
+    ShapeRef proxy = {ShapeType::Sphere, 0};
+    ASSERT_TRUE(pipeline.Run(shapes, &proxy, 1).empty());
+    ASSERT_TRUE(pipeline.GetStats().proxy_count == 1);
+    ASSERT_TRUE(pipeline.GetStats().broadphase_pair_count == 0);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::cout << "=== Collision Pipeline Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Broadphase Tests ---" << std::endl;
+    TEST(pairs_are_unique);
+    TEST(matches_brute_force);
+    TEST(oversized_proxies);
+    TEST(mixed_shapes_and_invalid);
+    TEST(empty_and_single);
+
+    std::cout << std::endl << "--- Parallel Tests ---" << std::endl;
+    TEST(parallel_matches_serial);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,263 @@
+﻿/**
+ * test_contact_manifold.cpp
+ *
+ * Test cases for multi-point contact manifolds and the persistent manifold cache
+ */
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <hgl/math/geometry/queries/ContactManifold.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+static ConvexHull MakeBoxHull(const Vector3f &center, const Vector3f &half)
+{
+    Vector3f pts[8];
+
+    for (int i = 0; i < 8; i++)
+        pts[i] = center + Vector3f((i & 1) ? half.x : -half.x, (i & 2) ? half.y : -half.y, (i & 4) ? half.z : -half.z);
+
+    return ConvexHull(pts, 8);
+}
+
+// ============================================================================
+// OBB-OBB Tests
+// ============================================================================
+
+void test_obb_obb_separated() {
+    OBB a(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    OBB b(Vector3f(0, 3, 0), Vector3f(1, 1, 1));
+
+    ContactManifold m;
+    ASSERT_FALSE(ContactManifoldQuery::Generate(a, b, m));
+    ASSERT_TRUE(m.IsEmpty());
+}
+
+void test_obb_obb_stacked() {
+    // Small box resting on a big one: four corner contacts
+    OBB ground(Vector3f(0, -1, 0), Vector3f(5, 1, 5));
+    OBB box(Vector3f(0.3f, 0.45f, 0.2f), Vector3f(0.5f, 0.5f, 0.5f));
+
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(ground, box, m));
+    ASSERT_TRUE(m.count == 4);
+    ASSERT_NEAR(m.normal.y, 1.0f, 1e-4f);
+
+    for (uint32_t i = 0; i < m.count; i++)
+    {
+        ASSERT_NEAR(m.points[i].penetration, 0.05f, 1e-4f);
+        ASSERT_NEAR(m.points[i].point_b.y, -0.05f, 1e-4f);
+        ASSERT_NEAR(m.points[i].point_a.y, 0.0f, 1e-4f);
+    }
+}
+
+void test_obb_obb_partial_overlap() {
+    // Box hanging over the edge: contact region clipped to the reference face
+    OBB ground(Vector3f(0, -1, 0), Vector3f(1, 1, 1));
+    OBB box(Vector3f(1.0f, 0.45f, 0.0f), Vector3f(0.5f, 0.5f, 0.5f));
+
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(ground, box, m));
+    ASSERT_TRUE(m.count == 4);
+
+    for (uint32_t i = 0; i < m.count; i++)
+        ASSERT_TRUE(m.points[i].point_b.x <= 1.0f + 1e-4f);
+}
+
+void test_obb_obb_rotated_edge() {
+    // Box rotated 45 degrees about Z resting on its edge
+    const float s = std::sqrt(0.5f);
+    OBB ground(Vector3f(0, -1, 0), Vector3f(5, 1, 5));
+    OBB box(Vector3f(0, s - 0.02f, 0), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(0.5f, 0.5f, 0.5f));
+
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(ground, box, m));
+    ASSERT_TRUE(m.count == 2);
+    ASSERT_NEAR(m.normal.y, 1.0f, 1e-3f);
+    ASSERT_NEAR(m.points[0].penetration, 0.02f, 1e-3f);
+}
+
+// ============================================================================
+// Capsule-OBB Tests
+// ============================================================================
+
+void test_capsule_obb_lying() {
+    OBB ground(Vector3f(0, -1, 0), Vector3f(5, 1, 5));
+    Capsule capsule(Vector3f(-1, 0.45f, 0), Vector3f(1, 0.45f, 0), 0.5f);
+
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(capsule, ground, m));
+    ASSERT_TRUE(m.count == 2);
+    ASSERT_NEAR(m.normal.y, -1.0f, 1e-4f);
+
+    for (uint32_t i = 0; i < m.count; i++)
+    {
+        ASSERT_NEAR(m.points[i].penetration, 0.05f, 1e-4f);
+        ASSERT_NEAR(std::abs(m.points[i].point_a.x), 1.0f, 1e-4f);
+    }
+
+    // Reversed order flips the normal
+    ContactManifold flipped;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(ground, capsule, flipped));
+    ASSERT_NEAR(flipped.normal.y, 1.0f, 1e-4f);
+}
+
+void test_capsule_obb_standing() {
+    OBB ground(Vector3f(0, -1, 0), Vector3f(5, 1, 5));
+    Capsule capsule(Vector3f(0, 0.4f, 0), Vector3f(0, 2, 0), 0.5f);
+
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(capsule, ground, m));
+    ASSERT_TRUE(m.count == 1);
+    ASSERT_NEAR(m.points[0].penetration, 0.1f, 1e-4f);
+}
+
+// ============================================================================
+// Convex-Convex Tests
+// ============================================================================
+
+void test_convex_hull_stack() {
+    ConvexHull ground = MakeBoxHull(Vector3f(0, -1, 0), Vector3f(5, 1, 5));
+    ConvexHull box = MakeBoxHull(Vector3f(0, 0.45f, 0), Vector3f(0.5f, 0.5f, 0.5f));
+
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(ground, box, m));
+    ASSERT_TRUE(m.count == 4);
+    ASSERT_NEAR(m.normal.y, 1.0f, 1e-3f);
+
+    for (uint32_t i = 0; i < m.count; i++)
+        ASSERT_NEAR(m.points[i].penetration, 0.05f, 1e-3f);
+}
+
+void test_convex_sphere_single_point() {
+    Sphere sphere(Vector3f(0, 0.9f, 0), 1.0f);
+    OBB ground(Vector3f(0, -1, 0), Vector3f(5, 1, 5));
+
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(sphere, ground, m));
+    ASSERT_TRUE(m.count == 1);
+    ASSERT_NEAR(m.points[0].penetration, 0.1f, 1e-2f);
+}
+
+void test_reduce_contacts() {
+    ContactPoint candidates[8];
+
+    for (int i = 0; i < 8; i++)
+    {
+        const float angle = float(i) * 3.14159265f / 4.0f;
+        candidates[i].point_b = Vector3f(std::cos(angle), 0, std::sin(angle));
+        candidates[i].penetration = (i == 3) ? 0.2f : 0.1f;
+    }
+
+    ContactPoint out[4];
+    ASSERT_TRUE(ContactManifoldQuery::ReduceContacts(candidates, 8, Vector3f(0, 1, 0), out) == 4);
+    ASSERT_NEAR(out[0].penetration, 0.2f, 1e-6f);
+
+    // Deepest point plus its opposite point are kept
+    ASSERT_NEAR(out[1].point_b.x, candidates[7].point_b.x, 1e-5f);
+    ASSERT_NEAR(out[1].point_b.z, candidates[7].point_b.z, 1e-5f);
+}
+
+// ============================================================================
+// Persistent Cache Tests
+// ============================================================================
+
+void test_cache_inherits_impulses() {
+    OBB ground(Vector3f(0, -1, 0), Vector3f(5, 1, 5));
+    OBB box(Vector3f(0, 0.45f, 0), Vector3f(0.5f, 0.5f, 0.5f));
+
+    ContactManifoldCache cache;
+    const uint64_t id = ContactManifoldCache::MakePairID(7, 3);
+    ASSERT_TRUE(id == ContactManifoldCache::MakePairID(3, 7));
+
+    cache.NewFrame();
+    ContactManifold fresh;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(ground, box, fresh));
+
+    ContactManifold &first = cache.Update(id, fresh);
+    for (uint32_t i = 0; i < first.count; i++)
+        first.points[i].normal_impulse = float(i + 1);
+
+    // Next frame: box moved slightly, contacts persist
+    cache.NewFrame();
+    OBB moved(Vector3f(0.005f, 0.45f, 0), Vector3f(0.5f, 0.5f, 0.5f));
+    ASSERT_TRUE(ContactManifoldQuery::Generate(ground, moved, fresh));
+
+    const ContactManifold &second = cache.Update(id, fresh);
+    ASSERT_TRUE(second.count == 4);
+
+    for (uint32_t i = 0; i < second.count; i++)
+    {
+        ASSERT_TRUE(second.points[i].lifetime == 1);
+        ASSERT_TRUE(second.points[i].normal_impulse > 0.0f);
+    }
+
+    ASSERT_TRUE(cache.Find(id) != nullptr);
+    ASSERT_TRUE(cache.RemoveStale() == 0);
+
+    // Pair not touched for a frame gets dropped
+    cache.NewFrame();
+    ASSERT_TRUE(cache.Find(id) == nullptr);
+    ASSERT_TRUE(cache.RemoveStale() == 1);
+    ASSERT_TRUE(cache.GetCount() == 0);
+}
+
+void test_cache_gjk_warm_start() {
+    ConvexHull a = MakeBoxHull(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    ConvexHull b = MakeBoxHull(Vector3f(0, 1.9f, 0), Vector3f(1, 1, 1));
+
+    ContactManifoldCache cache;
+    const uint64_t id = ContactManifoldCache::MakePairID(1, 2);
+
+    cache.NewFrame();
+    ContactManifold m;
+    ASSERT_TRUE(ContactManifoldQuery::Generate(a, b, m, cache.GetGJKCache(id)));
+    ASSERT_TRUE(cache.GetGJKCache(id)->count > 0);
+}
+
+int main() {
+    std::cout << "=== Contact Manifold Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- OBB-OBB Tests ---" << std::endl;
+    TEST(obb_obb_separated);
+    TEST(obb_obb_stacked);
+    TEST(obb_obb_partial_overlap);
+    TEST(obb_obb_rotated_edge);
+
+    std::cout << std::endl << "--- Capsule-OBB Tests ---" << std::endl;
+    TEST(capsule_obb_lying);
+    TEST(capsule_obb_standing);
+
+    std::cout << std::endl << "--- Convex-Convex Tests ---" << std::endl;
+    TEST(convex_hull_stack);
+    TEST(convex_sphere_single_point);
+    TEST(reduce_contacts);
+
+    std::cout << std::endl << "--- Persistent Cache Tests ---" << std::endl;
+    TEST(cache_inherits_impulses);
+    TEST(cache_gjk_warm_start);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
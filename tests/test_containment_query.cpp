@@ -12,6 +12,10 @@
 #include <hgl/math/geometry/primitives/Sphere.h>
 #include <hgl/math/geometry/primitives/Capsule.h>
 #include <hgl/math/geometry/AABB.h>
+#include <hgl/math/geometry/OBB.h>
+#include <hgl/math/geometry/BatchQueryStructures.h>
+#include <hgl/math/ParallelFor.h>
+#include <algorithm>
 
 using namespace hgl::math;
 
@@ -288,6 +292,257 @@ void test_multiple_points_in_sphere() {
     ASSERT_FALSE(ContainmentQuery::Contains(sphere, Vector3f(0, 3, 0)));
 }
 
+// ============================================================================
+// Batch Classification Tests
+// ============================================================================
+
+static float NextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return float(state >> 8) / float(1u << 24) * 8.0f - 4.0f;    // [-4,4)
+}
+
+struct RandomObjects {
+    BatchPointSOA points;
+    BatchSphereSOA spheres;
+    BatchAABBSOA boxes;
+    std::vector<Sphere> sphere_list;
+    std::vector<AABB> box_list;
+};
+
+static RandomObjects MakeRandomObjects(size_t count, uint32_t seed) {
+    RandomObjects objects;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3f c(NextRandom(seed), NextRandom(seed), NextRandom(seed));
+        const Vector3f e(std::abs(NextRandom(seed)) * 0.2f, std::abs(NextRandom(seed)) * 0.2f, std::abs(NextRandom(seed)) * 0.2f);
+        const float r = std::abs(NextRandom(seed)) * 0.2f;
+
+        objects.points.Add(c);
+        objects.spheres.Add(c, r);
+        objects.sphere_list.emplace_back(c, r);
+
+        AABB box;
+        box.SetMinMax(c - e, c + e);
+        objects.boxes.Add(box.GetMin(), box.GetMax());
+        objects.box_list.push_back(box);
+    }
+
+    return objects;
+}
+
+static float BoxDistance(const AABB& box, const Vector3f& p) {
+    return Length(p - glm::clamp(p, box.GetMin(), box.GetMax()));
+}
+
+static bool AllCorners(const AABB& box, bool (*inside)(const void*, const Vector3f&), const void* container) {
+    Vector3f corners[8];
+    box.GetCorners(corners);
+
+    for (int i = 0; i < 8; ++i)
+        if (!inside(container, corners[i]))
+            return false;
+
+    return true;
+}
+
+static ContainmentState Expected(bool inside, bool outside) {
+    return inside ? ContainmentState::Inside : (outside ? ContainmentState::Outside : ContainmentState::Intersecting);
+}
+
+void test_containment_results_packing() {
+    BatchContainmentResults results;
+    results.Resize(7);
+
+    ASSERT_TRUE(results.states.size() == 2);
+    ASSERT_TRUE(results.Count(ContainmentState::Outside) == 7);
+
+    results.Set(0, ContainmentState::Inside);
+    results.Set(3, ContainmentState::Intersecting);
+    results.Set(4, ContainmentState::Inside);
+    results.Set(6, ContainmentState::Intersecting);
+    results.Set(4, ContainmentState::Outside);
+
+    ASSERT_TRUE(results.Get(0) == ContainmentState::Inside);
+    ASSERT_TRUE(results.Get(1) == ContainmentState::Outside);
+    ASSERT_TRUE(results.Get(3) == ContainmentState::Intersecting);
+    ASSERT_TRUE(results.Get(4) == ContainmentState::Outside);
+    ASSERT_TRUE(results.Get(6) == ContainmentState::Intersecting);
+    ASSERT_TRUE(results.Count(ContainmentState::Intersecting) == 2);
+    ASSERT_TRUE(results.Count(ContainmentState::Inside) == 1);
+}
+
+void test_classify_aabb_and_sphere_container() {
+    const RandomObjects objects = MakeRandomObjects(3000, 11);
+
+    AABB box;
+    box.SetMinMax(Vector3f(-2, -1.5f, -1), Vector3f(2, 1.5f, 2.5f));
+    Sphere sphere(Vector3f(0.5f, -0.5f, 0), 2.5f);
+
+    BatchContainmentResults points, spheres, boxes;
+
+    ContainmentQuery::Classify(box, objects.points, points);
+    ContainmentQuery::Classify(box, objects.spheres, spheres);
+    ContainmentQuery::Classify(box, objects.boxes, boxes);
+
+    for (size_t i = 0; i < objects.points.count; ++i) {
+        const Sphere& s = objects.sphere_list[i];
+        const AABB& b = objects.box_list[i];
+
+        ASSERT_TRUE(points.Get(i) == Expected(box.ContainsPoint(s.GetCenter()), !box.ContainsPoint(s.GetCenter())));
+        ASSERT_TRUE(spheres.Get(i) == Expected(ContainmentQuery::Contains(box, s), BoxDistance(box, s.GetCenter()) > s.GetRadius()));
+        ASSERT_TRUE(boxes.Get(i) == Expected(ContainmentQuery::Contains(box, b), !box.Intersects(b)));
+    }
+
+    ContainmentQuery::Classify(sphere, objects.points, points);
+    ContainmentQuery::Classify(sphere, objects.spheres, spheres);
+    ContainmentQuery::Classify(sphere, objects.boxes, boxes);
+
+    auto in_sphere = [](const void* c, const Vector3f& p) { return static_cast<const Sphere*>(c)->ContainsPoint(p); };
+
+    for (size_t i = 0; i < objects.points.count; ++i) {
+        const Sphere& s = objects.sphere_list[i];
+        const AABB& b = objects.box_list[i];
+
+        ASSERT_TRUE(points.Get(i) == Expected(sphere.ContainsPoint(s.GetCenter()), !sphere.ContainsPoint(s.GetCenter())));
+        ASSERT_TRUE(spheres.Get(i) == Expected(ContainmentQuery::Contains(sphere, s),
+                                               Length(s.GetCenter() - sphere.GetCenter()) > sphere.GetRadius() + s.GetRadius()));
+        ASSERT_TRUE(boxes.Get(i) == Expected(AllCorners(b, in_sphere, &sphere), BoxDistance(b, sphere.GetCenter()) > sphere.GetRadius()));
+    }
+
+    ASSERT_TRUE(boxes.Count(ContainmentState::Inside) > 0);
+    ASSERT_TRUE(boxes.Count(ContainmentState::Intersecting) > 0);
+    ASSERT_TRUE(boxes.Count(ContainmentState::Outside) > 0);
+}
+
+void test_classify_obb_container() {
+    const RandomObjects objects = MakeRandomObjects(3000, 23);
+
+    const Vector3f x = Normalized(Vector3f(1, 1, 0.3f));
+    const Vector3f y = Normalized(Cross(Vector3f(0, 0, 1), x));
+    const Vector3f z = Cross(x, y);
+    OBB obb(Vector3f(0.3f, 0, -0.2f), x, y, z, Vector3f(2.5f, 1.0f, 1.5f));
+
+    BatchContainmentResults points, spheres, boxes;
+
+    ContainmentQuery::Classify(obb, objects.points, points);
+    ContainmentQuery::Classify(obb, objects.spheres, spheres);
+    ContainmentQuery::Classify(obb, objects.boxes, boxes);
+
+    for (size_t i = 0; i < objects.points.count; ++i) {
+        const Sphere& s = objects.sphere_list[i];
+        const AABB& b = objects.box_list[i];
+        const Vector3f local = s.GetCenter() - obb.GetCenter();
+
+        ASSERT_TRUE(points.Get(i) == Expected(obb.ContainsPoint(s.GetCenter()), !obb.ContainsPoint(s.GetCenter())));
+
+        const bool sphere_inside = std::abs(Dot(local, x)) + s.GetRadius() <= 2.5f
+                                && std::abs(Dot(local, y)) + s.GetRadius() <= 1.0f
+                                && std::abs(Dot(local, z)) + s.GetRadius() <= 1.5f;
+        const bool sphere_outside = Length(s.GetCenter() - obb.ClosestPoint(s.GetCenter())) > s.GetRadius();
+        ASSERT_TRUE(spheres.Get(i) == Expected(sphere_inside, sphere_outside));
+
+        const OBB as_obb(b.GetCenter(), b.GetLength() * 0.5f);
+        ASSERT_TRUE(boxes.Get(i) == Expected(ContainmentQuery::Contains(obb, b), !obb.Intersects(as_obb)));
+    }
+
+    ASSERT_TRUE(boxes.Count(ContainmentState::Inside) > 0);
+    ASSERT_TRUE(boxes.Count(ContainmentState::Intersecting) > 0);
+    ASSERT_TRUE(boxes.Count(ContainmentState::Outside) > 0);
+}
+
+void test_classify_capsule_container() {
+    const RandomObjects objects = MakeRandomObjects(2000, 37);
+
+    Capsule capsule(Vector3f(-2, -1, 0.5f), Vector3f(2, 1, -0.5f), 1.2f);
+    const Vector3f a = capsule.GetStart();
+    const Vector3f ab = capsule.GetEnd() - a;
+
+    BatchContainmentResults points, spheres, boxes;
+
+    ContainmentQuery::Classify(capsule, objects.points, points);
+    ContainmentQuery::Classify(capsule, objects.spheres, spheres);
+    ContainmentQuery::Classify(capsule, objects.boxes, boxes);
+
+    auto in_capsule = [](const void* c, const Vector3f& p) { return static_cast<const Capsule*>(c)->ContainsPoint(p); };
+
+    for (size_t i = 0; i < objects.points.count; ++i) {
+        const Sphere& s = objects.sphere_list[i];
+        const AABB& b = objects.box_list[i];
+
+        ASSERT_TRUE(points.Get(i) == Expected(capsule.ContainsPoint(s.GetCenter()), !capsule.ContainsPoint(s.GetCenter())));
+
+        // Spheres: compare against the six axis-extreme surface points
+        const ContainmentState state = spheres.Get(i);
+        for (int k = 0; k < 6; ++k) {
+            Vector3f offset(0, 0, 0);
+            offset[k / 2] = (k & 1) ? s.GetRadius() : -s.GetRadius();
+
+            if (state == ContainmentState::Inside)
+                ASSERT_TRUE(capsule.ContainsPoint(s.GetCenter() + offset));
+            if (state == ContainmentState::Outside)
+                ASSERT_FALSE(capsule.ContainsPoint(s.GetCenter() + offset));
+        }
+
+        // Boxes: the segment-box distance, sampled densely, is an upper bound of the exact one
+        constexpr int SAMPLES = 2000;
+        float sampled = 1e30f;
+        for (int k = 0; k <= SAMPLES; ++k)
+            sampled = std::min(sampled, BoxDistance(b, a + ab * (float(k) / SAMPLES)));
+
+        const bool inside = AllCorners(b, in_capsule, &capsule);
+        ASSERT_TRUE((boxes.Get(i) == ContainmentState::Inside) == inside);
+
+        if (boxes.Get(i) == ContainmentState::Outside)
+            ASSERT_TRUE(sampled > capsule.GetRadius());
+        if (sampled > capsule.GetRadius() + Length(ab) / SAMPLES)
+            ASSERT_TRUE(boxes.Get(i) == ContainmentState::Outside);
+    }
+
+    // Exact cases
+    BatchSphereSOA probes;
+    probes.Add(Vector3f(0, 0, 0), 1.2f);           // touches the surface from inside
+    probes.Add(Vector3f(0, 0, 3), 0.5f);           // crosses the surface
+    probes.Add(Vector3f(5, 0, 0), 0.5f);           // beyond the end cap
+
+    ContainmentQuery::Classify(capsule, probes, spheres);
+    ASSERT_TRUE(spheres.count == 3);
+    ASSERT_TRUE(spheres.Get(0) == ContainmentState::Inside);
+    ASSERT_TRUE(spheres.Get(2) == ContainmentState::Outside);
+
+    BatchAABBSOA cubes;
+    cubes.Add(Vector3f(-0.3f, -0.3f, -0.3f), Vector3f(0.3f, 0.3f, 0.3f));
+    cubes.Add(Vector3f(0.5f, 0.5f, 0.5f), Vector3f(3, 3, 3));
+    cubes.Add(Vector3f(3.5f, 3.5f, 3.5f), Vector3f(4, 4, 4));
+
+    ContainmentQuery::Classify(capsule, cubes, boxes);
+    ASSERT_TRUE(boxes.Get(0) == ContainmentState::Inside);
+    ASSERT_TRUE(boxes.Get(1) == ContainmentState::Intersecting);
+    ASSERT_TRUE(boxes.Get(2) == ContainmentState::Outside);
+}
+
+void test_classify_parallel_matches_serial() {
+    const RandomObjects objects = MakeRandomObjects(100003, 4242);
+
+    const Vector3f x = Normalized(Vector3f(1, 2, 0.5f));
+    const Vector3f y = Normalized(Cross(Vector3f(0, 0, 1), x));
+    OBB obb(Vector3f(0, 0, 0), x, y, Cross(x, y), Vector3f(2, 1, 3));
+    Capsule capsule(Vector3f(-1, 0, 0), Vector3f(1, 2, 0), 1.5f);
+
+    ThreadParallelExecutor executor(4);
+    BatchContainmentResults serial, parallel;
+
+    ContainmentQuery::Classify(obb, objects.boxes, serial);
+    ContainmentQuery::Classify(obb, objects.boxes, parallel, &executor);
+    ASSERT_TRUE(serial.states == parallel.states);
+
+    ContainmentQuery::Classify(capsule, objects.spheres, serial);
+    ContainmentQuery::Classify(capsule, objects.spheres, parallel, &executor);
+    ASSERT_TRUE(serial.states == parallel.states);
+
+    // Padding bits past the last object stay Outside
+    ASSERT_TRUE((serial.states.back() >> ((serial.count % 4) * 2)) == 0);
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -334,6 +589,13 @@ int main() {
     TEST(nested_containment);
     TEST(multiple_points_in_sphere);
 
+    std::cout << std::endl << "--- Batch Classification Tests ---" << std::endl;
+    TEST(containment_results_packing);
+    TEST(classify_aabb_and_sphere_container);
+    TEST(classify_obb_container);
+    TEST(classify_capsule_container);
+    TEST(classify_parallel_matches_serial);
+
     std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
 
     return 0;
@@ -13,6 +13,14 @@
 #include <hgl/math/geometry/primitives/Capsule.h>
 #include <hgl/math/geometry/primitives/Cylinder.h>
 #include <hgl/math/geometry/AABB.h>
+#include <hgl/math/geometry/OBB.h>
+#include <hgl/math/geometry/Triangle.h>
+#include <hgl/math/geometry/primitives/Cone.h>
+#include <hgl/math/geometry/primitives/Torus.h>
+#include <hgl/math/geometry/BatchQueryStructures.h>
+#include <hgl/math/ParallelFor.h>
+#include <vector>
+#include <algorithm>
 
 using namespace hgl::math;
 
@@ -267,6 +275,454 @@ void test_distance_coincident_spheres() {
     ASSERT_NEAR(dist, 0.0f, 0.01f);
 }
 
+// ============================================================================
+// Batch Distance Tests
+// ============================================================================
+
+static float NextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return float(state >> 8) / float(1u << 24) * 8.0f - 4.0f;    // [-4,4)
+}
+
+static BatchPointSOA MakeRandomPoints(size_t count, uint32_t seed) {
+    BatchPointSOA points;
+    points.Reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const float x = NextRandom(seed);
+        const float y = NextRandom(seed);
+        const float z = NextRandom(seed);
+        points.Add(Vector3f(x, y, z));
+    }
+
+    return points;
+}
+
+// Clamp into the solid cylinder in its own frame
+static float SolidCylinderDistance(const Vector3f& p, const Cylinder& cylinder) {
+    const Vector3f d = p - cylinder.GetCenter();
+    const float h = Dot(d, cylinder.GetAxis());
+    const Vector3f radial = d - cylinder.GetAxis() * h;
+    const float q = Length(radial);
+
+    const float half = cylinder.GetHeight() * 0.5f;
+    Vector3f closest = cylinder.GetCenter() + cylinder.GetAxis() * std::max(-half, std::min(h, half));
+    if (q > cylinder.GetRadius())
+        closest += radial * (cylinder.GetRadius() / q);
+    else
+        closest += radial;
+
+    return Length(p - closest);
+}
+
+void test_batch_points_match_scalar() {
+    const BatchPointSOA points = MakeRandomPoints(1000, 12345);
+    std::vector<float> out(points.count);
+
+    Sphere sphere(Vector3f(0.5f, -0.5f, 1.0f), 1.5f);
+    Capsule capsule(Vector3f(-1, -1, 0), Vector3f(2, 1, 1), 0.75f);
+    AABB box;
+    box.SetMinMax(Vector3f(-1, -2, -0.5f), Vector3f(1.5f, 0.5f, 2));
+    const Vector3f a0 = Normalized(Vector3f(1, 1, 0));
+    const Vector3f a1 = Normalized(Vector3f(-1, 1, 1));
+    const Vector3f a2 = Cross(a0, a1);
+    OBB obb(Vector3f(0.5f, 0, -0.5f), a0, a1, a2, Vector3f(1.5f, 0.5f, 1));
+    Cylinder cylinder(Vector3f(0, 1, 0), Normalized(Vector3f(0, 1, 1)), 3.0f, 1.0f);
+    Torus torus(Vector3f(0, 0, 0), Vector3f(0, 0, 1), 2.0f, 0.5f);
+    const Vector3f t0(-2, -1, 0.5f), t1(2, -1.5f, -0.5f), t2(0.5f, 2.5f, 1);
+
+    DistanceQuery::Distance(points, sphere, out.data());
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_NEAR(out[i], DistanceQuery::Distance(points.Get(i), sphere), 1e-4f);
+
+    DistanceQuery::Distance(points, capsule, out.data());
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_NEAR(out[i], DistanceQuery::Distance(points.Get(i), capsule), 1e-4f);
+
+    DistanceQuery::Distance(points, box, out.data());
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_NEAR(out[i], DistanceQuery::Distance(points.Get(i), box), 1e-4f);
+
+    DistanceQuery::Distance(points, obb, out.data());
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_NEAR(out[i], obb.DistanceToPoint(points.Get(i)), 1e-4f);
+
+    DistanceQuery::Distance(points, cylinder, out.data());
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_NEAR(out[i], SolidCylinderDistance(points.Get(i), cylinder), 1e-4f);
+
+    DistanceQuery::Distance(points, torus, out.data());
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_NEAR(out[i], torus.DistanceToPoint(points.Get(i)), 1e-4f);
+
+    DistanceQuery::Distance(points, t0, t1, t2, out.data());
+    for (size_t i = 0; i < points.count; ++i) {
+        const Vector3f p = points.Get(i);
+        ASSERT_NEAR(out[i], Length(p - ClosestPointOnTriangle(p, t0, t1, t2)), 1e-4f);
+    }
+}
+
+void test_batch_cone_distance() {
+    // Apex at origin, opening along +Z, height 2, base radius 1
+    Cone cone(Vector3f(0, 0, 0), Vector3f(0, 0, 1), 2.0f, 1.0f);
+
+    BatchPointSOA points;
+    points.Add(Vector3f(0, 0, 1.5f));       // inside
+    points.Add(Vector3f(0, 0, 3));          // below the base center
+    points.Add(Vector3f(2, 0, 3));          // beyond the rim
+    points.Add(Vector3f(2, 0, 1));          // beside the slant: nearest (q,h)=(0.8,1.6)
+    points.Add(Vector3f(0, 0, -1));         // above the apex
+    points.Add(Vector3f(0, 0.5f, 1));       // exactly on the slant
+
+    float out[6];
+    DistanceQuery::Distance(points, cone, out);
+
+    ASSERT_NEAR(out[0], 0.0f, 1e-5f);
+    ASSERT_NEAR(out[1], 1.0f, 1e-5f);
+    ASSERT_NEAR(out[2], std::sqrt(2.0f), 1e-5f);
+    ASSERT_NEAR(out[3], std::sqrt(1.8f), 1e-5f);
+    ASSERT_NEAR(out[4], 1.0f, 1e-5f);
+    ASSERT_NEAR(out[5], 0.0f, 1e-5f);
+
+    BatchConeSOA cones;
+    cones.Add(Vector3f(10, 0, 0), Vector3f(0, 0, 1), 2.0f, 1.0f);
+    cones.Add(cone.GetApex(), cone.GetAxis(), cone.GetHeight(), cone.GetBaseRadius());
+
+    float distance;
+    size_t nearest;
+    ASSERT_TRUE(DistanceQuery::MinDistance(Vector3f(2, 0, 1), cones, distance, &nearest));
+    ASSERT_TRUE(nearest == 1);
+    ASSERT_NEAR(distance, std::sqrt(1.8f), 1e-5f);
+}
+
+void test_batch_min_distance() {
+    // More primitives than one evaluation block
+    const size_t count = 600;
+    uint32_t seed = 777;
+
+    BatchSphereSOA spheres;
+    BatchCapsuleSOA capsules;
+    BatchAABBSOA boxes;
+    BatchOBBSOA obbs;
+    BatchCylinderSOA cylinders;
+    BatchTorusSOA tori;
+    BatchTriangleSOA triangles;
+
+    std::vector<Sphere> sphere_list;
+    std::vector<Capsule> capsule_list;
+    std::vector<AABB> box_list;
+    std::vector<Cylinder> cylinder_list;
+    std::vector<Torus> torus_list;
+    std::vector<Vector3f> triangle_list;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Vector3f c(NextRandom(seed) * 5, NextRandom(seed) * 5, NextRandom(seed) * 5);
+        const Vector3f d(NextRandom(seed), NextRandom(seed), NextRandom(seed) + 0.1f);
+        const float r = 0.1f + std::abs(NextRandom(seed)) * 0.1f;
+        const Vector3f axis = Normalized(d);
+
+        sphere_list.emplace_back(c, r);
+        spheres.Add(c, r);
+
+        capsule_list.emplace_back(c, c + d, r);
+        capsules.Add(c, c + d, r);
+
+        AABB box;
+        box.SetMinMax(c - glm::abs(d) * 0.5f, c + glm::abs(d) * 0.5f);
+        box_list.push_back(box);
+        boxes.Add(box.GetMin(), box.GetMax());
+        obbs.Add(c, Vector3f(1, 0, 0), Vector3f(0, 1, 0), Vector3f(0, 0, 1), glm::abs(d) * 0.5f);
+
+        cylinder_list.emplace_back(c, axis, 1.0f, r);
+        cylinders.Add(c, axis, 1.0f, r);
+
+        torus_list.emplace_back(c, axis, 1.0f, r);
+        tori.Add(c, axis, 1.0f, r);
+
+        triangle_list.push_back(c);
+        triangle_list.push_back(c + d);
+        triangle_list.push_back(c + Vector3f(d.y, -d.x, d.z * 0.5f));
+        triangles.Add(c, c + d, c + Vector3f(d.y, -d.x, d.z * 0.5f));
+    }
+
+    for (int q = 0; q < 20; ++q) {
+        const Vector3f p(NextRandom(seed) * 6, NextRandom(seed) * 6, NextRandom(seed) * 6);
+
+        float best[6];
+        size_t best_index[6];
+        for (int k = 0; k < 6; ++k) {
+            best[k] = 1e30f;
+            best_index[k] = 0;
+        }
+
+        auto update = [&](int k, size_t i, float d) {
+            if (d < best[k]) { best[k] = d; best_index[k] = i; }
+        };
+
+        for (size_t i = 0; i < count; ++i) {
+            update(0, i, DistanceQuery::Distance(p, sphere_list[i]));
+            update(1, i, DistanceQuery::Distance(p, capsule_list[i]));
+            update(2, i, DistanceQuery::Distance(p, box_list[i]));
+            update(3, i, SolidCylinderDistance(p, cylinder_list[i]));
+            update(4, i, torus_list[i].DistanceToPoint(p));
+            update(5, i, Length(p - ClosestPointOnTriangle(p, triangle_list[i * 3], triangle_list[i * 3 + 1], triangle_list[i * 3 + 2])));
+        }
+
+        float distance;
+        size_t nearest;
+
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, spheres, distance, &nearest));
+        ASSERT_NEAR(distance, best[0], 1e-4f);
+        ASSERT_NEAR(DistanceQuery::Distance(p, sphere_list[nearest]), best[0], 1e-4f);
+
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, capsules, distance, &nearest));
+        ASSERT_NEAR(distance, best[1], 1e-4f);
+        ASSERT_NEAR(DistanceQuery::Distance(p, capsule_list[nearest]), best[1], 1e-4f);
+
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, boxes, distance, &nearest));
+        ASSERT_NEAR(distance, best[2], 1e-4f);
+        ASSERT_NEAR(DistanceQuery::Distance(p, box_list[nearest]), best[2], 1e-4f);
+
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, obbs, distance, &nearest));
+        ASSERT_NEAR(distance, best[2], 1e-4f);
+
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, cylinders, distance, &nearest));
+        ASSERT_NEAR(distance, best[3], 1e-4f);
+
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, tori, distance, &nearest));
+        ASSERT_NEAR(distance, best[4], 1e-4f);
+        ASSERT_TRUE(nearest == best_index[4]);
+
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, triangles, distance, &nearest));
+        ASSERT_NEAR(distance, best[5], 1e-4f);
+    }
+
+    // A point inside several primitives reports the first one
+    BatchSphereSOA nested;
+    nested.Add(Vector3f(10, 0, 0), 1.0f);
+    nested.Add(Vector3f(0, 0, 0), 2.0f);
+    nested.Add(Vector3f(0, 0, 0), 3.0f);
+
+    float distance = -1.0f;
+    size_t nearest = 99;
+    ASSERT_TRUE(DistanceQuery::MinDistance(Vector3f(0.5f, 0, 0), nested, distance, &nearest));
+    ASSERT_NEAR(distance, 0.0f, 1e-6f);
+    ASSERT_TRUE(nearest == 1);
+
+    BatchSphereSOA empty;
+    ASSERT_FALSE(DistanceQuery::MinDistance(Vector3f(0, 0, 0), empty, distance));
+}
+
+void test_batch_parallel_matches_serial() {
+    const BatchPointSOA points = MakeRandomPoints(100000, 4242);
+    std::vector<float> serial(points.count), parallel(points.count);
+
+    Capsule capsule(Vector3f(-1, 0, 0), Vector3f(1, 2, 0), 0.5f);
+    ThreadParallelExecutor executor(4);
+
+    DistanceQuery::Distance(points, capsule, serial.data());
+    DistanceQuery::Distance(points, capsule, parallel.data(), &executor);
+
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_TRUE(serial[i] == parallel[i]);
+}
+
+// ============================================================================
+// Closest Point Query Tests
+// ============================================================================
+
+static bool NearVector(const Vector3f& a, const Vector3f& b, float epsilon) {
+    return Length(a - b) <= epsilon;
+}
+
+void test_closest_point_obb_cone_torus() {
+    // OBB rotated 45 degrees about Z
+    const float s = std::sqrt(0.5f);
+    OBB box(Vector3f(0, 0, 0), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(1, 1, 1));
+
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(5, 0, 0), box), Vector3f(2 * s, 0, 0), 1e-5f));
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(0.1f, 0.2f, 0.3f), box), Vector3f(0.1f, 0.2f, 0.3f), 1e-6f));
+    ASSERT_NEAR(DistanceQuery::Distance(Vector3f(5, 0, 0), box), 5.0f - 2 * s, 1e-5f);
+
+    // Cone: apex at origin, axis +Z, height 2, base radius 1
+    Cone cone(Vector3f(0, 0, 0), Vector3f(0, 0, 1), 2.0f, 1.0f);
+
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(0, 0, 3), cone), Vector3f(0, 0, 2), 1e-5f));
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(0, 0, -1), cone), Vector3f(0, 0, 0), 1e-5f));
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(0.1f, 0, 1.5f), cone), Vector3f(0.1f, 0, 1.5f), 1e-6f));
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(3, 0, 3), cone), Vector3f(1, 0, 2), 1e-5f));
+    // (1,0,0.5) projects onto the slant at t=0.4: (0.4,0,0.8)
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(1, 0, 0.5f), cone), Vector3f(0.4f, 0, 0.8f), 1e-5f));
+    ASSERT_NEAR(DistanceQuery::Distance(Vector3f(1, 0, 0.5f), cone), std::sqrt(0.45f), 1e-5f);
+
+    // Torus: center origin, axis +Y, R=2, r=0.5
+    Torus torus(Vector3f(0, 0, 0), Vector3f(0, 1, 0), 2.0f, 0.5f);
+
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(4, 0, 0), torus), Vector3f(2.5f, 0, 0), 1e-5f));
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(2, 0.2f, 0), torus), Vector3f(2, 0.2f, 0), 1e-6f));
+    ASSERT_NEAR(DistanceQuery::Distance(Vector3f(0, 3, 0), torus), std::sqrt(13.0f) - 0.5f, 1e-5f);
+
+    // Points on the axis still land on the tube
+    const Vector3f on_axis = DistanceQuery::ClosestPoint(Vector3f(0, 1, 0), torus);
+    ASSERT_NEAR(Length(on_axis - Vector3f(0, 1, 0)), std::sqrt(5.0f) - 0.5f, 1e-5f);
+}
+
+void test_closest_point_triangle() {
+    const Vector3f a(0, 0, 0), b(2, 0, 0), c(0, 2, 0);
+
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(0.5f, 0.5f, 3), a, b, c), Vector3f(0.5f, 0.5f, 0), 1e-6f));
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(-1, -1, 0), a, b, c), a, 1e-6f));
+    ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(Vector3f(2, 2, 0), a, b, c), Vector3f(1, 1, 0), 1e-6f));
+    ASSERT_NEAR(DistanceQuery::Distance(Vector3f(1, -1, 1), a, b, c), std::sqrt(2.0f), 1e-6f);
+
+    uint32_t seed = 99;
+    for (int i = 0; i < 200; ++i) {
+        const Vector3f p(NextRandom(seed) * 4, NextRandom(seed) * 4, NextRandom(seed) * 4);
+        ASSERT_TRUE(NearVector(DistanceQuery::ClosestPoint(p, a, b, c), ClosestPointOnTriangle(p, a, b, c), 1e-5f));
+    }
+}
+
+void test_box_box_distance() {
+    // Face-separated boxes: centers 5 apart, half extents 1
+    OBB a(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    OBB b(Vector3f(5, 0, 0), Vector3f(1, 1, 1));
+
+    ASSERT_NEAR(DistanceQuery::Distance(a, b), 3.0f, 1e-5f);
+    ASSERT_NEAR(a.Distance(b), 3.0f, 1e-5f);
+
+    // b rotated 45 degrees about Z, so only its edge faces a
+    const float s = std::sqrt(0.5f);
+    OBB edge(Vector3f(4, 0, 0), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(1, 1, 1));
+    ASSERT_NEAR(DistanceQuery::Distance(a, edge), 3.0f - 2 * s, 1e-5f);
+
+    const ClosestPointsResult result = DistanceQuery::ClosestPoints(a, edge);
+    ASSERT_NEAR(result.distance, 3.0f - 2 * s, 1e-5f);
+    ASSERT_NEAR(Length(result.pointOnA - result.pointOnB), result.distance, 1e-5f);
+    ASSERT_NEAR(result.pointOnA.x, 1.0f, 1e-5f);
+    ASSERT_NEAR(result.pointOnB.x, 4.0f - 2 * s, 1e-5f);
+
+    // Random boxes against a sampled surface of the second box: the exact distance
+    // is a lower bound of every sample and close to the best one
+    uint32_t seed = 2024;
+    for (int i = 0; i < 20; ++i) {
+        const Vector3f x = Normalized(Vector3f(NextRandom(seed), NextRandom(seed), NextRandom(seed)));
+        const Vector3f y = Normalized(Cross(x, Vector3f(NextRandom(seed), NextRandom(seed), NextRandom(seed))));
+        const Vector3f z = Cross(x, y);
+        const Vector3f half(0.5f + std::abs(NextRandom(seed)) * 0.25f, 0.5f + std::abs(NextRandom(seed)) * 0.25f, 0.5f + std::abs(NextRandom(seed)) * 0.25f);
+        const Vector3f center = Normalized(Vector3f(NextRandom(seed), NextRandom(seed), NextRandom(seed))) * 4.0f;
+
+        OBB c(center, x, y, z, half);
+        const ClosestPointsResult result = DistanceQuery::ClosestPoints(a, c);
+
+        ASSERT_NEAR(Length(result.pointOnA - result.pointOnB), result.distance, 1e-4f);
+        ASSERT_NEAR(DistanceQuery::Distance(result.pointOnA, a), 0.0f, 1e-4f);
+        ASSERT_NEAR(DistanceQuery::Distance(result.pointOnB, c), 0.0f, 1e-4f);
+
+        constexpr int STEPS = 24;
+        float sampled = 1e30f;
+        for (int face = 0; face < 6; ++face) {
+            const int axis = face / 2;
+            const float sign = (face & 1) ? 1.0f : -1.0f;
+            for (int u = 0; u <= STEPS; ++u)
+                for (int v = 0; v <= STEPS; ++v) {
+                    float local[3];
+                    local[axis] = sign;
+                    local[(axis + 1) % 3] = float(u) / STEPS * 2.0f - 1.0f;
+                    local[(axis + 2) % 3] = float(v) / STEPS * 2.0f - 1.0f;
+
+                    const Vector3f p = center + x * (local[0] * half.x) + y * (local[1] * half.y) + z * (local[2] * half.z);
+                    sampled = std::min(sampled, DistanceQuery::Distance(p, a));
+                }
+        }
+
+        ASSERT_TRUE(result.distance <= sampled + 1e-4f);
+        ASSERT_TRUE(result.distance >= sampled - 0.1f);
+    }
+
+    // Overlapping boxes
+    OBB overlap(Vector3f(1.5f, 0.5f, 0), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(1, 1, 1));
+    ASSERT_NEAR(DistanceQuery::Distance(a, overlap), 0.0f, 1e-6f);
+
+    // AABB gap distance
+    AABB box_a, box_b;
+    box_a.SetMinMax(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    box_b.SetMinMax(Vector3f(4, 5, 0.5f), Vector3f(6, 6, 2));
+    ASSERT_NEAR(DistanceQuery::Distance(box_a, box_b), 5.0f, 1e-6f);
+    ASSERT_NEAR(DistanceQuery::Distance(box_a, box_a), 0.0f, 1e-6f);
+}
+
+void test_batch_closest_point() {
+    const BatchPointSOA points = MakeRandomPoints(2000, 777);
+
+    const float s = std::sqrt(0.5f);
+    OBB box(Vector3f(0.2f, 0, 0), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(2.0f, 1.2f, 0.8f));
+    Cone cone(Vector3f(0, 0, -2), Vector3f(0, 0, 1), 4.0f, 1.6f);
+    Torus torus(Vector3f(0, 0, 0), Normalized(Vector3f(1, 1, 0)), 2.0f, 0.5f);
+    const Vector3f v0(-2, -2, 0), v1(2, -1.2f, 0.8f), v2(0, 2.4f, -0.4f);
+
+    BatchPointSOA out;
+    ThreadParallelExecutor executor(4);
+
+    DistanceQuery::ClosestPoint(points, box, out);
+    ASSERT_TRUE(out.count == points.count);
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_TRUE(NearVector(out.Get(i), DistanceQuery::ClosestPoint(points.Get(i), box), 1e-5f));
+
+    DistanceQuery::ClosestPoint(points, cone, out);
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_TRUE(NearVector(out.Get(i), DistanceQuery::ClosestPoint(points.Get(i), cone), 1e-5f));
+
+    DistanceQuery::ClosestPoint(points, torus, out);
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_TRUE(NearVector(out.Get(i), DistanceQuery::ClosestPoint(points.Get(i), torus), 1e-5f));
+
+    DistanceQuery::ClosestPoint(points, v0, v1, v2, out);
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_TRUE(NearVector(out.Get(i), ClosestPointOnTriangle(points.Get(i), v0, v1, v2), 1e-5f));
+
+    BatchPointSOA parallel;
+    DistanceQuery::ClosestPoint(points, v0, v1, v2, parallel, &executor);
+    for (size_t i = 0; i < points.count; ++i)
+        ASSERT_TRUE(out.x[i] == parallel.x[i] && out.y[i] == parallel.y[i] && out.z[i] == parallel.z[i]);
+}
+
+void test_batch_triangle_matches_scalar_query() {
+    // Far from the origin and close to vertices and edges, where a different
+    // region test would round differently from the scalar query
+    const Vector3f offset(1000.0f, -750.0f, 500.0f);
+    const Vector3f v0 = offset + Vector3f(-2, -2, 0), v1 = offset + Vector3f(2, -1.2f, 0.8f), v2 = offset + Vector3f(0, 2.4f, -0.4f);
+    const Vector3f anchors[6] = { v0, v1, v2, (v0 + v1) * 0.5f, (v1 + v2) * 0.5f, (v2 + v0) * 0.5f };
+
+    BatchPointSOA points;
+    uint32_t seed = 4242;
+    for (int i = 0; i < 6000; ++i) {
+        const float spread = (i % 2) ? 0.01f : 1.0f;
+        const Vector3f jitter(NextRandom(seed), NextRandom(seed), NextRandom(seed));
+        points.Add(anchors[i % 6] + jitter * spread);
+    }
+
+    std::vector<float> distance(points.count);
+    BatchPointSOA closest;
+    DistanceQuery::Distance(points, v0, v1, v2, distance.data());
+    DistanceQuery::ClosestPoint(points, v0, v1, v2, closest);
+
+    for (size_t i = 0; i < points.count; ++i) {
+        const Vector3f p = points.Get(i);
+        ASSERT_TRUE(NearVector(closest.Get(i), DistanceQuery::ClosestPoint(p, v0, v1, v2), 1e-4f));
+        ASSERT_NEAR(distance[i], DistanceQuery::Distance(p, v0, v1, v2), 1e-5f);
+    }
+
+    BatchTriangleSOA triangles;
+    triangles.Add(v0, v1, v2);
+
+    for (size_t i = 0; i < points.count; i += 97) {
+        const Vector3f p = points.Get(i);
+        float nearest = 0;
+        ASSERT_TRUE(DistanceQuery::MinDistance(p, triangles, nearest));
+        ASSERT_NEAR(nearest, DistanceQuery::Distance(p, v0, v1, v2), 1e-5f);
+    }
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -308,6 +764,19 @@ int main() {
     TEST(distance_zero_length_segment);
     TEST(distance_coincident_spheres);
 
+    std::cout << std::endl << "--- Batch Distance Tests ---" << std::endl;
+    TEST(batch_points_match_scalar);
+    TEST(batch_cone_distance);
+    TEST(batch_min_distance);
+    TEST(batch_parallel_matches_serial);
+
+    std::cout << std::endl << "--- Closest Point Query Tests ---" << std::endl;
+    TEST(closest_point_obb_cone_torus);
+    TEST(closest_point_triangle);
+    TEST(box_box_distance);
+    TEST(batch_closest_point);
+    TEST(batch_triangle_matches_scalar_query);
+
     std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
 
     return 0;
@@ -0,0 +1,382 @@
+﻿/**
+ * test_gjk.cpp
+ *
+ * Test cases for GJK/EPA convex collision
+ * Compares support-function based results against closed-form answers.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <hgl/math/geometry/queries/GJK.h>
+#include <hgl/math/geometry/queries/CollisionDetector.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+static ConvexHull MakeCubeHull(const Vector3f &center, float half)
+{
+    Vector3f pts[8];
+
+    for (int i = 0; i < 8; i++)
+        pts[i] = center + Vector3f((i & 1) ? half : -half, (i & 2) ? half : -half, (i & 4) ? half : -half);
+
+    return ConvexHull(pts, 8);
+}
+
+// ============================================================================
+// Support Function Tests
+// ============================================================================
+
+void test_support_sphere() {
+    Sphere s(Vector3f(1, 2, 3), 2.0f);
+    Vector3f p = GetSupportPoint(s, Vector3f(0, 5, 0));
+
+    ASSERT_NEAR(p.x, 1.0f, 1e-5f);
+    ASSERT_NEAR(p.y, 4.0f, 1e-5f);
+    ASSERT_NEAR(p.z, 3.0f, 1e-5f);
+}
+
+void test_support_box() {
+    OBB box(Vector3f(0, 0, 0), Vector3f(1, 2, 3));
+    Vector3f p = GetSupportPoint(box, Vector3f(-1, 1, -1));
+
+    ASSERT_NEAR(p.x, -1.0f, 1e-5f);
+    ASSERT_NEAR(p.y,  2.0f, 1e-5f);
+    ASSERT_NEAR(p.z, -3.0f, 1e-5f);
+}
+
+void test_support_cone() {
+    Cone cone(Vector3f(0, 2, 0), Vector3f(0, -1, 0), 2.0f, 1.0f);
+
+    Vector3f up = GetSupportPoint(cone, Vector3f(0, 1, 0));
+    ASSERT_NEAR(up.y, 2.0f, 1e-5f);
+
+    Vector3f side = GetSupportPoint(cone, Vector3f(1, 0, 0));
+    ASSERT_NEAR(side.x, 1.0f, 1e-5f);
+    ASSERT_NEAR(side.y, 0.0f, 1e-5f);
+}
+
+void test_support_cylinder() {
+    Cylinder cyl(Vector3f(0, 0, 0), Vector3f(0, 1, 0), 2.0f, 0.5f);
+    Vector3f p = GetSupportPoint(cyl, Vector3f(1, 1, 0));
+
+    ASSERT_NEAR(p.x, 0.5f, 1e-5f);
+    ASSERT_NEAR(p.y, 1.0f, 1e-5f);
+}
+
+// ============================================================================
+// Distance Tests
+// ============================================================================
+
+void test_distance_sphere_sphere() {
+    Sphere a(Vector3f(0, 0, 0), 1.0f);
+    Sphere b(Vector3f(5, 0, 0), 1.5f);
+
+    Vector3f pa, pb;
+    float dist = GJK::Distance(a, b, &pa, &pb);
+
+    ASSERT_NEAR(dist, 2.5f, 1e-3f);
+    ASSERT_NEAR(pa.x, 1.0f, 1e-3f);
+    ASSERT_NEAR(pb.x, 3.5f, 1e-3f);
+}
+
+void test_distance_box_box() {
+    OBB a(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    OBB b(Vector3f(4, 0.5f, 0), Vector3f(1, 1, 1));
+
+    ASSERT_NEAR(GJK::Distance(a, b), 2.0f, 1e-4f);
+    ASSERT_FALSE(GJK::Intersects(a, b));
+}
+
+void test_distance_capsule_hull() {
+    Capsule capsule(Vector3f(-3, 3, 0), Vector3f(3, 3, 0), 0.5f);
+    ConvexHull cube = MakeCubeHull(Vector3f(0, 0, 0), 1.0f);
+
+    ASSERT_NEAR(GJK::Distance(capsule, cube), 1.5f, 1e-4f);
+}
+
+// ============================================================================
+// Intersection / EPA Tests
+// ============================================================================
+
+void test_intersects_matches_closed_form() {
+    Sphere a(Vector3f(0, 0, 0), 1.0f);
+
+    for (int i = 0; i < 40; i++)
+    {
+        float x = 0.1f * float(i);
+        Sphere b(Vector3f(x, 0.3f, -0.2f), 1.0f);
+
+        if (std::abs(x - 1.9f) < 0.05f)
+            continue;   // skip the tangent band
+
+        ASSERT_TRUE(GJK::Intersects(a, b) == CollisionDetector::Intersects(a, b));
+    }
+}
+
+static OBB MakeRotatedBox(int seed, const Vector3f &offset)
+{
+    auto h = [seed](int k) { return std::sin(float(seed) * 12.9898f + float(k) * 78.233f); };
+
+    const Vector3f x = Normalized(Vector3f(h(0), h(1), h(2) + 1.5f));
+    const Vector3f t = Normalized(Vector3f(h(3) + 1.5f, h(4), h(5)));
+    const Vector3f z = Normalized(Cross(x, t));
+    const Vector3f y = Cross(z, x);
+
+    return OBB(offset + Vector3f(h(6), h(7), h(8)) * 1.5f, x, y, z,
+               Vector3f(0.7f + 0.5f * h(9), 0.7f + 0.5f * h(10), 0.7f + 0.5f * h(11)));
+}
+
+void test_intersects_matches_obb_sat() {
+    // Overlapping boxes must never be reported as separated, also far from the origin
+    int overlapping = 0;
+
+    for (int i = 0; i < 40000; i++)
+    {
+        const Vector3f offset = (i & 1) ? Vector3f(100, -60, 80) : Vector3f(0, 0, 0);
+        const OBB a = MakeRotatedBox(2 * i, offset);
+        const OBB b = MakeRotatedBox(2 * i + 1, offset);
+
+        if (!a.Intersects(b))
+            continue;
+
+        ASSERT_TRUE(GJK::Intersects(a, b));
+        ASSERT_TRUE(GJK::TestCollision(a, b).intersects);
+        ++overlapping;
+    }
+
+    ASSERT_TRUE(overlapping > 10000);
+}
+
+void test_epa_sphere_sphere() {
+    Sphere a(Vector3f(0, 0, 0), 1.0f);
+    Sphere b(Vector3f(1.5f, 0, 0), 1.0f);
+
+    CollisionInfo info = GJK::TestCollision(a, b);
+
+    ASSERT_TRUE(info.intersects);
+    ASSERT_NEAR(info.penetration, 0.5f, 0.02f);
+    ASSERT_NEAR(info.normal.x, 1.0f, 0.02f);
+    ASSERT_NEAR(info.distance, -info.penetration, 1e-6f);
+}
+
+void test_epa_box_box() {
+    OBB a(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    OBB b(Vector3f(0, 1.75f, 0), Vector3f(1, 1, 1));
+
+    CollisionInfo info = GJK::TestCollision(a, b);
+
+    ASSERT_TRUE(info.intersects);
+    ASSERT_NEAR(info.penetration, 0.25f, 1e-3f);
+    ASSERT_NEAR(info.normal.y, 1.0f, 1e-3f);
+}
+
+void test_separated_collision_info() {
+    Cone cone(Vector3f(0, 2, 0), Vector3f(0, -1, 0), 2.0f, 1.0f);
+    OBB box(Vector3f(0, -2, 0), Vector3f(1, 1, 1));
+
+    CollisionInfo info = GJK::TestCollision(cone, box);
+
+    ASSERT_FALSE(info.intersects);
+    ASSERT_NEAR(info.distance, 1.0f, 1e-3f);
+    ASSERT_NEAR(info.normal.y, -1.0f, 1e-3f);
+}
+
+void test_collision_detector_gjk_pairs() {
+    Cone cone(Vector3f(0, 2, 0), Vector3f(0, -1, 0), 2.0f, 1.0f);
+    Capsule near_capsule(Vector3f(-2, 0.5f, 0), Vector3f(2, 0.5f, 0), 0.3f);
+    Capsule far_capsule(Vector3f(-2, 0.5f, 3), Vector3f(2, 0.5f, 3), 0.3f);
+    Cylinder cyl(Vector3f(0, -0.9f, 0), Vector3f(0, 1, 0), 2.0f, 0.5f);
+    OBB box(Vector3f(3, 0, 0), Vector3f(0.5f, 0.5f, 0.5f));
+
+    ASSERT_TRUE(CollisionDetector::Intersects(cone, near_capsule));
+    ASSERT_FALSE(CollisionDetector::Intersects(far_capsule, cone));
+    ASSERT_TRUE(CollisionDetector::Intersects(cone, cyl));
+    ASSERT_FALSE(CollisionDetector::Intersects(cone, box));
+    ASSERT_FALSE(CollisionDetector::Intersects(cyl, box));
+
+    ConvexHull hull = MakeCubeHull(Vector3f(2.8f, 0, 0), 0.5f);
+    ASSERT_TRUE(CollisionDetector::Intersects(hull, box));
+    ASSERT_FALSE(CollisionDetector::Intersects(cone, hull));
+}
+
+void test_nearly_flat_simplex() {
+    // This pair builds a sliver tetrahedron (three almost identical support
+    // points); it must not be taken as enclosing the origin
+    AABB box;
+    box.SetMinMax(Vector3f(-1, -1, -1), Vector3f(1, 0, 1));
+
+    const Vector3f offset = Vector3f(20, 0, 0) * (1332 / 4000.0f);
+    Capsule capsule(Vector3f(-8.350378f, 0.49178883f, 1.2378802f) + offset,
+                    Vector3f(-8.0106173f, -0.25657997f, 2.025908f) + offset, 0.5f);
+
+    GJKResult result;
+    ASSERT_FALSE(GJK::Query(MakeConvexSupport(capsule), MakeConvexSupport(box), result));
+    ASSERT_NEAR(result.distance, 0.3013f, 1e-3f);
+}
+
+void test_sliver_triangle_normal() {
+    // Capsule almost touching a box edge: the final simplex is a long thin
+    // triangle and the witness normal must still point across the edge
+    AABB box;
+    box.SetMinMax(Vector3f(-1, -1, -1), Vector3f(1, 0, 1));
+
+    Capsule capsule(Vector3f(-1.04166603f, 0.515500009f, -0.450897932f),
+                    Vector3f(-1.75507927f, 1.61884332f, -0.127703279f), 0.5f);
+
+    const ConvexSupport a = MakeConvexSupport(capsule);
+    const ConvexSupport b = MakeConvexSupport(box);
+
+    GJKResult result;
+    ASSERT_FALSE(GJK::Query(a, b, result));
+    ASSERT_NEAR(result.distance, 0.01718f, 1e-4f);
+
+    const Vector3f normal = (result.point_b - result.point_a) / result.distance;
+    ASSERT_NEAR(normal.z, 0.0f, 1e-3f);
+
+    // Separation of the support planes along the normal matches the distance
+    ASSERT_NEAR(Dot(normal, b(-normal) - a(normal)), result.distance, 1e-3f);
+}
+
+void test_torus_hull_support() {
+    Torus torus(Vector3f(0, 0, 0), Vector3f(0, 1, 0), 2.0f, 0.5f);
+    Sphere inside_hole(Vector3f(0, 0, 0), 0.5f);
+    Sphere outside(Vector3f(4, 0, 0), 0.5f);
+
+    // Support describes the convex hull, so the hole counts as solid
+    ASSERT_TRUE(GJK::Intersects(torus, inside_hole));
+    ASSERT_FALSE(GJK::Intersects(torus, outside));
+}
+
+// ============================================================================
+// Warm Start Tests
+// ============================================================================
+
+void test_warm_start() {
+    OBB a(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    GJKCache cache;
+
+    float previous = 0.0f;
+    uint32_t cold_iterations = 0;
+    uint32_t warm_iterations = 0;
+
+    for (int frame = 0; frame < 10; frame++)
+    {
+        OBB b(Vector3f(3.0f + 0.01f * frame, 0.2f, 0.1f), Vector3f(1, 1, 1));
+
+        GJKResult cold;
+        GJK::Query(MakeConvexSupport(a), MakeConvexSupport(b), cold);
+
+        GJKResult warm;
+        GJK::Query(MakeConvexSupport(a), MakeConvexSupport(b), warm, &cache);
+
+        ASSERT_NEAR(cold.distance, warm.distance, 1e-4f);
+        ASSERT_TRUE(warm.distance >= previous);
+        previous = warm.distance;
+
+        if (frame > 0)
+        {
+            cold_iterations += cold.iterations;
+            warm_iterations += warm.iterations;
+        }
+    }
+
+    ASSERT_TRUE(warm_iterations <= cold_iterations);
+
+    cache.Reset();
+    ASSERT_TRUE(cache.count == 0);
+}
+
+void test_warm_start_curved() {
+    // Curved support against a box edge: the distance is only approached
+    // asymptotically, so convergence needs the absolute tolerance
+    OBB box(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+    GJKCache cache;
+
+    for (int frame = 0; frame < 10; frame++)
+    {
+        const Vector3f center(1.3908627f + 0.002f * frame, 1.307364f, 0.3172589f);
+        Sphere sphere(center, 0.4306412f);
+
+        const float expected = Length(center - Vector3f(1, 1, center.z)) - 0.4306412f;
+
+        GJKResult cold;
+        GJK::Query(MakeConvexSupport(sphere), MakeConvexSupport(box), cold);
+
+        GJKResult warm;
+        GJK::Query(MakeConvexSupport(sphere), MakeConvexSupport(box), warm, &cache);
+
+        ASSERT_NEAR(cold.distance, expected, 1e-4f);
+        ASSERT_NEAR(warm.distance, expected, 1e-4f);
+        ASSERT_TRUE(cold.iterations < 16);
+
+        if (frame > 0)
+            ASSERT_TRUE(warm.iterations <= 4);
+    }
+
+    cache.Reset();
+
+    Capsule capsule(Vector3f(2.2f, 2.3f, 0.3f), Vector3f(3.0f, 2.9f, 0.8f), 0.5f);
+
+    GJKResult cold;
+    GJK::Query(MakeConvexSupport(capsule), MakeConvexSupport(box), cold, &cache);
+    ASSERT_TRUE(cold.iterations < 16);
+
+    GJKResult warm;
+    GJK::Query(MakeConvexSupport(capsule), MakeConvexSupport(box), warm, &cache);
+    ASSERT_NEAR(cold.distance, warm.distance, 1e-4f);
+    ASSERT_TRUE(warm.iterations <= 4);
+}
+
+int main() {
+    std::cout << "=== GJK/EPA Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Support Function Tests ---" << std::endl;
+    TEST(support_sphere);
+    TEST(support_box);
+    TEST(support_cone);
+    TEST(support_cylinder);
+
+    std::cout << std::endl << "--- Distance Tests ---" << std::endl;
+    TEST(distance_sphere_sphere);
+    TEST(distance_box_box);
+    TEST(distance_capsule_hull);
+
+    std::cout << std::endl << "--- Intersection / EPA Tests ---" << std::endl;
+    TEST(intersects_matches_closed_form);
+    TEST(intersects_matches_obb_sat);
+    TEST(epa_sphere_sphere);
+    TEST(epa_box_box);
+    TEST(separated_collision_info);
+    TEST(collision_detector_gjk_pairs);
+    TEST(torus_hull_support);
+    TEST(nearly_flat_simplex);
+    TEST(sliver_triangle_normal);
+
+    std::cout << std::endl << "--- Warm Start Tests ---" << std::endl;
+    TEST(warm_start);
+    TEST(warm_start_curved);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
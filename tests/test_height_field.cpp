@@ -0,0 +1,280 @@
+﻿/**
+ * test_height_field.cpp
+ *
+ * Test cases for the heightfield collider
+ */
+
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <hgl/math/geometry/primitives/HeightField.h>
+#include <hgl/math/geometry/primitives/TriangleMesh.h>
+#include <hgl/math/geometry/primitives/Sphere.h>
+#include <hgl/math/geometry/primitives/Capsule.h>
+#include <hgl/math/geometry/Ray.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+const Vector3f ORIGIN(-10.0f, 5.0f, -2.0f);
+const Vector3f SCALE(0.5f, 0.75f, 0.1f);
+
+std::vector<float> MakeHeights(int w, int h)
+{
+    std::vector<float> data(w * h);
+
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            data[y * w + x] = 20.0f * std::sin(x * 0.21f) * std::cos(y * 0.17f) + 5.0f * std::sin(x * y * 0.01f);
+
+    return data;
+}
+
+// Same surface as an explicit triangle mesh, with the same diagonal split
+TriangleMesh MakeReferenceMesh(const HeightField &field)
+{
+    std::vector<Vector3f> vertices;
+    std::vector<uint32_t> indices;
+    const int w = field.GetWidth();
+    const int h = field.GetHeight();
+
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            vertices.push_back(field.GetSamplePoint(x, y));
+
+    for (int y = 0; y < h - 1; y++)
+        for (int x = 0; x < w - 1; x++)
+        {
+            const uint32_t i = y * w + x;
+            indices.insert(indices.end(), {i, i + 1, i + w + 1});
+            indices.insert(indices.end(), {i, i + w + 1, i + w});
+        }
+
+    return TriangleMesh(vertices.data(), uint32_t(vertices.size()), indices.data(), uint32_t(indices.size()));
+}
+
+// ============================================================================
+// Build Tests
+// ============================================================================
+
+void test_build_mips() {
+    std::vector<float> data = MakeHeights(37, 21);
+    HeightField field(data.data(), 37, 21, ORIGIN, SCALE);
+
+    ASSERT_TRUE(field.IsValid());
+    ASSERT_TRUE(field.GetLevelWidth(0) == 36 && field.GetLevelHeight(0) == 20);
+
+    const int top = field.GetLevelCount() - 1;
+    ASSERT_TRUE(field.GetLevelWidth(top) == 1 && field.GetLevelHeight(top) == 1);
+
+    float lo = FLT_MAX, hi = -FLT_MAX;
+    for (float v : data) { lo = std::min(lo, v); hi = std::max(hi, v); }
+
+    ASSERT_NEAR(field.GetMinMax(top, 0, 0).min_value, lo, 1e-6f);
+    ASSERT_NEAR(field.GetMinMax(top, 0, 0).max_value, hi, 1e-6f);
+
+    HeightField bad;
+    ASSERT_FALSE(bad.Set(data.data(), 1, 21));
+    ASSERT_FALSE(bad.Set(data.data(), 37, 21, ORIGIN, Vector3f(1, 1, 0)));
+    ASSERT_FALSE(bad.IsValid());
+}
+
+void test_integer_samples() {
+    std::vector<uint8_t> data(16 * 16);
+    for (int i = 0; i < 16 * 16; i++)
+        data[i] = uint8_t((i * 37) % 200);
+
+    HeightField field(data.data(), 16, 16, Vector3f(0, 0, 0), Vector3f(1, 1, 0.05f));
+
+    float z;
+    ASSERT_TRUE(field.GetHeight(3.0f, 4.0f, z));
+    ASSERT_NEAR(z, data[4 * 16 + 3] * 0.05f, 1e-5f);
+}
+
+// ============================================================================
+// Height Query Tests
+// ============================================================================
+
+void test_get_height() {
+    std::vector<float> data = MakeHeights(33, 33);
+    HeightField field(data.data(), 33, 33, ORIGIN, SCALE);
+    TriangleMesh mesh = MakeReferenceMesh(field);
+
+    for (int i = 0; i < 100; i++)
+    {
+        const float x = ORIGIN.x + 0.13f + i * 0.157f;
+        const float y = ORIGIN.y + 0.21f + i * 0.229f;
+
+        float z;
+        Vector3f normal;
+        ASSERT_TRUE(field.GetHeight(x, y, z, &normal));
+        ASSERT_NEAR(Length(normal), 1.0f, 1e-4f);
+        ASSERT_TRUE(normal.z > 0.0f);
+
+        MeshRayHit hit;
+        ASSERT_TRUE(mesh.Raycast(Ray(Vector3f(x, y, 100.0f), Vector3f(0, 0, -1)), 1000.0f, hit));
+        ASSERT_NEAR(z, hit.point.z, 1e-3f);
+        ASSERT_NEAR(Dot(normal, hit.normal), 1.0f, 1e-3f);
+    }
+
+    float z;
+    ASSERT_FALSE(field.GetHeight(ORIGIN.x - 1.0f, ORIGIN.y, z));
+}
+
+// ============================================================================
+// Raycast Tests
+// ============================================================================
+
+void test_raycast_matches_mesh() {
+    std::vector<float> data = MakeHeights(65, 65);
+    HeightField field(data.data(), 65, 65, ORIGIN, SCALE);
+    TriangleMesh mesh = MakeReferenceMesh(field);
+
+    int hits = 0;
+
+    for (int i = 0; i < 200; i++)
+    {
+        const Vector3f origin(ORIGIN.x - 2.0f + (i % 7) * 0.9f, ORIGIN.y - 1.0f + (i % 11) * 1.3f, 5.0f + (i % 5));
+        const Vector3f dir = Normalized(Vector3f(1.0f + (i % 3) * 0.3f, 0.8f + (i % 4) * 0.2f, -0.05f - (i % 9) * 0.08f));
+        const Ray ray(origin, dir);
+
+        MeshRayHit expected;
+        HeightFieldHit actual;
+
+        const bool mesh_hit = mesh.Raycast(ray, 200.0f, expected);
+        const bool field_hit = field.Raycast(ray, 200.0f, actual);
+
+        ASSERT_TRUE(mesh_hit == field_hit);
+
+        if (field_hit)
+        {
+            ASSERT_NEAR(actual.distance, expected.distance, 1e-3f);
+            ASSERT_NEAR(Dot(actual.normal, expected.normal), 1.0f, 1e-3f);
+            hits++;
+        }
+    }
+
+    ASSERT_TRUE(hits > 50);
+}
+
+void test_raycast_vertical_and_miss() {
+    std::vector<float> data = MakeHeights(17, 17);
+    HeightField field(data.data(), 17, 17, ORIGIN, SCALE);
+
+    HeightFieldHit hit;
+    float z;
+    ASSERT_TRUE(field.GetHeight(ORIGIN.x + 3.3f, ORIGIN.y + 4.1f, z));
+    ASSERT_TRUE(field.Raycast(Ray(Vector3f(ORIGIN.x + 3.3f, ORIGIN.y + 4.1f, 50.0f), Vector3f(0, 0, -1)), 100.0f, hit));
+    ASSERT_NEAR(hit.point.z, z, 1e-4f);
+
+    // Pointing up, and passing beside the field
+    ASSERT_FALSE(field.Raycast(Ray(Vector3f(ORIGIN.x + 3.3f, ORIGIN.y + 4.1f, 50.0f), Vector3f(0, 0, 1)), 100.0f, hit));
+    ASSERT_FALSE(field.Raycast(Ray(Vector3f(ORIGIN.x - 5.0f, ORIGIN.y, 0.0f), Vector3f(0, 1, 0)), 100.0f, hit));
+
+    // Distance limit stops before the ground
+    ASSERT_FALSE(field.Raycast(Ray(Vector3f(ORIGIN.x + 3.3f, ORIGIN.y + 4.1f, 50.0f), Vector3f(0, 0, -1)), 10.0f, hit));
+}
+
+void test_refresh() {
+    std::vector<float> data(9 * 9, 0.0f);
+    HeightField field(data.data(), 9, 9);
+
+    HeightFieldHit hit;
+    const Ray ray(Vector3f(4.5f, 4.5f, 100.0f), Vector3f(0, 0, -1));
+
+    ASSERT_TRUE(field.Raycast(ray, 200.0f, hit));
+    ASSERT_NEAR(hit.point.z, 0.0f, 1e-4f);
+
+    // Raise a plateau; without the refresh the mips would still skip it
+    for (int y = 4; y <= 5; y++)
+        for (int x = 4; x <= 5; x++)
+            data[y * 9 + x] = 10.0f;
+
+    field.Refresh(4, 4, 5, 5);
+
+    ASSERT_TRUE(field.Raycast(ray, 200.0f, hit));
+    ASSERT_NEAR(hit.point.z, 10.0f, 1e-4f);
+    ASSERT_NEAR(field.GetMinMax(field.GetLevelCount() - 1, 0, 0).max_value, 10.0f, 1e-6f);
+
+    HeightFieldHit side;
+    ASSERT_TRUE(field.Raycast(Ray(Vector3f(0.5f, 4.5f, 5.0f), Vector3f(1, 0, 0)), 20.0f, side));
+    ASSERT_TRUE(side.cell_x == 3);
+}
+
+// ============================================================================
+// Overlap Tests
+// ============================================================================
+
+void test_sphere_capsule_overlap() {
+    std::vector<float> data = MakeHeights(33, 33);
+    HeightField field(data.data(), 33, 33, ORIGIN, SCALE);
+    TriangleMesh mesh = MakeReferenceMesh(field);
+
+    for (int i = 0; i < 60; i++)
+    {
+        const float x = ORIGIN.x + 1.0f + i * 0.23f;
+        const float y = ORIGIN.y + 2.0f + i * 0.31f;
+        float z;
+        ASSERT_TRUE(field.GetHeight(x, y, z));
+
+        Sphere sphere(Vector3f(x, y, z + (i % 5 - 2) * 0.4f), 0.5f);
+        ASSERT_TRUE(field.Overlaps(sphere) == mesh.Overlaps(sphere));
+
+        Capsule capsule(Vector3f(x, y, z + 0.3f + (i % 4) * 0.3f), Vector3f(x + 0.5f, y, z + 1.5f + (i % 4) * 0.3f), 0.4f);
+        ASSERT_TRUE(field.Overlaps(capsule) == mesh.Overlaps(capsule));
+    }
+
+    ASSERT_FALSE(field.Overlaps(Sphere(Vector3f(ORIGIN.x - 5.0f, ORIGIN.y, 0.0f), 1.0f)));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::cout << "=== Height Field Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Build Tests ---" << std::endl;
+    TEST(build_mips);
+    TEST(integer_samples);
+
+    std::cout << std::endl << "--- Height Query Tests ---" << std::endl;
+    TEST(get_height);
+
+    std::cout << std::endl << "--- Raycast Tests ---" << std::endl;
+    TEST(raycast_matches_mesh);
+    TEST(raycast_vertical_and_miss);
+    TEST(refresh);
+
+    std::cout << std::endl << "--- Overlap Tests ---" << std::endl;
+    TEST(sphere_capsule_overlap);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
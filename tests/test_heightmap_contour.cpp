@@ -93,6 +93,328 @@ void test_uniform_heightmap() {
     ASSERT_TRUE(true);  // Just check it doesn't crash
 }
 
+// ============================================================================
+// Contour Stitching Tests
+// ============================================================================
+
+static float SignedArea(const std::vector<Vector2f>& vertices) {
+    float area = 0.0f;
+    for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+        area += vertices[j].x * vertices[i].y - vertices[i].x * vertices[j].y;
+    return area * 0.5f;
+}
+
+void test_contour_open_polyline() {
+    // Vertical step: one open polyline from the bottom border to the top border
+    uint8_t heightmap[16] = {
+        50,  50,  150, 150,
+        50,  50,  150, 150,
+        50,  50,  150, 150,
+        50,  50,  150, 150
+    };
+
+    HeightMapContourExtractor<uint8_t> extractor(heightmap, 4, 4, 80, 120);
+
+    std::vector<ContourPolygon> contours;
+    extractor.ExtractSingleContour(100, contours);
+
+    ASSERT_EQ(contours.size(), 1u);
+    ASSERT_FALSE(contours[0].is_closed);
+    ASSERT_EQ(contours[0].vertices.size(), 4u);
+
+    // High side (right) on the left of the walking direction: walks downwards
+    ASSERT_NEAR(contours[0].vertices.front().y, 3.0f, 1e-5f);
+    ASSERT_NEAR(contours[0].vertices.back().y, 0.0f, 1e-5f);
+    for (const Vector2f& v : contours[0].vertices)
+        ASSERT_NEAR(v.x, 1.5f, 1e-5f);
+}
+
+void test_contour_closed_loop() {
+    // Radial bump: a single closed loop around the peak, counter-clockwise
+    const int size = 64;
+    std::vector<float> heightmap(size * size);
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            heightmap[y * size + x] = 1.0f - std::sqrt(float((x - 31.5f) * (x - 31.5f) + (y - 31.5f) * (y - 31.5f))) / 32.0f;
+
+    HeightMapContourExtractor<float> extractor(heightmap.data(), size, size, 0.25f, 0.5f);
+
+    std::vector<ContourPolygon> contours;
+    extractor.ExtractSingleContour(0.5f, contours);
+
+    ASSERT_EQ(contours.size(), 1u);
+    ASSERT_TRUE(contours[0].is_closed);
+    ASSERT_TRUE(contours[0].vertices.size() > 50);
+    ASSERT_TRUE(SignedArea(contours[0].vertices) > 0.0f);
+    ASSERT_NEAR(SignedArea(contours[0].vertices), 3.14159265f * 16.0f * 16.0f, 10.0f);
+
+    for (const Vector2f& v : contours[0].vertices)
+        ASSERT_NEAR(glm::length(v - Vector2f(31.5f, 31.5f)), 16.0f, 0.1f);
+
+    // Consecutive vertices are neighbours on the grid
+    for (size_t i = 0; i < contours[0].vertices.size(); ++i) {
+        const Vector2f& a = contours[0].vertices[i];
+        const Vector2f& b = contours[0].vertices[(i + 1) % contours[0].vertices.size()];
+        ASSERT_TRUE(glm::length(b - a) < 1.5f);
+    }
+
+    // A pit is enclosed clockwise
+    for (float& h : heightmap) h = -h;
+    extractor.ExtractSingleContour(-0.5f, contours);
+    ASSERT_EQ(contours.size(), 1u);
+    ASSERT_TRUE(SignedArea(contours[0].vertices) < 0.0f);
+
+    // Simplification now has real polylines to work on
+    for (float& h : heightmap) h = -h;
+    HeightMapContourResult result = extractor.Extract(false, 0.5f);
+    ASSERT_EQ(result.mid_to_high_contours.size(), 1u);
+    ASSERT_TRUE(result.mid_to_high_contours[0].vertices.size() < contours[0].vertices.size());
+    ASSERT_EQ(result.low_to_mid_contours.size(), 1u);
+}
+
+void test_contour_saddle() {
+    // Diagonal corners high: the centre value decides whether they connect
+    float low_centre[4] = { 1.0f, 0.0f,
+                            0.0f, 0.9f };
+    HeightMapContourExtractor<float> low_extractor(low_centre, 2, 2, 0.5f, 0.5f);
+
+    std::vector<ContourPolygon> contours;
+    low_extractor.ExtractSingleContour(0.6f, contours);
+    ASSERT_EQ(contours.size(), 2u);
+
+    // Each piece cuts off one high corner
+    for (const ContourPolygon& c : contours) {
+        ASSERT_EQ(c.vertices.size(), 2u);
+        ASSERT_FALSE(c.is_closed);
+    }
+
+    // Centre above the threshold: the two segments cut off the low corners instead
+    low_extractor.ExtractSingleContour(0.4f, contours);
+    ASSERT_EQ(contours.size(), 2u);
+    for (const ContourPolygon& c : contours) {
+        const Vector2f mid = (c.vertices[0] + c.vertices[1]) * 0.5f;
+        ASSERT_TRUE((mid.x > 0.5f) != (mid.y > 0.5f));
+    }
+}
+
+void test_contour_multiple_islands() {
+    // Several separate plateaus each produce one closed loop; shared edge crossings are not duplicated
+    const int w = 40, h = 20;
+    std::vector<uint16_t> heightmap(w * h, 0);
+    for (int i = 0; i < 4; ++i)
+        for (int y = 5; y < 15; ++y)
+            for (int x = 2 + i * 10; x < 8 + i * 10; ++x)
+                heightmap[y * w + x] = 1000;
+
+    HeightMapContourExtractor<uint16_t> extractor(heightmap.data(), w, h, 250, 750);
+
+    std::vector<ContourPolygon> contours;
+    extractor.ExtractSingleContour(500, contours);
+
+    ASSERT_EQ(contours.size(), 4u);
+    for (const ContourPolygon& c : contours) {
+        ASSERT_TRUE(c.is_closed);
+        // 6x10 plateau: 2 * (6 + 10) boundary edges crossed
+        ASSERT_EQ(c.vertices.size(), 32u);
+        ASSERT_TRUE(SignedArea(c.vertices) > 0.0f);
+    }
+
+    // Degenerate grids produce nothing
+    extractor = HeightMapContourExtractor<uint16_t>(heightmap.data(), 1, h, 250, 750);
+    extractor.ExtractSingleContour(500, contours);
+    ASSERT_TRUE(contours.empty());
+}
+
+// ============================================================================
+// Multi-Level Extraction Tests
+// ============================================================================
+
+static void ContourSummary(const std::vector<ContourPolygon>& contours, size_t& vertex_count, size_t& closed_count, double& area) {
+    vertex_count = 0;
+    closed_count = 0;
+    area = 0.0;
+    for (const ContourPolygon& c : contours) {
+        vertex_count += c.vertices.size();
+        if (c.is_closed) {
+            closed_count++;
+            area += SignedArea(c.vertices);
+        }
+    }
+}
+
+void test_extract_levels_matches_single() {
+    const int w = 300, h = 230;
+    std::vector<float> terrain(w * h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            terrain[y * w + x] = std::sin(x * 0.05f) * std::cos(y * 0.07f) + 0.3f * std::sin((x + y) * 0.13f);
+
+    std::vector<float> levels;
+    for (int i = 0; i < 20; ++i)
+        levels.push_back(-1.2f + i * 0.12f);
+
+    HeightMapContourExtractor<float> extractor(terrain.data(), w, h, 0.0f, 0.5f);
+
+    ThreadParallelExecutor executor(4);
+    std::vector<std::vector<ContourPolygon>> serial, parallel;
+    extractor.ExtractLevels(levels, serial);
+    extractor.ExtractLevels(levels, parallel, &executor);
+
+    ASSERT_EQ(serial.size(), levels.size());
+    ASSERT_EQ(parallel.size(), levels.size());
+
+    size_t total = 0;
+    for (size_t l = 0; l < levels.size(); ++l) {
+        std::vector<ContourPolygon> single;
+        extractor.ExtractSingleContour(levels[l], single);
+
+        size_t v0, c0, v1, c1, v2, c2;
+        double a0, a1, a2;
+        ContourSummary(single, v0, c0, a0);
+        ContourSummary(serial[l], v1, c1, a1);
+        ContourSummary(parallel[l], v2, c2, a2);
+
+        // Seam crossings are computed by both bands but kept once
+        ASSERT_EQ(single.size(), serial[l].size());
+        ASSERT_EQ(single.size(), parallel[l].size());
+        ASSERT_EQ(v0, v1);
+        ASSERT_EQ(v0, v2);
+        ASSERT_EQ(c0, c2);
+        ASSERT_NEAR(a0, a2, 1e-3 * (std::abs(a0) + 1.0));
+
+        for (const ContourPolygon& c : parallel[l])
+            for (size_t i = 1; i < c.vertices.size(); ++i)
+                ASSERT_TRUE(glm::length(c.vertices[i] - c.vertices[i - 1]) < 1.5f);
+
+        total += single.size();
+    }
+    ASSERT_TRUE(total > 50);
+
+    // Extract() goes through the same path
+    HeightMapContourResult result = extractor.Extract(false, 0.0f, &executor);
+    std::vector<ContourPolygon> single;
+    extractor.ExtractSingleContour(0.5f, single);
+    ASSERT_EQ(result.mid_to_high_contours.size(), single.size());
+}
+
+void test_extract_levels_unsigned_interpolation() {
+    // threshold - value used to wrap around for uint32 data
+    uint32_t heightmap[4] = { 100, 300,
+                              100, 300 };
+    HeightMapContourExtractor<uint32_t> extractor(heightmap, 2, 2, 150, 250);
+
+    std::vector<std::vector<ContourPolygon>> levels;
+    extractor.ExtractLevels({ 150u, 200u, 250u }, levels);
+
+    ASSERT_EQ(levels.size(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(levels[i].size(), 1u);
+        ASSERT_EQ(levels[i][0].vertices.size(), 2u);
+        ASSERT_NEAR(levels[i][0].vertices[0].x, 0.25f + 0.25f * i, 1e-5f);
+    }
+
+    extractor.ExtractLevels({}, levels);
+    ASSERT_TRUE(levels.empty());
+}
+
+// ============================================================================
+// Streaming Extraction Tests
+// ============================================================================
+
+void test_streaming_matches_in_memory() {
+    const int w = 257, h = 199;
+    std::vector<float> terrain(w * h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            terrain[y * w + x] = std::sin(x * 0.06f) * std::cos(y * 0.05f) + 0.25f * std::cos((x - y) * 0.11f);
+
+    const std::vector<float> levels = { -0.9f, -0.4f, 0.0f, 0.35f, 0.8f };
+
+    HeightMapContourExtractor<float> extractor(terrain.data(), w, h, 0.0f, 0.5f);
+    std::vector<std::vector<ContourPolygon>> expected;
+    extractor.ExtractLevels(levels, expected);
+
+    // Bands of 7 rows read through a callback; only completed contours come out
+    std::vector<std::vector<ContourPolygon>> streamed(levels.size());
+    int reads = 0;
+
+    const bool ok = ExtractContoursStreaming<float>(w, h, 7, levels,
+        [&](int first_row, int row_count, float* buffer) {
+            std::copy(terrain.begin() + size_t(first_row) * w, terrain.begin() + size_t(first_row + row_count) * w, buffer);
+            reads++;
+            return true;
+        },
+        [&](size_t level, ContourPolygon&& contour) {
+            streamed[level].push_back(std::move(contour));
+        });
+
+    ASSERT_TRUE(ok);
+    ASSERT_EQ(reads, (h + 6) / 7);
+
+    for (size_t l = 0; l < levels.size(); ++l) {
+        size_t v0, c0, v1, c1;
+        double a0, a1;
+        ContourSummary(expected[l], v0, c0, a0);
+        ContourSummary(streamed[l], v1, c1, a1);
+
+        ASSERT_EQ(expected[l].size(), streamed[l].size());
+        ASSERT_EQ(v0, v1);
+        ASSERT_EQ(c0, c1);
+        ASSERT_NEAR(a0, a1, 1e-3 * (std::abs(a0) + 1.0));
+
+        for (const ContourPolygon& c : streamed[l]) {
+            for (size_t i = 1; i < c.vertices.size(); ++i)
+                ASSERT_TRUE(glm::length(c.vertices[i] - c.vertices[i - 1]) < 1.5f);
+            if (!c.is_closed) {
+                // Open contours start and end on the grid border
+                for (const Vector2f& v : { c.vertices.front(), c.vertices.back() })
+                    ASSERT_TRUE(v.x == 0.0f || v.y == 0.0f || v.x == float(w - 1) || v.y == float(h - 1));
+            }
+        }
+    }
+}
+
+void test_streaming_incremental_output() {
+    // Islands along the rows: each closes and is emitted as soon as the rows past it are pushed
+    const int w = 64, h = 64;
+    std::vector<uint8_t> heightmap(w * h, 0);
+    for (int i = 0; i < 3; ++i)
+        for (int y = 5 + i * 20; y < 15 + i * 20; ++y)
+            for (int x = 10; x < 50; ++x)
+                heightmap[y * w + x] = 200;
+
+    size_t emitted = 0;
+    HeightMapContourStream<uint8_t> stream(w, { 100 }, [&](size_t level, ContourPolygon&& contour) {
+        ASSERT_EQ(level, 0u);
+        ASSERT_TRUE(contour.is_closed);
+        ASSERT_EQ(contour.vertices.size(), 2u * (40 + 10));
+        emitted++;
+    });
+
+    size_t max_open = 0;
+    for (int y = 0; y < h; ++y) {
+        stream.PushRow(heightmap.data() + y * w);
+        max_open = std::max(max_open, stream.GetOpenContourCount());
+
+        if (y == 15) ASSERT_EQ(emitted, 1u);
+        if (y == 35) ASSERT_EQ(emitted, 2u);
+    }
+
+    // At most the two sides of the island that is still being swept are open
+    ASSERT_TRUE(max_open <= 2);
+
+    stream.Finish();
+    ASSERT_EQ(emitted, 3u);
+    ASSERT_EQ(stream.GetOpenContourCount(), 0u);
+    ASSERT_EQ(stream.GetRowCount(), h);
+
+    // Failing reads abort the extraction
+    const bool ok = ExtractContoursStreaming<uint8_t>(w, h, 16, { 100 },
+        [&](int first_row, int, uint8_t*) { return first_row < 32; },
+        nullptr);
+    ASSERT_FALSE(ok);
+}
+
 // ============================================================================
 // Douglas-Peucker Simplification Tests
 // ============================================================================
@@ -261,6 +583,358 @@ void test_mesh_data_export() {
     delete[] index_data;
 }
 
+void test_shoreline_index_matches_brute_force() {
+    // Several wavy contours; random queries inside and well outside their bounds
+    std::vector<ShorelineContour> contours;
+    for (int c = 0; c < 5; ++c) {
+        ShorelineContour contour;
+        float accumulated = 0;
+        Vector2f prev(c * 40.0f, 10.0f * std::sin(c * 1.3f));
+        for (int i = 1; i <= 200; ++i) {
+            Vector2f next(c * 40.0f + 15.0f * std::sin(i * 0.07f + c), i * 0.8f + 5.0f * std::cos(i * 0.31f));
+            ShorelineSegment seg;
+            seg.start = prev;
+            seg.end = next;
+            seg.length = glm::length(next - prev);
+            seg.accumulated_length = accumulated;
+            seg.normal = glm::normalize(Vector2f(-(next - prev).y, (next - prev).x));
+            accumulated += seg.length;
+            contour.segments.push_back(seg);
+            prev = next;
+        }
+        contour.total_length = accumulated;
+        contours.push_back(contour);
+    }
+
+    ShorelineSegmentIndex index;
+    index.Build(contours);
+    ASSERT_EQ(index.GetSegmentCount(), 1000u);
+
+    uint32_t seed = 12345;
+    auto rnd = [&]() { seed = seed * 1664525u + 1013904223u; return (seed >> 8) / float(1 << 24); };
+
+    for (int q = 0; q < 2000; ++q) {
+        const Vector2f p(rnd() * 400.0f - 100.0f, rnd() * 400.0f - 100.0f);
+
+        float best = std::numeric_limits<float>::max();
+        for (const ShorelineContour& contour : contours)
+            best = std::min(best, contour.QueryDistance(p));
+
+        ShorelineQueryResult r;
+        ASSERT_TRUE(index.Query(p, r));
+        ASSERT_NEAR(r.distance, best, 1e-3f);
+        ASSERT_NEAR(glm::length(p - r.closest_point), r.distance, 1e-3f);
+
+        // Near-ties may pick another segment, so check the arc-length against the reported point
+        ASSERT_TRUE(r.contour_id >= 0 && r.contour_id < int(contours.size()));
+        bool on_contour = false;
+        for (const ShorelineSegment& seg : contours[r.contour_id].segments) {
+            const float t = (r.distance_along_contour - seg.accumulated_length) / seg.length;
+            if (t < -1e-4f || t > 1.0f + 1e-4f) continue;
+            if (glm::length(seg.start + t * (seg.end - seg.start) - r.closest_point) < 1e-3f) on_contour = true;
+        }
+        ASSERT_TRUE(on_contour);
+    }
+
+    // Limited search radius misses far segments
+    ShorelineQueryResult far;
+    ASSERT_FALSE(index.Query(Vector2f(1000.0f, 1000.0f), far, 10.0f));
+    ASSERT_EQ(far.contour_id, -1);
+
+    ShorelineSegmentIndex empty;
+    empty.Build({});
+    ASSERT_TRUE(empty.IsEmpty());
+    ASSERT_FALSE(empty.Query(Vector2f(0, 0), far));
+}
+
+void test_shoreline_index_batch_parallel() {
+    ShorelineContour square;
+    const Vector2f corners[4] = { Vector2f(0, 0), Vector2f(10, 0), Vector2f(10, 10), Vector2f(0, 10) };
+    for (int i = 0; i < 4; ++i) {
+        ShorelineSegment seg;
+        seg.start = corners[i];
+        seg.end = corners[(i + 1) % 4];
+        seg.length = 10.0f;
+        seg.accumulated_length = i * 10.0f;
+        seg.normal = Vector2f(-(seg.end - seg.start).y, (seg.end - seg.start).x) / 10.0f;
+        square.segments.push_back(seg);
+    }
+    square.total_length = 40.0f;
+    square.is_closed = true;
+
+    ShorelineSegmentIndex index;
+    index.Build({ square }, 1.0f);
+
+    std::vector<Vector2f> points;
+    for (int y = -20; y <= 30; ++y)
+        for (int x = -20; x <= 30; ++x)
+            points.push_back(Vector2f(x + 0.25f, y + 0.5f));
+
+    std::vector<ShorelineQueryResult> serial(points.size()), parallel(points.size());
+    ThreadParallelExecutor executor(4);
+    index.QueryBatch(points.data(), points.size(), serial.data());
+    index.QueryBatch(points.data(), points.size(), parallel.data(), &executor);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(serial[i].distance, parallel[i].distance);
+        ASSERT_EQ(serial[i].distance_along_contour, parallel[i].distance_along_contour);
+        ASSERT_NEAR(serial[i].distance, square.QueryDistance(points[i]), 1e-4f);
+    }
+
+    // (5.25, -3.5): closest to the bottom edge, 5.25 along the contour
+    const size_t i = (-4 + 20) * 51 + (5 + 20);
+    ASSERT_NEAR(serial[i].distance, 3.5f, 1e-5f);
+    ASSERT_NEAR(serial[i].distance_along_contour, 5.25f, 1e-5f);
+    ASSERT_NEAR(serial[i].normal.y, 1.0f, 1e-5f);
+}
+
+void test_shallow_water_extract_island() {
+    // Round island: land above 150, water around it
+    const int w = 96, h = 96;
+    std::vector<uint8_t> heightmap(w * h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) {
+            const float r = std::sqrt(float((x - 48) * (x - 48) + (y - 48) * (y - 48)));
+            heightmap[y * w + x] = uint8_t(std::max(0.0f, std::min(255.0f, 255.0f - r * 6.0f)));
+        }
+
+    HeightMapContourExtractor<uint8_t> contour_extractor(heightmap.data(), w, h, 60, 150);
+    HeightMapContourResult contours = contour_extractor.Extract();
+    ASSERT_EQ(contours.mid_to_high_contours.size(), 1u);
+
+    ShallowWaterMeshConfig config;
+    config.grid_spacing = 1.0f;
+    config.max_wave_depth = 8.0f;
+
+    ShallowWaterDataExtractor extractor(&contours, config);
+    ThreadParallelExecutor executor(4);
+    ShallowWaterMeshData serial = extractor.Extract();
+    ShallowWaterMeshData mesh = extractor.Extract(&executor);
+
+    ASSERT_EQ(mesh.shore_contours.size(), 1u);
+    ASSERT_TRUE(mesh.vertices.size() > 0);
+    ASSERT_EQ(mesh.vertices.size(), serial.vertices.size());
+    ASSERT_EQ(mesh.indices.size() % 6, 0u);
+    ASSERT_EQ(mesh.indices.size(), serial.indices.size());
+
+    // Shore radius: 255 - r * 6 = 150
+    const float shore_r = 105.0f / 6.0f;
+    const ShorelineContour& shore = mesh.shore_contours[0];
+    size_t seaward = 0;
+
+    for (const ShallowWaterVertex& v : mesh.vertices) {
+        const float r = glm::length(v.position - Vector2f(48, 48));
+
+        // Signed distance: positive toward the sea, negative on land
+        ASSERT_NEAR(v.distance_to_shore, r - shore_r, 0.25f);
+        ASSERT_EQ(v.contour_id, 0);
+        ASSERT_TRUE(v.contour_position >= 0.0f && v.contour_position <= 1.0f);
+        ASSERT_TRUE(v.depth_normalized >= 0.0f && v.depth_normalized <= 1.0f);
+
+        // Normal points toward land (the island centre)
+        ASSERT_TRUE(glm::dot(v.shore_normal, Vector2f(48, 48) - v.position) > 0.0f);
+
+        // Every vertex is a corner of a cell touching the band
+        ASSERT_TRUE(v.distance_to_shore >= -config.grid_spacing * 2.5f);
+        ASSERT_TRUE(v.distance_to_shore <= config.max_wave_depth + config.grid_spacing * 1.5f);
+
+        if (v.distance_to_shore > 0.0f) seaward++;
+    }
+    ASSERT_TRUE(seaward > mesh.vertices.size() / 2);
+    ASSERT_NEAR(shore.total_length, 2.0f * 3.14159265f * shore_r, 1.0f);
+
+    for (uint32_t index : mesh.indices)
+        ASSERT_TRUE(index < mesh.vertices.size());
+
+    // Without indices only the vertices are produced
+    config.generate_indices = false;
+    ShallowWaterMeshData no_index = ShallowWaterDataExtractor(&contours, config).Extract();
+    ASSERT_EQ(no_index.vertices.size(), mesh.vertices.size());
+    ASSERT_TRUE(no_index.indices.empty());
+}
+
+static bool InsidePolygon(const std::vector<Vector2f>& polygon, const Vector2f& p) {
+    bool inside = false;
+    for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+        const Vector2f& a = polygon[i];
+        const Vector2f& b = polygon[j];
+        if ((a.y > p.y) != (b.y > p.y) && p.x < a.x + (p.y - a.y) / (b.y - a.y) * (b.x - a.x))
+            inside = !inside;
+    }
+    return inside;
+}
+
+void test_shallow_water_extract_spikes() {
+    // Star-shaped island with sharp spikes (counter-clockwise, land on the left): around the
+    // tips and the notches the nearest point is a vertex shared by two segments
+    ContourPolygon star;
+    star.is_closed = true;
+    for (int i = 0; i < 14; ++i) {
+        const float angle = i * 3.14159265f / 7.0f;
+        const float radius = (i % 2 == 0) ? 30.0f : 7.0f;
+        star.vertices.push_back(Vector2f(50.0f + radius * std::cos(angle), 50.0f + radius * std::sin(angle)));
+    }
+
+    HeightMapContourResult contours;
+    contours.mid_to_high_contours.push_back(star);
+
+    ShallowWaterMeshConfig config;
+    config.grid_spacing = 0.25f;
+    config.max_wave_depth = 6.0f;
+
+    ShallowWaterMeshData mesh = ShallowWaterDataExtractor(&contours, config).Extract();
+    ASSERT_TRUE(mesh.vertices.size() > 1000);
+
+    // Positive toward the sea, negative on land, no matter which segment was nearest
+    for (const ShallowWaterVertex& v : mesh.vertices) {
+        if (std::abs(v.distance_to_shore) < 1e-3f) continue;
+        ASSERT_EQ(v.distance_to_shore < 0.0f, InsidePolygon(star.vertices, v.position));
+    }
+
+    // The index normal gives the same sign everywhere around the contour
+    ShorelineSegmentIndex index;
+    index.Build(mesh.shore_contours);
+
+    for (int y = 0; y <= 400; ++y)
+        for (int x = 0; x <= 400; ++x) {
+            const Vector2f p(x * 0.25f, y * 0.25f);
+            ShorelineQueryResult r;
+            ASSERT_TRUE(index.Query(p, r));
+            if (r.distance < 1e-3f) continue;
+            ASSERT_EQ(glm::dot(p - r.closest_point, r.normal) > 0.0f, InsidePolygon(star.vertices, p));
+        }
+}
+
+// ============================================================================
+// Distance Transform Tests
+// ============================================================================
+
+void test_distance_transform_matches_brute_force() {
+    const int w = 97, h = 61;
+    std::vector<uint8_t> mask(w * h, 0);
+    std::vector<int> fx, fy;
+
+    uint32_t seed = 777;
+    for (int i = 0; i < 40; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const int x = int((seed >> 8) % w);
+        seed = seed * 1664525u + 1013904223u;
+        const int y = int((seed >> 8) % h);
+        mask[y * w + x] = 1;
+        fx.push_back(x);
+        fy.push_back(y);
+    }
+
+    std::vector<float> serial(w * h), parallel(w * h);
+    ThreadParallelExecutor executor(4);
+    ASSERT_TRUE(EuclideanDistanceTransform2D(mask.data(), w, h, serial.data()));
+    ASSERT_TRUE(EuclideanDistanceTransform2D(mask.data(), w, h, parallel.data(), &executor));
+
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) {
+            int best = w * w + h * h;
+            for (size_t i = 0; i < fx.size(); ++i)
+                best = std::min(best, (x - fx[i]) * (x - fx[i]) + (y - fy[i]) * (y - fy[i]));
+
+            // Exact: squared distances are integers
+            ASSERT_EQ(serial[y * w + x], float(std::sqrt(double(best))));
+            ASSERT_EQ(parallel[y * w + x], serial[y * w + x]);
+        }
+
+    // No feature pixels at all
+    std::vector<uint8_t> empty(w * h, 0);
+    ASSERT_TRUE(EuclideanDistanceTransform2D(empty.data(), w, h, serial.data()));
+    ASSERT_EQ(serial[0], std::numeric_limits<float>::max());
+
+    ASSERT_FALSE(EuclideanDistanceTransform2D(nullptr, w, h, serial.data()));
+    ASSERT_FALSE(EuclideanDistanceTransform2D(mask.data(), 0, h, serial.data()));
+}
+
+void test_signed_distance_transform() {
+    // Disc of radius 20 centred in a 64x64 raster
+    const int w = 64, h = 64;
+    std::vector<uint8_t> inside(w * h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            inside[y * w + x] = (x - 32) * (x - 32) + (y - 32) * (y - 32) <= 400 ? 1 : 0;
+
+    std::vector<float> sdf(w * h);
+    ThreadParallelExecutor executor(3);
+    ASSERT_TRUE(SignedDistanceTransform2D(inside.data(), w, h, sdf.data(), &executor));
+
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) {
+            const float d = sdf[y * w + x];
+            const float r = std::sqrt(float((x - 32) * (x - 32) + (y - 32) * (y - 32)));
+
+            ASSERT_TRUE(inside[y * w + x] ? d < 0.0f : d > 0.0f);
+            ASSERT_NEAR(d, r - 20.5f, 1.0f);
+        }
+
+    // Straight edge: exact half-pixel offsets
+    std::vector<uint8_t> half(w * h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            half[y * w + x] = x < 10 ? 1 : 0;
+
+    ASSERT_TRUE(SignedDistanceTransform2D(half.data(), w, h, sdf.data()));
+    ASSERT_EQ(sdf[5 * w + 9], -0.5f);
+    ASSERT_EQ(sdf[5 * w + 10], 0.5f);
+    ASSERT_EQ(sdf[5 * w + 30], 20.5f);
+    ASSERT_EQ(sdf[5 * w + 0], -9.5f);
+
+    // Everything inside
+    std::vector<uint8_t> full(w * h, 1);
+    ASSERT_TRUE(SignedDistanceTransform2D(full.data(), w, h, sdf.data()));
+    ASSERT_EQ(sdf[w * h - 1], std::numeric_limits<float>::lowest());
+}
+
+void test_shore_distance_field_matches_contour() {
+    // Island whose shore is the high threshold; the raster should agree with the contour
+    const int w = 128, h = 100;
+    std::vector<float> heightmap(w * h);
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) {
+            const float dx = (x - 60) / 35.0f, dy = (y - 48) / 25.0f;
+            heightmap[y * w + x] = 1.0f - std::sqrt(dx * dx + dy * dy);
+        }
+
+    HeightMapContourExtractor<float> extractor(heightmap.data(), w, h, -0.5f, 0.0f);
+
+    std::vector<float> field;
+    ThreadParallelExecutor executor(4);
+    ASSERT_TRUE(extractor.ComputeShoreDistanceField(0.0f, field, &executor));
+    ASSERT_EQ(field.size(), size_t(w * h));
+
+    HeightMapContourResult contours = extractor.Extract();
+    ShallowWaterMeshConfig config;
+    std::vector<ShorelineContour> shore, deep;
+    ShallowWaterDataExtractor(&contours, config).ExtractShorelineOnly(shore, deep);
+
+    ShorelineSegmentIndex index;
+    index.Build(shore);
+
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x) {
+            const float d = field[y * w + x];
+
+            // Land (height >= threshold) is negative, water positive
+            ASSERT_TRUE(heightmap[y * w + x] >= 0.0f ? d < 0.0f : d > 0.0f);
+
+            ShorelineQueryResult r;
+            ASSERT_TRUE(index.Query(Vector2f(float(x), float(y)), r));
+            ASSERT_NEAR(std::abs(d), r.distance, 1.0f);
+        }
+
+    std::vector<float> serial;
+    ASSERT_TRUE(extractor.ComputeShoreDistanceField(0.0f, serial));
+    ASSERT_TRUE(serial == field);
+
+    HeightMapContourExtractor<float> invalid(nullptr, w, h, 0.0f, 0.0f);
+    ASSERT_FALSE(invalid.ComputeShoreDistanceField(0.0f, field));
+    ASSERT_TRUE(field.empty());
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -273,6 +947,23 @@ int main()
     TEST(simple_heightmap_float);
     TEST(uniform_heightmap);
 
+    std::cout << "\n=== Contour Stitching Tests ===" << std::endl;
+
+    TEST(contour_open_polyline);
+    TEST(contour_closed_loop);
+    TEST(contour_saddle);
+    TEST(contour_multiple_islands);
+
+    std::cout << "\n=== Multi-Level Extraction Tests ===" << std::endl;
+
+    TEST(extract_levels_matches_single);
+    TEST(extract_levels_unsigned_interpolation);
+
+    std::cout << "\n=== Streaming Extraction Tests ===" << std::endl;
+
+    TEST(streaming_matches_in_memory);
+    TEST(streaming_incremental_output);
+
     std::cout << "\n=== Douglas-Peucker Simplification Tests ===" << std::endl;
 
     TEST(simplify_straight_line);
@@ -289,6 +980,16 @@ int main()
     TEST(shallow_water_mesh_config);
     TEST(shallow_water_data_extractor);
     TEST(mesh_data_export);
+    TEST(shoreline_index_matches_brute_force);
+    TEST(shoreline_index_batch_parallel);
+    TEST(shallow_water_extract_island);
+    TEST(shallow_water_extract_spikes);
+
+    std::cout << "\n=== Distance Transform Tests ===" << std::endl;
+
+    TEST(distance_transform_matches_brute_force);
+    TEST(signed_distance_transform);
+    TEST(shore_distance_field_matches_contour);
 
     std::cout << "\n=== All Tests Passed! ===" << std::endl;
 
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <numbers>
 #include <hgl/math/geometry/Polygon2D.h>
+#include <hgl/math/geometry/Polygon2DTriangulation.h>
 #include <hgl/math/VectorTypes.h>
 
 using namespace hgl::math;
@@ -583,6 +584,378 @@ void test_triangulate_default_min_edge() {
     ASSERT_EQ(triangles.size(), 6);
 }
 
+// ============================================================================
+// Monotone Partition Triangulation Tests
+// ============================================================================
+
+static bool PointInLoop(const std::vector<Vector2f>& loop, const Vector2f& p) {
+    bool inside = false;
+    for (size_t i = 0, j = loop.size() - 1; i < loop.size(); j = i++) {
+        if ((loop[i].y > p.y) != (loop[j].y > p.y) &&
+            p.x < (loop[j].x - loop[i].x) * (p.y - loop[i].y) / (loop[j].y - loop[i].y) + loop[i].x)
+            inside = !inside;
+    }
+    return inside;
+}
+
+/**
+ * Checks that triangles index the concatenated vertices, are CCW, lie inside
+ * the outer loop and outside the holes, and exactly cover the polygon area.
+ */
+static void CheckTriangulation(const std::vector<Vector2f>& outer,
+                               const std::vector<std::vector<Vector2f>>& holes,
+                               const std::vector<size_t>& triangles) {
+    std::vector<Vector2f> all = outer;
+    double expected_area = std::abs(Polygon2DSignedArea(outer));
+    size_t vertex_count = outer.size();
+
+    for (const auto& hole : holes) {
+        all.insert(all.end(), hole.begin(), hole.end());
+        expected_area -= std::abs(Polygon2DSignedArea(hole));
+        vertex_count += hole.size();
+    }
+
+    ASSERT_EQ(triangles.size() % 3, 0u);
+    ASSERT_EQ(triangles.size() / 3, vertex_count + 2 * holes.size() - 2);
+
+    double area = 0;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        ASSERT_TRUE(triangles[i] < all.size() && triangles[i + 1] < all.size() && triangles[i + 2] < all.size());
+
+        const Vector2f& a = all[triangles[i]];
+        const Vector2f& b = all[triangles[i + 1]];
+        const Vector2f& c = all[triangles[i + 2]];
+        const double cross = double(b.x - a.x) * (c.y - a.y) - double(b.y - a.y) * (c.x - a.x);
+
+        ASSERT_TRUE(cross >= 0);
+        area += cross * 0.5;
+
+        if (cross > 1e-6) {
+            const Vector2f centroid = (a + b + c) / 3.0f;
+            ASSERT_TRUE(PointInLoop(outer, centroid));
+            for (const auto& hole : holes)
+                ASSERT_FALSE(PointInLoop(hole, centroid));
+        }
+    }
+
+    ASSERT_NEAR(area, expected_area, expected_area * 1e-5 + 1e-6);
+}
+
+static std::vector<Vector2f> MakeRect(float x0, float y0, float x1, float y1) {
+    return { Vector2f(x0, y0), Vector2f(x1, y0), Vector2f(x1, y1), Vector2f(x0, y1) };
+}
+
+void test_monotone_simple_polygons() {
+    const std::vector<std::vector<Vector2f>> shapes = {
+        { Vector2f(0, 0), Vector2f(4, 0), Vector2f(0, 3) },
+        MakeRect(0, 0, 2, 2),
+        { Vector2f(0, 0), Vector2f(2, 0), Vector2f(2, 1), Vector2f(1, 1), Vector2f(1, 2), Vector2f(0, 2) },
+        { Vector2f(0, 3), Vector2f(1, 1), Vector2f(3, 1), Vector2f(1.5f, -0.5f), Vector2f(2.5f, -3),
+          Vector2f(0, -1.5f), Vector2f(-2.5f, -3), Vector2f(-1.5f, -0.5f), Vector2f(-3, 1), Vector2f(-1, 1) },
+    };
+
+    for (const auto& shape : shapes) {
+        std::vector<size_t> triangles;
+        ASSERT_TRUE(TriangulatePolygon2DMonotone(shape, triangles));
+        CheckTriangulation(shape, {}, triangles);
+
+        // Clockwise input keeps the original numbering and still yields CCW triangles
+        std::vector<Vector2f> reversed(shape.rbegin(), shape.rend());
+        ASSERT_TRUE(TriangulatePolygon2DMonotone(reversed, triangles));
+        CheckTriangulation(reversed, {}, triangles);
+    }
+}
+
+void test_monotone_comb_with_equal_y() {
+    // A comb: many teeth share the same y, producing split/merge vertices on horizontal runs
+    std::vector<Vector2f> comb;
+    const int teeth = 50;
+    comb.emplace_back(0, 0);
+    comb.emplace_back(float(teeth * 2), 0);
+    for (int i = teeth; i > 0; --i) {
+        comb.emplace_back(float(i * 2), 5);
+        comb.emplace_back(float(i * 2 - 1), 5);
+        comb.emplace_back(float(i * 2 - 1), 1);
+        comb.emplace_back(float(i * 2 - 2), 1);
+    }
+    comb.pop_back();
+    comb.emplace_back(0, 5);
+
+    std::vector<size_t> triangles;
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(comb, triangles));
+    CheckTriangulation(comb, {}, triangles);
+
+    // Rotated 90 degrees the teeth become horizontal
+    std::vector<Vector2f> rotated;
+    for (const Vector2f& p : comb)
+        rotated.emplace_back(-p.y, p.x);
+
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(rotated, triangles));
+    CheckTriangulation(rotated, {}, triangles);
+}
+
+void test_monotone_large_star() {
+    // Star-shaped polygon with random radii, many reflex vertices
+    std::vector<Vector2f> star;
+    uint32_t seed = 12345;
+    const size_t count = 20000;
+
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const float r = 50.0f + float(seed >> 8) / float(1u << 24) * 50.0f;
+        const float angle = float(i) / float(count) * 2.0f * std::numbers::pi_v<float>;
+        star.emplace_back(r * std::cos(angle), r * std::sin(angle));
+    }
+
+    std::vector<size_t> triangles;
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(star, triangles));
+    ASSERT_EQ(triangles.size(), (count - 2) * 3);
+
+    double area = 0;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        const Vector2f& a = star[triangles[i]];
+        const Vector2f& b = star[triangles[i + 1]];
+        const Vector2f& c = star[triangles[i + 2]];
+        area += 0.5 * (double(b.x - a.x) * (c.y - a.y) - double(b.y - a.y) * (c.x - a.x));
+    }
+    ASSERT_NEAR(area, Polygon2DArea(star), Polygon2DArea(star) * 1e-4);
+}
+
+void test_monotone_with_holes() {
+    const std::vector<Vector2f> outer = MakeRect(0, 0, 10, 10);
+
+    // One hole, wound either way
+    std::vector<std::vector<Vector2f>> holes = { MakeRect(3, 3, 6, 6) };
+    std::vector<size_t> triangles;
+
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(outer, holes, triangles));
+    CheckTriangulation(outer, holes, triangles);
+
+    std::reverse(holes[0].begin(), holes[0].end());
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(outer, holes, triangles));
+    CheckTriangulation(outer, holes, triangles);
+
+    // Grid of holes aligned on the same rows and columns
+    holes.clear();
+    for (int y = 0; y < 4; ++y)
+        for (int x = 0; x < 4; ++x)
+            holes.push_back(MakeRect(1 + x * 2.2f, 1 + y * 2.2f, 2 + x * 2.2f, 2 + y * 2.2f));
+
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(outer, holes, triangles));
+    CheckTriangulation(outer, holes, triangles);
+
+    // Concave outer loop with a triangular and a diamond hole
+    const std::vector<Vector2f> concave = {
+        Vector2f(0, 0), Vector2f(10, 0), Vector2f(10, 10), Vector2f(6, 10),
+        Vector2f(5, 4), Vector2f(4, 10), Vector2f(0, 10)
+    };
+    holes = {
+        { Vector2f(1, 1), Vector2f(3, 1), Vector2f(2, 3) },
+        { Vector2f(8, 5), Vector2f(9, 6), Vector2f(8, 7), Vector2f(7, 6) },
+    };
+
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(concave, holes, triangles));
+    CheckTriangulation(concave, holes, triangles);
+}
+
+void test_monotone_random_holes() {
+    // Concave star-shaped outer loops with small star-shaped holes well inside them
+    uint32_t seed = 2024;
+    auto rnd = [&]() { seed = seed * 1664525u + 1013904223u; return float(seed >> 8) / float(1u << 24); };
+    const Vector2f centres[3] = { Vector2f(-6, -3), Vector2f(0, 3), Vector2f(6, -3) };
+    const float tau = 2.0f * std::numbers::pi_v<float>;
+
+    for (int c = 0; c < 600; ++c) {
+        const int n = 8 + int(rnd() * 32);
+        const bool snap = (c % 3) == 2;
+
+        // Jittered angles keep every gap below pi, so the loop stays around the origin (inradius > 16)
+        std::vector<Vector2f> outer;
+        for (int i = 0; i < n; ++i) {
+            const float angle = (float(i) + (rnd() - 0.5f) * 0.6f) / float(n) * tau;
+            const float r = 20.0f + rnd() * 30.0f;
+            Vector2f p(r * std::cos(angle), r * std::sin(angle));
+            if (snap) p = Vector2f(std::round(p.x), std::round(p.y));
+            outer.push_back(p);
+        }
+
+        std::vector<std::vector<Vector2f>> holes;
+        const int hole_count = 1 + c % 3;
+        for (int h = 0; h < hole_count; ++h) {
+            const Vector2f o = centres[h];
+            std::vector<Vector2f> hole;
+
+            if (snap) {
+                // Axis-aligned and diamond holes on the integer grid: horizontal edges and equal-y vertices
+                const float a = 1.0f + std::floor(rnd() * 2.0f), b = 1.0f + std::floor(rnd() * 2.0f);
+                if (h % 2 == 0)
+                    hole = MakeRect(o.x - a, o.y - b, o.x + a, o.y + b);
+                else
+                    hole = { Vector2f(o.x - a, o.y), Vector2f(o.x, o.y - b), Vector2f(o.x + a, o.y), Vector2f(o.x, o.y + b) };
+            } else {
+                const int m = 3 + int(rnd() * 6);
+                for (int i = 0; i < m; ++i) {
+                    const float angle = (float(i) + (rnd() - 0.5f) * 0.6f) / float(m) * tau;
+                    const float r = 0.5f + rnd() * 2.0f;
+                    hole.emplace_back(o.x + r * std::cos(angle), o.y + r * std::sin(angle));
+                }
+            }
+
+            if (c % 2)
+                std::reverse(hole.begin(), hole.end());
+            holes.push_back(hole);
+        }
+
+        std::vector<size_t> triangles;
+        ASSERT_TRUE(TriangulatePolygon2DMonotone(outer, holes, triangles));
+        CheckTriangulation(outer, holes, triangles);
+    }
+
+    // Hole split/merge vertices next to a concave outer vertex; failed in double precision only
+    using Vector2dd = glm::vec<2, double>;
+    const std::vector<Vector2dd> outer = {
+        Vector2dd(-22.2524, 14.3007), Vector2dd(-10.1342, -2.97567), Vector2dd(9.236, -20.224),
+        Vector2dd(9.47405, -10.9336), Vector2dd(38.1791, -11.2104)
+    };
+    const std::vector<std::vector<Vector2dd>> holes = {
+        { Vector2dd(-3.48646, 1.18765), Vector2dd(-1.90191, -2.54129), Vector2dd(1.97418, -2.79975) }
+    };
+
+    std::vector<size_t> triangles;
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(outer, holes, triangles));
+    ASSERT_EQ(triangles.size(), 8u * 3u);
+
+    std::vector<Vector2dd> all = outer;
+    all.insert(all.end(), holes[0].begin(), holes[0].end());
+
+    double area = 0;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        const Vector2dd& a = all[triangles[i]];
+        const Vector2dd& b = all[triangles[i + 1]];
+        const Vector2dd& c = all[triangles[i + 2]];
+        const double cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        ASSERT_TRUE(cross > 0);
+        area += cross * 0.5;
+    }
+    ASSERT_NEAR(area, std::abs(Polygon2DSignedArea(outer)) - std::abs(Polygon2DSignedArea(holes[0])), 1e-9);
+}
+
+void test_monotone_invalid_input() {
+    std::vector<size_t> triangles;
+
+    ASSERT_FALSE(TriangulatePolygon2DMonotone(std::vector<Vector2f>{}, triangles));
+    ASSERT_FALSE(TriangulatePolygon2DMonotone(std::vector<Vector2f>{ Vector2f(0, 0), Vector2f(1, 0) }, triangles));
+    ASSERT_FALSE(TriangulatePolygon2DMonotone(std::vector<Vector2f>{ Vector2f(0, 0), Vector2f(1, 0), Vector2f(2, 0) }, triangles));
+    ASSERT_TRUE(triangles.empty());
+
+    // Repeated points are skipped
+    const std::vector<Vector2f> repeated = {
+        Vector2f(0, 0), Vector2f(0, 0), Vector2f(2, 0), Vector2f(2, 2), Vector2f(2, 2), Vector2f(0, 2), Vector2f(0, 0)
+    };
+    ASSERT_TRUE(TriangulatePolygon2DMonotone(repeated, triangles));
+    ASSERT_EQ(triangles.size(), 6u);
+}
+
+void test_indexed_ear_simple_polygons() {
+    const std::vector<std::vector<Vector2f>> shapes = {
+        { Vector2f(0, 0), Vector2f(4, 0), Vector2f(0, 3) },
+        MakeRect(0, 0, 2, 2),
+        { Vector2f(0, 0), Vector2f(2, 0), Vector2f(2, 1), Vector2f(1, 1), Vector2f(1, 2), Vector2f(0, 2) },
+        { Vector2f(0, 3), Vector2f(1, 1), Vector2f(3, 1), Vector2f(1.5f, -0.5f), Vector2f(2.5f, -3),
+          Vector2f(0, -1.5f), Vector2f(-2.5f, -3), Vector2f(-1.5f, -0.5f), Vector2f(-3, 1), Vector2f(-1, 1) },
+    };
+
+    for (const auto& shape : shapes) {
+        std::vector<size_t> triangles;
+        std::vector<size_t> reference;
+
+        ASSERT_TRUE(TriangulatePolygon2DIndexedEar(shape, triangles));
+        ASSERT_TRUE(TriangulatePolygon2D(shape, reference));
+        ASSERT_EQ(triangles.size(), reference.size());
+        CheckTriangulation(shape, {}, triangles);
+
+        std::vector<Vector2f> reversed(shape.rbegin(), shape.rend());
+        ASSERT_TRUE(TriangulatePolygon2DIndexedEar(reversed, triangles));
+        CheckTriangulation(reversed, {}, triangles);
+    }
+}
+
+void test_indexed_ear_comb() {
+    std::vector<Vector2f> comb;
+    const int teeth = 200;
+    comb.emplace_back(0, 0);
+    comb.emplace_back(float(teeth * 2), 0);
+    for (int i = teeth; i > 0; --i) {
+        comb.emplace_back(float(i * 2), 5);
+        comb.emplace_back(float(i * 2 - 1), 5);
+        comb.emplace_back(float(i * 2 - 1), 1);
+        comb.emplace_back(float(i * 2 - 2), 1);
+    }
+    comb.pop_back();
+    comb.emplace_back(0, 5);
+
+    std::vector<size_t> triangles;
+    ASSERT_TRUE(TriangulatePolygon2DIndexedEar(comb, triangles));
+    CheckTriangulation(comb, {}, triangles);
+}
+
+void test_indexed_ear_collinear_edges() {
+    // Square with many collinear points on every side: those vertices start out in the reflex grid
+    std::vector<Vector2f> square;
+    const int steps = 100;
+    for (int i = 0; i < steps; ++i) square.emplace_back(float(i), 0.0f);
+    for (int i = 0; i < steps; ++i) square.emplace_back(float(steps), float(i));
+    for (int i = 0; i < steps; ++i) square.emplace_back(float(steps - i), float(steps));
+    for (int i = 0; i < steps; ++i) square.emplace_back(0.0f, float(steps - i));
+
+    std::vector<size_t> triangles;
+    ASSERT_TRUE(TriangulatePolygon2DIndexedEar(square, triangles));
+    CheckTriangulation(square, {}, triangles);
+}
+
+void test_indexed_ear_large_star() {
+    std::vector<Vector2f> star;
+    uint32_t seed = 54321;
+    const size_t count = 20000;
+
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const float r = 50.0f + float(seed >> 8) / float(1u << 24) * 50.0f;
+        const float angle = float(i) / float(count) * 2.0f * std::numbers::pi_v<float>;
+        star.emplace_back(r * std::cos(angle), r * std::sin(angle));
+    }
+
+    std::vector<size_t> triangles;
+    ASSERT_TRUE(TriangulatePolygon2DIndexedEar(star, triangles));
+    ASSERT_EQ(triangles.size(), (count - 2) * 3);
+
+    double area = 0;
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        const Vector2f& a = star[triangles[i]];
+        const Vector2f& b = star[triangles[i + 1]];
+        const Vector2f& c = star[triangles[i + 2]];
+        const double cross = double(b.x - a.x) * (c.y - a.y) - double(b.y - a.y) * (c.x - a.x);
+        ASSERT_TRUE(cross >= 0);
+        area += 0.5 * cross;
+    }
+    ASSERT_NEAR(area, Polygon2DArea(star), Polygon2DArea(star) * 1e-4);
+}
+
+void test_indexed_ear_invalid_input() {
+    std::vector<size_t> triangles;
+
+    ASSERT_FALSE(TriangulatePolygon2DIndexedEar(std::vector<Vector2f>{}, triangles));
+    ASSERT_FALSE(TriangulatePolygon2DIndexedEar(std::vector<Vector2f>{ Vector2f(0, 0), Vector2f(1, 0) }, triangles));
+    ASSERT_FALSE(TriangulatePolygon2DIndexedEar(std::vector<Vector2f>{ Vector2f(0, 0), Vector2f(1, 0), Vector2f(2, 0) }, triangles));
+    ASSERT_TRUE(triangles.empty());
+
+    const std::vector<Vector2f> repeated = {
+        Vector2f(0, 0), Vector2f(0, 0), Vector2f(2, 0), Vector2f(2, 2), Vector2f(2, 2), Vector2f(0, 2), Vector2f(0, 0)
+    };
+    ASSERT_TRUE(TriangulatePolygon2DIndexedEar(repeated, triangles));
+    ASSERT_EQ(triangles.size(), 6u);
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -652,6 +1025,23 @@ int main()
     TEST(triangulate_default_min_edge);
     std::cout << std::endl;
 
+    std::cout << "--- Monotone Partition Triangulation Tests ---" << std::endl;
+    TEST(monotone_simple_polygons);
+    TEST(monotone_comb_with_equal_y);
+    TEST(monotone_large_star);
+    TEST(monotone_with_holes);
+    TEST(monotone_random_holes);
+    TEST(monotone_invalid_input);
+    std::cout << std::endl;
+
+    std::cout << "--- Indexed Ear Clipping Tests ---" << std::endl;
+    TEST(indexed_ear_simple_polygons);
+    TEST(indexed_ear_comb);
+    TEST(indexed_ear_collinear_edges);
+    TEST(indexed_ear_large_star);
+    TEST(indexed_ear_invalid_input);
+    std::cout << std::endl;
+
     std::cout << "===========================================" << std::endl;
     std::cout << "All tests PASSED!" << std::endl;
     std::cout << "===========================================" << std::endl;
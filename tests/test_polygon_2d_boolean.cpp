@@ -0,0 +1,352 @@
+﻿/**
+ * test_polygon_2d_boolean.cpp
+ *
+ * 2D多边形布尔运算与偏移的测试用例
+ * Tests for 2D polygon boolean operations and offsetting
+ */
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <numbers>
+#include <hgl/math/geometry/Polygon2D.h>
+#include <hgl/math/geometry/Polygon2DBoolean.h>
+#include <hgl/math/VectorTypes.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_EQ(a, b) \
+    if ((a) != (b)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static std::vector<Vector2d> MakeRect(double x0, double y0, double x1, double y1) {
+    return { Vector2d(x0, y0), Vector2d(x1, y0), Vector2d(x1, y1), Vector2d(x0, y1) };
+}
+
+static double SignedArea(const Polygon2DPaths& paths) {
+    double area = 0;
+    for (const auto& loop : paths)
+        area += Polygon2DSignedArea(loop);
+    return area;
+}
+
+static size_t CountLoops(const Polygon2DPaths& paths, bool ccw) {
+    size_t count = 0;
+    for (const auto& loop : paths)
+        if ((Polygon2DSignedArea(loop) > 0) == ccw)
+            count++;
+    return count;
+}
+
+static int Winding(const Polygon2DPaths& paths, const Vector2d& p) {
+    int winding = 0;
+    for (const auto& loop : paths) {
+        for (size_t i = 0, j = loop.size() - 1; i < loop.size(); j = i++) {
+            const Vector2d& a = loop[j];
+            const Vector2d& b = loop[i];
+            const double side = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+            if (a.y <= p.y && b.y > p.y && side > 0) winding++;
+            if (a.y > p.y && b.y <= p.y && side < 0) winding--;
+        }
+    }
+    return winding;
+}
+
+// ============================================================================
+// Boolean Operation Tests
+// ============================================================================
+
+void test_boolean_overlapping_squares() {
+    const Polygon2DPaths a = { MakeRect(0, 0, 2, 2) };
+    const Polygon2DPaths b = { MakeRect(1, 1, 3, 3) };
+    Polygon2DPaths out;
+
+    ASSERT_TRUE(Polygon2DBoolean(a, b, Polygon2DBooleanOp::Union, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out[0].size(), 8u);
+    ASSERT_NEAR(SignedArea(out), 7.0, 1e-9);
+
+    ASSERT_TRUE(Polygon2DBoolean(a, b, Polygon2DBooleanOp::Intersection, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out[0].size(), 4u);
+    ASSERT_NEAR(SignedArea(out), 1.0, 1e-9);
+
+    ASSERT_TRUE(Polygon2DBoolean(a, b, Polygon2DBooleanOp::Difference, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_NEAR(SignedArea(out), 3.0, 1e-9);
+
+    ASSERT_TRUE(Polygon2DBoolean(a, b, Polygon2DBooleanOp::Xor, out));
+    ASSERT_EQ(out.size(), 2u);
+    ASSERT_NEAR(SignedArea(out), 6.0, 1e-9);
+
+    // Clockwise input is interpreted the same way under NonZero
+    Polygon2DPaths reversed = b;
+    std::reverse(reversed[0].begin(), reversed[0].end());
+    ASSERT_TRUE(Polygon2DBoolean(a, reversed, Polygon2DBooleanOp::Union, out));
+    ASSERT_NEAR(SignedArea(out), 7.0, 1e-9);
+}
+
+void test_boolean_touching_and_disjoint() {
+    Polygon2DPaths out;
+
+    // Shared edge: merged into one rectangle without the collinear split vertices
+    ASSERT_TRUE(Polygon2DBoolean({ MakeRect(0, 0, 2, 2) }, { MakeRect(2, 0, 4, 2) }, Polygon2DBooleanOp::Union, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out[0].size(), 4u);
+    ASSERT_NEAR(SignedArea(out), 8.0, 1e-9);
+
+    // Partial edge overlap
+    ASSERT_TRUE(Polygon2DBoolean({ MakeRect(0, 0, 2, 2) }, { MakeRect(2, 1, 4, 5) }, Polygon2DBooleanOp::Union, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_NEAR(SignedArea(out), 12.0, 1e-9);
+
+    // Corner contact: two separate loops
+    ASSERT_TRUE(Polygon2DBoolean({ MakeRect(0, 0, 1, 1) }, { MakeRect(1, 1, 2, 2) }, Polygon2DBooleanOp::Union, out));
+    ASSERT_EQ(out.size(), 2u);
+    ASSERT_NEAR(SignedArea(out), 2.0, 1e-9);
+
+    // Disjoint intersection is empty
+    ASSERT_TRUE(Polygon2DBoolean({ MakeRect(0, 0, 1, 1) }, { MakeRect(5, 5, 6, 6) }, Polygon2DBooleanOp::Intersection, out));
+    ASSERT_TRUE(out.empty());
+
+    // Identical inputs
+    ASSERT_TRUE(Polygon2DBoolean({ MakeRect(0, 0, 1, 1) }, { MakeRect(0, 0, 1, 1) }, Polygon2DBooleanOp::Xor, out));
+    ASSERT_TRUE(out.empty());
+}
+
+void test_boolean_holes() {
+    Polygon2DPaths out;
+
+    ASSERT_TRUE(Polygon2DBoolean({ MakeRect(0, 0, 10, 10) }, { MakeRect(3, 3, 7, 7) }, Polygon2DBooleanOp::Difference, out));
+    ASSERT_EQ(out.size(), 2u);
+    ASSERT_EQ(CountLoops(out, true), 1u);
+    ASSERT_EQ(CountLoops(out, false), 1u);
+    ASSERT_NEAR(SignedArea(out), 84.0, 1e-9);
+
+    // Filling the hole back in
+    Polygon2DPaths filled;
+    ASSERT_TRUE(Polygon2DBoolean(out, { MakeRect(2, 2, 8, 8) }, Polygon2DBooleanOp::Union, filled));
+    ASSERT_EQ(filled.size(), 1u);
+    ASSERT_NEAR(SignedArea(filled), 100.0, 1e-9);
+
+    // Even-odd: nested squares in one input alternate
+    const Polygon2DPaths nested = { MakeRect(0, 0, 10, 10), MakeRect(2, 2, 8, 8), MakeRect(4, 4, 6, 6) };
+    ASSERT_TRUE(Polygon2DBoolean(nested, {}, Polygon2DBooleanOp::Union, out, Polygon2DFillRule::EvenOdd));
+    ASSERT_EQ(out.size(), 3u);
+    ASSERT_NEAR(SignedArea(out), 100.0 - 36.0 + 4.0, 1e-9);
+
+    ASSERT_TRUE(Polygon2DBoolean(nested, {}, Polygon2DBooleanOp::Union, out, Polygon2DFillRule::NonZero));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_NEAR(SignedArea(out), 100.0, 1e-9);
+}
+
+void test_boolean_many_footprints() {
+    // 30x30 overlapping footprints merge into a single square
+    Polygon2DPaths footprints;
+    for (int y = 0; y < 30; ++y)
+        for (int x = 0; x < 30; ++x)
+            footprints.push_back(MakeRect(x, y, x + 1.5, y + 1.5));
+
+    Polygon2DPaths out;
+    ASSERT_TRUE(Polygon2DBoolean(footprints, {}, Polygon2DBooleanOp::Union, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out[0].size(), 4u);
+    ASSERT_NEAR(SignedArea(out), 30.5 * 30.5, 1e-6);
+
+    // Rotated diamonds: every pair of neighbours crosses at non-grid points
+    footprints.clear();
+    for (int y = 0; y < 20; ++y)
+        for (int x = 0; x < 20; ++x)
+            footprints.push_back({ Vector2d(x + 0.5, y - 0.3), Vector2d(x + 1.3, y + 0.5),
+                                   Vector2d(x + 0.5, y + 1.3), Vector2d(x - 0.3, y + 0.5) });
+
+    ASSERT_TRUE(Polygon2DBoolean(footprints, {}, Polygon2DBooleanOp::Union, out));
+    ASSERT_EQ(CountLoops(out, true), 1u);
+
+    // Random samples rarely land exactly on a diamond edge, unlike a regular lattice
+    uint32_t seed = 4242;
+    for (int i = 0; i < 4000; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const double x = -0.5 + double(seed >> 8) / double(1u << 24) * 21.0;
+        seed = seed * 1664525u + 1013904223u;
+        const double y = -0.5 + double(seed >> 8) / double(1u << 24) * 21.0;
+
+        const Vector2d p(x, y);
+        ASSERT_EQ(Winding(out, p) != 0, Winding(footprints, p) != 0);
+    }
+}
+
+void test_boolean_random_against_sampling() {
+    uint32_t seed = 777;
+    auto random = [&]() {
+        seed = seed * 1664525u + 1013904223u;
+        return double(seed >> 8) / double(1u << 24);
+    };
+
+    const Polygon2DBooleanOp ops[] = { Polygon2DBooleanOp::Union, Polygon2DBooleanOp::Intersection,
+                                       Polygon2DBooleanOp::Difference, Polygon2DBooleanOp::Xor };
+
+    for (int round = 0; round < 20; ++round) {
+        // Self-intersecting random loops exercise the fill rule as well
+        Polygon2DPaths subject(2), clip(2);
+        for (auto* paths : { &subject, &clip })
+            for (auto& loop : *paths)
+                for (int i = 0; i < 7; ++i)
+                    loop.emplace_back(random() * 10.0, random() * 10.0);
+
+        for (Polygon2DFillRule rule : { Polygon2DFillRule::EvenOdd, Polygon2DFillRule::NonZero }) {
+            auto filled = [&](int winding) {
+                return rule == Polygon2DFillRule::EvenOdd ? (winding & 1) != 0 : winding != 0;
+            };
+
+            for (Polygon2DBooleanOp op : ops) {
+                Polygon2DPaths out;
+                ASSERT_TRUE(Polygon2DBoolean(subject, clip, op, out, rule));
+
+                for (double y = 0.013; y < 10.0; y += 0.31)
+                    for (double x = 0.007; x < 10.0; x += 0.29) {
+                        const Vector2d p(x, y);
+                        const bool s = filled(Winding(subject, p));
+                        const bool c = filled(Winding(clip, p));
+                        bool expected = s || c;
+                        if (op == Polygon2DBooleanOp::Intersection) expected = s && c;
+                        if (op == Polygon2DBooleanOp::Difference) expected = s && !c;
+                        if (op == Polygon2DBooleanOp::Xor) expected = s != c;
+
+                        ASSERT_EQ(Winding(out, p) != 0, expected);
+                    }
+            }
+        }
+    }
+}
+
+void test_boolean_invalid_input() {
+    Polygon2DPaths out = { MakeRect(0, 0, 1, 1) };
+
+    ASSERT_TRUE(Polygon2DBoolean({}, {}, Polygon2DBooleanOp::Union, out));
+    ASSERT_TRUE(out.empty());
+
+    // Degenerate loops are ignored
+    ASSERT_TRUE(Polygon2DBoolean({ { Vector2d(0, 0), Vector2d(1, 0) } }, {}, Polygon2DBooleanOp::Union, out));
+    ASSERT_TRUE(out.empty());
+
+    ASSERT_FALSE(Polygon2DBoolean({ { Vector2d(0, 0), Vector2d(NAN, 0), Vector2d(0, 1) } }, {}, Polygon2DBooleanOp::Union, out));
+}
+
+// ============================================================================
+// Offset Tests
+// ============================================================================
+
+void test_offset_square() {
+    const Polygon2DPaths square = { MakeRect(0, 0, 2, 2) };
+    Polygon2DPaths out;
+
+    ASSERT_TRUE(Polygon2DOffset(square, 1.0, out, Polygon2DJoinType::Miter));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out[0].size(), 4u);
+    ASSERT_NEAR(SignedArea(out), 16.0, 1e-9);
+
+    // Miter limit below sqrt(2) bevels the corners
+    ASSERT_TRUE(Polygon2DOffset(square, 1.0, out, Polygon2DJoinType::Miter, 1.2));
+    ASSERT_EQ(out[0].size(), 8u);
+    ASSERT_NEAR(SignedArea(out), 16.0 - 4 * 0.5, 1e-9);
+
+    ASSERT_TRUE(Polygon2DOffset(square, 1.0, out, Polygon2DJoinType::Round, 2.0, 0.001));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_NEAR(SignedArea(out), 4.0 + 8.0 + std::numbers::pi, 0.01);
+
+    ASSERT_TRUE(Polygon2DOffset(square, -0.5, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_NEAR(SignedArea(out), 1.0, 1e-9);
+
+    ASSERT_TRUE(Polygon2DOffset(square, -1.5, out));
+    ASSERT_TRUE(out.empty());
+}
+
+void test_offset_concave_and_holes() {
+    // L shape: the reflex corner stays sharp when inflating
+    const Polygon2DPaths l_shape = { { Vector2d(0, 0), Vector2d(4, 0), Vector2d(4, 1), Vector2d(1, 1), Vector2d(1, 4), Vector2d(0, 4) } };
+    Polygon2DPaths out;
+
+    ASSERT_TRUE(Polygon2DOffset(l_shape, 0.5, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out[0].size(), 6u);
+    ASSERT_NEAR(SignedArea(out), 5.0 * 2.0 + 3.0 * 2.0, 1e-9);
+
+    // Deflating the L splits nothing but shrinks both arms
+    ASSERT_TRUE(Polygon2DOffset(l_shape, -0.25, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_NEAR(SignedArea(out), 3.5 * 0.5 + 3.0 * 0.5, 1e-9);
+
+    // Ring: inflating shrinks the hole, deflating grows it
+    const Polygon2DPaths ring = { MakeRect(0, 0, 10, 10), MakeRect(7, 3, 3, 7) };   // clockwise hole
+
+    ASSERT_TRUE(Polygon2DOffset(ring, 1.0, out));
+    ASSERT_EQ(CountLoops(out, false), 1u);
+    ASSERT_NEAR(SignedArea(out), 144.0 - 4.0, 1e-9);
+
+    ASSERT_TRUE(Polygon2DOffset(ring, 2.5, out));
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_NEAR(SignedArea(out), 225.0, 1e-9);
+
+    ASSERT_TRUE(Polygon2DOffset(ring, -1.0, out));
+    ASSERT_EQ(CountLoops(out, false), 1u);
+    ASSERT_NEAR(SignedArea(out), 64.0 - 36.0, 1e-9);
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+
+int main()
+{
+    std::cout << "===========================================" << std::endl;
+    std::cout << "2D Polygon Boolean / Offset Tests" << std::endl;
+    std::cout << "===========================================" << std::endl;
+    std::cout << std::endl;
+
+    std::cout << "--- Boolean Operation Tests ---" << std::endl;
+    TEST(boolean_overlapping_squares);
+    TEST(boolean_touching_and_disjoint);
+    TEST(boolean_holes);
+    TEST(boolean_many_footprints);
+    TEST(boolean_random_against_sampling);
+    TEST(boolean_invalid_input);
+    std::cout << std::endl;
+
+    std::cout << "--- Offset Tests ---" << std::endl;
+    TEST(offset_square);
+    TEST(offset_concave_and_holes);
+    std::cout << std::endl;
+
+    std::cout << "===========================================" << std::endl;
+    std::cout << "All tests PASSED!" << std::endl;
+    std::cout << "===========================================" << std::endl;
+
+    return 0;
+}
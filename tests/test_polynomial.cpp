@@ -0,0 +1,240 @@
+﻿/**
+ * test_polynomial.cpp
+ *
+ * Test cases for the cubic/quartic root solvers
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <hgl/math/Polynomial.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Scalar Tests
+// ============================================================================
+
+void test_quadratic() {
+    double r[2];
+
+    ASSERT_TRUE(SolveQuadratic(1, -3, 2, r) == 2);
+    ASSERT_NEAR(r[0], 1.0, 1e-12);
+    ASSERT_NEAR(r[1], 2.0, 1e-12);
+
+    ASSERT_TRUE(SolveQuadratic(1, 0, 1, r) == 0);
+    ASSERT_TRUE(SolveQuadratic(1, -2, 1, r) == 1);
+    ASSERT_NEAR(r[0], 1.0, 1e-12);
+
+    // Large b: the cancellation-free form keeps the small root accurate
+    ASSERT_TRUE(SolveQuadratic(1, -1e8, 1, r) == 2);
+    ASSERT_NEAR(r[0], 1e-8, 1e-20);
+
+    // Linear fallback
+    ASSERT_TRUE(SolveQuadratic(0, 2, -4, r) == 1);
+    ASSERT_NEAR(r[0], 2.0, 1e-12);
+}
+
+void test_cubic() {
+    double r[3];
+
+    // (x+2)(x-1)(x-3)
+    ASSERT_TRUE(SolveCubic(1, -2, -5, 6, r) == 3);
+    ASSERT_NEAR(r[0], -2.0, 1e-10);
+    ASSERT_NEAR(r[1], 1.0, 1e-10);
+    ASSERT_NEAR(r[2], 3.0, 1e-10);
+
+    // (x-2)(x^2+1), scaled
+    ASSERT_TRUE(SolveCubic(3, -6, 3, -6, r) == 1);
+    ASSERT_NEAR(r[0], 2.0, 1e-10);
+
+    // (x-1)^2(x+2): the double root comes back twice
+    ASSERT_TRUE(SolveCubic(1, 0, -3, 2, r) == 3);
+    ASSERT_NEAR(r[0], -2.0, 1e-10);
+    ASSERT_NEAR(r[1], 1.0, 1e-6);
+    ASSERT_NEAR(r[2], 1.0, 1e-6);
+
+    // Degenerate leading coefficient drops to quadratic
+    ASSERT_TRUE(SolveCubic(0, 1, -3, 2, r) == 2);
+    ASSERT_NEAR(r[0], 1.0, 1e-12);
+}
+
+void test_quartic() {
+    double r[4];
+
+    // (x+3)(x+1)(x-2)(x-4) = x^4 - 2x^3 - 13x^2 + 14x + 24
+    ASSERT_TRUE(SolveQuartic(1, -2, -13, 14, 24, r) == 4);
+    ASSERT_NEAR(r[0], -3.0, 1e-9);
+    ASSERT_NEAR(r[1], -1.0, 1e-9);
+    ASSERT_NEAR(r[2], 2.0, 1e-9);
+    ASSERT_NEAR(r[3], 4.0, 1e-9);
+
+    // (x^2-1)(x^2+4): two real roots
+    ASSERT_TRUE(SolveQuartic(2, 0, 6, 0, -8, r) == 2);
+    ASSERT_NEAR(r[0], -1.0, 1e-9);
+    ASSERT_NEAR(r[1], 1.0, 1e-9);
+
+    // (x^2+1)(x^2+2): none
+    ASSERT_TRUE(SolveQuartic(1, 0, 3, 0, 2, r) == 0);
+
+    // Biquadratic (x^2-1)(x^2-9)
+    ASSERT_TRUE(SolveQuartic(1, 0, -10, 0, 9, r) == 4);
+    ASSERT_NEAR(r[0], -3.0, 1e-9);
+    ASSERT_NEAR(r[3], 3.0, 1e-9);
+
+    // Widely spread roots: (x-0.001)(x-1)(x-10)(x-1000)
+    double e[4] = {0.001, 1.0, 10.0, 1000.0};
+    double c3 = -(e[0] + e[1] + e[2] + e[3]);
+    double c2 = e[0]*e[1] + e[0]*e[2] + e[0]*e[3] + e[1]*e[2] + e[1]*e[3] + e[2]*e[3];
+    double c1 = -(e[0]*e[1]*e[2] + e[0]*e[1]*e[3] + e[0]*e[2]*e[3] + e[1]*e[2]*e[3]);
+    double c0 = e[0]*e[1]*e[2]*e[3];
+    ASSERT_TRUE(SolveQuartic(1, c3, c2, c1, c0, r) == 4);
+    for (int i = 0; i < 4; ++i)
+        ASSERT_NEAR(r[i], e[i], e[i] * 1e-6);
+
+    // Degenerate leading coefficient drops to cubic
+    ASSERT_TRUE(SolveQuartic(0, 1, -2, -5, 6, r) == 3);
+    ASSERT_NEAR(r[2], 3.0, 1e-10);
+}
+
+// ============================================================================
+// Batch Tests
+// ============================================================================
+
+void test_cubic_batch_matches_scalar() {
+    const size_t count = 257;
+    std::vector<float> a(count), b(count), c(count), d(count), roots(count * 3);
+    std::vector<uint8_t> n(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = (i % 17 == 0) ? 0.0f : 1.0f + float(i % 5);
+        b[i] = std::sin(i * 0.37f) * 4;
+        c[i] = std::cos(i * 0.91f) * 6;
+        d[i] = std::sin(i * 1.73f) * 3;
+    }
+
+    SolveCubicBatch(a.data(), b.data(), c.data(), d.data(), count, roots.data(), n.data());
+
+    for (size_t i = 0; i < count; ++i) {
+        double r[3];
+        int expected = SolveCubic(a[i], b[i], c[i], d[i], r);
+        ASSERT_TRUE(n[i] == expected);
+        for (int k = 0; k < expected; ++k)
+            ASSERT_NEAR(roots[i * 3 + k], float(r[k]), 1e-4f * (1.0f + std::fabs(float(r[k]))));
+    }
+}
+
+void test_quartic_batch_matches_scalar() {
+    const size_t count = 301;
+    std::vector<float> a(count), b(count), c(count), d(count), e(count), roots(count * 4);
+    std::vector<uint8_t> n(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        // Build most lanes from known real roots so four-root cases are common
+        float r0 = std::sin(i * 0.3f) * 5, r1 = std::cos(i * 0.7f) * 3, r2 = std::sin(i * 1.1f) * 2;
+        float r3 = (i % 3 == 0) ? r2 + 0.5f : std::cos(i * 1.9f) * 4;
+        a[i] = (i % 23 == 0) ? 0.0f : 1.0f;
+        b[i] = -(r0 + r1 + r2 + r3);
+        c[i] = r0*r1 + r0*r2 + r0*r3 + r1*r2 + r1*r3 + r2*r3 + ((i % 4 == 1) ? 8.0f : 0.0f);
+        d[i] = -(r0*r1*r2 + r0*r1*r3 + r0*r2*r3 + r1*r2*r3);
+        e[i] = r0*r1*r2*r3;
+    }
+
+    SolveQuarticBatch(a.data(), b.data(), c.data(), d.data(), e.data(), count, roots.data(), n.data());
+
+    for (size_t i = 0; i < count; ++i) {
+        double r[4];
+        int expected = SolveQuartic(a[i], b[i], c[i], d[i], e[i], r);
+        ASSERT_TRUE(n[i] == expected);
+        for (int k = 0; k < expected; ++k) {
+            double x = roots[i * 4 + k];
+            double f = (((a[i] * x + b[i]) * x + c[i]) * x + d[i]) * x + e[i];
+            ASSERT_NEAR(roots[i * 4 + k], float(r[k]), 1e-4f * (1.0f + std::fabs(float(r[k]))));
+            ASSERT_TRUE(std::fabs(f) < 1e-2 * (1.0 + std::fabs(x * x * x * x)));
+        }
+    }
+}
+
+void test_batch_wide_coefficient_range() {
+    // Roots scaled from 1e-8 to 1e8 push the cube-root argument far outside float range
+    const size_t count = 84;
+    std::vector<float> a(count), b(count), c(count), d(count), e(count), roots(count * 4);
+    std::vector<uint8_t> n(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const float s = std::pow(10.0f, float(int(i % 17) - 8));
+        const float r0 = (1.0f + std::sin(i * 0.7f)) * s, r1 = std::cos(i * 1.3f) * 2 * s;
+        const float r2 = (i % 2) ? -3.0f * s : r1 + 4.0f * s;
+        a[i] = 1.0f;
+        b[i] = -(r0 + r1 + r2);
+        c[i] = r0*r1 + r0*r2 + r1*r2 + ((i % 3 == 0) ? 9.0f * s * s : 0.0f);
+        d[i] = -r0*r1*r2;
+        e[i] = s * s * s * s;
+    }
+
+    SolveCubicBatch(a.data(), b.data(), c.data(), d.data(), count, roots.data(), n.data());
+
+    for (size_t i = 0; i < count; ++i) {
+        const double s = std::pow(10.0, double(int(i % 17) - 8));
+        double r[3];
+        int expected = SolveCubic(a[i], b[i], c[i], d[i], r);
+        ASSERT_TRUE(n[i] == expected);
+        for (int k = 0; k < expected; ++k)
+            ASSERT_NEAR(roots[i * 3 + k] / s, r[k] / s, 1e-4);
+    }
+
+    SolveQuarticBatch(a.data(), b.data(), c.data(), d.data(), e.data(), count, roots.data(), n.data());
+
+    for (size_t i = 0; i < count; ++i) {
+        const double s = std::pow(10.0, double(int(i % 17) - 8));
+        double r[4];
+        int expected = SolveQuartic(a[i], b[i], c[i], d[i], e[i], r);
+        ASSERT_TRUE(n[i] == expected);
+        for (int k = 0; k < expected; ++k)
+            ASSERT_NEAR(roots[i * 4 + k] / s, r[k] / s, 1e-4);
+    }
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::cout << "=== Polynomial Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Scalar Tests ---" << std::endl;
+    TEST(quadratic);
+    TEST(cubic);
+    TEST(quartic);
+
+    std::cout << std::endl << "--- Batch Tests ---" << std::endl;
+    TEST(cubic_batch_matches_scalar);
+    TEST(quartic_batch_matches_scalar);
+    TEST(batch_wide_coefficient_range);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
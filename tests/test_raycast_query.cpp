@@ -6,13 +6,21 @@
  */
 
 #include <cassert>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <vector>
 #include <hgl/math/geometry/queries/RaycastQuery.h>
 #include <hgl/math/geometry/primitives/Sphere.h>
 #include <hgl/math/geometry/primitives/Capsule.h>
 #include <hgl/math/geometry/primitives/Cylinder.h>
+#include <hgl/math/geometry/primitives/Torus.h>
 #include <hgl/math/geometry/Ray.h>
+#include <hgl/math/geometry/PreparedRay.h>
+#include <hgl/math/geometry/OBB.h>
+#include <hgl/math/geometry/BatchQueryStructures.h>
+#include <hgl/math/ParallelFor.h>
+#include <hgl/graph/CameraInfo.h>
 #include <hgl/math/geometry/Plane.h>
 #include <hgl/math/geometry/AABB.h>
 
@@ -289,6 +297,391 @@ void test_multiple_rays_same_sphere() {
     ASSERT_TRUE(RaycastQuery::Intersects(ray3, sphere));
 }
 
+// ============================================================================
+// Ray-Torus Tests
+// ============================================================================
+
+void test_ray_torus_through_tube() {
+    Torus torus(Vector3f(0, 0, 0), Vector3f(0, 0, 1), 2.0f, 0.5f);
+    Ray ray(Vector3f(-5, 0, 0), Vector3f(1, 0, 0));
+
+    float t;
+    ASSERT_TRUE(RaycastQuery::Intersects(ray, torus, t));
+    ASSERT_NEAR(t, 2.5f, 1e-4f);
+}
+
+void test_ray_torus_through_hole() {
+    Torus torus(Vector3f(1, 2, 3), Vector3f(0, 0, 1), 2.0f, 0.5f);
+
+    // Straight down the axis passes through the hole
+    ASSERT_FALSE(RaycastQuery::Intersects(Ray(Vector3f(1, 2, 10), Vector3f(0, 0, -1)), torus));
+
+    // Inside the bounding sphere but still missing the tube
+    ASSERT_FALSE(RaycastQuery::Intersects(Ray(Vector3f(1, -5, 3.6f), Vector3f(0, 1, 0)), torus));
+}
+
+void test_ray_torus_from_inside_tube() {
+    Torus torus(Vector3f(0, 0, 0), Vector3f(0, 1, 0), 2.0f, 0.5f);
+    Ray ray(Vector3f(2, 0, 0), Vector3f(0, 1, 0));
+
+    float t;
+    ASSERT_TRUE(RaycastQuery::Intersects(ray, torus, t));
+    ASSERT_NEAR(t, 0.5f, 1e-4f);
+}
+
+void test_ray_torus_detailed_hit() {
+    Torus torus(Vector3f(0, 0, 0), Vector3f(0, 0, 1), 3.0f, 1.0f);
+    Ray ray(Vector3f(3, 0, 10), Vector3f(0, 0, -2));     // Unnormalized direction
+
+    RaycastHit hit = RaycastQuery::Test(ray, torus);
+    ASSERT_TRUE(hit.hit);
+    ASSERT_NEAR(hit.distance, 4.5f, 1e-4f);
+    ASSERT_NEAR(hit.point.z, 1.0f, 1e-4f);
+    ASSERT_NEAR(hit.normal.z, 1.0f, 1e-4f);
+}
+
+void test_ray_torus_outer_equator() {
+    // Hits near the outer equator, where the torus touches its bounding sphere:
+    // the entry root is about zero from the sphere entry and must not be lost
+    Torus torus(Vector3f(0, 0, 0), Vector3f(0, 1, 0), 2.0f, 0.5f);
+    Ray ray(Vector3f(5.443212f, 5.993952f, 2.576288f), Vector3f(-0.323599f, -0.4999f, -0.052137f));
+
+    float t;
+    ASSERT_TRUE(RaycastQuery::Intersects(ray, torus, t));
+    ASSERT_NEAR(t, 11.9907f, 1e-3f);
+
+    // Exactly tangent to the bounding sphere at the equator
+    ASSERT_TRUE(RaycastQuery::Intersects(Ray(Vector3f(-5, 0, 2.5f), Vector3f(1, 0, 0)), torus, t));
+    ASSERT_NEAR(t, 5.0f, 1e-2f);
+}
+
+void test_ray_torus_matches_march() {
+    Torus torus(Vector3f(0.5f, -1, 2), Normalized(Vector3f(0.3f, 1, 0.2f)), 2.0f, 0.6f);
+
+    // Signed implicit function, negative inside the tube
+    auto inside = [&](const Vector3f &p) {
+        Vector3f local = p - torus.GetCenter();
+        float h = Dot(local, torus.GetAxis());
+        float planar = std::sqrt(std::max(Dot(local, local) - h * h, 0.0f));
+        return (planar - torus.GetMajorRadius()) * (planar - torus.GetMajorRadius()) + h * h
+             - torus.GetMinorRadius() * torus.GetMinorRadius();
+    };
+
+    int hits = 0;
+
+    for (int i = 0; i < 200; ++i) {
+        Vector3f origin(std::sin(i * 1.3f) * 6, std::cos(i * 0.7f) * 6, std::sin(i * 2.1f) * 6);
+        Vector3f target = torus.GetCenter() + Vector3f(std::sin(i * 0.9f), std::cos(i * 1.7f), std::sin(i * 0.4f)) * 2.0f;
+        Ray ray(origin, Normalized(target - origin));
+
+        // Reference: first sign change along a fine march
+        float expected = -1.0f;
+        float prev = inside(origin);
+        for (float s = 0.001f; s < 20.0f; s += 0.001f) {
+            float cur = inside(ray.origin + ray.direction * s);
+            if ((cur < 0) != (prev < 0)) { expected = s; break; }
+            prev = cur;
+        }
+
+        float t;
+        bool hit = RaycastQuery::Intersects(ray, torus, t);
+
+        // Grazing rays can be missed by the march; only compare clear hits
+        if (expected > 0) {
+            ASSERT_TRUE(hit);
+            ASSERT_NEAR(t, expected, 2e-3f);
+            ++hits;
+        }
+        else if (hit) {
+            ASSERT_NEAR(inside(ray.origin + ray.direction * t), 0.0f, 1e-3f);
+        }
+    }
+
+    ASSERT_TRUE(hits > 50);
+}
+
+// ============================================================================
+// Prepared Ray Tests
+// ============================================================================
+
+void test_prepared_ray_aabb_matches_ray() {
+    for (int i = 0; i < 500; ++i) {
+        Vector3f origin(std::sin(i * 1.1f) * 8, std::cos(i * 0.3f) * 8, std::sin(i * 0.7f) * 8);
+        Vector3f dir(std::cos(i * 2.3f), std::sin(i * 1.9f), std::cos(i * 0.5f));
+        if (i % 5 == 0) dir.x = 0.0f;                   // Axis parallel slabs
+        if (i % 7 == 0) dir.y = 0.0f;
+
+        Vector3f center(std::sin(i * 0.2f) * 3, std::cos(i * 0.9f) * 3, 0.0f);
+        AABB box;
+        box.SetMinMax(center - Vector3f(1.5f, 2.0f, 1.0f), center + Vector3f(1.5f, 2.0f, 1.0f));
+
+        Ray ray(origin, dir);
+        PreparedRay prepared(ray);
+
+        float t_ray = 0, t_prepared = 0;
+        bool hit_ray = RaycastQuery::Intersects(ray, box, t_ray);
+        bool hit_prepared = RaycastQuery::Intersects(prepared, box, t_prepared);
+
+        ASSERT_TRUE(hit_ray == hit_prepared);
+        if (hit_ray)
+            ASSERT_NEAR(t_ray, t_prepared, 1e-4f);
+
+        float t_min, t_max, p_min, p_max;
+        ASSERT_TRUE(box.IntersectsRay(ray, t_min, t_max) == box.IntersectsRay(prepared, p_min, p_max));
+    }
+}
+
+void test_prepared_ray_slab_boundary() {
+    AABB box;
+    box.SetMinMax(Vector3f(0, 0, 0), Vector3f(1, 1, 1));
+
+    // Travels inside the x=0 face: 0*inf must not poison the interval
+    PreparedRay on_face(Ray(Vector3f(0, 0.5f, -2), Vector3f(0, 0, 1)));
+    ASSERT_TRUE(box.IntersectsRay(on_face));
+
+    PreparedRay outside(Ray(Vector3f(-0.01f, 0.5f, -2), Vector3f(0, 0, 1)));
+    ASSERT_FALSE(box.IntersectsRay(outside));
+
+    float t;
+    ASSERT_TRUE(box.IntersectsRay(on_face, t));
+    ASSERT_NEAR(t, 2.0f, 1e-5f);
+}
+
+void test_prepared_ray_obb() {
+    OBB obb(Vector3f(2, 0, 0), Vector3f(0.7071f, 0.7071f, 0), Vector3f(-0.7071f, 0.7071f, 0), Vector3f(0, 0, 1), Vector3f(1, 1, 1));
+    Ray ray(Vector3f(-5, 0, 0), Vector3f(1, 0, 0));
+
+    float t_ray, t_prepared;
+    ASSERT_TRUE(RaycastQuery::Intersects(ray, obb, t_ray));
+    ASSERT_TRUE(RaycastQuery::Intersects(PreparedRay(ray), obb, t_prepared));
+    ASSERT_NEAR(t_ray, t_prepared, 1e-6f);
+    ASSERT_NEAR(t_ray, 7.0f - 1.41421f, 1e-3f);
+
+    // Crosses the corner of the rotated box's AABB but not the box itself
+    ASSERT_FALSE(RaycastQuery::Intersects(Ray(Vector3f(3.3f, 1.3f, -5), Vector3f(0, 0, 1)), obb));
+}
+
+void test_watertight_triangle_matches_moller() {
+    Vector3f v0(0, 0, 0), v1(2, 0, 0), v2(0, 2, 0);
+
+    for (int i = 0; i < 200; ++i) {
+        Vector3f origin(std::sin(i * 0.37f) * 2 + 0.5f, std::cos(i * 0.61f) * 2 + 0.5f, 3.0f + (i % 3));
+        Vector3f dir(std::sin(i * 1.3f) * 0.3f, std::cos(i * 0.9f) * 0.3f, -1.0f);
+        Ray ray(origin, dir);
+
+        float t0, u0, w0, t1, u1, w1;
+        bool moller = RaycastQuery::IntersectsTriangle(ray, v0, v1, v2, t0, u0, w0);
+        bool woop = RaycastQuery::IntersectsTriangle(PreparedRay(ray), v0, v1, v2, t1, u1, w1);
+
+        // Only rays clearly inside or outside are compared
+        Vector3f p = origin + dir * (-origin.z / dir.z);
+        float margin = std::min(std::min(p.x, p.y), 2.0f - p.x - p.y);
+        if (std::fabs(margin) < 1e-3f)
+            continue;
+
+        ASSERT_TRUE(moller == woop);
+        if (moller) {
+            ASSERT_NEAR(t0, t1, 1e-4f);
+            ASSERT_NEAR(u0, u1, 1e-4f);
+            ASSERT_NEAR(w0, w1, 1e-4f);
+        }
+    }
+}
+
+void test_watertight_shared_edge() {
+    // Two triangles sharing the diagonal of a unit square
+    Vector3f a(0, 0, 0), b(1, 0, 0), c(1, 1, 0), d(0, 1, 0);
+
+    const Vector3f dir(0.013f, -0.007f, -1.0f);
+
+    for (int i = 0; i <= 100; ++i) {
+        float s = i / 100.0f;
+
+        // Aimed exactly at the diagonal point (s,s,0)
+        PreparedRay ray(Ray(Vector3f(s, s, 0) - dir, dir));
+
+        float t;
+        bool hit_lower = RaycastQuery::IntersectsTriangle(ray, a, b, c, t);
+        bool hit_upper = RaycastQuery::IntersectsTriangle(ray, a, c, d, t);
+
+        if (s > 0.0f && s < 1.0f)
+            ASSERT_TRUE(hit_lower || hit_upper);
+    }
+}
+
+// ============================================================================
+// Batch Ray-Triangle Tests
+// ============================================================================
+
+void test_batch_triangles_match_single() {
+    BatchTriangleSOA triangles;
+    std::vector<Vector3f> verts;
+
+    for (int i = 0; i < 37; ++i) {
+        Vector3f c(std::sin(i * 1.7f) * 4, std::cos(i * 0.8f) * 4, std::sin(i * 0.3f) * 4);
+        Vector3f a = c + Vector3f(std::sin(i * 2.1f), std::cos(i * 1.3f), 0.3f) * 1.5f;
+        Vector3f b = c + Vector3f(std::cos(i * 0.7f), -0.4f, std::sin(i * 1.9f)) * 1.5f;
+        Vector3f d = c + Vector3f(-0.5f, std::sin(i * 0.5f), std::cos(i * 2.9f)) * 1.5f;
+        triangles.Add(a, b, d);
+        verts.insert(verts.end(), {a, b, d});
+    }
+
+    int hits = 0;
+
+    for (int r = 0; r < 300; ++r) {
+        Vector3f origin(std::sin(r * 0.9f) * 10, std::cos(r * 1.3f) * 10, std::sin(r * 2.3f) * 10);
+        Vector3f target(std::sin(r * 0.4f) * 3, std::cos(r * 0.6f) * 3, std::sin(r * 0.2f) * 3);
+        PreparedRay ray(Ray(origin, target - origin));
+
+        float best = 1000.0f;
+        int best_index = -1;
+        float best_u = 0, best_v = 0;
+
+        for (int i = 0; i < 37; ++i) {
+            float t, u, v;
+            if (RaycastQuery::IntersectsTriangle(ray, verts[i * 3], verts[i * 3 + 1], verts[i * 3 + 2], t, u, v) && t < best) {
+                best = t; best_index = i; best_u = u; best_v = v;
+            }
+        }
+
+        RayTriangleHit hit;
+        bool found = RaycastQuery::IntersectsTriangles(ray, triangles, 1000.0f, hit);
+
+        ASSERT_TRUE(found == (best_index >= 0));
+        if (found) {
+            ASSERT_TRUE(int(hit.index) == best_index);
+            ASSERT_NEAR(hit.distance, best, 1e-5f);
+            ASSERT_NEAR(hit.u, best_u, 1e-5f);
+            ASSERT_NEAR(hit.v, best_v, 1e-5f);
+            ++hits;
+        }
+    }
+
+    ASSERT_TRUE(hits > 30);
+}
+
+void test_triangle_packet8() {
+    TrianglePacket8 packet;
+
+    // Stacked quads' lower triangles at z = 1..5, only five slots used
+    for (int i = 0; i < 5; ++i)
+        ASSERT_TRUE(packet.Add(Vector3f(0, 0, 5.0f - i), Vector3f(1, 0, 5.0f - i), Vector3f(0, 1, 5.0f - i)));
+
+    PreparedRay ray(Ray(Vector3f(0.2f, 0.2f, 10), Vector3f(0, 0, -1)));
+
+    RayTriangleHit hit;
+    ASSERT_TRUE(RaycastQuery::IntersectsTriangles(ray, packet, 100.0f, hit));
+    ASSERT_TRUE(hit.index == 0);
+    ASSERT_NEAR(hit.distance, 5.0f, 1e-5f);
+    ASSERT_NEAR(hit.u, 0.2f, 1e-5f);
+    ASSERT_NEAR(hit.v, 0.2f, 1e-5f);
+
+    // Distance limit skips the nearer layers; unused slots never hit
+    RayTriangleHit limited;
+    PreparedRay below(Ray(Vector3f(0.2f, 0.2f, 0), Vector3f(0, 0, 1)));
+    ASSERT_TRUE(RaycastQuery::IntersectsTriangles(below, packet, 100.0f, limited));
+    ASSERT_TRUE(limited.index == 4);
+    ASSERT_FALSE(RaycastQuery::IntersectsTriangles(below, packet, 0.5f, limited));
+
+    for (int i = 5; i < 8; ++i)
+        ASSERT_TRUE(packet.Add(Vector3f(0, 0, -1), Vector3f(1, 0, -1), Vector3f(0, 1, -1)));
+    ASSERT_FALSE(packet.Add(Vector3f(0, 0, 0), Vector3f(1, 0, 0), Vector3f(0, 1, 0)));
+}
+
+// ============================================================================
+// Viewport Ray Tests
+// ============================================================================
+
+hgl::graph::CameraInfo MakeTestCamera(bool reversed_z, bool infinite_far) {
+    // Vulkan style perspective (depth [0,1]) looking along +Y, Z-up
+    const float n = 0.1f, f = 100.0f, aspect = 16.0f / 9.0f, t = 0.6f;
+    Matrix4f proj(0.0f);
+    proj[0][0] = 1.0f / (aspect * t);
+    proj[1][1] = 1.0f / t;
+    proj[2][3] = -1.0f;
+    if (infinite_far) {
+        proj[2][2] = 0.0f;          // Reversed-Z, infinite far
+        proj[3][2] = n;
+    } else if (reversed_z) {
+        proj[2][2] = n / (f - n);
+        proj[3][2] = n * f / (f - n);
+    } else {
+        proj[2][2] = f / (n - f);
+        proj[3][2] = n * f / (n - f);
+    }
+
+    // View: camera at (1,-5,2) looking along +Y with Z up
+    Matrix4f view(1.0f);
+    view[0] = Vector4f(1, 0, 0, 0);
+    view[1] = Vector4f(0, 0, -1, 0);
+    view[2] = Vector4f(0, 1, 0, 0);
+    view[3] = Vector4f(-1, 2, -5, 1);
+
+    hgl::graph::CameraInfo ci;
+    ci.vp = proj * view;
+    ci.inverse_vp = glm::inverse(ci.vp);
+    ci.use_reversed_z = (reversed_z || infinite_far) ? 1 : 0;
+    return ci;
+}
+
+void test_viewport_ray_grid_matches_single() {
+    const Vector2u viewport(320, 180);
+
+    for (int mode = 0; mode < 3; ++mode) {
+        hgl::graph::CameraInfo ci = MakeTestCamera(mode >= 1, mode == 2);
+
+        BatchRaySOA rays;
+        GenerateViewportRays(rays, &ci, viewport, Vector2i(10, 20), Vector2u(37, 11));
+        ASSERT_TRUE(rays.count == 37 * 11);
+
+        for (int y = 0; y < 11; ++y) {
+            for (int x = 0; x < 37; ++x) {
+                Ray ray;
+                ray.SetFromViewportPoint(Vector2i(10 + x, 20 + y), &ci, viewport);
+
+                const size_t i = size_t(y) * 37 + x;
+                ASSERT_NEAR(rays.originX[i], ray.origin.x, 1e-4f);
+                ASSERT_NEAR(rays.originY[i], ray.origin.y, 1e-4f);
+                ASSERT_NEAR(rays.originZ[i], ray.origin.z, 1e-4f);
+                ASSERT_NEAR(rays.directionX[i], ray.direction.x, 1e-5f);
+                ASSERT_NEAR(rays.directionY[i], ray.direction.y, 1e-5f);
+                ASSERT_NEAR(rays.directionZ[i], ray.direction.z, 1e-5f);
+            }
+        }
+    }
+}
+
+void test_viewport_ray_points_and_parallel() {
+    const Vector2u viewport(640, 360);
+    hgl::graph::CameraInfo ci = MakeTestCamera(false, false);
+
+    Vector2i points[] = {Vector2i(0, 0), Vector2i(320, 180), Vector2i(639, 359), Vector2i(17, 300)};
+    BatchRaySOA rays;
+    GenerateViewportRays(rays, &ci, viewport, points, 4);
+    ASSERT_TRUE(rays.count == 4);
+
+    for (int i = 0; i < 4; ++i) {
+        Ray ray;
+        ray.SetFromViewportPoint(points[i], &ci, viewport);
+        ASSERT_NEAR(rays.directionX[i], ray.direction.x, 1e-5f);
+        ASSERT_NEAR(rays.directionZ[i], ray.direction.z, 1e-5f);
+        ASSERT_NEAR(rays.originY[i], ray.origin.y, 1e-4f);
+    }
+
+    // Screen center looks straight down the view line
+    ASSERT_NEAR(rays.directionY[1], 1.0f, 1e-5f);
+
+    // Row-chunked parallel generation matches the serial result
+    BatchRaySOA serial, parallel;
+    ThreadParallelExecutor executor(4);
+    GenerateViewportRays(serial, &ci, viewport, Vector2i(0, 0), viewport);
+    GenerateViewportRays(parallel, &ci, viewport, Vector2i(0, 0), viewport, &executor);
+
+    ASSERT_TRUE(serial.count == parallel.count);
+    for (size_t i = 0; i < serial.count; i += 97)
+        ASSERT_TRUE(serial.directionX[i] == parallel.directionX[i] && serial.originZ[i] == parallel.originZ[i]);
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -327,6 +720,29 @@ int main() {
     TEST(ray_triangle_edge_hit);
     TEST(ray_triangle_barycentric);
 
+    std::cout << std::endl << "--- Ray-Torus Tests ---" << std::endl;
+    TEST(ray_torus_through_tube);
+    TEST(ray_torus_through_hole);
+    TEST(ray_torus_from_inside_tube);
+    TEST(ray_torus_detailed_hit);
+    TEST(ray_torus_outer_equator);
+    TEST(ray_torus_matches_march);
+
+    std::cout << std::endl << "--- Prepared Ray Tests ---" << std::endl;
+    TEST(prepared_ray_aabb_matches_ray);
+    TEST(prepared_ray_slab_boundary);
+    TEST(prepared_ray_obb);
+    TEST(watertight_triangle_matches_moller);
+    TEST(watertight_shared_edge);
+
+    std::cout << std::endl << "--- Batch Ray-Triangle Tests ---" << std::endl;
+    TEST(batch_triangles_match_single);
+    TEST(triangle_packet8);
+
+    std::cout << std::endl << "--- Viewport Ray Tests ---" << std::endl;
+    TEST(viewport_ray_grid_matches_single);
+    TEST(viewport_ray_points_and_parallel);
+
     std::cout << std::endl << "--- Edge Cases ---" << std::endl;
     TEST(ray_origin_on_sphere_surface);
     TEST(ray_zero_direction);
@@ -0,0 +1,267 @@
+﻿/**
+ * test_signed_distance_field.cpp
+ *
+ * Test cases for signed distance field baking and sampling
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <hgl/math/geometry/primitives/SignedDistanceField.h>
+#include <hgl/math/geometry/primitives/TriangleMesh.h>
+#include <hgl/math/geometry/primitives/Sphere.h>
+#include <hgl/math/geometry/primitives/Cone.h>
+#include <hgl/math/geometry/primitives/Cylinder.h>
+#include <hgl/math/geometry/queries/CollisionDispatch.h>
+#include <hgl/math/geometry/queries/DistanceQuery.h>
+#include <hgl/math/geometry/BatchQueryStructures.h>
+#include <hgl/math/ParallelFor.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+static float NextRandom(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+    return float(state >> 8) / float(1u << 24);     // [0,1)
+}
+
+static AABB MakeBounds(const Vector3f& min_point, const Vector3f& max_point)
+{
+    AABB box;
+    box.SetMinMax(min_point, max_point);
+    return box;
+}
+
+// Closed cube [-1,1]^3 with outward winding
+static TriangleMesh MakeCubeMesh()
+{
+    const Vector3f v[8] =
+    {
+        Vector3f(-1, -1, -1), Vector3f(1, -1, -1), Vector3f(1, 1, -1), Vector3f(-1, 1, -1),
+        Vector3f(-1, -1,  1), Vector3f(1, -1,  1), Vector3f(1, 1,  1), Vector3f(-1, 1,  1)
+    };
+
+    const uint32_t idx[36] =
+    {
+        0, 2, 1,  0, 3, 2,      // -Z
+        4, 5, 6,  4, 6, 7,      // +Z
+        0, 1, 5,  0, 5, 4,      // -Y
+        3, 7, 6,  3, 6, 2,      // +Y
+        0, 4, 7,  0, 7, 3,      // -X
+        1, 2, 6,  1, 6, 5       // +X
+    };
+
+    return TriangleMesh(v, 8, idx, 36);
+}
+
+// ============================================================================
+// Signed Distance Tests
+// ============================================================================
+
+void test_primitive_signed_distance()
+{
+    Sphere sphere(Vector3f(0, 0, 0), 1.0f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0.25f, 0, 0), sphere), -0.75f, 1e-6f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0, 3, 0), sphere), 2.0f, 1e-6f);
+
+    AABB box = MakeBounds(Vector3f(-1, -1, -1), Vector3f(1, 1, 1));
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0.5f, 0, 0), box), -0.5f, 1e-6f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(2, 2, 0), box), std::sqrt(2.0f), 1e-6f);
+
+    Cylinder cylinder(Vector3f(0, 0, 0), Vector3f(0, 0, 1), 4.0f, 1.0f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0, 0, 1.5f), cylinder), -0.5f, 1e-6f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0.5f, 0, 0), cylinder), -0.5f, 1e-6f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(2, 0, 3), cylinder), std::sqrt(2.0f), 1e-6f);
+
+    // Apex at origin opening along +Z, height 2, base radius 1
+    Cone cone(Vector3f(0, 0, 0), Vector3f(0, 0, 1), 2.0f, 1.0f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0, 0, 1.9f), cone), -0.1f, 1e-5f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0, 0, 1), cone), -1.0f / std::sqrt(5.0f), 1e-5f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(2, 0, 1), cone), std::sqrt(1.8f), 1e-5f);
+    ASSERT_NEAR(DistanceQuery::SignedDistance(Vector3f(0, 0, 3), cone), 1.0f, 1e-5f);
+}
+
+// ============================================================================
+// Bake Tests
+// ============================================================================
+
+void test_bake_sphere_shapes()
+{
+    Sphere spheres[1] = { Sphere(Vector3f(0.1f, -0.2f, 0.05f), 1.0f) };
+
+    CollisionShapeSet shapes;
+    shapes.spheres = spheres;
+    shapes.sphere_count = 1;
+
+    SignedDistanceField sdf;
+    ASSERT_TRUE(sdf.Bake(shapes, MakeBounds(Vector3f(-2, -2, -2), Vector3f(2, 2, 2)), 0.1f, 0.4f));
+    ASSERT_TRUE(sdf.IsValid());
+    ASSERT_TRUE(sdf.GetSampleCount(0) == 41);
+    ASSERT_TRUE(sdf.GetBrickCount(0) == 6);
+
+    // Bricks away from the surface are stored as constants
+    const size_t total = sdf.GetBricks().size();
+    ASSERT_TRUE(sdf.GetDenseBrickCount() > 0);
+    ASSERT_TRUE(sdf.GetDenseBrickCount() < total);
+
+    uint32_t seed = 99;
+    for (int i = 0; i < 500; i++)
+    {
+        const Vector3f p(NextRandom(seed) * 4 - 2, NextRandom(seed) * 4 - 2, NextRandom(seed) * 4 - 2);
+        const float exact = DistanceQuery::SignedDistance(p, spheres[0]);
+
+        // Interpolation is only exact away from the clamp at the band edge
+        if (std::abs(exact) < 0.3f) {
+            ASSERT_NEAR(sdf.Sample(p), exact, 0.01f);
+        } else {
+            ASSERT_TRUE((sdf.Sample(p) > 0.0f) == (exact > 0.0f));
+        }
+    }
+
+    // Gradient on the surface is the outward normal
+    Vector3f gradient;
+    const Vector3f surface = spheres[0].GetCenter() + Normalized(Vector3f(1, 1, 0));
+    ASSERT_NEAR(sdf.Sample(surface, &gradient), 0.0f, 0.01f);
+    ASSERT_NEAR(gradient.x, std::sqrt(0.5f), 0.05f);
+    ASSERT_NEAR(gradient.y, std::sqrt(0.5f), 0.05f);
+    ASSERT_NEAR(gradient.z, 0.0f, 0.05f);
+
+    const Vector3f projected = sdf.ClosestPoint(spheres[0].GetCenter() + Vector3f(0, 0, 1.2f));
+    ASSERT_NEAR(Length(projected - spheres[0].GetCenter()), 1.0f, 0.01f);
+}
+
+void test_bake_mesh()
+{
+    const TriangleMesh mesh = MakeCubeMesh();
+    const AABB cube = MakeBounds(Vector3f(-1, -1, -1), Vector3f(1, 1, 1));
+
+    SignedDistanceField sdf;
+    ASSERT_TRUE(sdf.Bake(mesh, MakeBounds(Vector3f(-1.6f, -1.6f, -1.6f), Vector3f(1.6f, 1.6f, 1.6f)), 0.1f, 0.5f));
+
+    // Samples sit exactly on lattice points, so they match the exact box distance
+    for (int z = 0; z < sdf.GetSampleCount(2); z += 3)
+        for (int y = 0; y < sdf.GetSampleCount(1); y += 3)
+            for (int x = 0; x < sdf.GetSampleCount(0); x += 3)
+            {
+                const Vector3f p = sdf.GetOrigin() + Vector3f(float(x), float(y), float(z)) * sdf.GetVoxelSize();
+                const float exact = std::clamp(DistanceQuery::SignedDistance(p, cube), -0.5f, 0.5f);
+
+                ASSERT_NEAR(sdf.GetSample(x, y, z), exact, 1e-4f);
+            }
+
+    uint32_t seed = 7;
+    for (int i = 0; i < 500; i++)
+    {
+        const Vector3f p(NextRandom(seed) * 3.2f - 1.6f, NextRandom(seed) * 3.2f - 1.6f, NextRandom(seed) * 3.2f - 1.6f);
+        const float exact = std::clamp(DistanceQuery::SignedDistance(p, cube), -0.5f, 0.5f);
+
+        ASSERT_NEAR(sdf.Sample(p), exact, 0.05f);
+    }
+
+    ASSERT_TRUE(sdf.Sample(Vector3f(0, 0, 0)) < 0.0f);
+    ASSERT_TRUE(sdf.Sample(Vector3f(1.5f, 0, 0)) > 0.0f);
+}
+
+void test_bake_parallel_and_batch()
+{
+    const TriangleMesh mesh = MakeCubeMesh();
+    const AABB bounds = MakeBounds(Vector3f(-1.5f, -1.5f, -1.5f), Vector3f(1.5f, 1.5f, 1.5f));
+    ThreadParallelExecutor executor(4);
+
+    SignedDistanceField serial, parallel;
+    ASSERT_TRUE(serial.Bake(mesh, bounds, 0.1f, 0.3f));
+    ASSERT_TRUE(parallel.Bake(mesh, bounds, 0.1f, 0.3f, &executor));
+    ASSERT_TRUE(serial.GetDenseBrickCount() == parallel.GetDenseBrickCount());
+
+    for (int z = 0; z < serial.GetSampleCount(2); z++)
+        for (int y = 0; y < serial.GetSampleCount(1); y++)
+            for (int x = 0; x < serial.GetSampleCount(0); x++)
+                ASSERT_TRUE(serial.GetSample(x, y, z) == parallel.GetSample(x, y, z));
+
+    BatchPointSOA points;
+    uint32_t seed = 3;
+    for (int i = 0; i < 2000; i++)
+        points.Add(Vector3f(NextRandom(seed) * 4 - 2, NextRandom(seed) * 4 - 2, NextRandom(seed) * 4 - 2));
+
+    std::vector<float> distance(points.count);
+    std::vector<Vector3f> gradient(points.count);
+    serial.Sample(points, distance.data(), gradient.data(), &executor);
+
+    for (size_t i = 0; i < points.count; i++)
+    {
+        Vector3f g;
+        ASSERT_TRUE(distance[i] == serial.Sample(points.Get(i), &g));
+        ASSERT_TRUE(gradient[i] == g);
+    }
+}
+
+void test_outside_and_invalid()
+{
+    Sphere spheres[1] = { Sphere(Vector3f(0, 0, 0), 0.5f) };
+
+    CollisionShapeSet shapes;
+    shapes.spheres = spheres;
+    shapes.sphere_count = 1;
+
+    SignedDistanceField sdf;
+    ASSERT_TRUE(sdf.Bake(shapes, MakeBounds(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)), 0.1f, 1.0f));
+
+    // Outside the lattice: value at the nearest covered point plus the gap
+    Vector3f gradient;
+    ASSERT_NEAR(sdf.Sample(Vector3f(3, 0, 0), &gradient), sdf.Sample(Vector3f(1, 0, 0)) + 2.0f, 1e-5f);
+    ASSERT_NEAR(gradient.x, 1.0f, 1e-6f);
+
+    ASSERT_FALSE(sdf.Bake(shapes, MakeBounds(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)), 0.0f, 1.0f));
+    ASSERT_FALSE(sdf.IsValid());
+    ASSERT_FALSE(sdf.Bake(shapes, MakeBounds(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)), 0.1f, 0.0f));
+
+    TriangleMesh empty;
+    ASSERT_FALSE(sdf.Bake(empty, MakeBounds(Vector3f(-1, -1, -1), Vector3f(1, 1, 1)), 0.1f, 1.0f));
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::cout << "=== Signed Distance Field Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Signed Distance Tests ---" << std::endl;
+    TEST(primitive_signed_distance);
+
+    std::cout << std::endl << "--- Bake Tests ---" << std::endl;
+    TEST(bake_sphere_shapes);
+    TEST(bake_mesh);
+    TEST(bake_parallel_and_batch);
+    TEST(outside_and_invalid);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
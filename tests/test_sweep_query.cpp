@@ -0,0 +1,254 @@
+﻿/**
+ * test_sweep_query.cpp
+ *
+ * Test cases for swept collision / time of impact queries
+ */
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <hgl/math/geometry/queries/SweepQuery.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Moving Sphere Tests
+// ============================================================================
+
+void test_sphere_sphere_hit() {
+    Sphere bullet(Vector3f(-10, 0, 0), 0.5f);
+    Sphere target(Vector3f(0, 0, 0), 1.0f);
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(bullet, Vector3f(20, 0, 0), target, hit));
+    ASSERT_NEAR(hit.time, 8.5f / 20.0f, 1e-5f);
+    ASSERT_NEAR(hit.normal.x, 1.0f, 1e-5f);
+    ASSERT_NEAR(hit.point.x, -1.0f, 1e-5f);
+    ASSERT_FALSE(hit.initially_overlapping);
+}
+
+void test_sphere_sphere_miss() {
+    Sphere bullet(Vector3f(-10, 2, 0), 0.5f);
+    Sphere target(Vector3f(0, 0, 0), 1.0f);
+
+    SweepHit hit;
+    ASSERT_FALSE(SweepQuery::Sweep(bullet, Vector3f(20, 0, 0), target, hit));
+    ASSERT_FALSE(SweepQuery::Sweep(bullet, Vector3f(-20, -2, 0), target, hit));
+}
+
+void test_sphere_thin_wall_no_tunneling() {
+    // Discrete test at start and end would miss the wall entirely
+    Sphere bullet(Vector3f(-5, 0, 0), 0.1f);
+    AABB wall;
+    wall.SetMinMax(Vector3f(-0.01f, -2, -2), Vector3f(0.01f, 2, 2));
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(bullet, Vector3f(10, 0, 0), wall, hit));
+    ASSERT_NEAR(hit.time, (5.0f - 0.11f) / 10.0f, 1e-5f);
+    ASSERT_NEAR(hit.normal.x, 1.0f, 1e-5f);
+}
+
+void test_sphere_aabb_edge_and_corner() {
+    AABB box;
+    box.SetMinMax(Vector3f(-1, -1, -1), Vector3f(1, 1, 1));
+
+    // Passes the rounded edge along Z: hits the edge capsule, not the expanded box corner
+    Sphere s(Vector3f(-5, 1.4f, 0), 0.5f);
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(s, Vector3f(10, 0, 0), box, hit));
+
+    const float expected_x = -1.0f - std::sqrt(0.25f - 0.16f);
+    ASSERT_NEAR(-5.0f + 10.0f * hit.time, expected_x, 1e-4f);
+
+    // Misses the rounded corner even though the expanded box is hit
+    Sphere corner(Vector3f(-5, 1.45f, 1.45f), 0.5f);
+    ASSERT_FALSE(SweepQuery::Sweep(corner, Vector3f(10, 0, 0), box, hit));
+}
+
+void test_sphere_obb_rotated() {
+    const float s = std::sqrt(0.5f);
+    OBB box(Vector3f(0, 0, 0), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(1, 1, 1));
+    Sphere sphere(Vector3f(0, 5, 0), 0.5f);
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(sphere, Vector3f(0, -10, 0), box, hit));
+
+    // Top corner of the rotated box is at y = sqrt(2)
+    ASSERT_NEAR(5.0f - 10.0f * hit.time, std::sqrt(2.0f) + 0.5f, 1e-4f);
+    ASSERT_NEAR(hit.normal.y, -1.0f, 1e-4f);
+}
+
+void test_sphere_triangle() {
+    Triangle3f tri(Vector3f(-1, 0, -1), Vector3f(1, 0, -1), Vector3f(0, 0, 1));
+    SweepHit hit;
+
+    Sphere face(Vector3f(0, 3, 0), 0.5f);
+    ASSERT_TRUE(SweepQuery::Sweep(face, Vector3f(0, -6, 0), tri, hit));
+    ASSERT_NEAR(hit.time, 2.5f / 6.0f, 1e-5f);
+    ASSERT_NEAR(hit.normal.y, -1.0f, 1e-5f);
+
+    // Grazes the edge z=-1 from outside the face region
+    Sphere edge(Vector3f(0, 3, -1.3f), 0.5f);
+    ASSERT_TRUE(SweepQuery::Sweep(edge, Vector3f(0, -6, 0), tri, hit));
+    ASSERT_NEAR(3.0f - 6.0f * hit.time, 0.4f, 1e-4f);
+
+    Sphere miss(Vector3f(0, 3, -2), 0.5f);
+    ASSERT_FALSE(SweepQuery::Sweep(miss, Vector3f(0, -6, 0), tri, hit));
+}
+
+void test_initial_overlap() {
+    Sphere s(Vector3f(0, 0.2f, 0), 0.5f);
+    AABB box;
+    box.SetMinMax(Vector3f(-1, -1, -1), Vector3f(1, 0, 1));
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(s, Vector3f(1, 0, 0), box, hit));
+    ASSERT_TRUE(hit.initially_overlapping);
+    ASSERT_NEAR(hit.time, 0.0f, 1e-6f);
+}
+
+// ============================================================================
+// Moving Capsule Tests
+// ============================================================================
+
+void test_capsule_sphere() {
+    Capsule capsule(Vector3f(-1, 0, 0), Vector3f(1, 0, 0), 0.25f);
+    Sphere target(Vector3f(0.5f, 5, 0), 0.25f);
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(capsule, Vector3f(0, 10, 0), target, hit));
+    ASSERT_NEAR(hit.time, 4.5f / 10.0f, 1e-5f);
+    ASSERT_NEAR(hit.normal.y, 1.0f, 1e-5f);
+    ASSERT_NEAR(hit.point.y, 4.75f, 1e-4f);
+}
+
+void test_capsule_box_conservative() {
+    Capsule capsule(Vector3f(-1, 3, 0), Vector3f(1, 3, 0), 0.5f);
+    OBB box(Vector3f(0, 0, 0), Vector3f(2, 1, 2));
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(capsule, Vector3f(0, -4, 0), box, hit));
+
+    // Contact when the capsule bottom (y - 0.5) reaches the box top (y = 1)
+    ASSERT_NEAR(hit.time, 1.5f / 4.0f, SweepQuery::DEFAULT_TOLERANCE);
+    ASSERT_TRUE(hit.time <= 1.5f / 4.0f);
+    ASSERT_NEAR(hit.normal.y, -1.0f, 1e-3f);
+
+    ASSERT_FALSE(SweepQuery::Sweep(capsule, Vector3f(0, 4, 0), box, hit));
+}
+
+void test_capsule_triangle_and_capsule() {
+    Triangle3f tri(Vector3f(-1, 0, -1), Vector3f(1, 0, -1), Vector3f(0, 0, 1));
+    Capsule capsule(Vector3f(0, 1, 0), Vector3f(0, 3, 0), 0.5f);
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(capsule, Vector3f(0, -2, 0), tri, hit));
+    ASSERT_NEAR(hit.time, 0.25f, 1e-3f);
+
+    Capsule other(Vector3f(2, -1, 0), Vector3f(2, 1, 0), 0.5f);
+    ASSERT_TRUE(SweepQuery::Sweep(capsule, Vector3f(4, -2, 0), other, hit));
+    ASSERT_NEAR(hit.time, 0.25f, 1e-3f);
+}
+
+void test_capsule_grazing_box_edge() {
+    // Capsule skimming over the box edge: the closest features change every
+    // step and the witness normal is never exact. The reported time must not
+    // pass the contact (0.391533, from a double-precision bisection of the
+    // segment-box distance).
+    AABB box;
+    box.SetMinMax(Vector3f(-1, -1, -1), Vector3f(1, 0, 1));
+
+    Capsule capsule(Vector3f(-8.84792519f, 0.499702007f, -0.746618509f),
+                    Vector3f(-9.16190434f, 0.713722289f, -0.809593797f), 0.5f);
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::Sweep(capsule, Vector3f(20, 0, 0), box, hit));
+    ASSERT_TRUE(hit.time <= 0.391533f);
+    ASSERT_NEAR(hit.time, 0.391533f, 2e-3f);
+
+    // Level with the top face: r = 0.5 over the edge at y = 0
+    for (float y : {0.2f, 0.3f, 0.4f, 0.45f})
+    {
+        Capsule upright(Vector3f(-10, y, 0), Vector3f(-10, y + 2, 0), 0.5f);
+        const float contact = (9.0f - std::sqrt(0.25f - y * y)) / 20.0f;
+
+        ASSERT_TRUE(SweepQuery::Sweep(upright, Vector3f(20, 0, 0), box, hit));
+        ASSERT_TRUE(hit.time <= contact + 1e-6f);
+        ASSERT_NEAR(hit.time, contact, 5e-3f);
+    }
+}
+
+// ============================================================================
+// Conservative Advancement Tests
+// ============================================================================
+
+void test_both_moving() {
+    OBB a(Vector3f(-5, 0, 0), Vector3f(1, 1, 1));
+    OBB b(Vector3f(5, 0, 0), Vector3f(1, 1, 1));
+
+    SweepHit hit;
+    ASSERT_TRUE(SweepQuery::TimeOfImpact(a, Vector3f(5, 0, 0), b, Vector3f(-5, 0, 0), hit));
+    ASSERT_NEAR(hit.time, 0.8f, 1e-3f);
+    ASSERT_NEAR(hit.normal.x, 1.0f, 1e-3f);
+
+    // Contact point in world space at impact time
+    ASSERT_NEAR(hit.point.x, 0.0f, 1e-2f);
+}
+
+void test_matches_analytic() {
+    Sphere a(Vector3f(-3, 0.5f, 0), 0.5f);
+    Sphere b(Vector3f(0, 0, 0), 1.0f);
+    const Vector3f motion(6, 0, 0);
+
+    SweepHit analytic, advanced;
+    ASSERT_TRUE(SweepQuery::Sweep(a, motion, b, analytic));
+    ASSERT_TRUE(SweepQuery::TimeOfImpact(a, motion, b, Vector3f(0, 0, 0), advanced));
+    ASSERT_TRUE(advanced.time <= analytic.time + 1e-6f);
+    ASSERT_NEAR(advanced.time, analytic.time, 1e-3f);
+}
+
+int main() {
+    std::cout << "=== Sweep Query Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Moving Sphere Tests ---" << std::endl;
+    TEST(sphere_sphere_hit);
+    TEST(sphere_sphere_miss);
+    TEST(sphere_thin_wall_no_tunneling);
+    TEST(sphere_aabb_edge_and_corner);
+    TEST(sphere_obb_rotated);
+    TEST(sphere_triangle);
+    TEST(initial_overlap);
+
+    std::cout << std::endl << "--- Moving Capsule Tests ---" << std::endl;
+    TEST(capsule_sphere);
+    TEST(capsule_box_conservative);
+    TEST(capsule_triangle_and_capsule);
+    TEST(capsule_grazing_box_edge);
+
+    std::cout << std::endl << "--- Conservative Advancement Tests ---" << std::endl;
+    TEST(both_moving);
+    TEST(matches_analytic);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}
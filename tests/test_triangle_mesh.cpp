@@ -0,0 +1,302 @@
+﻿/**
+ * test_triangle_mesh.cpp
+ *
+ * Test cases for the static triangle mesh collider
+ */
+
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <hgl/math/geometry/primitives/TriangleMesh.h>
+#include <hgl/math/geometry/primitives/Sphere.h>
+#include <hgl/math/geometry/primitives/Capsule.h>
+#include <hgl/math/geometry/OBB.h>
+#include <hgl/math/geometry/Ray.h>
+#include <hgl/math/geometry/queries/RaycastQuery.h>
+
+using namespace hgl::math;
+
+#define TEST(name) \
+    std::cout << "Testing " << #name << "... "; \
+    test_##name(); \
+    std::cout << "PASSED" << std::endl;
+
+#define ASSERT_TRUE(expr) \
+    if (!(expr)) { \
+        std::cerr << "FAILED: " << #expr << " at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+#define ASSERT_FALSE(expr) ASSERT_TRUE(!(expr))
+
+#define ASSERT_NEAR(a, b, epsilon) \
+    if (std::abs((a) - (b)) > (epsilon)) { \
+        std::cerr << "FAILED: " << #a << " (" << (a) << ") != " << #b << " (" << (b) << ") at line " << __LINE__ << std::endl; \
+        exit(1); \
+    }
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+// Wavy terrain of size x size quads over [0,size] in XZ
+TriangleMesh MakeTerrain(uint32_t size)
+{
+    std::vector<Vector3f> vertices;
+    std::vector<uint32_t> indices;
+
+    for (uint32_t z = 0; z <= size; z++)
+        for (uint32_t x = 0; x <= size; x++)
+            vertices.push_back(Vector3f(float(x), std::sin(x * 0.5f) * std::cos(z * 0.3f), float(z)));
+
+    for (uint32_t z = 0; z < size; z++)
+        for (uint32_t x = 0; x < size; x++)
+        {
+            const uint32_t i = z * (size + 1) + x;
+
+            indices.insert(indices.end(), {i, i + size + 1, i + 1});
+            indices.insert(indices.end(), {i + 1, i + size + 1, i + size + 2});
+        }
+
+    return TriangleMesh(vertices.data(), uint32_t(vertices.size()), indices.data(), uint32_t(indices.size()));
+}
+
+float BruteForceClosest(const TriangleMesh &mesh, const Vector3f &p)
+{
+    float best = FLT_MAX;
+
+    for (uint32_t i = 0; i < mesh.GetTriangleCount(); i++)
+    {
+        const Vector3f c = mesh.GetTriangle(i).ClosestPoint(p);
+        best = std::min(best, Length(p - c));
+    }
+
+    return best;
+}
+
+// ============================================================================
+// Build Tests
+// ============================================================================
+
+void test_build() {
+    TriangleMesh mesh = MakeTerrain(32);
+
+    ASSERT_TRUE(mesh.GetTriangleCount() == 32 * 32 * 2);
+    ASSERT_TRUE(mesh.GetNodeCount() < mesh.GetTriangleCount());
+    ASSERT_TRUE(mesh.GetDepth() > 1 && mesh.GetDepth() < 32);
+
+    // Every triangle is referenced exactly once by the leaves
+    std::vector<int> seen(mesh.GetTriangleCount(), 0);
+    std::vector<uint32_t> all;
+    AABB box = mesh.GetBoundingBox();
+    ASSERT_TRUE(mesh.QueryBoundingBox(box, all) == mesh.GetTriangleCount());
+    for (uint32_t t : all) seen[t]++;
+    for (int n : seen) ASSERT_TRUE(n == 1);
+}
+
+void test_invalid_input() {
+    Vector3f v[3] = { Vector3f(0, 0, 0), Vector3f(1, 0, 0), Vector3f(0, 1, 0) };
+    uint32_t bad_index[3] = { 0, 1, 5 };
+    uint32_t bad_count[2] = { 0, 1 };
+
+    TriangleMesh mesh;
+    ASSERT_FALSE(mesh.Set(v, 3, bad_index, 3));
+    ASSERT_TRUE(mesh.IsEmpty());
+    ASSERT_FALSE(mesh.Set(v, 3, bad_count, 2));
+
+    MeshRayHit hit;
+    ASSERT_FALSE(mesh.Raycast(Ray(Vector3f(0, 0, 1), Vector3f(0, 0, -1)), 10.0f, hit));
+}
+
+// ============================================================================
+// Raycast Tests
+// ============================================================================
+
+void test_raycast_matches_brute_force() {
+    TriangleMesh mesh = MakeTerrain(32);
+
+    for (int i = 0; i < 50; i++)
+    {
+        const Vector3f origin(0.37f + i * 0.61f, 5.0f, 0.53f + i * 0.59f);
+        const Vector3f dir = Normalized(Vector3f(0.2f, -1.0f, 0.1f * (i % 3)));
+        const Ray ray(origin, dir);
+
+        float best = FLT_MAX;
+        for (uint32_t t = 0; t < mesh.GetTriangleCount(); t++)
+        {
+            const Triangle3f tri = mesh.GetTriangle(t);
+            float d;
+            if (RaycastQuery::IntersectsTriangle(ray, tri[0], tri[1], tri[2], d))
+                best = std::min(best, d);
+        }
+
+        MeshRayHit hit;
+        const bool found = mesh.Raycast(ray, 100.0f, hit);
+
+        ASSERT_TRUE(found == (best < FLT_MAX));
+        if (found)
+        {
+            ASSERT_NEAR(hit.distance, best, 1e-4f);
+            ASSERT_TRUE(Dot(hit.normal, dir) <= 0.0f);
+            ASSERT_TRUE(mesh.RaycastAny(ray, 100.0f));
+            ASSERT_FALSE(mesh.RaycastAny(ray, best * 0.5f));
+        }
+    }
+}
+
+void test_raycast_miss() {
+    TriangleMesh mesh = MakeTerrain(8);
+    MeshRayHit hit;
+
+    ASSERT_FALSE(mesh.Raycast(Ray(Vector3f(4, 5, 4), Vector3f(0, 1, 0)), 100.0f, hit));
+    ASSERT_FALSE(mesh.Raycast(Ray(Vector3f(-5, 0, 4), Vector3f(-1, 0, 0)), 100.0f, hit));
+    ASSERT_FALSE(mesh.Raycast(Ray(Vector3f(4, 5, 4), Vector3f(0, -1, 0)), 2.0f, hit));
+}
+
+// ============================================================================
+// Overlap Tests
+// ============================================================================
+
+void test_sphere_overlap() {
+    TriangleMesh mesh = MakeTerrain(16);
+
+    Sphere above(Vector3f(8, 3, 8), 1.0f);
+    Sphere touching(Vector3f(8, 0.5f, 8), 1.0f);
+
+    ASSERT_FALSE(mesh.Overlaps(above));
+    ASSERT_TRUE(mesh.Overlaps(touching));
+
+    std::vector<uint32_t> tris;
+    ASSERT_TRUE(mesh.QueryOverlaps(touching, tris) > 0);
+
+    // Every reported triangle really overlaps, and none is missed
+    uint32_t expected = 0;
+    for (uint32_t t = 0; t < mesh.GetTriangleCount(); t++)
+    {
+        const Vector3f c = mesh.GetTriangle(t).ClosestPoint(touching.GetCenter());
+        if (Length(c - touching.GetCenter()) <= touching.GetRadius())
+            expected++;
+    }
+    ASSERT_TRUE(tris.size() == expected);
+}
+
+void test_capsule_overlap() {
+    TriangleMesh mesh = MakeTerrain(16);
+
+    Capsule standing(Vector3f(5, 0.5f, 5), Vector3f(5, 2.5f, 5), 0.6f);
+    Capsule floating(Vector3f(5, 3.0f, 5), Vector3f(5, 5.0f, 5), 0.6f);
+    Capsule crossing(Vector3f(5, -2.0f, 5), Vector3f(5, 2.0f, 5), 0.01f);     // thin, pierces the surface
+
+    ASSERT_TRUE(mesh.Overlaps(standing));
+    ASSERT_FALSE(mesh.Overlaps(floating));
+    ASSERT_TRUE(mesh.Overlaps(crossing));
+}
+
+void test_obb_overlap() {
+    TriangleMesh mesh = MakeTerrain(16);
+
+    const float s = std::sqrt(0.5f);
+    OBB rotated(Vector3f(8, 2.0f, 8), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(0.5f, 0.5f, 0.5f));
+    OBB sunk(Vector3f(8, 0.0f, 8), Vector3f(s, s, 0), Vector3f(-s, s, 0), Vector3f(0, 0, 1), Vector3f(0.5f, 0.5f, 0.5f));
+
+    ASSERT_FALSE(mesh.Overlaps(rotated));
+    ASSERT_TRUE(mesh.Overlaps(sunk));
+
+    std::vector<uint32_t> tris;
+    ASSERT_TRUE(mesh.QueryOverlaps(sunk, tris) > 0);
+}
+
+void test_obb_triangle_sat() {
+    // Large triangle crossing a small box with no triangle vertex inside it
+    OBB box(Vector3f(0, 0, 0), Vector3f(0.5f, 0.5f, 0.5f));
+    Triangle3f crossing(Vector3f(-10, 0, -10), Vector3f(10, 0, -10), Vector3f(0, 0, 10));
+    Triangle3f beside(Vector3f(2, -5, -5), Vector3f(2, 5, -5), Vector3f(2, 0, 5));
+
+    ASSERT_TRUE(box.IntersectsTriangle(crossing));
+    ASSERT_FALSE(box.IntersectsTriangle(beside));
+
+    // Box face axes all overlap; only the triangle normal separates
+    Triangle3f edge_case(Vector3f(1.2f, 0, -5), Vector3f(0, 1.2f, -5), Vector3f(0.6f, 0.6f, 5));
+    ASSERT_FALSE(box.IntersectsTriangle(edge_case));
+}
+
+// ============================================================================
+// Closest Point Tests
+// ============================================================================
+
+void test_closest_point() {
+    TriangleMesh mesh = MakeTerrain(16);
+
+    for (int i = 0; i < 30; i++)
+    {
+        const Vector3f p(0.5f + i * 0.5f, 1.0f + (i % 5), 15.5f - i * 0.45f);
+
+        MeshClosestPoint result;
+        ASSERT_TRUE(mesh.ClosestPoint(p, FLT_MAX, result));
+        ASSERT_NEAR(result.distance, BruteForceClosest(mesh, p), 1e-4f);
+        ASSERT_NEAR(Length(result.point - p), result.distance, 1e-4f);
+    }
+
+    MeshClosestPoint result;
+    ASSERT_FALSE(mesh.ClosestPoint(Vector3f(8, 20, 8), 5.0f, result));
+}
+
+void test_closest_feature_cache() {
+    TriangleMesh mesh = MakeTerrain(16);
+    TriangleMeshCache cache;
+
+    // Walk a point across the terrain; cached results must equal uncached ones
+    for (int i = 0; i < 40; i++)
+    {
+        const Vector3f p(2.0f + i * 0.3f, 1.5f, 3.0f + i * 0.2f);
+
+        MeshClosestPoint cached, fresh;
+        ASSERT_TRUE(mesh.ClosestPoint(p, FLT_MAX, cached, &cache));
+        ASSERT_TRUE(mesh.ClosestPoint(p, FLT_MAX, fresh));
+
+        ASSERT_NEAR(cached.distance, fresh.distance, 1e-5f);
+        ASSERT_TRUE(cache.triangle == cached.triangle);
+    }
+
+    // Overlap cache remembers the touching triangle
+    TriangleMeshCache overlap_cache;
+    Sphere sphere(Vector3f(8, 0.2f, 8), 0.5f);
+    ASSERT_TRUE(mesh.Overlaps(sphere, &overlap_cache));
+    ASSERT_TRUE(overlap_cache.triangle != MESH_INVALID_TRIANGLE);
+    ASSERT_TRUE(mesh.Overlaps(sphere, &overlap_cache));
+
+    overlap_cache.Reset();
+    ASSERT_TRUE(overlap_cache.triangle == MESH_INVALID_TRIANGLE);
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main() {
+    std::cout << "=== Triangle Mesh Tests ===" << std::endl << std::endl;
+
+    std::cout << "--- Build Tests ---" << std::endl;
+    TEST(build);
+    TEST(invalid_input);
+
+    std::cout << std::endl << "--- Raycast Tests ---" << std::endl;
+    TEST(raycast_matches_brute_force);
+    TEST(raycast_miss);
+
+    std::cout << std::endl << "--- Overlap Tests ---" << std::endl;
+    TEST(sphere_overlap);
+    TEST(capsule_overlap);
+    TEST(obb_overlap);
+    TEST(obb_triangle_sat);
+
+    std::cout << std::endl << "--- Closest Point Tests ---" << std::endl;
+    TEST(closest_point);
+    TEST(closest_feature_cache);
+
+    std::cout << std::endl << "=== All Tests Passed! ===" << std::endl;
+
+    return 0;
+}